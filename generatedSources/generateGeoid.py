@@ -0,0 +1,21 @@
+#!/bin/python3
+
+#
+# Converts the EGM96 geoid grid WW15MGH.DAC from big-endian to little-endian
+# byte order, so that Positioning::Geoid can use the data in place on all
+# supported (little-endian) platforms, without copying or byte-swapping.
+#
+# Usage: generateGeoid.py <input file> <output file>
+#
+
+import sys
+
+with open(sys.argv[1], 'rb') as inputFile:
+    bigEndian = inputFile.read()
+
+littleEndian = bytearray(len(bigEndian))
+littleEndian[0::2] = bigEndian[1::2]
+littleEndian[1::2] = bigEndian[0::2]
+
+with open(sys.argv[2], 'wb') as outputFile:
+    outputFile.write(littleEndian)
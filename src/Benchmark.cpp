@@ -0,0 +1,1890 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <QBuffer>
+#include <QCache>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QGeoCircle>
+#include <QGeoCoordinate>
+#include <QGeoPositionInfo>
+#include <QGeoRectangle>
+#include <QHash>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QPolygonF>
+#include <QRandomGenerator>
+#include <QSaveFile>
+#include <QSet>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtMath>
+#include <atomic>
+#include <numeric>
+
+#include "Benchmark.h"
+#include "BenchmarkReference.h"
+#include "GlobalObject.h"
+#include "config.h"
+#include "dataManagement/FileWriter.h"
+#include "fileFormats/CSV.h"
+#include "fileFormats/CUP.h"
+#include "fileFormats/DEM.h"
+#include "fileFormats/FPL.h"
+#include "fileFormats/FileProbe.h"
+#include "fileFormats/MBTILES.h"
+#include "fileFormats/PLN.h"
+#include "fileFormats/PMTILES.h"
+#include "fileFormats/TripKit.h"
+#include "fileFormats/ZipFile.h"
+#include "geomaps/GeoJSON.h"
+#include "geomaps/GeoMapProvider.h"
+#include "geomaps/OpenAir.h"
+#include "geomaps/TileServer.h"
+#include "geomaps/VAC.h"
+#include "geomaps/WaypointLibrary.h"
+#include "navigation/AirspaceIncursionPredictor.h"
+#include "navigation/LegTracker.h"
+#include "notam/NOTAMList.h"
+#include "positioning/Geoid.h"
+#include "traffic/CollisionPredictor.h"
+#include "traffic/TrafficDataProvider.h"
+#include "traffic/TrafficDataSource_Abstract.h"
+#include "traffic/TrafficDataSource_File.h"
+#include "ui/SideviewQuickItem.h"
+#include "weather/Decoder.h"
+#include "weather/QNHStationIndex.h"
+#include "weather/WeatherDataProvider.h"
+
+using namespace Qt::Literals::StringLiterals;
+
+
+namespace {
+
+// Every benchmark is repeated until it has run for at least this long
+constexpr qint64 minimalDuration = 1000; // ms
+
+// Synthetic data is spread over a square of this size around this center
+constexpr double centerLatitude = 48.0;
+constexpr double centerLongitude = 8.0;
+constexpr double extent = 3.0; // degrees
+
+// Number of synthetic objects
+constexpr int numAirspaces = 2000;
+constexpr int numMessages = 20000;
+constexpr int numNOTAMs = 5000;
+constexpr int numStations = 2000;
+constexpr int numTracks = 100;
+constexpr int numFixesPerTrack = 600;
+constexpr int numTerrainQueries = 200;
+constexpr int numTilesPerSide = 32;
+constexpr int numWaypoints = 10000;
+
+// Zoom level of the synthetic MBTILES file
+constexpr int tileZoom = 10;
+
+// Zoom level and size of the synthetic terrain tiles
+constexpr int terrainZoom = 10;
+constexpr int terrainTileSize = 256;
+
+
+// Traffic data source that gives access to the FLARM and GDL90 parsers
+class BenchmarkSource : public Traffic::TrafficDataSource_Abstract
+{
+public:
+    BenchmarkSource() : TrafficDataSource_Abstract(false, nullptr) {}
+
+    [[nodiscard]] QString dataFormat() const override { return {}; }
+    [[nodiscard]] QString icon() const override { return {}; }
+    [[nodiscard]] QString sourceName() const override { return u"Benchmark"_s; }
+    void connectToTrafficReceiver() override {}
+    void disconnectFromTrafficReceiver() override {}
+
+    using TrafficDataSource_Abstract::processFLARMData;
+    using TrafficDataSource_Abstract::processGDLMessage;
+};
+
+
+// Runs the function repeatedly and returns the result as a JSON object.
+// The parameter items is the number of items that the function processes
+// in one iteration.
+template<typename F>
+QJsonObject measure(const QString& name, qsizetype items, F function)
+{
+    // Warm up caches
+    function();
+
+    qint64 iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    do
+    {
+        function();
+        iterations++;
+    } while (timer.elapsed() < minimalDuration);
+    auto const nanoseconds = timer.nsecsElapsed();
+
+    auto const nsPerIteration = double(nanoseconds)/double(iterations);
+    qInfo().noquote() << u"%1: %2 µs per iteration"_s.arg(name).arg(nsPerIteration/1000.0, 0, 'f', 1);
+    return {
+        {u"name"_s, name},
+        {u"iterations"_s, iterations},
+        {u"items"_s, items},
+        {u"nsPerIteration"_s, nsPerIteration},
+        {u"itemsPerSecond"_s, double(items)*1e9/nsPerIteration},
+    };
+}
+
+
+// Random coordinate in the area covered by synthetic data
+QGeoCoordinate randomCoordinate(QRandomGenerator& generator)
+{
+    return {centerLatitude + extent*(generator.generateDouble()-0.5), centerLongitude + extent*(generator.generateDouble()-0.5)};
+}
+
+// Adds the speedup over a reference benchmark to the result
+void addSpeedup(QJsonObject& result, const QJsonObject& reference)
+{
+    result.insert(u"speedup"_s, reference.value(u"nsPerIteration"_s).toDouble()/result.value(u"nsPerIteration"_s).toDouble());
+}
+
+// True if both lists contain the same waypoints, with bitwise identical
+// coordinates
+bool identicalWaypoints(const QVector<GeoMaps::Waypoint>& first, const QVector<GeoMaps::Waypoint>& second)
+{
+    if (first.size() != second.size())
+    {
+        return false;
+    }
+    for(qsizetype i=0; i<first.size(); i++)
+    {
+        auto const firstCoordinate = first.at(i).coordinate();
+        auto const secondCoordinate = second.at(i).coordinate();
+        if (!(first.at(i) == second.at(i))
+            || (firstCoordinate.latitude() != secondCoordinate.latitude())
+            || (firstCoordinate.longitude() != secondCoordinate.longitude())
+            || (firstCoordinate.altitude() != secondCoordinate.altitude()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Polygon approximating a circle around the center, with radius in degrees
+QList<QGeoCoordinate> randomPolygon(QRandomGenerator& generator)
+{
+    auto const center = randomCoordinate(generator);
+    auto const radius = 0.05 + 0.2*generator.generateDouble();
+    QList<QGeoCoordinate> polygon;
+    for(int i=0; i<=32; i++)
+    {
+        auto const angle = 2.0*M_PI*(i%32)/32.0;
+        polygon.append({center.latitude() + radius*qSin(angle), center.longitude() + radius*qCos(angle)/qCos(qDegreesToRadians(center.latitude()))});
+    }
+    return polygon;
+}
+
+// Position info with the given motion, at the current time
+Positioning::PositionInfo positionInfo(const QGeoCoordinate& coordinate, double track, double groundSpeed, double verticalSpeed)
+{
+    QGeoPositionInfo info(coordinate, QDateTime::currentDateTimeUtc());
+    info.setAttribute(QGeoPositionInfo::Direction, track);
+    info.setAttribute(QGeoPositionInfo::GroundSpeed, groundSpeed);
+    info.setAttribute(QGeoPositionInfo::VerticalSpeed, verticalSpeed);
+    return Positioning::PositionInfo(info, u"Benchmark"_s);
+}
+
+// Traffic around the center, within 10 km horizontally and 500 m vertically
+QList<Positioning::PositionInfo> traffic(int count)
+{
+    QRandomGenerator generator(9);
+    QList<Positioning::PositionInfo> result;
+    result.reserve(count);
+    QGeoCoordinate const center(centerLatitude, centerLongitude, 1000.0);
+    for(int i=0; i<count; i++)
+    {
+        auto const coordinate = center.atDistanceAndAzimuth(generator.bounded(10000.0), generator.bounded(360.0), generator.bounded(1000.0)-500.0);
+        result.append(positionInfo(coordinate, generator.bounded(360.0), 20.0 + generator.bounded(60.0), generator.bounded(6.0) - 3.0));
+    }
+    return result;
+}
+
+// Straight tracks with constant ground speed and vertical speed, sampled
+// at 10 Hz
+QList<Positioning::PositionInfo> tracks()
+{
+    QRandomGenerator generator(8);
+    QList<Positioning::PositionInfo> result;
+    result.reserve(numTracks*numFixesPerTrack);
+    for(int i=0; i<numTracks; i++)
+    {
+        auto coordinate = randomCoordinate(generator);
+        coordinate.setAltitude(300.0 + generator.bounded(2700.0));
+        auto const track = generator.bounded(360.0);
+        auto const groundSpeed = 25.0 + generator.bounded(50.0);
+        auto const verticalSpeed = generator.bounded(6.0) - 3.0;
+        for(int j=0; j<numFixesPerTrack; j++)
+        {
+            result.append(positionInfo(coordinate, track, groundSpeed, verticalSpeed));
+
+            coordinate = coordinate.atDistanceAndAzimuth(0.1*groundSpeed, track, 0.1*verticalSpeed);
+        }
+    }
+    return result;
+}
+
+// Zig-zag route with the given number of legs, 15 km each, heading east.
+// The route does not come near any of its segments twice.
+QList<Navigation::Leg> route(int numLegs)
+{
+    QList<Navigation::Leg> result;
+    result.reserve(numLegs);
+    QGeoCoordinate start(centerLatitude, centerLongitude);
+    for(int i=0; i<numLegs; i++)
+    {
+        auto const end = start.atDistanceAndAzimuth(15000.0, (i%2 == 0) ? 60.0 : 120.0);
+        result.append(Navigation::Leg(GeoMaps::Waypoint(start), GeoMaps::Waypoint(end)));
+        start = end;
+    }
+    return result;
+}
+
+// Five fixes on every leg, flying the route from start to end
+QList<Positioning::PositionInfo> routeFixes(const QList<Navigation::Leg>& legs)
+{
+    QList<Positioning::PositionInfo> result;
+    result.reserve(5*legs.size());
+    for(const auto& leg : legs)
+    {
+        auto const start = leg.startPoint().coordinate();
+        auto const end = leg.endPoint().coordinate();
+        auto const track = start.azimuthTo(end);
+        for(int i=0; i<5; i++)
+        {
+            result.append(positionInfo(start.atDistanceAndAzimuth(start.distanceTo(end)*i/5.0, track), track, 50.0, 0.0));
+        }
+    }
+    return result;
+}
+
+// Writes data to a file, returns true on success
+bool writeFile(const QString& fileName, const QByteArray& data)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly) && (file.write(data) == data.size());
+}
+
+// Aviation map in GeoJSON format, with waypoints and airspaces
+bool writeAviationMap(const QString& fileName)
+{
+    QRandomGenerator generator(1);
+    QJsonArray features;
+    for(int i=0; i<numWaypoints; i++)
+    {
+        auto const coordinate = randomCoordinate(generator);
+        features.append(QJsonObject {
+            {u"type"_s, u"Feature"_s},
+            {u"properties"_s, QJsonObject {
+                 {u"TYP"_s, u"WP"_s},
+                 {u"CAT"_s, u"RP"_s},
+                 {u"NAM"_s, u"Waypoint %1"_s.arg(i)},
+                 {u"ICA"_s, u"WP%1"_s.arg(i)},
+                 {u"ELE"_s, 100+i%1000},
+             }},
+            {u"geometry"_s, QJsonObject {
+                 {u"type"_s, u"Point"_s},
+                 {u"coordinates"_s, QJsonArray {coordinate.longitude(), coordinate.latitude()}},
+             }},
+        });
+    }
+    for(int i=0; i<numAirspaces; i++)
+    {
+        QJsonArray coordinates;
+        for(const auto& coordinate : randomPolygon(generator))
+        {
+            coordinates.append(QJsonArray {coordinate.longitude(), coordinate.latitude()});
+        }
+        features.append(QJsonObject {
+            {u"type"_s, u"Feature"_s},
+            {u"properties"_s, QJsonObject {
+                 {u"TYP"_s, u"AS"_s},
+                 {u"CAT"_s, (i%2 == 0) ? u"CTR"_s : u"D"_s},
+                 {u"NAM"_s, u"Airspace %1"_s.arg(i)},
+                 {u"ID"_s, u"Airspace %1"_s.arg(i)},
+                 {u"BOT"_s, u"GND"_s},
+                 {u"TOP"_s, u"FL 100"_s},
+             }},
+            {u"geometry"_s, QJsonObject {
+                 {u"type"_s, u"Polygon"_s},
+                 {u"coordinates"_s, QJsonArray {coordinates}},
+             }},
+        });
+    }
+    QJsonObject const collection {
+        {u"type"_s, u"FeatureCollection"_s},
+        {u"features"_s, features},
+    };
+    return writeFile(fileName, QJsonDocument(collection).toJson(QJsonDocument::Compact));
+}
+
+// Coordinate in the format used by CUP files, such as "4807.123N"
+QByteArray cupCoordinate(double value, int degreeDigits, char positive, char negative)
+{
+    auto const absValue = qAbs(value);
+    auto const degrees = int(absValue);
+    return QByteArray::number(degrees).rightJustified(degreeDigits, '0')
+           + QByteArray::number((absValue-degrees)*60.0, 'f', 3).rightJustified(6, '0')
+           + ((value >= 0) ? positive : negative);
+}
+
+// Waypoint files in CSV and CUP format
+bool writeWaypoints(const QString& csvFileName, const QString& cupFileName)
+{
+    QRandomGenerator generator(2);
+    QByteArray csv = "Name,Latitude,Longitude,Elevation,Description\n";
+    QByteArray cup = "name,code,country,lat,lon,elev,style,rwdir,rwlen,freq,desc\n";
+    for(int i=0; i<numWaypoints; i++)
+    {
+        auto const coordinate = randomCoordinate(generator);
+        csv += "\"Waypoint " + QByteArray::number(i) + "\","
+               + QByteArray::number(coordinate.latitude(), 'f', 6) + ','
+               + QByteArray::number(coordinate.longitude(), 'f', 6) + ','
+               + QByteArray::number(100+i%1000) + ",\"Synthetic waypoint\"\n";
+        cup += "\"Waypoint " + QByteArray::number(i) + "\",WP" + QByteArray::number(i) + ",DE,"
+               + cupCoordinate(coordinate.latitude(), 2, 'N', 'S') + ','
+               + cupCoordinate(coordinate.longitude(), 3, 'E', 'W') + ','
+               + QByteArray::number(100+i%1000) + "m,2,270,800m,123.500,\"Synthetic waypoint\"\n";
+    }
+
+    // Records that exercise quotes, whitespace, empty fields, line endings
+    // and non-ASCII characters
+    csv += " \"Quoted \"\"name\"\"\" , 48.5 , 8.5 ,  300 , \"Text, with comma\"\r\n";
+    csv += "Unquoted name,48.1,8.1,,\n";
+    csv += "\"Z\xC3\xBCrich S\xC3\xBCd\",47.3,8.5,400,\"\xC3\x9Cmlaut\"\n";
+    cup += "\"Quoted \"\"name\"\"\",QN,DE,4807.123N,00812.456E,1200ft,1,090,1200m,122.500,\"Text, with comma\"\r\n";
+    cup += " \"Spaced\" , SP ,DE, 4807.123N , 00812.456W ,100.5m,1,,,,\n";
+    cup += "\"Z\xC3\xBCrich S\xC3\xBCd\",ZS,CH,4723.000S,00830.000E,400m,2,270,800m,123.500,\"\xC3\x9Cmlaut\",\"\"\n";
+    cup += "-----Related Tasks-----\n";
+    cup += "\"Task\",\"Waypoint 0\",\"Waypoint 1\"\n";
+    return writeFile(csvFileName, csv) && writeFile(cupFileName, cup);
+}
+
+// Coordinate in the format used by OpenAir files, such as "48:07:30 N"
+QByteArray openAirCoordinate(double value, char positive, char negative)
+{
+    auto const seconds = qRound(qAbs(value)*3600.0);
+    return QByteArray::number(seconds/3600) + ':'
+           + QByteArray::number((seconds/60)%60).rightJustified(2, '0') + ':'
+           + QByteArray::number(seconds%60).rightJustified(2, '0') + ' '
+           + ((value >= 0) ? positive : negative);
+}
+
+// Airspaces in OpenAir format. Every third airspace is a circle, and every
+// third airspace is a sector bounded by two arcs.
+bool writeOpenAir(const QString& fileName)
+{
+    QRandomGenerator generator(3);
+    QByteArray data;
+    for(int i=0; i<numAirspaces; i++)
+    {
+        data += "AC " + QByteArray((i%2 == 0) ? "D" : "R") + '\n';
+        data += "AN Airspace " + QByteArray::number(i) + '\n';
+        data += "AL GND\n";
+        data += "AH FL 100\n";
+        switch(i%3)
+        {
+        case 0:
+            for(const auto& coordinate : randomPolygon(generator))
+            {
+                data += "DP " + openAirCoordinate(coordinate.latitude(), 'N', 'S') + ' '
+                        + openAirCoordinate(coordinate.longitude(), 'E', 'W') + '\n';
+            }
+            break;
+        case 1:
+        {
+            auto const center = randomCoordinate(generator);
+            data += "V X=" + openAirCoordinate(center.latitude(), 'N', 'S') + ' '
+                    + openAirCoordinate(center.longitude(), 'E', 'W') + '\n';
+            data += "DC " + QByteArray::number(2.0 + generator.bounded(10.0), 'f', 1) + '\n';
+            break;
+        }
+        default:
+        {
+            auto const center = randomCoordinate(generator);
+            auto const start = generator.bounded(360);
+            auto const end = (start + 30 + generator.bounded(270)) % 360;
+            data += "V X=" + openAirCoordinate(center.latitude(), 'N', 'S') + ' '
+                    + openAirCoordinate(center.longitude(), 'E', 'W') + '\n';
+            data += "V D=+\n";
+            data += "DA 12," + QByteArray::number(start) + ',' + QByteArray::number(end) + '\n';
+            data += "V D=-\n";
+            data += "DA 5," + QByteArray::number(end) + ',' + QByteArray::number(start) + '\n';
+        }
+        }
+        data += '\n';
+    }
+    return writeFile(fileName, data);
+}
+
+// NMEA sentence with checksum
+QByteArray nmeaSentence(const QByteArray& body)
+{
+    quint8 checksum = 0;
+    for(auto character : body)
+    {
+        checksum ^= quint8(character);
+    }
+    return '$' + body + '*' + QByteArray::number(checksum, 16).rightJustified(2, '0').toUpper() + "\r\n";
+}
+
+// FLARM/NMEA data, with own position and traffic
+QList<QString> flarmData()
+{
+    QRandomGenerator generator(4);
+    QList<QString> result;
+    result.reserve(numMessages);
+    for(int i=0; i<numMessages; i++)
+    {
+        QByteArray sentence;
+        switch(i%4)
+        {
+        case 0:
+            sentence = nmeaSentence("GPRMC,120000.00,A,4800.000,N,00800.000,E,90.0,270.0,010126,,,A");
+            break;
+        case 1:
+            sentence = nmeaSentence("PGRMZ,3000,F,2");
+            break;
+        case 2:
+            sentence = nmeaSentence("PFLAU,3,1,2,1,0,180,0,-147,7851");
+            break;
+        default:
+            sentence = nmeaSentence("PFLAA,0," + QByteArray::number(generator.bounded(-5000, 5000)) + ','
+                                    + QByteArray::number(generator.bounded(-5000, 5000)) + ','
+                                    + QByteArray::number(generator.bounded(-500, 500)) + ",1,AA"
+                                    + QByteArray::number(1000+i%100, 16).toUpper() + ",180,,30,1.5,1");
+        }
+        result.append(QString::fromLatin1(sentence));
+    }
+    return result;
+}
+
+// FLARM simulator file with the FLARM/NMEA data, one sentence every 10 ms
+bool writeFLARMSimulation(const QString& fileName)
+{
+    QByteArray data;
+    qint64 time = 850000;
+    for(const auto& sentence : flarmData())
+    {
+        data += QByteArray::number(time) + ' ' + sentence.trimmed().toLatin1() + '\n';
+        time += 10;
+    }
+    return writeFile(fileName, data);
+}
+
+// CRC of GDL90 messages (CRC-CCITT, computed bit by bit)
+quint16 gdlCRC(const QByteArray& data)
+{
+    quint16 crc = 0;
+    for(auto byte : data)
+    {
+        crc ^= quint16(quint8(byte)) << 8U;
+        for(int bit=0; bit<8; bit++)
+        {
+            crc = ((crc & 0x8000U) != 0) ? quint16((crc << 1U) ^ 0x1021U) : quint16(crc << 1U);
+        }
+    }
+    return crc;
+}
+
+// GDL90 ownship and traffic reports, escaped, without framing bytes
+QList<QByteArray> gdlData()
+{
+    QRandomGenerator generator(5);
+    QList<QByteArray> result;
+    result.reserve(numMessages);
+    for(int i=0; i<numMessages; i++)
+    {
+        auto const coordinate = randomCoordinate(generator);
+        auto const latitude = qint32(coordinate.latitude()*8388608.0/180.0) & 0xFFFFFF;
+        auto const longitude = qint32(coordinate.longitude()*8388608.0/180.0) & 0xFFFFFF;
+        auto const altitude = quint32(generator.bounded(40, 400));
+
+        QByteArray message;
+        message += char((i%10 == 0) ? 10 : 20);
+        message += char(0x00);
+        message += char(0xA0);
+        message += char(0x10);
+        message += char(i%256);
+        message += char(latitude >> 16);
+        message += char(latitude >> 8);
+        message += char(latitude);
+        message += char(longitude >> 16);
+        message += char(longitude >> 8);
+        message += char(longitude);
+        message += char(altitude >> 4U);
+        message += char(((altitude & 0x0FU) << 4U) | 0x09U);
+        message += char(0x89);
+        message += char(0x06);
+        message += char(0x40);
+        message += char(0x00);
+        message += char(generator.bounded(256));
+        message += char(1);
+        message += "D-EFGH  ";
+        message += char(0x00);
+        auto const crc = gdlCRC(message);
+        message += char(crc & 0xFFU);
+        message += char(crc >> 8U);
+
+        QByteArray escaped;
+        for(auto byte : std::as_const(message))
+        {
+            if ((byte == 0x7d) || (byte == 0x7e))
+            {
+                escaped += char(0x7d);
+                escaped += char(byte ^ 0x20);
+                continue;
+            }
+            escaped += byte;
+        }
+        result.append(escaped);
+    }
+    return result;
+}
+
+// METAR messages with typical groups
+QStringList metars()
+{
+    return {
+        u"METAR EDDF 011220Z 24012KT 9999 FEW035 SCT250 18/09 Q1017 NOSIG"_s,
+        u"METAR EDDS 011220Z 26015G27KT 220V290 6000 -SHRA BKN020CB 14/11 Q1009 TEMPO 3000 TSRA"_s,
+        u"METAR EDNY 011220Z VRB02KT CAVOK 22/12 Q1021"_s,
+        u"METAR LSZH 011220Z 05008KT 0800 R14/P1500N FG VV002 08/08 Q1028 BECMG 2000"_s,
+        u"METAR EDTF 011220Z AUTO 31005KT 9999 NCD 20/08 Q1018"_s,
+    };
+}
+
+// Weather data in the XML format of aviationweather.gov, with METARs of
+// stations spread over the area covered by synthetic data
+QByteArray weatherXML()
+{
+    QRandomGenerator generator(11);
+    auto const rawTexts = metars();
+    QString result = u"<response><data>"_s;
+    for(int i=0; i<numStations; i++)
+    {
+        auto const coordinate = randomCoordinate(generator);
+        QString ICAOCode = u"E"_s;
+        ICAOCode += QChar(u'A'+(i/676)%26);
+        ICAOCode += QChar(u'A'+(i/26)%26);
+        ICAOCode += QChar(u'A'+i%26);
+        auto rawText = rawTexts.at(i%rawTexts.size());
+        rawText.replace(6, 4, ICAOCode);
+        result += u"<METAR><raw_text>%1</raw_text><station_id>%2</station_id>"_s.arg(rawText, ICAOCode);
+        result += u"<observation_time>2026-01-01T12:20:00Z</observation_time>"_s;
+        result += u"<latitude>%1</latitude><longitude>%2</longitude>"_s.arg(coordinate.latitude(), 0, 'f', 4).arg(coordinate.longitude(), 0, 'f', 4);
+        result += u"<temp_c>%1</temp_c><dewpoint_c>%2</dewpoint_c>"_s.arg(10+i%15).arg(5+i%5);
+        result += u"<wind_dir_degrees>240</wind_dir_degrees><wind_speed_kt>%1</wind_speed_kt>"_s.arg(i%20);
+        result += u"<altim_in_hg>%1</altim_in_hg>"_s.arg(29.50+0.01*(i%80), 0, 'f', 2);
+        result += u"<flight_category>VFR</flight_category><elevation_m>%1</elevation_m></METAR>"_s.arg(100+i%900);
+    }
+    result += u"</data></response>"_s;
+    return result.toUtf8();
+}
+
+// NOTAMs in the JSON format of the FAA, spread over the area covered by
+// synthetic data. Like the FAA data, every fourth NOTAM is listed twice.
+QByteArray notamJSON()
+{
+    QRandomGenerator generator(12);
+    QJsonArray items;
+    for(int i=0; i<numNOTAMs; i++)
+    {
+        auto const coordinate = randomCoordinate(generator);
+        auto const latitudeMinutes = qFloor(coordinate.latitude()*60.0);
+        auto const longitudeMinutes = qFloor(coordinate.longitude()*60.0);
+        auto const coordinates = u"%1%2N%3%4E"_s
+                                     .arg(latitudeMinutes/60, 2, 10, QChar(u'0'))
+                                     .arg(latitudeMinutes%60, 2, 10, QChar(u'0'))
+                                     .arg(longitudeMinutes/60, 3, 10, QChar(u'0'))
+                                     .arg(longitudeMinutes%60, 2, 10, QChar(u'0'));
+        QJsonObject const notam {
+            {u"number"_s, u"A%1/26"_s.arg(i, 4, 10, QChar(u'0'))},
+            {u"affectedFIR"_s, u"EDGG"_s},
+            {u"icaoLocation"_s, u"EDGG"_s},
+            {u"coordinates"_s, coordinates},
+            {u"radius"_s, u"5"_s},
+            {u"traffic"_s, u"IV"_s},
+            {u"selectionCode"_s, u"QWULW"_s},
+            {u"minimumFL"_s, u"000"_s},
+            {u"maximumFL"_s, u"050"_s},
+            {u"effectiveStart"_s, u"2026-01-01T00:00:00.000Z"_s},
+            {u"effectiveEnd"_s, u"2099-12-31T23:59:00.000Z"_s},
+            {u"text"_s, u"GLIDER ACTIVITY WITHIN 5NM RADIUS OF %1"_s.arg(coordinates)},
+        };
+        QJsonObject const item {{u"properties"_s, QJsonObject {{u"coreNOTAMData"_s, QJsonObject {{u"notam"_s, notam}}}}}};
+        items.append(item);
+        if (i%4 == 0)
+        {
+            items.append(item);
+        }
+    }
+    return QJsonDocument(QJsonObject {{u"items"_s, items}}).toJson(QJsonDocument::Compact);
+}
+
+// Number of bytes that the process has read with system calls such as
+// read(), or -1 if the operating system does not provide the number. Data
+// read from memory-mapped files is not included.
+qint64 processBytesRead()
+{
+    QFile file(u"/proc/self/io"_s);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return -1;
+    }
+    for(const auto& line : file.readAll().split('\n'))
+    {
+        if (line.startsWith("rchar:"))
+        {
+            return line.mid(6).trimmed().toLongLong();
+        }
+    }
+    return -1;
+}
+
+// File type, as Platform::FileExchange_Abstract::processFileOpenRequest
+// detects it. Instead of emitting signals, the name of the request that
+// would be emitted is returned. The parameter bytesRead is set to the
+// number of bytes read from the file, including memory-mapped content, or
+// to -1 if it cannot be determined.
+QString detectFileType(const QString& fileName, qint64& bytesRead)
+{
+    FileFormats::FileProbe probe(fileName);
+    const QString myPath = probe.fileName();
+    auto const mimeType = probe.mimeType();
+    auto const signature = probe.signature();
+
+    // Bytes read by the importers that open the file by name are counted by
+    // the operating system, those read by the probe are counted by the probe
+    auto bytesReadBefore = processBytesRead();
+    auto const detect = [&]() -> QString {
+        // Flight Route in GPX format
+        if ((mimeType.inherits(QStringLiteral("application/xml"))) || (mimeType.name() == u"application/x-gpx+xml"))
+        {
+            const FileFormats::PLN pln(fileName);
+            if (pln.isValid())
+            {
+                return u"FlightRoute"_s;
+            }
+            const FileFormats::FPL fpl(fileName);
+            if (fpl.isValid())
+            {
+                return u"FlightRoute"_s;
+            }
+            return u"FlightRouteOrWaypointLibrary"_s;
+        }
+
+        // GeoJSON file
+        if (signature == FileFormats::FileProbe::JSON)
+        {
+            auto const content = probe.content();
+            bytesReadBefore = processBytesRead();
+            auto fileContent = GeoMaps::GeoJSON::inspect(content);
+            if (fileContent == GeoMaps::GeoJSON::flightRoute)
+            {
+                return u"FlightRoute"_s;
+            }
+            if (fileContent == GeoMaps::GeoJSON::waypointLibrary)
+            {
+                return u"WaypointLibrary"_s;
+            }
+            if (fileContent == GeoMaps::GeoJSON::valid)
+            {
+                return u"FlightRouteOrWaypointLibrary"_s;
+            }
+        }
+
+        // FLARM Simulator file
+        if ((signature == FileFormats::FileProbe::Text) && Traffic::TrafficDataSource_File::containsFLARMSimulationData(probe.prefix()))
+        {
+            return u"FLARMSimulation"_s;
+        }
+
+        // MBTiles or PMTiles
+        if ((signature == FileFormats::FileProbe::SQLite) || (signature == FileFormats::FileProbe::PMTiles))
+        {
+            auto tileFile = FileFormats::TileFileAbstract::open(myPath);
+            auto const tileFormat = tileFile->format();
+            if (tileFormat == FileFormats::TileFileAbstract::Vector)
+            {
+                return u"VectorMap"_s;
+            }
+            if (tileFormat == FileFormats::TileFileAbstract::Raster)
+            {
+                return u"RasterMap"_s;
+            }
+        }
+
+        // OpenAir
+        QString info;
+        if ((signature == FileFormats::FileProbe::OpenAir) && GeoMaps::openAir::isValid(myPath, &info))
+        {
+            return u"OpenAir"_s;
+        }
+
+        // CUP file
+        if ((signature == FileFormats::FileProbe::Text) && FileFormats::CUP::mimeTypes().contains(mimeType.name()))
+        {
+            FileFormats::CUP const cup(myPath);
+            if (cup.isValid())
+            {
+                return u"WaypointLibrary"_s;
+            }
+        }
+
+        // VAC
+        if (GeoMaps::VAC::mimeTypes().contains(mimeType.name()))
+        {
+            const GeoMaps::VAC vac(fileName, {});
+            if (vac.isValid())
+            {
+                return u"VAC"_s;
+            }
+            return u"ImportError"_s;
+        }
+
+        // Image
+        if (signature == FileFormats::FileProbe::Image)
+        {
+            QImage const img(myPath);
+            if (!img.isNull())
+            {
+                return u"Image"_s;
+            }
+        }
+
+        // TripKits
+        if ((signature == FileFormats::FileProbe::Zip) && FileFormats::TripKit::mimeTypes().contains(mimeType.name()))
+        {
+            FileFormats::TripKit const tripKit(myPath);
+            if (tripKit.isValid())
+            {
+                return u"TripKit"_s;
+            }
+        }
+
+        // ZipFiles
+        if ((signature == FileFormats::FileProbe::Zip) && FileFormats::ZipFile::mimeTypes().contains(mimeType.name()))
+        {
+            FileFormats::ZipFile const zipFile(myPath);
+            if (zipFile.isValid())
+            {
+                return u"ZipFile"_s;
+            }
+        }
+
+        // OpenAir files whose airspace records begin beyond the prefix
+        if ((signature == FileFormats::FileProbe::Text) && GeoMaps::openAir::isValid(myPath, &info))
+        {
+            return u"OpenAir"_s;
+        }
+
+        return u"UnknownFunction"_s;
+    };
+
+    auto const result = detect();
+    auto const bytesReadAfter = processBytesRead();
+    bytesRead = ((bytesReadBefore < 0) || (bytesReadAfter < 0)) ? -1 : probe.bytesRead() + (bytesReadAfter - bytesReadBefore);
+    return result;
+}
+
+// MBTILES file with random tile data
+bool writeMBTILES(const QString& fileName)
+{
+    QRandomGenerator generator(6);
+    bool success = false;
+    {
+        auto dataBase = QSqlDatabase::addDatabase(u"QSQLITE"_s, u"Benchmark"_s);
+        dataBase.setDatabaseName(fileName);
+        if (dataBase.open())
+        {
+            QSqlQuery query(dataBase);
+            success = query.exec(u"CREATE TABLE metadata (name text, value text);"_s)
+                      && query.exec(u"CREATE TABLE tiles (zoom_level integer, tile_column integer, tile_row integer, tile_data blob);"_s)
+                      && query.exec(u"CREATE UNIQUE INDEX tile_index on tiles (zoom_level, tile_column, tile_row);"_s)
+                      && query.exec(u"INSERT INTO metadata VALUES ('format', 'pbf');"_s)
+                      && dataBase.transaction();
+            query.prepare(u"INSERT INTO tiles VALUES (?, ?, ?, ?);"_s);
+            for(int x=0; success && (x<numTilesPerSide); x++)
+            {
+                for(int y=0; success && (y<numTilesPerSide); y++)
+                {
+                    QByteArray data(20000, Qt::Uninitialized);
+                    generator.fillRange(reinterpret_cast<quint32*>(data.data()), data.size()/4);
+                    query.addBindValue(tileZoom);
+                    query.addBindValue(x);
+                    query.addBindValue(y);
+                    query.addBindValue(data);
+                    success = query.exec();
+                }
+            }
+            success = success && dataBase.commit();
+            dataBase.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(u"Benchmark"_s);
+    return success;
+}
+
+// Terrain MBTILES file that covers the area of synthetic data with PNG tiles
+// in "Terrarium" format, showing gentle hills
+bool writeTerrainMBTILES(const QString& fileName)
+{
+    auto const scale = static_cast<double>(1 << terrainZoom);
+    auto tileX = [&](double longitude) { return qFloor((longitude+180.0)/360.0 * scale); };
+    auto tileY = [&](double latitude) { return qFloor((1.0 - asinh(tan(qDegreesToRadians(latitude)))/M_PI)/2.0 * scale); };
+
+    bool success = false;
+    {
+        auto dataBase = QSqlDatabase::addDatabase(u"QSQLITE"_s, u"Benchmark"_s);
+        dataBase.setDatabaseName(fileName);
+        if (dataBase.open())
+        {
+            QSqlQuery query(dataBase);
+            success = query.exec(u"CREATE TABLE metadata (name text, value text);"_s)
+                      && query.exec(u"CREATE TABLE tiles (zoom_level integer, tile_column integer, tile_row integer, tile_data blob);"_s)
+                      && query.exec(u"CREATE UNIQUE INDEX tile_index on tiles (zoom_level, tile_column, tile_row);"_s)
+                      && query.exec(u"INSERT INTO metadata VALUES ('format', 'png');"_s)
+                      && dataBase.transaction();
+            query.prepare(u"INSERT INTO tiles VALUES (?, ?, ?, ?);"_s);
+            for(int x=tileX(centerLongitude-extent/2.0); success && (x<=tileX(centerLongitude+extent/2.0)); x++)
+            {
+                for(int y=tileY(centerLatitude+extent/2.0); success && (y<=tileY(centerLatitude-extent/2.0)); y++)
+                {
+                    QImage image(terrainTileSize, terrainTileSize, QImage::Format_RGB32);
+                    for(int py=0; py<terrainTileSize; py++)
+                    {
+                        auto const latitude = qRadiansToDegrees(atan(sinh(M_PI*(1.0-2.0*(y+py/double(terrainTileSize-1))/scale))));
+                        auto* line = reinterpret_cast<QRgb*>(image.scanLine(py));
+                        for(int px=0; px<terrainTileSize; px++)
+                        {
+                            auto const longitude = (x+px/double(terrainTileSize-1))/scale*360.0 - 180.0;
+                            auto const value = 32768.0 + 800.0 + 400.0*sin(7.0*latitude)*cos(5.0*longitude);
+                            line[px] = qRgb(qFloor(value/256.0), qFloor(value) % 256, qFloor((value-qFloor(value))*256.0));
+                        }
+                    }
+                    QByteArray data;
+                    QBuffer buffer(&data);
+                    image.save(&buffer, "PNG");
+                    query.addBindValue(terrainZoom);
+                    query.addBindValue(x);
+                    query.addBindValue((1<<terrainZoom)-1-y);
+                    query.addBindValue(data);
+                    success = query.exec();
+                }
+            }
+            success = success && dataBase.commit();
+            dataBase.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(u"Benchmark"_s);
+    return success;
+}
+
+} // namespace
+
+
+struct Benchmark::Fixtures
+{
+    QTemporaryDir directory;
+    QString aviationMapFileName {directory.filePath(u"aviationMap.geojson"_s)};
+    QString csvFileName {directory.filePath(u"waypoints.csv"_s)};
+    QString cupFileName {directory.filePath(u"waypoints.cup"_s)};
+    QString openAirFileName {directory.filePath(u"airspaces.txt"_s)};
+    QString flarmFileName {directory.filePath(u"flarm.txt"_s)};
+    QString mbtilesFileName {directory.filePath(u"tiles.mbtiles"_s)};
+    QString pmtilesFileName {directory.filePath(u"tiles.pmtiles"_s)};
+    QString terrainFileName {directory.filePath(u"terrain.terrain"_s)};
+    QString demFileName {directory.filePath(u"terrain.dem"_s)};
+
+    // Aviation maps, as installed from several regions
+    QStringList aviationMapFileNames;
+
+    // Random positions for map and waypoint queries, and for terrain queries
+    QList<QGeoCoordinate> positions;
+    QList<QGeoCoordinate> terrainPositions;
+
+    // Straight tracks, as position infos and as coordinates
+    QList<Positioning::PositionInfo> fixes;
+    QList<QGeoCoordinate> trackPositions;
+};
+
+
+int Benchmark::run(const QString& fileName)
+{
+    Fixtures fixtures;
+    if (!writeFixtures(fixtures))
+    {
+        qWarning() << "Benchmark: Unable to write fixtures";
+        return 1;
+    }
+
+    QJsonArray results;
+
+    // Set to false if an implementation does not produce the same results as
+    // the reference implementation it replaces
+    bool checksPassed = true;
+
+    runAviationMaps(fixtures, results, checksPassed);
+    runWaypoints(fixtures, results, checksPassed);
+    runTerrain(fixtures, results, checksPassed);
+    runSideview(fixtures, results);
+    runMapStyles(results, checksPassed);
+    runNavigation(fixtures, results, checksPassed);
+    runFileFormats(fixtures, results, checksPassed);
+    runTraffic(fixtures, results);
+    runWeather(fixtures, results, checksPassed);
+    runTiles(fixtures, results);
+    runFileTypeDetection(fixtures, results, checksPassed);
+
+    QJsonObject const report {
+        {u"version"_s, QStringLiteral(ENROUTE_VERSION_STRING)},
+        {u"date"_s, QDateTime::currentDateTimeUtc().toString(Qt::ISODate)},
+        {u"benchmarks"_s, results},
+        {u"checksPassed"_s, checksPassed},
+    };
+    auto const json = QJsonDocument(report).toJson();
+    if (fileName == u"-"_s)
+    {
+        QTextStream(stdout) << json;
+        return checksPassed ? 0 : 1;
+    }
+    if (!writeFile(fileName, json))
+    {
+        qWarning() << "Benchmark: Unable to write results to" << fileName;
+        return 1;
+    }
+    return checksPassed ? 0 : 1;
+}
+
+
+bool Benchmark::writeFixtures(Fixtures& fixtures)
+{
+    if (!fixtures.directory.isValid()
+        || !writeAviationMap(fixtures.aviationMapFileName)
+        || !writeWaypoints(fixtures.csvFileName, fixtures.cupFileName)
+        || !writeOpenAir(fixtures.openAirFileName)
+        || !writeFLARMSimulation(fixtures.flarmFileName)
+        || !writeMBTILES(fixtures.mbtilesFileName)
+        || !FileFormats::PMTILES::fromMBTILES(fixtures.mbtilesFileName, fixtures.pmtilesFileName).isEmpty()
+        || !writeTerrainMBTILES(fixtures.terrainFileName)
+        || !FileFormats::DEM::fromTerrainTiles(fixtures.terrainFileName, fixtures.demFileName, terrainZoom).isEmpty())
+    {
+        return false;
+    }
+
+    for(int i=0; i<4; i++)
+    {
+        fixtures.aviationMapFileNames.append(fixtures.directory.filePath(u"aviationMap-%1.geojson"_s.arg(i)));
+        if (!QFile::copy(fixtures.aviationMapFileName, fixtures.aviationMapFileNames.last()))
+        {
+            return false;
+        }
+    }
+
+    QRandomGenerator generator(7);
+    for(int i=0; i<100; i++)
+    {
+        fixtures.positions.append(randomCoordinate(generator));
+    }
+    for(int i=0; i<numTerrainQueries; i++)
+    {
+        fixtures.terrainPositions.append(randomCoordinate(generator));
+    }
+
+    fixtures.fixes = tracks();
+    fixtures.trackPositions.reserve(fixtures.fixes.size());
+    for(const auto& fix : std::as_const(fixtures.fixes))
+    {
+        fixtures.trackPositions.append(fix.coordinate());
+    }
+    return true;
+}
+
+
+void Benchmark::runAviationMaps(const Fixtures& fixtures, QJsonArray& results, bool& checksPassed)
+{
+    auto const& aviationMapFileName = fixtures.aviationMapFileName;
+    auto const& aviationMapFileNames = fixtures.aviationMapFileNames;
+    auto const& positions = fixtures.positions;
+
+    results.append(measure(u"GeoJSON ingestion"_s, numWaypoints+numAirspaces, [&]() {
+        (void)GeoMaps::GeoMapProvider::readAviationMapSegment(aviationMapFileName);
+    }));
+
+    auto const airspaces = GeoMaps::GeoMapProvider::readAviationMapSegment(aviationMapFileName).airspaces;
+    results.append(measure(u"airspacesAtPosition"_s, positions.size(), [&]() {
+        for(const auto& position : std::as_const(positions))
+        {
+            (void)GeoMaps::GeoMapProvider::airspacesAtPosition(airspaces, position);
+        }
+    }));
+
+    // Reloading the aviation maps after one file changed, compared with a
+    // full rebuild without and with the segment cache. All must yield the
+    // same waypoints and airspaces.
+    QHash<QString, GeoMaps::GeoMapProvider::AviationMapSegment> aviationMapSegments;
+    auto const aviationData = GeoMaps::GeoMapProvider::fillAviationDataCache(aviationMapSegments, aviationMapFileNames, false);
+    auto const aviationDataReference = BenchmarkReference::fillAviationDataCache(aviationMapFileNames, false);
+    auto const identicalAviationData = identicalWaypoints(aviationData.waypoints, aviationDataReference.waypoints)
+                                       && (aviationData.airspaces.size() == aviationDataReference.airspaces.size());
+    if (!identicalAviationData)
+    {
+        qWarning() << "Benchmark: Aviation map reload differs from the previous full rebuild";
+        checksPassed = false;
+    }
+    auto const reloadReference = measure(u"Aviation map reload, previous full rebuild"_s, aviationMapFileNames.size(), [&]() {
+        (void)BenchmarkReference::fillAviationDataCache(aviationMapFileNames, false);
+    });
+    auto reloadFullResult = measure(u"Aviation map reload, full rebuild"_s, aviationMapFileNames.size(), [&]() {
+        QHash<QString, GeoMaps::GeoMapProvider::AviationMapSegment> segments;
+        (void)GeoMaps::GeoMapProvider::fillAviationDataCache(segments, aviationMapFileNames, false);
+    });
+    int modificationCount = 0;
+    auto reloadResult = measure(u"Aviation map reload, one file changed"_s, aviationMapFileNames.size(), [&]() {
+        QFile file(aviationMapFileNames.constFirst());
+        if (file.open(QIODevice::ReadWrite))
+        {
+            (void)file.setFileTime(QDateTime::currentDateTimeUtc().addSecs(++modificationCount), QFileDevice::FileModificationTime);
+        }
+        (void)GeoMaps::GeoMapProvider::fillAviationDataCache(aviationMapSegments, aviationMapFileNames, false);
+    });
+    addSpeedup(reloadFullResult, reloadReference);
+    addSpeedup(reloadResult, reloadReference);
+    reloadFullResult.insert(u"identical"_s, identicalAviationData);
+    reloadResult.insert(u"identical"_s, identicalAviationData);
+    results.append(reloadReference);
+    results.append(reloadFullResult);
+    results.append(reloadResult);
+}
+
+
+void Benchmark::runWaypoints(const Fixtures& fixtures, QJsonArray& results, bool& checksPassed)
+{
+    auto const& positions = fixtures.positions;
+    auto const& directory = fixtures.directory;
+    auto const& cupFileName = fixtures.cupFileName;
+    QHash<QString, GeoMaps::GeoMapProvider::AviationMapSegment> aviationMapSegments;
+    auto const aviationData = GeoMaps::GeoMapProvider::fillAviationDataCache(aviationMapSegments, fixtures.aviationMapFileNames, false);
+
+    // Waypoint search, keystroke by keystroke as in the waypoint search
+    // dialog, compared with the linear filter used before
+    auto const& waypoints = aviationData.waypoints;
+    QStringList filters;
+    for(const auto& query : {u"waypoint 4711"_s, u"wp12"_s, u"point 99"_s})
+    {
+        for(qsizetype length=1; length<=query.size(); length++)
+        {
+            filters.append(query.left(length));
+        }
+    }
+    auto const& searchIndex = aviationData.waypointSearchIndex;
+    auto const searchWaypoints = [&](const QString& filter, QStringList& lastWords, QVector<qsizetype>& lastMatches) {
+        auto const words = GeoMaps::WaypointSearchIndex::searchWords(filter);
+        if (!lastWords.isEmpty() && GeoMaps::WaypointSearchIndex::isRefinement(lastWords, words))
+        {
+            lastMatches = searchIndex.refine(lastMatches, words);
+        }
+        else
+        {
+            lastMatches = searchIndex.search(words);
+        }
+        lastWords = words;
+        return searchIndex.waypoints(lastMatches);
+    };
+    bool identicalSearch = true;
+    {
+        QStringList lastWords;
+        QVector<qsizetype> lastMatches;
+        for(const auto& filter : std::as_const(filters))
+        {
+            identicalSearch = identicalSearch && identicalWaypoints(searchWaypoints(filter, lastWords, lastMatches), BenchmarkReference::filteredWaypoints(waypoints, filter));
+        }
+    }
+    if (!identicalSearch)
+    {
+        qWarning() << "Benchmark: Waypoint search differs from the previous linear filter";
+        checksPassed = false;
+    }
+    auto const searchReference = measure(u"Waypoint search, previous linear filter"_s, filters.size(), [&]() {
+        for(const auto& filter : std::as_const(filters))
+        {
+            (void)BenchmarkReference::filteredWaypoints(waypoints, filter);
+        }
+    });
+    auto searchResult = measure(u"Waypoint search"_s, filters.size(), [&]() {
+        QStringList lastWords;
+        QVector<qsizetype> lastMatches;
+        for(const auto& filter : std::as_const(filters))
+        {
+            (void)searchWaypoints(filter, lastWords, lastMatches);
+        }
+    });
+    addSpeedup(searchResult, searchReference);
+    searchResult.insert(u"identical"_s, identicalSearch);
+    results.append(searchReference);
+    results.append(searchResult);
+
+    // Nearby and closest waypoints, from the KD-tree and by sorting or
+    // scanning all waypoints as before
+    auto const& spatialIndex = aviationData.waypointSpatialIndex;
+    auto const closestRadius = Units::Distance::fromNM(5.0);
+    bool identicalNearby = true;
+    for(const auto& position : std::as_const(positions))
+    {
+        auto const closest = spatialIndex.nearestWithin(position, closestRadius);
+        auto const closestReference = BenchmarkReference::closestWaypoint(waypoints, position, position.atDistanceAndAzimuth(closestRadius.toM(), 0.0));
+        identicalNearby = identicalNearby
+                          && identicalWaypoints(spatialIndex.nearest(position, 20, u"WP"_s), BenchmarkReference::nearbyWaypoints(waypoints, position, u"WP"_s))
+                          && (closest.isValid() == closestReference.isValid())
+                          && (!closest.isValid() || (closest == closestReference));
+    }
+    if (!identicalNearby)
+    {
+        qWarning() << "Benchmark: Nearby or closest waypoints differ from the previous scan";
+        checksPassed = false;
+    }
+    auto const nearbyReference = measure(u"Nearby waypoints, previous sort"_s, positions.size(), [&]() {
+        for(const auto& position : std::as_const(positions))
+        {
+            (void)BenchmarkReference::nearbyWaypoints(waypoints, position, u"WP"_s);
+        }
+    });
+    auto nearbyResult = measure(u"Nearby waypoints"_s, positions.size(), [&]() {
+        for(const auto& position : std::as_const(positions))
+        {
+            (void)spatialIndex.nearest(position, 20, u"WP"_s);
+        }
+    });
+    addSpeedup(nearbyResult, nearbyReference);
+    nearbyResult.insert(u"identical"_s, identicalNearby);
+    results.append(nearbyReference);
+    results.append(nearbyResult);
+    auto const closestReference = measure(u"Closest waypoint, previous scan"_s, positions.size(), [&]() {
+        for(const auto& position : std::as_const(positions))
+        {
+            (void)BenchmarkReference::closestWaypoint(waypoints, position, position.atDistanceAndAzimuth(closestRadius.toM(), 0.0));
+        }
+    });
+    auto closestResult = measure(u"Closest waypoint"_s, positions.size(), [&]() {
+        for(const auto& position : std::as_const(positions))
+        {
+            (void)spatialIndex.nearestWithin(position, closestRadius);
+        }
+    });
+    addSpeedup(closestResult, closestReference);
+    closestResult.insert(u"identical"_s, identicalNearby);
+    results.append(closestReference);
+    results.append(closestResult);
+
+    // Import of waypoints into a library that is not empty, skipping
+    // waypoints near existing ones. The previous merge compares every new
+    // waypoint with every existing one, so the library is kept small.
+    constexpr qsizetype numImportedWaypoints = 2000;
+    auto const existingWaypoints = waypoints.mid(0, numImportedWaypoints);
+    auto const importedWaypoints = FileFormats::CUP(cupFileName).waypoints().mid(0, numImportedWaypoints);
+    GeoMaps::WaypointLibrary library(nullptr);
+    auto const byName = [](const GeoMaps::Waypoint& first, const GeoMaps::Waypoint& second) {
+        if (first.name() != second.name())
+        {
+            return first.name() < second.name();
+        }
+        return first.coordinate().latitude() < second.coordinate().latitude();
+    };
+    library.addMany(existingWaypoints);
+    library.addMany(importedWaypoints, true);
+    QVector<GeoMaps::Waypoint> importResult = library.waypoints();
+    auto importReferenceResult = BenchmarkReference::importWaypoints(existingWaypoints, importedWaypoints, true);
+    std::sort(importResult.begin(), importResult.end(), byName);
+    std::sort(importReferenceResult.begin(), importReferenceResult.end(), byName);
+    auto const identicalImport = identicalWaypoints(importResult, importReferenceResult);
+    if (!identicalImport)
+    {
+        qWarning() << "Benchmark: Waypoint library import differs from the previous merge";
+        checksPassed = false;
+    }
+    auto const importReference = measure(u"Waypoint library import, previous merge"_s, importedWaypoints.size(), [&]() {
+        (void)BenchmarkReference::importWaypoints(existingWaypoints, importedWaypoints, true);
+    });
+    auto importBenchmarkResult = measure(u"Waypoint library import"_s, importedWaypoints.size(), [&]() {
+        library.clear();
+        library.addMany(existingWaypoints);
+        library.addMany(importedWaypoints, true);
+    });
+    addSpeedup(importBenchmarkResult, importReference);
+    importBenchmarkResult.insert(u"identical"_s, identicalImport);
+    results.append(importReference);
+    results.append(importBenchmarkResult);
+
+    // Saving the waypoint library after each of a burst of edits, as
+    // WaypointLibrary did before with a synchronous write per edit, and with
+    // the FileWriter, which coalesces the writes
+    constexpr int numSaves = 100;
+    auto const libraryFileName = directory.filePath(u"waypoint library.geojson"_s);
+    auto const libraryWaypoints = library.waypoints();
+    results.append(measure(u"Waypoint library saves, previous synchronous writes"_s, numSaves, [&]() {
+        for(int i=0; i<numSaves; i++)
+        {
+            QFile file(libraryFileName);
+            if (file.open(QIODevice::WriteOnly))
+            {
+                file.write(GeoMaps::WaypointLibrary::toGeoJSON(libraryWaypoints));
+            }
+        }
+    }));
+    DataManagement::FileWriter fileWriter;
+    std::atomic<int> serializerCount {0};
+    auto fileWriterResult = measure(u"Waypoint library saves, FileWriter"_s, numSaves, [&]() {
+        for(int i=0; i<numSaves; i++)
+        {
+            fileWriter.schedule(libraryFileName, [&]() {
+                serializerCount++;
+                return GeoMaps::WaypointLibrary::toGeoJSON(libraryWaypoints);
+            });
+        }
+        fileWriter.flush();
+    });
+    // measure() calls the function once more to warm up
+    fileWriterResult.insert(u"filesWrittenPerIteration"_s, double(serializerCount)/double(fileWriterResult.value(u"iterations"_s).toInteger()+1));
+    results.append(fileWriterResult);
+}
+
+
+void Benchmark::runTerrain(const Fixtures& fixtures, QJsonArray& results, bool& checksPassed)
+{
+    auto const& terrainPositions = fixtures.terrainPositions;
+    auto const& trackPositions = fixtures.trackPositions;
+    auto const& terrainFileName = fixtures.terrainFileName;
+    auto const& demFileName = fixtures.demFileName;
+
+    // Terrain elevation, at random positions and along the tracks. The tile
+    // cache is as small as the one used by GeoMapProvider.
+    QList<QSharedPointer<FileFormats::TileFileAbstract>> const terrainMapTiles {FileFormats::TileFileAbstract::open(terrainFileName)};
+    QCache<qint64,QImage> terrainTileCache {6};
+    FileFormats::DEM const dem(demFileName);
+    results.append(measure(u"Terrain elevation, PNG tiles, random"_s, terrainPositions.size(), [&]() {
+        for(const auto& position : std::as_const(terrainPositions))
+        {
+            (void)GeoMaps::GeoMapProvider::terrainElevationFromTiles(terrainMapTiles, terrainTileCache, position);
+        }
+    }));
+    results.append(measure(u"Terrain elevation, DEM, random"_s, terrainPositions.size(), [&]() {
+        (void)dem.elevations(terrainPositions);
+    }));
+    results.append(measure(u"Terrain elevation, PNG tiles, along tracks"_s, trackPositions.size(), [&]() {
+        for(const auto& position : std::as_const(trackPositions))
+        {
+            (void)GeoMaps::GeoMapProvider::terrainElevationFromTiles(terrainMapTiles, terrainTileCache, position);
+        }
+    }));
+    results.append(measure(u"Terrain elevation, DEM, along tracks"_s, trackPositions.size(), [&]() {
+        (void)dem.elevations(trackPositions);
+    }));
+
+    // Geoidal separation along the tracks, one coordinate at a time and as a
+    // batch. The big-endian grid that the geoid used before is no longer
+    // shipped, so there is no comparison with the previous implementation.
+    auto const separations = Positioning::Geoid::separation(trackPositions);
+    bool identicalSeparations = (separations.size() == trackPositions.size());
+    for(qsizetype i=0; identicalSeparations && (i<trackPositions.size()); i++)
+    {
+        auto const single = Positioning::Geoid::separation(trackPositions.at(i)).toM();
+        auto const batch = separations.at(i).toM();
+        identicalSeparations = (single == batch) || (qIsNaN(single) && qIsNaN(batch));
+    }
+    if (!identicalSeparations)
+    {
+        qWarning() << "Benchmark: Geoidal separations differ between single and batch queries";
+        checksPassed = false;
+    }
+    auto const geoidReference = measure(u"Geoid separation"_s, trackPositions.size(), [&]() {
+        for(const auto& position : std::as_const(trackPositions))
+        {
+            (void)Positioning::Geoid::separation(position);
+        }
+    });
+    auto geoidResult = measure(u"Geoid separation, batch"_s, trackPositions.size(), [&]() {
+        (void)Positioning::Geoid::separation(trackPositions);
+    });
+    addSpeedup(geoidResult, geoidReference);
+    geoidResult.insert(u"identical"_s, identicalSeparations);
+    results.append(geoidReference);
+    results.append(geoidResult);
+}
+
+
+void Benchmark::runSideview(const Fixtures& fixtures, QJsonArray& results)
+{
+    auto const airspaces = GeoMaps::GeoMapProvider::readAviationMapSegment(fixtures.aviationMapFileName).airspaces;
+    FileFormats::DEM const dem(fixtures.demFileName);
+
+    // Airspace bands of the side view, along a line through the center with
+    // the sample spacing of a side view 1000 pixels wide at 100 pixels per
+    // 10 km. The polygons and vertices created per update indicate the
+    // number of allocations.
+    constexpr int numSideviewSamples = 250;
+    auto const sideviewStart = QGeoCoordinate(centerLatitude, centerLongitude);
+    auto const sideviewEnd = sideviewStart.atDistanceAndAzimuth(numSideviewSamples*400.0, 90.0);
+    QGeoRectangle const sideviewCorridor(QList({sideviewStart, sideviewEnd}));
+    QList<GeoMaps::Airspace> sideviewAirspaces;
+    for(const auto& airspace : airspaces)
+    {
+        if (airspace.polygon().boundingGeoRectangle().intersects(sideviewCorridor))
+        {
+            sideviewAirspaces << airspace;
+        }
+    }
+    QList<Ui::SideviewQuickItem::Sample> sideviewSamples;
+    QList<QGeoCoordinate> sideviewCoordinates;
+    QList<double> sideviewXCoordinates;
+    for(int i=0; i<numSideviewSamples; i++)
+    {
+        Ui::SideviewQuickItem::Sample sample;
+        sample.coordinate = sideviewStart.atDistanceAndAzimuth(i*400.0, 90.0);
+        for(qsizetype j=0; j<sideviewAirspaces.size(); j++)
+        {
+            if (sideviewAirspaces.at(j).polygon().contains(sample.coordinate))
+            {
+                sample.airspaces.append(j);
+            }
+        }
+        sideviewSamples << sample;
+        sideviewCoordinates << sample.coordinate;
+        sideviewXCoordinates << 4.0*i;
+    }
+    auto sideviewElevations = dem.elevations(sideviewCoordinates);
+    for(auto& elevation : sideviewElevations)
+    {
+        if (!elevation.isFinite())
+        {
+            elevation = Units::Distance::fromM(0.0);
+        }
+    }
+    auto const sideviewAltToYCoordinate = [](Units::Distance altitude) {
+        return 300.0*((Units::Distance::fromFT(6000.0) - altitude)/Units::Distance::fromFT(6000.0));
+    };
+    auto const sideviewQNH = Units::Pressure::fromHPa(1013.25);
+    auto const sideviewAltitude = Units::Distance::fromFT(4000.0);
+    auto sideviewResult = measure(u"Sideview airspace bands"_s, numSideviewSamples, [&]() {
+        (void)Ui::SideviewQuickItem::airspaceBands(sideviewAirspaces, sideviewSamples, sideviewXCoordinates, sideviewElevations,
+                                                   sideviewQNH, sideviewAltitude, sideviewAltitude, sideviewAltToYCoordinate);
+    });
+    qsizetype sideviewPolygons = 0;
+    qsizetype sideviewVertices = 0;
+    auto const sideviewBands = Ui::SideviewQuickItem::airspaceBands(sideviewAirspaces, sideviewSamples, sideviewXCoordinates, sideviewElevations,
+                                                                    sideviewQNH, sideviewAltitude, sideviewAltitude, sideviewAltToYCoordinate);
+    for(const auto& band : sideviewBands)
+    {
+        for(const auto& polygon : band.value<QVector<QPolygonF>>())
+        {
+            sideviewPolygons++;
+            sideviewVertices += polygon.size();
+        }
+    }
+    sideviewResult.insert(u"airspaces"_s, sideviewAirspaces.size());
+    sideviewResult.insert(u"polygons"_s, sideviewPolygons);
+    sideviewResult.insert(u"vertices"_s, sideviewVertices);
+    results.append(sideviewResult);
+}
+
+
+void Benchmark::runMapStyles(QJsonArray& results, bool& checksPassed)
+{
+    // Night-mode sprite sheets, recolored pixel by pixel as before, and with
+    // the transform computed once per distinct color. The results must be
+    // identical, pixel by pixel.
+    QMap<QString, QByteArray> spritePNGs;
+    QDirIterator spriteIterator(u":/flightMap/sprites"_s, {u"*.png"_s}, QDir::Files);
+    while (spriteIterator.hasNext())
+    {
+        auto const spriteFileName = spriteIterator.next();
+        QFile spriteFile(spriteFileName);
+        if (spriteFile.open(QIODevice::ReadOnly))
+        {
+            spritePNGs[spriteFileName] = spriteFile.readAll();
+        }
+    }
+    bool identicalSprites = !spritePNGs.isEmpty();
+    for(auto iterator = spritePNGs.constBegin(); iterator != spritePNGs.constEnd(); ++iterator)
+    {
+        auto const reference = QImage::fromData(BenchmarkReference::nightVersionOf(iterator.key()), "PNG");
+        auto const night = QImage::fromData(GeoMaps::TileServer::nightVersionOf(iterator.value()), "PNG");
+        identicalSprites = identicalSprites && !night.isNull() && (night == reference);
+    }
+    if (!identicalSprites)
+    {
+        qWarning() << "Benchmark: Night-mode sprite sheets differ from the previous recoloring";
+        checksPassed = false;
+    }
+    auto const spriteReference = measure(u"Night-mode sprites, previous recoloring"_s, spritePNGs.size(), [&]() {
+        for(auto iterator = spritePNGs.constBegin(); iterator != spritePNGs.constEnd(); ++iterator)
+        {
+            (void)BenchmarkReference::nightVersionOf(iterator.key());
+        }
+    });
+    auto spriteResult = measure(u"Night-mode sprites"_s, spritePNGs.size(), [&]() {
+        for(auto iterator = spritePNGs.constBegin(); iterator != spritePNGs.constEnd(); ++iterator)
+        {
+            QFile spriteFile(iterator.key());
+            if (spriteFile.open(QIODevice::ReadOnly))
+            {
+                (void)GeoMaps::TileServer::nightVersionOf(spriteFile.readAll());
+            }
+        }
+    });
+    addSpeedup(spriteResult, spriteReference);
+    spriteResult.insert(u"identical"_s, identicalSprites);
+    results.append(spriteReference);
+    results.append(spriteResult);
+
+    // Switching between day and night style, as GeoMapProvider did before
+    // by writing a temporary file, and with style documents served by the
+    // tile server
+    constexpr int numStyleSwitches = 100;
+    QStringList const styleTemplates {u":/flightMap/osm-liberty.json"_s, u":/flightMap/osm-liberty-dark.json"_s};
+    GeoMaps::TileServer tileServer;
+    auto const styleReference = measure(u"Style switch, previous temporary file"_s, numStyleSwitches, [&]() {
+        for(int i=0; i<numStyleSwitches; i++)
+        {
+            (void)BenchmarkReference::styleFileURL(styleTemplates.at(i%2), tileServer.serverUrl(), u"base"_s, u"terrain"_s);
+        }
+    });
+    auto styleResult = measure(u"Style switch"_s, numStyleSwitches, [&]() {
+        for(int i=0; i<numStyleSwitches; i++)
+        {
+            (void)GeoMaps::GeoMapProvider::styleURL(tileServer, styleTemplates.at(i%2), u"base"_s, u"terrain"_s);
+        }
+    });
+    addSpeedup(styleResult, styleReference);
+    results.append(styleReference);
+    results.append(styleResult);
+}
+
+
+void Benchmark::runNavigation(const Fixtures& fixtures, QJsonArray& results, bool& checksPassed)
+{
+    auto const& fixes = fixtures.fixes;
+    auto const airspaces = GeoMaps::GeoMapProvider::readAviationMapSegment(fixtures.aviationMapFileName).airspaces;
+
+    Navigation::AirspaceIncursionPredictor predictor;
+    predictor.setAirspaces(airspaces);
+    results.append(measure(u"Airspace incursion prediction"_s, fixes.size(), [&]() {
+        for(const auto& fix : std::as_const(fixes))
+        {
+            (void)predictor.predict(fix, Units::Distance::fromM(300.0), Units::Pressure::fromHPa(1013.25), {});
+        }
+    }));
+
+    // The leg tracker is compared with the full scan over all legs that
+    // FlightRoute used before. On a route that does not come near the same
+    // segment twice, both must find the same legs.
+    for(int numLegs : {100, 1000})
+    {
+        auto const legs = route(numLegs);
+        auto const legFixes = routeFixes(legs);
+
+        Navigation::LegTracker legTracker;
+        bool identicalLegs = true;
+        for(const auto& fix : legFixes)
+        {
+            identicalLegs = identicalLegs && (legTracker.currentLeg(legs, fix) == BenchmarkReference::currentLeg(legs, fix));
+        }
+        if (!identicalLegs)
+        {
+            qWarning() << "Benchmark: LegTracker differs from the full scan";
+            checksPassed = false;
+        }
+
+        auto const legReference = measure(u"Current leg, %1 legs, full scan"_s.arg(numLegs), legFixes.size(), [&]() {
+            for(const auto& fix : legFixes)
+            {
+                (void)BenchmarkReference::currentLeg(legs, fix);
+            }
+        });
+        auto legResult = measure(u"Current leg, %1 legs"_s.arg(numLegs), legFixes.size(), [&]() {
+            legTracker.reset();
+            for(const auto& fix : legFixes)
+            {
+                (void)legTracker.currentLeg(legs, fix);
+            }
+        });
+        addSpeedup(legResult, legReference);
+        legResult.insert(u"identical"_s, identicalLegs);
+        results.append(legReference);
+        results.append(legResult);
+    }
+
+    auto const ownship = positionInfo(QGeoCoordinate(centerLatitude, centerLongitude, 1000.0), 90.0, 50.0, 0.0);
+    Traffic::CollisionPredictor collisionPredictor;
+    for(int count : {20, 200, 2000})
+    {
+        auto const targets = traffic(count);
+        results.append(measure(u"Collision prediction, %1 targets"_s.arg(count), count, [&]() {
+            (void)collisionPredictor.setOwnship(ownship, QDateTime::currentDateTimeUtc());
+            for(const auto& target : targets)
+            {
+                collisionPredictor.addTarget(target);
+            }
+            collisionPredictor.compute();
+        }));
+    }
+}
+
+
+void Benchmark::runFileFormats(const Fixtures& fixtures, QJsonArray& results, bool& checksPassed)
+{
+    auto const& directory = fixtures.directory;
+    auto const& csvFileName = fixtures.csvFileName;
+    auto const& cupFileName = fixtures.cupFileName;
+    auto const& openAirFileName = fixtures.openAirFileName;
+
+    // The CSV and CUP parsers are compared with the previous, QString-based
+    // parsers. They must produce identical records, and should be at least
+    // ten times as fast.
+    constexpr double csvSpeedupTarget = 10.0;
+    auto const identicalCSV = (FileFormats::CSV(csvFileName).lines() == BenchmarkReference::readCSV(csvFileName));
+    auto const identicalCUP = identicalWaypoints(FileFormats::CUP(cupFileName).waypoints(), BenchmarkReference::readCUP(cupFileName));
+    if (!identicalCSV || !identicalCUP)
+    {
+        qWarning() << "Benchmark: CSV or CUP parser differs from the previous parser";
+        checksPassed = false;
+    }
+
+    auto const csvReference = measure(u"CSV import, previous parser"_s, numWaypoints, [&]() {
+        (void)BenchmarkReference::readCSV(csvFileName);
+    });
+    auto csvResult = measure(u"CSV import"_s, numWaypoints, [&]() {
+        FileFormats::CSV const csv(csvFileName);
+    });
+    addSpeedup(csvResult, csvReference);
+    csvResult.insert(u"identical"_s, identicalCSV);
+    results.append(csvReference);
+    results.append(csvResult);
+
+    auto const cupReference = measure(u"CUP import, previous parser"_s, numWaypoints, [&]() {
+        (void)BenchmarkReference::readCUP(cupFileName);
+    });
+    auto cupResult = measure(u"CUP import"_s, numWaypoints, [&]() {
+        FileFormats::CUP const cup(cupFileName);
+    });
+    addSpeedup(cupResult, cupReference);
+    cupResult.insert(u"identical"_s, identicalCUP);
+    results.append(cupReference);
+    results.append(cupResult);
+
+    for(const auto& result : {csvResult, cupResult})
+    {
+        if (result.value(u"speedup"_s).toDouble() < csvSpeedupTarget)
+        {
+            qWarning().noquote() << u"Benchmark: %1 is less than %2 times as fast as the previous parser"_s.arg(result.value(u"name"_s).toString()).arg(csvSpeedupTarget);
+        }
+    }
+
+    results.append(measure(u"OpenAir parsing"_s, numAirspaces, [&]() {
+        QStringList errors;
+        QStringList warnings;
+        (void)GeoMaps::openAir::parse(openAirFileName, errors, warnings);
+    }));
+
+    // OpenAir import, as DataManager::importOpenAir does it now and did it
+    // before airspaces were built in linear time and streamed to the file
+    auto const openAirGeoJSONFileName = directory.filePath(u"airspaces.geojson"_s);
+    results.append(measure(u"OpenAir import, previous importer"_s, numAirspaces, [&]() {
+        QStringList errors;
+        QStringList warnings;
+        auto const json = BenchmarkReference::parseOpenAir(openAirFileName, errors, warnings);
+        (void)writeFile(openAirGeoJSONFileName, json.toJson());
+    }));
+    results.append(measure(u"OpenAir import"_s, numAirspaces, [&]() {
+        QStringList errors;
+        QStringList warnings;
+        QSaveFile file(openAirGeoJSONFileName);
+        if (file.open(QIODevice::WriteOnly) && GeoMaps::openAir::writeGeoJSON(openAirFileName, file, errors, warnings))
+        {
+            (void)file.commit();
+        }
+    }));
+}
+
+
+void Benchmark::runTraffic(const Fixtures& fixtures, QJsonArray& results)
+{
+    auto const& flarmFileName = fixtures.flarmFileName;
+
+    BenchmarkSource source;
+    auto const flarm = flarmData();
+    results.append(measure(u"processFLARMData"_s, flarm.size(), [&]() {
+        for(const auto& sentence : flarm)
+        {
+            source.processFLARMData(sentence);
+        }
+    }));
+
+    // Replay of a recorded session as fast as possible, through the event
+    // loop and with the Bluetooth-style splitting of messages. The source is
+    // registered with the traffic data provider, so that the dispatch time in
+    // the summary includes the receivers that handle traffic in the app.
+    auto* replaySource = new Traffic::TrafficDataSource_File(false, flarmFileName, nullptr);
+    replaySource->setReplaySpeed(0.0);
+    replaySource->setReplaySummary(true);
+    GlobalObject::trafficDataProvider()->addDataSource(replaySource);
+    QString replaySummary;
+    bool replayFinished = false;
+    QEventLoop replayLoop;
+    QObject::connect(replaySource, &Traffic::TrafficDataSource_File::replayFinished, &replayLoop, [&](const QString& summary) {
+        replaySummary = summary;
+        replayFinished = true;
+        replayLoop.quit();
+    });
+    auto replayResult = measure(u"FLARM replay"_s, flarm.size(), [&]() {
+        // Short replays can finish before connectToTrafficReceiver() returns
+        replayFinished = false;
+        replaySource->connectToTrafficReceiver();
+        if (!replayFinished)
+        {
+            replayLoop.exec();
+        }
+    });
+    replayResult.insert(u"summary"_s, replaySummary);
+    results.append(replayResult);
+    replaySource->disconnectFromTrafficReceiver();
+    GlobalObject::trafficDataProvider()->removeDataSource(replaySource);
+
+    auto const gdl = gdlData();
+    results.append(measure(u"GDL90 decoding"_s, gdl.size(), [&]() {
+        for(const auto& message : gdl)
+        {
+            source.processGDLMessage(message);
+        }
+    }));
+}
+
+
+void Benchmark::runWeather(const Fixtures& fixtures, QJsonArray& results, bool& checksPassed)
+{
+    auto const& trackPositions = fixtures.trackPositions;
+
+    auto const metarList = metars();
+    auto const referenceDate = QDate(2026, 1, 1);
+    results.append(measure(u"METAR decoding"_s, metarList.size(), [&]() {
+        for(const auto& metar : metarList)
+        {
+            Weather::Decoder decoder(metar, referenceDate);
+            (void)decoder.decodedText({}, {});
+        }
+    }));
+
+    // Weather data as downloaded from aviationweather.gov
+    auto const weatherData = weatherXML();
+    results.append(measure(u"Weather parsing"_s, numStations, [&]() {
+        (void)Weather::WeatherDataProvider::parse({weatherData});
+    }));
+
+    // Closest station with QNH along the tracks, with the index and with the
+    // scan over all stations used before. The scan is slow, so only part of
+    // the tracks is used.
+    QMap<QString, Weather::METAR> stationMETARs;
+    for(const auto& metar : Weather::WeatherDataProvider::parse({weatherData}).METARs)
+    {
+        stationMETARs.insert(metar.ICAOCode(), metar);
+    }
+    auto const qnhPositions = trackPositions.mid(0, 3*numFixesPerTrack);
+    bool identicalQNH = !stationMETARs.isEmpty();
+    {
+        Weather::QNHStationIndex const stationIndex(stationMETARs);
+        for(const auto& position : qnhPositions)
+        {
+            identicalQNH = identicalQNH && (stationIndex.closest(position).ICAOCode() == BenchmarkReference::closestMETARWithQNH(stationMETARs, position).ICAOCode());
+        }
+    }
+    if (!identicalQNH)
+    {
+        qWarning() << "Benchmark: Closest QNH station differs from the previous scan";
+        checksPassed = false;
+    }
+    auto const qnhReference = measure(u"Closest QNH station, previous scan"_s, qnhPositions.size(), [&]() {
+        for(const auto& position : qnhPositions)
+        {
+            (void)BenchmarkReference::closestMETARWithQNH(stationMETARs, position);
+        }
+    });
+    auto qnhResult = measure(u"Closest QNH station"_s, qnhPositions.size(), [&]() {
+        Weather::QNHStationIndex const stationIndex(stationMETARs);
+        for(const auto& position : qnhPositions)
+        {
+            (void)stationIndex.closest(position);
+        }
+    });
+    addSpeedup(qnhResult, qnhReference);
+    qnhResult.insert(u"identical"_s, identicalQNH);
+    results.append(qnhReference);
+    results.append(qnhResult);
+
+    // NOTAMs as downloaded from the FAA, parsed and deduplicated, and the
+    // cleanup of a NOTAM list, compared with the QList-based cleanup used
+    // before
+    auto const notamData = notamJSON();
+    QGeoCircle const notamRegion(QGeoCoordinate(centerLatitude, centerLongitude), 200000.0);
+    results.append(measure(u"NOTAM parsing"_s, numNOTAMs, [&]() {
+        NOTAM::NOTAMList const list(QJsonDocument::fromJson(notamData), notamRegion);
+    }));
+    NOTAM::NOTAMList const notamList(QJsonDocument::fromJson(notamData), notamRegion);
+    QSet<QString> cancelledNotamNumbers;
+    for(int i=0; i<numNOTAMs; i+=10)
+    {
+        cancelledNotamNumbers.insert(u"A%1/26"_s.arg(i, 4, 10, QChar(u'0')));
+    }
+    auto const cleanedNotams = notamList.cleaned(cancelledNotamNumbers).notams();
+    auto const identicalNotams = !cleanedNotams.isEmpty() && (cleanedNotams == BenchmarkReference::cleanedNOTAMs(notamList.notams(), cancelledNotamNumbers));
+    if (!identicalNotams)
+    {
+        qWarning() << "Benchmark: NOTAM cleanup differs from the previous cleanup";
+        checksPassed = false;
+    }
+    auto const notamReference = measure(u"NOTAM cleanup, previous QList::contains"_s, notamList.notams().size(), [&]() {
+        (void)BenchmarkReference::cleanedNOTAMs(notamList.notams(), cancelledNotamNumbers);
+    });
+    auto notamResult = measure(u"NOTAM cleanup"_s, notamList.notams().size(), [&]() {
+        (void)notamList.cleaned(cancelledNotamNumbers);
+    });
+    addSpeedup(notamResult, notamReference);
+    notamResult.insert(u"identical"_s, identicalNotams);
+    results.append(notamReference);
+    results.append(notamResult);
+}
+
+
+void Benchmark::runTiles(const Fixtures& fixtures, QJsonArray& results)
+{
+    auto const& mbtilesFileName = fixtures.mbtilesFileName;
+    auto const& pmtilesFileName = fixtures.pmtilesFileName;
+
+    FileFormats::MBTILES mbtiles(mbtilesFileName);
+    results.append(measure(u"MBTILES tile reads"_s, numTilesPerSide*numTilesPerSide, [&]() {
+        for(int x=0; x<numTilesPerSide; x++)
+        {
+            for(int y=0; y<numTilesPerSide; y++)
+            {
+                (void)mbtiles.tile(tileZoom, x, (1<<tileZoom)-1-y);
+            }
+        }
+    }));
+
+    // Tile requests from the map client arrive concurrently. MBTILES cannot
+    // be read concurrently, because database connections are bound to one
+    // thread, so the concurrent benchmark is run for PMTILES only.
+    FileFormats::PMTILES pmtiles(pmtilesFileName);
+    results.append(measure(u"PMTILES tile reads"_s, numTilesPerSide*numTilesPerSide, [&]() {
+        for(int x=0; x<numTilesPerSide; x++)
+        {
+            for(int y=0; y<numTilesPerSide; y++)
+            {
+                (void)pmtiles.tile(tileZoom, x, (1<<tileZoom)-1-y);
+            }
+        }
+    }));
+    QList<int> columns(numTilesPerSide);
+    std::iota(columns.begin(), columns.end(), 0);
+    results.append(measure(u"PMTILES tile reads, concurrent"_s, numTilesPerSide*numTilesPerSide, [&]() {
+        QtConcurrent::blockingMap(columns, [&](int x) {
+            for(int y=0; y<numTilesPerSide; y++)
+            {
+                (void)pmtiles.tile(tileZoom, x, (1<<tileZoom)-1-y);
+            }
+        });
+    }));
+}
+
+
+void Benchmark::runFileTypeDetection(const Fixtures& fixtures, QJsonArray& results, bool& checksPassed)
+{
+    auto const& aviationMapFileName = fixtures.aviationMapFileName;
+    auto const& csvFileName = fixtures.csvFileName;
+    auto const& cupFileName = fixtures.cupFileName;
+    auto const& openAirFileName = fixtures.openAirFileName;
+    auto const& mbtilesFileName = fixtures.mbtilesFileName;
+    auto const& pmtilesFileName = fixtures.pmtilesFileName;
+
+    // File type detection, as processFileOpenRequest does it now and did it
+    // before it read a bounded prefix of each file. Both must detect the same
+    // type. Besides the time, the number of bytes read on either path is
+    // reported.
+    QList<std::pair<QString, QString>> const samples {
+        {u"GeoJSON"_s, aviationMapFileName},
+        {u"CSV"_s, csvFileName},
+        {u"CUP"_s, cupFileName},
+        {u"OpenAir"_s, openAirFileName},
+        {u"MBTILES"_s, mbtilesFileName},
+        {u"PMTILES"_s, pmtilesFileName},
+    };
+    for(const auto& sample : samples)
+    {
+        qint64 bytesRead = -1;
+        auto const fileType = detectFileType(sample.second, bytesRead);
+        auto const previousBytesReadBefore = processBytesRead();
+        auto const previousFileType = BenchmarkReference::detectFileType(sample.second);
+        auto const previousBytesReadAfter = processBytesRead();
+        auto const previousBytesRead = ((previousBytesReadBefore < 0) || (previousBytesReadAfter < 0)) ? -1 : previousBytesReadAfter - previousBytesReadBefore;
+        auto const identicalFileType = (fileType == previousFileType);
+        if (!identicalFileType)
+        {
+            qWarning().noquote() << u"Benchmark: File type detection for %1 differs from the previous checks: %2 instead of %3"_s.arg(sample.first, fileType, previousFileType);
+            checksPassed = false;
+        }
+
+        auto const reference = measure(u"File type detection, %1, previous checks"_s.arg(sample.first), 1, [&]() {
+            (void)BenchmarkReference::detectFileType(sample.second);
+        });
+        auto result = measure(u"File type detection, %1"_s.arg(sample.first), 1, [&]() {
+            qint64 unused = 0;
+            (void)detectFileType(sample.second, unused);
+        });
+        addSpeedup(result, reference);
+        result.insert(u"fileType"_s, fileType);
+        result.insert(u"identical"_s, identicalFileType);
+        result.insert(u"bytesRead"_s, bytesRead);
+        result.insert(u"previousBytesRead"_s, previousBytesRead);
+        result.insert(u"fileSize"_s, QFileInfo(sample.second).size());
+        results.append(reference);
+        results.append(result);
+    }
+}
@@ -0,0 +1,82 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QJsonArray>
+#include <QString>
+
+
+/*! \brief Headless benchmarks of parsers, indexes and map queries
+ *
+ *  This class measures the hot paths of the app without starting the GUI. It
+ *  is run with the command line option "--benchmark", which exists only if
+ *  the app is built with the CMake option ENROUTE_BENCHMARK. The input data is
+ *  synthetic: it is generated in a temporary directory when the benchmarks
+ *  start, with a fixed random seed, so that the benchmarks run offline and
+ *  their results can be compared between versions.
+ *
+ *  The results are written in JSON format. For every benchmark, the output
+ *  contains the number of iterations, the average time per iteration and the
+ *  number of items (lines, messages, tiles, …) processed per second.
+ *
+ *  Where an implementation has replaced an earlier one, the earlier one is
+ *  kept in BenchmarkReference and measured as well. The benchmarks then
+ *  check that both produce the same results, and report the speedup.
+ */
+
+class Benchmark
+{
+public:
+    /*! \brief Run all benchmarks
+     *
+     *  @param fileName Name of the file where the results are written, or
+     *  "-" for standard output
+     *
+     *  @returns Exit code for the application: zero on success, and one if
+     *  the fixtures or the results could not be written, or if an
+     *  implementation produced results that differ from its reference
+     */
+    static int run(const QString& fileName);
+
+private:
+    // Input files and data shared by the benchmarks, defined in Benchmark.cpp
+    struct Fixtures;
+
+    // Writes the input files to a temporary directory and generates the input
+    // data. Returns false if a file could not be written.
+    static bool writeFixtures(Fixtures& fixtures);
+
+    // Each of these methods runs the benchmarks of one area and appends the
+    // results. Where an implementation is compared with a reference, they set
+    // checksPassed to false if the implementation does not produce the same
+    // results as the reference implementation it replaces.
+    static void runAviationMaps(const Fixtures& fixtures, QJsonArray& results, bool& checksPassed);
+    static void runWaypoints(const Fixtures& fixtures, QJsonArray& results, bool& checksPassed);
+    static void runTerrain(const Fixtures& fixtures, QJsonArray& results, bool& checksPassed);
+    static void runSideview(const Fixtures& fixtures, QJsonArray& results);
+    static void runMapStyles(QJsonArray& results, bool& checksPassed);
+    static void runNavigation(const Fixtures& fixtures, QJsonArray& results, bool& checksPassed);
+    static void runFileFormats(const Fixtures& fixtures, QJsonArray& results, bool& checksPassed);
+    static void runTraffic(const Fixtures& fixtures, QJsonArray& results);
+    static void runWeather(const Fixtures& fixtures, QJsonArray& results, bool& checksPassed);
+    static void runTiles(const Fixtures& fixtures, QJsonArray& results);
+    static void runFileTypeDetection(const Fixtures& fixtures, QJsonArray& results, bool& checksPassed);
+};
@@ -0,0 +1,1403 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <QBuffer>
+#include <QFile>
+#include <QGeoCoordinate>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QLockFile>
+#include <QMimeDatabase>
+#include <QSet>
+#include <QTemporaryFile>
+#include <QTextStream>
+
+#include "BenchmarkReference.h"
+#include "GlobalObject.h"
+#include "Librarian.h"
+#include "fileFormats/CUP.h"
+#include "fileFormats/DataFileAbstract.h"
+#include "fileFormats/FPL.h"
+#include "fileFormats/PLN.h"
+#include "fileFormats/TileFileAbstract.h"
+#include "fileFormats/TripKit.h"
+#include "fileFormats/ZipFile.h"
+#include "geomaps/GeoJSON.h"
+#include "geomaps/OpenAir.h"
+#include "geomaps/VAC.h"
+#include "traffic/TrafficDataSource_File.h"
+
+#include <cmath>
+
+using namespace Qt::Literals::StringLiterals;
+
+
+//
+// CSV and CUP
+//
+
+namespace {
+
+QStringList parseCSV(const QString& string)
+{
+    // Thanks to https://stackoverflow.com/questions/27318631/parsing-through-a-csv-file-in-qt
+
+    enum State : quint8
+    {
+        Normal,
+        Quote
+    } state = Normal;
+    QStringList fields;
+    fields.reserve(10);
+    QString value;
+
+    for (int i = 0; i < string.size(); i++)
+    {
+        const QChar current = string.at(i);
+
+        // Normal state
+        if (state == Normal)
+        {
+            // Comma
+            if (current == ',')
+            {
+                // Save field
+                fields.append(value.trimmed());
+                value.clear();
+            }
+
+            // Double-quote
+            else if (current == '"')
+            {
+                state = Quote;
+                value += current;
+            }
+
+            // Other character
+            else
+            {
+                value += current;
+            }
+        }
+
+        // In-quote state
+        else if (state == Quote)
+        {
+            // Another double-quote
+            if (current == '"')
+            {
+                if (i < string.size())
+                {
+                    // A double double-quote?
+                    if (i + 1 < string.size() && string.at(i + 1) == '"')
+                    {
+                        value += '"';
+
+                        // Skip a second quote character in a row
+                        i++;
+                    }
+                    else
+                    {
+                        state = Normal;
+                        value += '"';
+                    }
+                }
+            }
+
+            // Other character
+            else
+            {
+                value += current;
+            }
+        }
+    }
+
+    if (!value.isEmpty())
+    {
+        fields.append(value.trimmed());
+    }
+
+    // Quotes are left in until here; so when fields are trimmed, only whitespace outside of
+    // quotes is removed.  The outermost quotes are removed here.
+    for (auto &field : fields)
+    {
+        if (field.length() >= 1 && field.at(0) == '"')
+        {
+            field = field.mid(1);
+            if (field.length() >= 1 && field.right(1) == '"')
+            {
+                field = field.left(field.length() - 1);
+            }
+        }
+    }
+
+    return fields;
+}
+
+GeoMaps::Waypoint readCUPWaypoint(const QStringList& fields)
+{
+    if (fields.size() < 6)
+    {
+        return {};
+    }
+
+    // Get Name
+    const auto &name = fields[0];
+
+    // Get Latitude
+    double lat = NAN;
+    {
+        auto latString = fields[3];
+        if (latString.size() != 9)
+        {
+            return {};
+        }
+        if ((latString[8] != 'N') && (latString[8] != 'S'))
+        {
+            return {};
+        }
+        bool ok = false;
+        lat = latString.left(2).toDouble(&ok);
+        if (!ok)
+        {
+            return {};
+        }
+        lat = lat + latString.mid(2, 6).toDouble(&ok) / 60.0;
+        if (!ok)
+        {
+            return {};
+        }
+        if (latString[8] == 'S')
+        {
+            lat = -lat;
+        }
+    }
+
+    // Get Longitude
+    double lon = NAN;
+    {
+        auto longString = fields[4];
+        if (longString.size() != 10)
+        {
+            return {};
+        }
+        if ((longString[9] != 'W') && (longString[9] != 'E'))
+        {
+            return {};
+        }
+        bool ok = false;
+        lon = longString.left(3).toDouble(&ok);
+        if (!ok)
+        {
+            return {};
+        }
+        lon = lon + longString.mid(3, 6).toDouble(&ok) / 60.0;
+        if (!ok)
+        {
+            return {};
+        }
+        if (longString[9] == 'W')
+        {
+            lon = -lon;
+        }
+    }
+
+    double ele = NAN;
+    {
+        const auto &eleString = fields[5];
+        bool ok = false;
+        if (eleString.endsWith(u"m"))
+        {
+            ele = eleString.chopped(1).toDouble(&ok);
+        }
+        if (eleString.endsWith(u"ft"))
+        {
+            ele = eleString.chopped(2).toDouble(&ok) * 0.3048;
+        }
+        if (!ok)
+        {
+            return {};
+        }
+    }
+
+    // Get additional information
+    QStringList notes;
+    if ((fields.size() >= 8) && (!fields[7].isEmpty()))
+    {
+        notes += QObject::tr("Direction: %1°", "GeoMaps::CUP").arg(fields[7]);
+    }
+    if ((fields.size() >= 9) && (!fields[8].isEmpty()))
+    {
+        notes += QObject::tr("Length: %1", "GeoMaps::CUP").arg(fields[8]);
+    }
+    if ((fields.size() >= 11) && (!fields[10].isEmpty()))
+    {
+        notes += fields[10];
+    }
+    if ((fields.size() >= 12) && (!fields[11].isEmpty()))
+    {
+        notes += fields[11];
+    }
+
+    GeoMaps::Waypoint result(QGeoCoordinate(lat, lon, ele));
+    result.setName(name);
+    if (!notes.isEmpty())
+    {
+        result.setNotes(notes.join(u" • "_s));
+    }
+    return result;
+}
+
+} // namespace
+
+
+QVector<QStringList> BenchmarkReference::readCSV(const QString& fileName)
+{
+    QVector<QStringList> lines;
+    auto file = FileFormats::DataFileAbstract::openFileURL(fileName);
+    if (!file->open(QIODevice::ReadOnly))
+    {
+        return lines;
+    }
+
+    QTextStream stream(file.data());
+    QString line;
+    stream.readLineInto(&line);
+    while (stream.readLineInto(&line))
+    {
+        lines << parseCSV(line);
+    }
+    return lines;
+}
+
+
+QVector<GeoMaps::Waypoint> BenchmarkReference::readCUP(const QString& fileName)
+{
+    QVector<GeoMaps::Waypoint> waypoints;
+    foreach (auto& line, readCSV(fileName))
+    {
+        if (line.contains(u"-----Related Tasks-----"))
+        {
+            break;
+        }
+        auto waypoint = readCUPWaypoint(line);
+        if (!waypoint.isValid())
+        {
+            return {};
+        }
+        waypoints << waypoint;
+    }
+    return waypoints;
+}
+
+
+//
+// OpenAir
+//
+
+namespace {
+
+class AirSpace {
+public:
+    QString ac;
+    QString an;
+    QString al;
+    QString ah;
+    QChar variableD {'+'};
+    QGeoCoordinate variableX;
+    QVector<QGeoCoordinate> polygon;
+
+    void addPoint(const QString& qs)
+    {
+        QGeoCoordinate const point = toCoord(qs);
+        polygon.prepend(point);
+    }
+
+    void addCircle(const QString& qs)
+    {
+        bool ok = false;
+        double const radius = qs.toDouble(&ok) * 1852;
+        if (!ok)
+        {
+            throw QObject::tr("Invalid number found: %1", "OpenAir").arg(qs);
+        }
+        if (variableX.isValid())
+        {
+            for (int i=0; i <= 360; i += 10)
+            {
+                polygon.prepend(variableX.atDistanceAndAzimuth(radius, i));
+            }
+        }
+        else
+        {
+            throw QObject::tr("Variable X is not set but Circle should be drawn", "OpenAir");
+        }
+    }
+
+    void addArc(const QString& qs)
+    {
+        bool ok = false;
+        QStringList items = qs.split(u',', Qt::SkipEmptyParts);
+        double const radius = items[0].toDouble(&ok) * 1852;
+        if (!ok)
+        {
+            throw QObject::tr("Invalid number found: %1", "OpenAir").arg(items[0]);
+        }
+        double const angleStart = items[1].toDouble(&ok);
+        if (!ok)
+        {
+            throw QObject::tr("Invalid number found: %1", "OpenAir").arg(items[1]);
+        }
+        double const angleEnd = items[2].toDouble(&ok);
+        if (!ok)
+        {
+            throw QObject::tr("Invalid number found: %1", "OpenAir").arg(items[2]);
+        }
+        if (variableX.isValid())
+        {
+            if (variableD == '-')
+            {
+                if (angleEnd > angleStart)
+                {
+                    addArcCounterClockwise(radius, angleStart, 0);
+                    addArcCounterClockwise(radius, 360, angleEnd);
+                }
+                else
+                {
+                    addArcCounterClockwise(radius, angleStart, angleEnd);
+                }
+            }
+            else
+            {
+                if (angleEnd < angleStart)
+                {
+                    addArcClockwise(radius,angleStart, 360);
+                    addArcClockwise(radius, 0, angleEnd);
+                }
+                else
+                {
+                    addArcClockwise(radius,angleStart, angleEnd);
+                }
+            }
+            polygon.prepend(variableX.atDistanceAndAzimuth(radius, angleEnd));
+        }
+        else
+        {
+            throw QObject::tr("Variable X is not set but Circle should be drawn", "OpenAir");
+        }
+    }
+
+    void addArcPoints(const QString& qs)
+    {
+        QStringList items = qs.split(u',', Qt::SkipEmptyParts);
+        QGeoCoordinate const startPoint = toCoord(items[0]);
+        if (items[1].startsWith(u" "_s))
+        {
+            items[1] = items[1].sliced(1);
+        }
+        QGeoCoordinate const endPoint = toCoord(items[1]);
+        if (!variableX.isValid())
+        {
+            throw QObject::tr("Variable X is not set but Circle should be drawn", "OpenAir");
+        }
+        double const radius = variableX.distanceTo(startPoint);
+        double const angleStart = variableX.azimuthTo(startPoint);
+        double const angleEnd = variableX.azimuthTo(endPoint);
+        if (variableD == '-')
+        {
+            if (angleEnd > angleStart)
+            {
+                addArcCounterClockwise(radius, angleStart, 0);
+                addArcCounterClockwise(radius, 360, angleEnd);
+            }
+            else
+            {
+                addArcCounterClockwise(radius, angleStart, angleEnd);
+            }
+        }
+        else
+        {
+            if (angleEnd < angleStart)
+            {
+                addArcClockwise(radius,angleStart, 360);
+                addArcClockwise(radius, 0, angleEnd);
+            }
+            else
+            {
+                addArcClockwise(radius,angleStart, angleEnd);
+            }
+        }
+        polygon.prepend(variableX.atDistanceAndAzimuth(radius, angleEnd));
+    }
+
+    void addArcClockwise(double radius, double start, double end)
+    {
+        if ((radius <= 0) || (start < -360.0) || (start > 360.0) || (end < -360.0) || (end > 360.0) || (start >= end))
+        {
+            throw QObject::tr("Invalid arc specification", "OpenAir");
+        }
+
+        do
+        {
+            polygon.prepend(variableX.atDistanceAndAzimuth(radius, start));
+            start += 10;
+        } while (start < end);
+    }
+
+    void addArcCounterClockwise(double radius, double start, double end)
+    {
+        if ((radius <= 0) || (start < -360.0) || (start > 360.0) || (end < -360.0) || (end > 360.0) || (start <= end))
+        {
+            throw QObject::tr("Invalid arc specification", "OpenAir");
+        }
+
+        do
+        {
+            polygon.prepend(variableX.atDistanceAndAzimuth(radius, start));
+            start -= 10;
+        } while (start > end);
+    }
+
+    /*
+     * Final check if all information regarding one AirSpace is read:
+     *  - close polygon if it is open
+     *  - delete doubled points from the polygon
+     *  - reverse polygon if it is clockwise
+     *  - check if necessary information is complete (e.g. lower limit and upper limit are defined)
+     */
+    void finalize(QStringList& errorList)
+    {
+        if  (polygon.size() > 1)
+        {
+            //close polygon if it is open
+            auto last = polygon.size() - 1;
+            if ((polygon.at(0).latitude() != polygon.at(last).latitude()) ||
+                (polygon.at(0).longitude() != polygon.at(last).longitude()))
+            {
+                polygon.prepend(polygon.at(last));
+            }
+            //delete doubled points
+            for (auto i=polygon.size() - 1; i > 0; i--) {
+                if ((polygon.at(i).latitude()  == polygon.at(i - 1).latitude() ) &&
+                    (polygon.at(i).longitude() == polygon.at(i - 1).longitude()) )
+                {
+                    polygon.removeAt(i);
+                }
+            }
+            //reverse polygon if it is clockwise
+            if (isClockwise())
+            {
+                reversePolygon();
+            }
+        }
+        if (al.size() < 1)
+        {
+            errorList.append("Lower Limit not set for AirSpace " + an);
+        }
+        if (ah.size() < 1)
+        {
+            errorList.append("Upper Limit not set for AirSpace " + an);
+        }
+        if ((ac.compare(u"A"_s)   != 0) &&
+            (ac.compare(u"ATZ"_s) != 0) &&
+            (ac.compare(u"B"_s)   != 0) &&
+            (ac.compare(u"CTR"_s) != 0) &&
+            (ac.compare(u"C"_s)   != 0) &&
+            (ac.compare(u"D"_s)   != 0) &&
+            (ac.compare(u"DNG"_s) != 0) &&
+            (ac.compare(u"FIR"_s) != 0) &&
+            (ac.compare(u"FIS"_s) != 0) &&
+            (ac.compare(u"GLD"_s) != 0) &&
+            (ac.compare(u"NRA"_s) != 0) &&
+            (ac.compare(u"P"_s)   != 0) &&
+            (ac.compare(u"PJE"_s) != 0) &&
+            (ac.compare(u"R"_s)   != 0) &&
+            (ac.compare(u"TMZ"_s) != 0) &&
+            (ac.compare(u"SUA"_s) != 0)   )
+        {
+            ac = u"SUA"_s;
+        }
+    }
+
+    [[nodiscard]] bool isSet() const
+    {
+        return (ac.length() > 0);
+    }
+
+    void setHeight(QString qs, bool higher)
+    {
+        qs.replace(u"FL"_s, u"FL "_s);
+        qs.replace(u"ft"_s, u" ft"_s);
+        qs.replace(u"SFC"_s, u"GND"_s);
+        qs.replace(u"agl"_s, u"AGL"_s);
+        QStringList items = qs.split(u' ', Qt::SkipEmptyParts);
+        if (items[0].compare(u"0"_s) == 0)
+        {
+            items[0] = u"GND"_s;
+        }
+        if ((items.size() > 1) && (items[1].compare(u"ft"_s) == 0))
+        {
+            items.removeAt(1);
+        }
+        if ((items.size() > 1) && ((items[0].compare(u"FL"_s) == 0) || (items[1].compare(u"AGL"_s) == 0)))
+        {
+            items[0] = items[0] + " " + items[1];
+        }
+        if (higher)
+        {
+            ah = items[0];
+        }
+        else
+        {
+            al = items[0];
+        }
+    }
+
+    void setVar(const QString& qs)
+    {
+        if (qs.startsWith(u"X="_s))
+        {
+            variableX = toCoord(qs.sliced(2));
+        }
+        else if (qs.startsWith(u"D="_s))
+        {
+            variableD = qs.at(2);
+            if ((variableD != '-') && (variableD != '+'))
+            {
+                variableD = '+';
+                throw QObject::tr("Invalid content for VariableD (direction): %1", "OpenAir").arg(qs.at(2));
+            }
+        }
+    }
+
+private:
+    static double getNumber(const QString& degree)
+    {
+        bool ok = false;
+        double ret = NAN;
+        auto i = degree.indexOf(u":"_s);
+        if (i < 0)
+        {
+            ret = degree.toDouble(&ok);
+            if (!ok)
+            {
+                throw QObject::tr("Invalid number found: %1", "OpenAir").arg(degree);
+            }
+            return ret;
+        }
+        ret = degree.first(i).toDouble(&ok) + getNumber(degree.sliced(i + 1)) / 60;
+        if (!ok)
+        {
+            throw QObject::tr("Invalid number found: %1", "OpenAir").arg(degree.first(i));
+        }
+        return ret;
+    }
+
+    [[nodiscard]] bool isClockwise() const
+    {
+        double area = 0;
+        qsizetype j = 0;
+
+        for (auto i=0; i < polygon.size(); i++)
+        {
+            j = (i + 1) % polygon.size();
+            area += polygon.at(i).longitude() * polygon.at(j).latitude() - polygon.at(j).longitude() * polygon.at(i).latitude();
+        }
+        // If the area is positive, the polygon is defined clockwise, otherwise counterclockwise
+        return (area < 0);
+    }
+
+    void reversePolygon() {
+        auto j = polygon.size() - 1;
+        for (int i=0; i < j;i++, j--)
+        {
+            polygon.swapItemsAt(i, j);
+        }
+    }
+
+    static QGeoCoordinate toCoord(const QString& qs)
+    {
+        double latitude = NAN;
+        double longitude = NAN;
+        QStringList items = qs.split(u' ', Qt::SkipEmptyParts);
+        if (items[0].endsWith('N') || items[0].endsWith('S'))
+        {
+            items.insert(1, items[0].sliced(items[0].length() - 1));
+            items[0].chop(1);
+        }
+        latitude = getNumber(items[0]);
+        if (items[1].compare(u"S"_s) == 0)
+        {
+            latitude *= -1;
+        }
+        else if (items[1].compare(u"N"_s) != 0)
+        {
+            throw QObject::tr("Invalid coordinate found: %1", "OpenAir").arg(qs);
+        }
+        if (items[2].endsWith('W') || items[2].endsWith('E'))
+        {
+            items.insert(3, items[2].sliced(items[2].length() - 1));
+            items[2].chop(1);
+        }
+        longitude = getNumber(items[2]);
+        if (items[3].compare(u"W"_s) == 0)
+        {
+            longitude *= -1;
+        }
+        else if (items[3].compare(u"E"_s) != 0)
+        {
+            throw QObject::tr("Invalid coordinate found: %1", "OpenAir").arg(qs);
+        }
+        if ((latitude > 90) || (latitude < -90) || (longitude > 180) || (longitude < -180))
+        {
+            throw QObject::tr("Invalid coordinate found: %1", "OpenAir").arg(qs);
+        }
+        return {latitude, longitude};
+    }
+};
+
+
+class AirSpaceVector {
+private:
+    QVector<AirSpace> airSpaceVector;
+
+public:
+    void addAirSpace(const AirSpace& airSpace)
+    {
+        airSpaceVector.append(airSpace);
+    }
+
+    bool isSameName(const QString& qs)
+    {
+        return (!airSpaceVector.empty()) && (airSpaceVector.last().an.compare(qs) == 0);
+    }
+
+    QGeoCoordinate getLastX()
+    {
+        return airSpaceVector.last().variableX;
+    }
+
+    QJsonDocument getJson(const QString& fileName)
+    {
+        QJsonObject recObj;
+        QJsonObject featureObj;
+        QJsonObject propObj;
+        QJsonObject geomObj;
+        QJsonArray featureArray;
+        QJsonArray polygonArray;
+        QJsonArray coordArray;
+        QJsonArray coord;
+        QGeoCoordinate const point;
+
+        recObj.insert(u"type"_s, QJsonValue::fromVariant("FeatureCollection"));
+        recObj.insert(u"info"_s, QJsonValue::fromVariant(fileName));
+
+        for (const auto &i : std::as_const(airSpaceVector))
+        {
+            featureObj.insert(u"type"_s, QJsonValue::fromVariant("Feature"));
+            propObj = QJsonObject();
+            propObj.insert(u"NAM"_s, QJsonValue::fromVariant(i.an));
+            propObj.insert(u"ID"_s, QJsonValue::fromVariant(i.an));
+            propObj.insert(u"CAT"_s, QJsonValue::fromVariant(i.ac));
+            propObj.insert(u"TYP"_s, QJsonValue::fromVariant("AS"));
+            if (!i.al.isEmpty()) {
+                propObj.insert(u"BOT"_s, QJsonValue::fromVariant(i.al));
+            }
+            if (!i.ah.isEmpty()) {
+                propObj.insert(u"TOP"_s, QJsonValue::fromVariant(i.ah));
+            }
+
+            // Compute SBO: simplified bottom altitude in feet
+            if (!i.al.isEmpty())
+            {
+                int sbo = 0;
+                const QString& al = i.al;
+                if (al.compare(u"GND"_s) == 0)
+                {
+                    sbo = 0;
+                }
+                else if (al.startsWith(u"FL "_s))
+                {
+                    // "FL 90" → 9000 ft, "FL 100" → 10000 ft, etc.
+                    bool ok = false;
+                    const int fl = al.sliced(3).toInt(&ok);
+                    sbo = ok ? fl * 100 : 0;
+                }
+                else
+                {
+                    // Plain feet AMSL ("3500") or feet AGL ("3500 AGL") — take the leading number
+                    bool ok = false;
+                    const int ft = al.split(u' ', Qt::SkipEmptyParts).first().toInt(&ok);
+                    sbo = ok ? ft : 0;
+                }
+                propObj.insert(u"SBO"_s, QJsonValue::fromVariant(sbo));
+            }
+
+            featureObj.insert(u"properties"_s, propObj);
+
+            while (coordArray.count() != 0)
+            {
+                coordArray.pop_back();
+            }
+            for (const auto &j : i.polygon) {
+                while (coord.count() != 0) {
+                    coord.pop_back();
+                }
+                coord.append(j.longitude());
+                coord.append(j.latitude());
+                coordArray.append(coord);
+            }
+            while (polygonArray.count() != 0)
+            {
+                polygonArray.pop_back();
+            }
+            polygonArray.append(coordArray);
+            if (i.polygon.size() > 1) {
+                geomObj.insert(u"type"_s, QJsonValue::fromVariant("Polygon"));
+                geomObj.insert(u"coordinates"_s, polygonArray);
+                featureObj.insert(u"geometry"_s, geomObj);
+            }
+
+            featureArray.append(featureObj);
+        }
+
+        if (featureArray.isEmpty())
+        {
+            return {};
+        }
+
+        recObj.insert(u"features"_s, featureArray);
+        QJsonDocument json(recObj);
+        return json;
+    }
+};
+
+} // namespace
+
+
+QJsonDocument BenchmarkReference::parseOpenAir(const QString& fileName, QStringList& errorList, QStringList& warningList)
+{
+    QString line;
+    AirSpace airSpace;
+    AirSpaceVector airSpaceVector;
+
+
+    auto inputFile = FileFormats::DataFileAbstract::openFileURL(fileName);
+    if (!inputFile->open(QIODeviceBase::ReadOnly))
+    {
+        errorList << QObject::tr("Cannot open file %1", "OpenAir").arg(fileName);
+        return {};
+    }
+
+    QTextStream inputStream(inputFile.data());
+    inputStream.setEncoding(QStringConverter::Latin1);
+
+    bool hadError = false;
+    int lineNo = 0;
+    while (inputStream.readLineInto(&line))
+    {
+        lineNo++;
+
+        try {
+            if (line.startsWith(u"*"_s) || line.length() == 0)
+            {
+                continue;
+            }
+            if (line.startsWith(u"AC "_s))
+            {
+                //if airSpace is already filled, the existing airSpace must be added to the list and a new airSpace must be initialized
+                if (airSpace.isSet())
+                {
+                    if (!hadError)
+                    {
+                        airSpace.finalize(errorList);
+                        airSpaceVector.addAirSpace(airSpace);
+                    }
+                    airSpace = AirSpace();
+                    hadError = false;
+                }
+                airSpace.ac = line.sliced(3).trimmed();
+                continue;
+            }
+            if (line.startsWith(u"AN "_s))
+            {
+                airSpace.an = line.sliced(3);
+                if (airSpaceVector.isSameName(airSpace.an))
+                {
+                    airSpace.variableX = airSpaceVector.getLastX();
+                }
+                continue;
+            }
+            if (line.startsWith(u"AL "_s))
+            {
+                airSpace.setHeight(line.sliced(3), false);
+                continue;
+            }
+            if (line.startsWith(u"AH "_s))
+            {
+                airSpace.setHeight(line.sliced(3), true);
+                continue;
+            }
+            if (line.startsWith(u"V "_s))
+            {
+                airSpace.setVar(line.sliced(2));
+                continue;
+            }
+            if (line.startsWith(u"DP "_s))
+            {
+                airSpace.addPoint(line.sliced(3));
+                continue;
+            }
+            if (line.startsWith(u"DC "_s))
+            {
+                airSpace.addCircle(line.sliced(3));
+                continue;
+            }
+            if (line.startsWith(u"DA "_s))
+            {
+                airSpace.addArc(line.sliced(3));
+                continue;
+            }
+            if (line.startsWith(u"DB "_s))
+            {
+                airSpace.addArcPoints(line.sliced(3));
+                continue;
+            }
+            if (line.startsWith(u"AT "_s))
+            {
+                continue;
+            }
+            warningList.append(QObject::tr("Unrecognized record type in line %1: %2; Line ignored.", "OpenAir").arg(QString::number(lineNo), line));
+        }
+        catch (QString& ex)
+        {
+            hadError = true;
+            warningList.append(QObject::tr("Error in line %1: %2; Airspace %3 ignored.", "OpenAir").arg(QString::number(lineNo), ex, airSpace.an));
+        }
+    }
+    if (airSpace.isSet())
+    {
+        airSpace.finalize(errorList);
+        airSpaceVector.addAirSpace(airSpace);
+    }
+
+    return airSpaceVector.getJson(fileName);
+}
+
+
+//
+// Flight route
+//
+
+qsizetype BenchmarkReference::currentLeg(const QList<Navigation::Leg>& legs, const Positioning::PositionInfo& positionInfo)
+{
+    // Take the last leg that we are following (if there is one)
+    for(auto i=legs.size()-1; i>=0; i--)
+    {
+        if (legs[i].isFollowing(positionInfo))
+        {
+            return i;
+        }
+    }
+
+    // Take the last leg that we are near to (if there is one)
+    for(auto i=legs.size()-1; i>=0; i--)
+    {
+        if (legs[i].isNear(positionInfo))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+
+//
+// Night-mode sprites
+//
+
+QByteArray BenchmarkReference::nightVersionOf(const QString& fileName)
+{
+    QImage image(fileName);
+    image.convertTo(QImage::Format_ARGB32);
+
+    for (int y = 0; y < image.height(); ++y)
+    {
+        auto* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x)
+        {
+            const QColor color = QColor::fromRgb(line[x] | 0xFF000000U);
+
+            const qreal vFlipped = 0.88 * (1.0 - color.valueF());
+            const qreal vMuted = 0.45 + 0.4 * color.valueF();
+            const qreal saturation = color.saturationF();
+            const qreal value = (1.0 - saturation) * vFlipped + saturation * vMuted;
+
+            const auto newColor = QColor::fromHsvF(qMax(color.hsvHueF(), 0.0), 0.55 * saturation, value);
+            line[x] = (line[x] & 0xFF000000U) | (newColor.rgb() & 0x00FFFFFFU);
+        }
+    }
+
+    QByteArray result;
+    QBuffer buffer(&result);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "PNG");
+    return result;
+}
+
+
+//
+// Waypoints
+//
+
+QVector<GeoMaps::Waypoint> BenchmarkReference::filteredWaypoints(const QVector<GeoMaps::Waypoint>& waypoints, const QString& filter)
+{
+    QStringList filterWords;
+    foreach(auto word, filter.simplified().split(' ', Qt::SkipEmptyParts)) {
+        QString const simplifiedWord = GlobalObject::librarian()->simplifySpecialChars(word);
+        if (simplifiedWord.isEmpty()) {
+            continue;
+        }
+        filterWords.append(simplifiedWord);
+    }
+
+    QVector<GeoMaps::Waypoint> result;
+    for(const auto& waypoint : waypoints) {
+        if (!waypoint.isValid()) {
+            continue;
+        }
+        bool allWordsFound = true;
+        foreach(auto word, filterWords) {
+            QString const fullName = GlobalObject::librarian()->simplifySpecialChars(waypoint.name());
+            if (!fullName.contains(word, Qt::CaseInsensitive) && !waypoint.ICAOCode().contains(word, Qt::CaseInsensitive)) {
+                allWordsFound = false;
+                break;
+            }
+        }
+        if (allWordsFound) {
+            result.append( waypoint );
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const GeoMaps::Waypoint& first, const GeoMaps::Waypoint& second) {return first.name() < second.name(); });
+
+    return result;
+}
+
+
+QVector<GeoMaps::Waypoint> BenchmarkReference::nearbyWaypoints(const QVector<GeoMaps::Waypoint>& waypoints, const QGeoCoordinate& position, const QString& type)
+{
+    QVector<GeoMaps::Waypoint> tWps;
+    for(const auto& waypoint : waypoints)
+    {
+        if (!waypoint.isValid())
+        {
+            continue;
+        }
+        if (waypoint.type() != type)
+        {
+            continue;
+        }
+        tWps.append(waypoint);
+    }
+
+    std::sort(tWps.begin(), tWps.end(), [position](const GeoMaps::Waypoint& first, const GeoMaps::Waypoint& second) {return position.distanceTo(first.coordinate()) < position.distanceTo(second.coordinate()); });
+
+    return tWps.mid(0,20);
+}
+
+
+GeoMaps::Waypoint BenchmarkReference::closestWaypoint(const QVector<GeoMaps::Waypoint>& waypoints, const QGeoCoordinate& position, const QGeoCoordinate& distPosition)
+{
+    GeoMaps::Waypoint result;
+    for(const auto& waypoint : waypoints)
+    {
+        if (!waypoint.isValid())
+        {
+            continue;
+        }
+        if (!result.isValid())
+        {
+            result = waypoint;
+        }
+        if (position.distanceTo(waypoint.coordinate()) < position.distanceTo(result.coordinate()))
+        {
+            result = waypoint;
+        }
+    }
+
+    if (!result.isValid() || (position.distanceTo(result.coordinate()) > position.distanceTo(distPosition)))
+    {
+        return {};
+    }
+    return result;
+}
+
+
+QVector<GeoMaps::Waypoint> BenchmarkReference::importWaypoints(QVector<GeoMaps::Waypoint> library, const QVector<GeoMaps::Waypoint>& waypoints, bool skip)
+{
+    if (skip)
+    {
+        foreach(const auto& newWaypoint, waypoints)
+        {
+            bool skip = false;
+            foreach(const auto& existingWaypoint, library)
+            {
+                if (newWaypoint.isNear(existingWaypoint))
+                {
+                    skip = true;
+                    break;
+                }
+            }
+            if (!skip)
+            {
+                library.append(newWaypoint);
+            }
+        }
+    }
+    else
+    {
+        library += waypoints;
+    }
+
+    std::sort(library.begin(), library.end(), [](const GeoMaps::Waypoint &a, const GeoMaps::Waypoint &b)
+    { return a.name() < b.name(); });
+    return library;
+}
+
+
+//
+// Aviation maps
+//
+
+BenchmarkReference::AviationData BenchmarkReference::fillAviationDataCache(QStringList JSONFileNames, bool hideGlidingSectors)
+{
+    // Ensure that order is the same every time
+    JSONFileNames.sort();
+
+    //
+    // Generate new GeoJSON array and new list of waypoints
+    //
+
+    // First, create a vector of JSON objects.
+    // We use a QSet to keep track of objects that have already been added in order to avoid duplicated entries.
+    // The vector is used to ensure that the order of the objects remains identical during runs.
+    // A QSet seems to have some built-in randomness and does not do that.
+    QVector<QJsonObject> objectVector;
+    {
+        QSet<QJsonObject> objectSet;
+        for(const auto& JSONFileName : JSONFileNames)
+        {
+            // Read the lock file
+            QLockFile lockFile(JSONFileName + u".lock"_s);
+            lockFile.lock();
+            QFile file(JSONFileName);
+            QJsonDocument document;
+            if (file.open(QIODevice::ReadOnly))
+            {
+                document = QJsonDocument::fromJson(file.readAll());
+                file.close();
+            }
+            lockFile.unlock();
+
+            for(const auto& value : document.object()[QStringLiteral("features")].toArray())
+            {
+                auto object = value.toObject();
+                if (objectSet.contains(object))
+                {
+                    continue;
+                }
+                objectVector += object;
+                objectSet += object;
+            }
+        }
+    }
+
+    // Create vectors of airspaces and waypoints
+    QVector<GeoMaps::Airspace> newAirspaces;
+    QVector<GeoMaps::Waypoint> newWaypoints;
+    for(const auto& object : std::as_const(objectVector))
+    {
+        // Check if the current object is a waypoint. If so, add it to the list of waypoints.
+        GeoMaps::Waypoint const waypoint(object);
+        if (waypoint.isValid())
+        {
+            newWaypoints.append(waypoint);
+            continue;
+        }
+
+        // Check if the current object is an airspace. If so, add it to the list of airspaces.
+        GeoMaps::Airspace const airspace(object);
+        if (airspace.isValid())
+        {
+            newAirspaces.append(airspace);
+            continue;
+        }
+    }
+
+    // Then, create a new JSONArray of features and a new list of waypoints
+    QJsonArray newFeatures;
+    for(const auto& object : std::as_const(objectVector))
+    {
+        // If 'hideGlidingSector' is set, ignore all objects that are airspaces
+        // and that are gliding sectors
+        if (hideGlidingSectors)
+        {
+            GeoMaps::Airspace const airspaceTest(object);
+            if (airspaceTest.CAT() == u"GLD"_s)
+            {
+                continue;
+            }
+        }
+        newFeatures += object;
+    }
+
+    QByteArray newGeoJSON;
+    {
+        QJsonObject resultObject;
+        resultObject.insert(QStringLiteral("type"), "FeatureCollection");
+        resultObject.insert(QStringLiteral("features"), newFeatures);
+        QJsonDocument const geoDoc(resultObject);
+        newGeoJSON = geoDoc.toJson();
+    }
+
+    // Sort waypoints by name
+    std::sort(newWaypoints.begin(), newWaypoints.end(), [](const GeoMaps::Waypoint& first, const GeoMaps::Waypoint& second) {return first.name() < second.name(); });
+
+    return {newWaypoints, newAirspaces, newGeoJSON};
+}
+
+
+//
+// Map style
+//
+
+QString BenchmarkReference::styleFileURL(const QString& fileName, const QString& serverUrl, const QString& baseMapPath, const QString& terrainMapPath)
+{
+    QFile file(fileName);
+    QByteArray data;
+    if (file.open(QIODevice::ReadOnly))
+    {
+        data = file.readAll();
+        data.replace("%URL%", (serverUrl + u"/"_s + baseMapPath).toLatin1());
+        data.replace("%URLT%", (serverUrl + u"/"_s + terrainMapPath).toLatin1());
+        data.replace("%URL2%", serverUrl.toLatin1());
+        file.close();
+    }
+
+    QTemporaryFile styleFile;
+    if (styleFile.open())
+    {
+        styleFile.write(data);
+        styleFile.close();
+    }
+    return u"file://"_s + styleFile.fileName();
+}
+
+
+//
+// Weather
+//
+
+Weather::METAR BenchmarkReference::closestMETARWithQNH(const QMap<QString, Weather::METAR>& METARs, const QGeoCoordinate& position)
+{
+    Weather::METAR closestMETARWithQNH;
+    for (auto i = METARs.cbegin(), end = METARs.cend(); i != end; ++i)
+    {
+        if (!i.value().isValid())
+        {
+            continue;
+        }
+        if (!i.value().QNH().isFinite())
+        {
+            continue;
+        }
+        if (!i.value().coordinate().isValid())
+        {
+            continue;
+        }
+        if (!closestMETARWithQNH.isValid()) {
+            closestMETARWithQNH = i.value();
+            continue;
+        }
+
+        if (position.distanceTo(i.value().coordinate()) < position.distanceTo(closestMETARWithQNH.coordinate()))
+        {
+            closestMETARWithQNH = i.value();
+        }
+    }
+    return closestMETARWithQNH;
+}
+
+
+//
+// NOTAMs
+//
+
+QList<NOTAM::NOTAM> BenchmarkReference::cleanedNOTAMs(const QList<NOTAM::NOTAM>& notams, const QSet<QString>& cancelledNotamNumbers)
+{
+    QList<NOTAM::NOTAM> result;
+    foreach(auto notam, notams)
+    {
+        if (!notam.isValid())
+        {
+            continue;
+        }
+        if (notam.isOutdated())
+        {
+            continue;
+        }
+        if (cancelledNotamNumbers.contains(notam.number()))
+        {
+            continue;
+        }
+        if (result.contains(notam))
+        {
+            continue;
+        }
+        result.append(notam);
+    }
+    return result;
+}
+
+
+//
+// File type detection
+//
+
+QString BenchmarkReference::detectFileType(const QString& fileName)
+{
+    auto file = FileFormats::DataFileAbstract::openFileURL(fileName);
+    const QString myPath = file->fileName();
+
+    QMimeDatabase const dataBase;
+    auto mimeType = dataBase.mimeTypeForData(file.data());
+
+    // Flight Route in GPX format
+    if ((mimeType.inherits(QStringLiteral("application/xml"))) || (mimeType.name() == u"application/x-gpx+xml"))
+    {
+        const FileFormats::PLN pln(fileName);
+        if (pln.isValid())
+        {
+            return u"FlightRoute"_s;
+        }
+        const FileFormats::FPL fpl(fileName);
+        if (fpl.isValid())
+        {
+            return u"FlightRoute"_s;
+        }
+        return u"FlightRouteOrWaypointLibrary"_s;
+    }
+
+    // GeoJSON file
+    auto fileContent = GeoMaps::GeoJSON::inspect(myPath);
+    if (fileContent == GeoMaps::GeoJSON::flightRoute)
+    {
+        return u"FlightRoute"_s;
+    }
+    if (fileContent == GeoMaps::GeoJSON::waypointLibrary)
+    {
+        return u"WaypointLibrary"_s;
+    }
+    if (fileContent == GeoMaps::GeoJSON::valid)
+    {
+        return u"FlightRouteOrWaypointLibrary"_s;
+    }
+
+    // FLARM Simulator file
+    if (Traffic::TrafficDataSource_File::containsFLARMSimulationData(myPath))
+    {
+        return u"FLARMSimulation"_s;
+    }
+
+    // MBTiles or PMTiles
+    auto tileFile = FileFormats::TileFileAbstract::open(myPath);
+    auto const tileFormat = tileFile->format();
+    if (tileFormat == FileFormats::TileFileAbstract::Vector)
+    {
+        return u"VectorMap"_s;
+    }
+    if (tileFormat == FileFormats::TileFileAbstract::Raster)
+    {
+        return u"RasterMap"_s;
+    }
+
+    // CUP file
+    if (FileFormats::CUP::mimeTypes().contains(mimeType.name()))
+    {
+        FileFormats::CUP const cup(myPath);
+        if (cup.isValid())
+        {
+            return u"WaypointLibrary"_s;
+        }
+    }
+
+    // VAC
+    if (GeoMaps::VAC::mimeTypes().contains(mimeType.name()))
+    {
+        const GeoMaps::VAC vac(fileName, {});
+        if (vac.isValid())
+        {
+            return u"VAC"_s;
+        }
+        return u"ImportError"_s;
+    }
+
+    // Image
+    if (mimeType.name().startsWith(u"image"_s))
+    {
+        QImage const img(myPath);
+        if (!img.isNull())
+        {
+            return u"Image"_s;
+        }
+    }
+
+    // TripKits
+    if (FileFormats::TripKit::mimeTypes().contains(mimeType.name()))
+    {
+        FileFormats::TripKit const tripKit(myPath);
+        if (tripKit.isValid())
+        {
+            return u"TripKit"_s;
+        }
+    }
+
+    // ZipFiles
+    if (FileFormats::ZipFile::mimeTypes().contains(mimeType.name()))
+    {
+        FileFormats::ZipFile const zipFile(myPath);
+        if (zipFile.isValid())
+        {
+            return u"ZipFile"_s;
+        }
+    }
+
+    // OpenAir
+    QString info;
+    if (GeoMaps::openAir::isValid(myPath, &info))
+    {
+        return u"OpenAir"_s;
+    }
+
+    return u"UnknownFunction"_s;
+}
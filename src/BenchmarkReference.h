@@ -0,0 +1,235 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QJsonDocument>
+#include <QMap>
+#include <QSet>
+#include <QStringList>
+
+#include "geomaps/Airspace.h"
+#include "geomaps/Waypoint.h"
+#include "navigation/Leg.h"
+#include "notam/NOTAM.h"
+#include "weather/METAR.h"
+
+
+/*! \brief Earlier implementations of optimized hot paths
+ *
+ *  The functions in this namespace are copies of code that has since been
+ *  replaced by faster implementations. Benchmark uses them to measure the
+ *  speedup on the same fixtures, and to check that the new implementations
+ *  produce the same results. They are not used anywhere else.
+ */
+
+namespace BenchmarkReference
+{
+
+/*! \brief Read a CSV file, as FileFormats::CSV did before it used
+ *  FileFormats::CSVReader
+ *
+ *  @param fileName Name of the CSV file
+ *
+ *  @returns Fields of all lines except the first, or an empty list if the
+ *  file cannot be opened
+ */
+QVector<QStringList> readCSV(const QString& fileName);
+
+/*! \brief Read a CUP file, as FileFormats::CUP did before it used
+ *  FileFormats::CSVReader
+ *
+ *  @param fileName Name of the CUP file
+ *
+ *  @returns Waypoints, or an empty list if the file is invalid
+ */
+QVector<GeoMaps::Waypoint> readCUP(const QString& fileName);
+
+/*! \brief Read a file in OpenAir format, as GeoMaps::openAir::parse did
+ *  before airspaces were built in linear time
+ *
+ *  @param fileName Name of the OpenAir file
+ *
+ *  @param errorList Reference to a QStringList where error messages will be appended
+ *
+ *  @param warningList Reference to a QStringList where warnings will be appended
+ *
+ *  @returns GeoJSON document
+ */
+QJsonDocument parseOpenAir(const QString& fileName, QStringList& errorList, QStringList& warningList);
+
+/*! \brief Current leg of a flight route, as Navigation::FlightRoute found it
+ *  before it used Navigation::LegTracker
+ *
+ *  @param legs Legs of the flight route
+ *
+ *  @param positionInfo Current position
+ *
+ *  @returns Index of the current leg in legs, or -1 if there is none
+ */
+qsizetype currentLeg(const QList<Navigation::Leg>& legs, const Positioning::PositionInfo& positionInfo);
+
+/*! \brief Night-mode version of a sprite sheet, as GeoMaps::TileServer
+ *  computed it before colors were looked up in a table
+ *
+ *  @param fileName Name of a PNG file, typically in the resource system
+ *
+ *  @returns PNG data
+ */
+QByteArray nightVersionOf(const QString& fileName);
+
+/*! \brief Waypoints matching a filter, as GeoMaps::GeoMapProvider found
+ *  them before it used GeoMaps::WaypointSearchIndex
+ *
+ *  @param waypoints Waypoints to search
+ *
+ *  @param filter Filter string, as typed by the user
+ *
+ *  @returns Waypoints whose name or ICAO code contains every word of the
+ *  filter, sorted by name
+ */
+QVector<GeoMaps::Waypoint> filteredWaypoints(const QVector<GeoMaps::Waypoint>& waypoints, const QString& filter);
+
+/*! \brief Nearby waypoints, as GeoMaps::GeoMapProvider found them before it
+ *  used GeoMaps::WaypointSpatialIndex
+ *
+ *  @param waypoints Waypoints to search
+ *
+ *  @param position Position near which waypoints are searched for
+ *
+ *  @param type Type of waypoints
+ *
+ *  @returns The 20 waypoints of the given type that are closest to position,
+ *  sorted by distance
+ */
+QVector<GeoMaps::Waypoint> nearbyWaypoints(const QVector<GeoMaps::Waypoint>& waypoints, const QGeoCoordinate& position, const QString& type);
+
+/*! \brief Closest waypoint, as GeoMaps::GeoMapProvider found it before it
+ *  used GeoMaps::WaypointSpatialIndex
+ *
+ *  @param waypoints Waypoints to search
+ *
+ *  @param position Position near which waypoints are searched for
+ *
+ *  @param distPosition Waypoints further away from position than
+ *  distPosition are ignored
+ *
+ *  @returns Closest waypoint, or an invalid waypoint if there is none
+ */
+GeoMaps::Waypoint closestWaypoint(const QVector<GeoMaps::Waypoint>& waypoints, const QGeoCoordinate& position, const QGeoCoordinate& distPosition);
+
+/*! \brief Waypoint library after an import, as GeoMaps::WaypointLibrary
+ *  computed it before it used GeoMaps::WaypointLibrary::addMany
+ *
+ *  @param library Waypoints in the library
+ *
+ *  @param waypoints Waypoints to import
+ *
+ *  @param skip If true, waypoints near to an existing waypoint are skipped
+ *
+ *  @returns Waypoints in the library after the import, sorted by name
+ */
+QVector<GeoMaps::Waypoint> importWaypoints(QVector<GeoMaps::Waypoint> library, const QVector<GeoMaps::Waypoint>& waypoints, bool skip);
+
+/*! \brief Merged aviation maps, as GeoMaps::GeoMapProvider computed them
+ *  before it read the files incrementally
+ */
+struct AviationData
+{
+    /*! \brief Waypoints, sorted by name */
+    QVector<GeoMaps::Waypoint> waypoints;
+
+    /*! \brief Airspaces */
+    QVector<GeoMaps::Airspace> airspaces;
+
+    /*! \brief Combined GeoJSON document */
+    QByteArray combinedGeoJSON;
+};
+
+/*! \brief Read and merge aviation maps, as GeoMaps::GeoMapProvider did
+ *  before it read the files incrementally
+ *
+ *  @param JSONFileNames Names of the GeoJSON files
+ *
+ *  @param hideGlidingSectors If true, gliding sectors are omitted from the
+ *  combined GeoJSON document
+ *
+ *  @returns Merged aviation maps
+ */
+AviationData fillAviationDataCache(QStringList JSONFileNames, bool hideGlidingSectors);
+
+/*! \brief URL of a style document, as GeoMaps::GeoMapProvider computed it
+ *  before the tile server kept the documents in memory
+ *
+ *  The style template is read and filled in, and written to a temporary
+ *  file. As before, the file is deleted when the style changes next, which
+ *  happens here when the function returns.
+ *
+ *  @param fileName Name of the style template
+ *
+ *  @param serverUrl URL of the tile server
+ *
+ *  @param baseMapPath Path of the base map on the tile server
+ *
+ *  @param terrainMapPath Path of the terrain map on the tile server
+ *
+ *  @returns URL of the temporary file
+ */
+QString styleFileURL(const QString& fileName, const QString& serverUrl, const QString& baseMapPath, const QString& terrainMapPath);
+
+/*! \brief METAR of the closest station with QNH, as
+ *  Weather::WeatherDataProvider found it before it used
+ *  Weather::QNHStationIndex
+ *
+ *  @param METARs METARs, by ICAO code
+ *
+ *  @param position Position
+ *
+ *  @returns METAR of the station closest to the position, or an invalid
+ *  METAR if there is none
+ */
+Weather::METAR closestMETARWithQNH(const QMap<QString, Weather::METAR>& METARs, const QGeoCoordinate& position);
+
+/*! \brief NOTAMs with expired and duplicated entries removed, as
+ *  NOTAM::NOTAMList::cleaned computed them before it used a hash set
+ *
+ *  @param notams NOTAMs
+ *
+ *  @param cancelledNotamNumbers Set with numbers of notams that are known
+ *  as cancelled
+ *
+ *  @returns NOTAMs with expired, cancelled and duplicated entries removed
+ */
+QList<NOTAM::NOTAM> cleanedNOTAMs(const QList<NOTAM::NOTAM>& notams, const QSet<QString>& cancelledNotamNumbers);
+
+/*! \brief File type, as Platform::FileExchange_Abstract::processFileOpenRequest
+ *  detected it before it used FileFormats::FileProbe
+ *
+ *  The checks run in the same order as before, each of them opening and
+ *  reading the file again. Instead of emitting signals, the method returns
+ *  the name of the request that would have been emitted.
+ *
+ *  @param fileName Name of the file
+ *
+ *  @returns Name of the detected file type, for instance "VectorMap"
+ */
+QString detectFileType(const QString& fileName);
+
+} // namespace BenchmarkReference
@@ -28,6 +28,7 @@
 #include "Librarian.h"
 #include "Sensors.h"
 #include "dataManagement/DataManager.h"
+#include "dataManagement/FileWriter.h"
 #include "dataManagement/SSLErrorHandler.h"
 #include "geomaps/GeoMapProvider.h"
 #include "geomaps/WaypointLibrary.h"
@@ -52,6 +53,7 @@ QPointer<DataManagement::DataManager> g_dataManager {};
 QPointer<DataManagement::SSLErrorHandler> g_sslErrorHandler {};
 QPointer<DemoRunner> g_demoRunner {};
 QPointer<Platform::FileExchange> g_fileExchange {};
+QPointer<DataManagement::FileWriter> g_fileWriter {};
 QPointer<Traffic::FlarmnetDB> g_flarmnetDB {};
 QPointer<GeoMaps::GeoMapProvider> g_geoMapProvider {};
 QPointer<Librarian> g_librarian {};
@@ -127,6 +129,9 @@ void GlobalObject::clear()
     delete g_weatherDataProvider;
     delete g_sensors;
 
+    // Delete last, because the destructor carries out pending writes
+    delete g_fileWriter;
+
     delete g_networkAccessManager;
 
     isConstructingOrDeconstructing = false;
@@ -151,6 +156,12 @@ auto GlobalObject::fileExchange() -> Platform::FileExchange*
 }
 
 
+auto GlobalObject::fileWriter() -> DataManagement::FileWriter*
+{
+    return allocateInternal<DataManagement::FileWriter>(g_fileWriter);
+}
+
+
 auto GlobalObject::flarmnetDB() -> Traffic::FlarmnetDB*
 {
     return allocateInternal<Traffic::FlarmnetDB>(g_flarmnetDB);
@@ -31,6 +31,7 @@ class Sensors;
 namespace DataManagement
 {
 class DataManager;
+class FileWriter;
 class SSLErrorHandler;
 } // namespace DataManagement
 
@@ -161,6 +162,12 @@ public:
      */
     Q_INVOKABLE static Traffic::FlarmnetDB* flarmnetDB();
 
+    /*! \brief Pointer to appplication-wide static DataManagement::FileWriter instance
+     *
+     * @returns Pointer to appplication-wide static instance.
+     */
+    Q_INVOKABLE static DataManagement::FileWriter* fileWriter();
+
     /*! \brief Pointer to appplication-wide static FileExchange instance
      *
      * @returns Pointer to appplication-wide static instance.
@@ -0,0 +1,145 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QThread>
+#include <array>
+#include <memory>
+
+#include "Trace.h"
+
+using namespace Qt::Literals::StringLiterals;
+
+
+namespace {
+
+struct Event
+{
+    const char* name {nullptr};
+    qint64 start {0};
+    qint64 end {0};
+};
+
+// Ring buffer of one thread. Only the owning thread writes to the buffer.
+struct Buffer
+{
+    static constexpr qsizetype size = 16384;
+
+    std::array<Event, size> events {};
+    std::atomic<qsizetype> count {0};
+    qsizetype threadID {0};
+    QString threadName;
+};
+
+// Buffers of all threads that ever recorded a span. Buffers outlive their
+// threads, so that spans of finished threads can still be written.
+QMutex registryMutex;
+QList<std::shared_ptr<Buffer>> registry;
+
+Buffer& threadBuffer()
+{
+    thread_local std::shared_ptr<Buffer> const buffer = []() {
+        auto result = std::make_shared<Buffer>();
+        result->threadName = QThread::currentThread()->objectName();
+        const QMutexLocker locker(&registryMutex);
+        result->threadID = registry.size() + 1;
+        registry.append(result);
+        return result;
+    }();
+    return *buffer;
+}
+
+} // namespace
+
+
+qint64 Trace::now()
+{
+    static QElapsedTimer const clock = []() {
+        QElapsedTimer result;
+        result.start();
+        return result;
+    }();
+    return clock.nsecsElapsed();
+}
+
+
+void Trace::record(const char* name, qint64 start, qint64 end)
+{
+    auto& buffer = threadBuffer();
+    auto const count = buffer.count.load(std::memory_order_relaxed);
+    buffer.events[count % Buffer::size] = {name, start, end};
+    buffer.count.store(count + 1, std::memory_order_release);
+}
+
+
+bool Trace::write(const QString& fileName)
+{
+    QJsonArray traceEvents;
+    {
+        const QMutexLocker locker(&registryMutex);
+        for (const auto& buffer : std::as_const(registry))
+        {
+            auto threadName = buffer->threadName;
+            if (threadName.isEmpty())
+            {
+                threadName = u"Thread %1"_s.arg(buffer->threadID);
+            }
+            traceEvents.append(QJsonObject {
+                {u"name"_s, u"thread_name"_s},
+                {u"ph"_s, u"M"_s},
+                {u"pid"_s, 1},
+                {u"tid"_s, buffer->threadID},
+                {u"args"_s, QJsonObject {{u"name"_s, threadName}}},
+            });
+
+            auto const count = buffer->count.load(std::memory_order_acquire);
+            for (auto i = qMax(count - Buffer::size, qsizetype(0)); i < count; i++)
+            {
+                const auto& event = buffer->events[i % Buffer::size];
+                traceEvents.append(QJsonObject {
+                    {u"name"_s, QString::fromLatin1(event.name)},
+                    {u"ph"_s, u"X"_s},
+                    {u"pid"_s, 1},
+                    {u"tid"_s, buffer->threadID},
+                    {u"ts"_s, double(event.start)/1000.0},
+                    {u"dur"_s, double(event.end - event.start)/1000.0},
+                });
+            }
+        }
+    }
+
+    QJsonObject const trace {
+        {u"traceEvents"_s, traceEvents},
+        {u"displayTimeUnit"_s, u"ms"_s},
+    };
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qWarning() << "Trace: Unable to open" << fileName << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+    return true;
+}
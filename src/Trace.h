@@ -0,0 +1,111 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <atomic>
+
+
+/*! \brief Lightweight tracing of hot paths
+ *
+ *  Functions mark their execution time by creating a Span on the stack.
+ *  When tracing is enabled, every span records its name, start and end time
+ *  in a ring buffer that belongs to the current thread, so that recording
+ *  requires no locks. When tracing is disabled, creating a span costs a
+ *  single relaxed atomic load. The recorded spans can be written in the
+ *  Chrome trace event format, which is understood by chrome://tracing and
+ *  by the Perfetto UI.
+ *
+ *  Tracing is enabled with the command line option "--trace".
+ */
+
+namespace Trace
+{
+
+/*! \brief Indicates if spans are recorded */
+inline std::atomic<bool> enabled {false};
+
+/*! \brief Time since the start of the trace clock, in nanoseconds */
+[[nodiscard]] qint64 now();
+
+/*! \brief Record a span in the ring buffer of the current thread
+ *
+ *  @param name Name of the span. The pointer must remain valid until the
+ *  trace is written; string literals are the typical choice.
+ *
+ *  @param start Start time, as returned by now()
+ *
+ *  @param end End time, as returned by now()
+ */
+void record(const char* name, qint64 start, qint64 end);
+
+/*! \brief Write recorded spans in Chrome trace event format
+ *
+ *  Each thread keeps the most recent spans only; older spans are
+ *  overwritten. Spans recorded while this method runs might be missing from
+ *  the output.
+ *
+ *  @param fileName Name of the file that will be written
+ *
+ *  @returns True on success
+ */
+bool write(const QString& fileName);
+
+
+/*! \brief Scoped span
+ *
+ *  The span starts when the object is created and ends when it is destroyed.
+ *  If tracing is not enabled when the object is created, nothing is
+ *  recorded.
+ */
+class Span
+{
+public:
+    /*! \brief Start a span
+     *
+     *  @param name Name of the span, typically a string literal. See
+     *  record() for details.
+     */
+    explicit Span(const char* name) : m_name(name)
+    {
+        if (enabled.load(std::memory_order_relaxed))
+        {
+            m_start = now();
+        }
+    }
+
+    // End the span
+    ~Span()
+    {
+        if (m_start >= 0)
+        {
+            record(m_name, m_start, now());
+        }
+    }
+
+private:
+    Q_DISABLE_COPY_MOVE(Span)
+
+    const char* m_name;
+    qint64 m_start {-1};
+};
+
+} // namespace Trace
@@ -26,13 +26,14 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QLockFile>
+#include <QSaveFile>
 #include <QSettings>
 #include <QStack>
 #include <QTemporaryDir>
 
 #include "config.h"
 #include "dataManagement/DataManager.h"
-#include "fileFormats/MBTILES.h"
+#include "fileFormats/TileFileAbstract.h"
 #include "geomaps/OpenAir.h"
 
 using namespace std::chrono_literals;
@@ -158,16 +159,18 @@ QString DataManagement::DataManager::import(const QString& fileName, const QStri
     auto path = m_dataDirectory + u"/Unsupported"_s;
     auto newFileName = path + u"/"_s + newName;
 
-    FileFormats::MBTILES mbtiles(localFile->fileName());
-    switch(mbtiles.format())
+    // PMTILES files are installed under the same file name suffixes as
+    // MBTILES; the file format is recognized from the file content.
+    auto tileFile = FileFormats::TileFileAbstract::open(localFile->fileName());
+    switch(tileFile->format())
     {
-    case FileFormats::MBTILES::Raster:
+    case FileFormats::TileFileAbstract::Raster:
         newFileName += u".raster"_s;
         break;
-    case FileFormats::MBTILES::Vector:
+    case FileFormats::TileFileAbstract::Vector:
         newFileName += u".mbtiles"_s;
         break;
-    case FileFormats::MBTILES::Unknown:
+    case FileFormats::TileFileAbstract::Unknown:
         return tr("Unable to recognize map file format.");
     }
 
@@ -195,12 +198,22 @@ QString DataManagement::DataManager::importOpenAir(const QString& fileName, cons
     auto path = m_dataDirectory + u"/Unsupported"_s;
     auto newFileName = path + u"/"_s + newName;
 
+    if (!QDir().mkpath(path))
+    {
+        return tr("Unable to create directory '%1'.").arg(path);
+    }
+    newFileName = newFileName+u".geojson"_s;
+    QSaveFile file(newFileName);
+    if (!file.open(QIODeviceBase::WriteOnly))
+    {
+        return tr("Error writing file '%1': %2.").arg(newFileName, file.errorString());
+    }
+
     QStringList errors;
     QStringList warnings;
-    auto json = GeoMaps::openAir::parse(fileName, errors, warnings);
-
-    if (!errors.isEmpty())
+    if (!GeoMaps::openAir::writeGeoJSON(fileName, file, errors, warnings))
     {
+        file.cancelWriting();
         QString info;
         info += u"<p>"_s + tr("Errors") + u"</p>"_s;
         info += u"<ul style='margin-left:-25px;'>"_s;
@@ -212,19 +225,7 @@ QString DataManagement::DataManager::importOpenAir(const QString& fileName, cons
         return info;
     }
 
-    if (!QDir().mkpath(path))
-    {
-        return tr("Unable to create directory '%1'.").arg(path);
-    }
-    newFileName = newFileName+u".geojson"_s;
-    QFile::remove(newFileName);
-    QFile file(newFileName);
-    if (file.open(QIODeviceBase::WriteOnly))
-    {
-        file.write(json.toJson());
-        file.close();
-    }
-    if (file.error() != QFileDevice::NoError)
+    if (!file.commit())
     {
         QFile::remove(newFileName);
         updateDataItemListAndWhatsNew();
@@ -38,9 +38,9 @@ namespace DataManagement {
  *  items.
  *
  *  - Aviation maps (in GeoJSON format, file name ends in "geojson")
- *  - Base maps/raster (in MBTILES format, file name ends in "mbtiles")
- *  - Base maps/vector (in MBTILES format, file name ends in "raster")
- *  - Terrain maps (in MBTILES format, file name ends in "terrain")
+ *  - Base maps/raster (in MBTILES or PMTILES format, file name ends in "mbtiles")
+ *  - Base maps/vector (in MBTILES or PMTILES format, file name ends in "raster")
+ *  - Terrain maps (in MBTILES or PMTILES format, file name ends in "terrain")
  *  - FLARM Databases (as a text file, file name ends in "data")
  *  - VAC collections (SQLite databases, file name ends in "vac")
  *
@@ -204,13 +204,14 @@ public:
     /*! \brief Import raster or vector map into the library of locally installed
      * maps
      *
-     * This method imports a raster or vector map in MBTILES format into the
-     * library of locally installed maps. To avoid clashes and inconsistencies,
-     * the map will delete all locally install vector maps when importing a
-     * raster map, and all raster maps when importing a vector map.
+     * This method imports a raster or vector map in MBTILES or PMTILES format
+     * into the library of locally installed maps. To avoid clashes and
+     * inconsistencies, the map will delete all locally install vector maps
+     * when importing a raster map, and all raster maps when importing a
+     * vector map.
      *
      * @param fileName File name of locally raster or vector map, in MBTILES
-     * format.
+     * or PMTILES format.
      *
      * @param newName Name under which the map is available in the library. If
      * the name exists, the library entry will be replaced.
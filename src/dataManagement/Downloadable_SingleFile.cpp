@@ -26,7 +26,7 @@
 #include "Downloadable_SingleFile.h"
 #include "GlobalObject.h"
 #include "GlobalSettings.h"
-#include "fileFormats/MBTILES.h"
+#include "fileFormats/TileFileAbstract.h"
 
 using namespace Qt::Literals::StringLiterals;
 
@@ -154,11 +154,11 @@ auto DataManagement::Downloadable_SingleFile::description() -> QString
         }
     }
 
-    // Extract infomation from MBTILES
+    // Extract infomation from MBTILES or PMTILES
     if (m_fileName.endsWith(u".mbtiles") || m_fileName.endsWith(u".raster") || m_fileName.endsWith(u".terrain"))
     {
-        FileFormats::MBTILES mbtiles(m_fileName);
-        result += u"<p>"_s + mbtiles.info() + u"</p>"_s;
+        auto tileFile = FileFormats::TileFileAbstract::open(m_fileName);
+        result += u"<p>"_s + tileFile->info() + u"</p>"_s;
     }
 
     // Extract infomation from text file - this is simply the first line
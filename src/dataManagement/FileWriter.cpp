@@ -0,0 +1,149 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+
+#include "dataManagement/FileWriter.h"
+
+using namespace std::chrono_literals;
+
+
+namespace {
+
+// Pending writes start once no further write has been scheduled for this long
+constexpr auto debounceInterval = 500ms;
+
+// Pending writes start at most this long after the first of them was
+// scheduled, even if further writes keep being scheduled
+constexpr auto maximalDelay = 2000ms;
+
+} // namespace
+
+
+DataManagement::FileWriter::FileWriter(QObject* parent)
+    : GlobalObject(parent)
+{
+    m_threadPool.setMaxThreadCount(1);
+
+    m_delayTimer.setSingleShot(true);
+    connect(&m_delayTimer, &QTimer::timeout, this, &DataManagement::FileWriter::startPendingJobs);
+
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &DataManagement::FileWriter::flush);
+}
+
+
+DataManagement::FileWriter::~FileWriter()
+{
+    flush();
+}
+
+
+//
+// Methods
+//
+
+void DataManagement::FileWriter::schedule(const QString& fileName, std::function<QByteArray()> serializer)
+{
+    m_scheduledCount++;
+
+    auto iterator = m_pendingJobs.find(fileName);
+    if (iterator != m_pendingJobs.end())
+    {
+        iterator->serializer = std::move(serializer);
+    }
+    else
+    {
+        QElapsedTimer scheduled;
+        scheduled.start();
+        m_pendingJobs.insert(fileName, {fileName, std::move(serializer), scheduled});
+    }
+
+    // Restart the timer on every call, but never beyond maximalDelay after
+    // the first pending write was scheduled
+    if (!m_pendingSince.isValid())
+    {
+        m_pendingSince.start();
+    }
+    auto const remaining = maximalDelay - std::chrono::milliseconds(m_pendingSince.elapsed());
+    m_delayTimer.start(std::clamp<std::chrono::milliseconds>(remaining, 0ms, debounceInterval));
+}
+
+void DataManagement::FileWriter::flush()
+{
+    startPendingJobs();
+    m_threadPool.waitForDone();
+}
+
+
+//
+// Private Methods
+//
+
+void DataManagement::FileWriter::startPendingJobs()
+{
+    m_delayTimer.stop();
+    m_pendingSince.invalidate();
+    if (m_pendingJobs.isEmpty())
+    {
+        return;
+    }
+
+    auto jobs = m_pendingJobs.values();
+    m_pendingJobs.clear();
+    QtConcurrent::run(&m_threadPool, &DataManagement::FileWriter::write, jobs).then(this, [this](const QList<qint64>& latencies) {
+        for (auto latency : latencies)
+        {
+            m_writeCount++;
+            m_lastLatency = latency;
+            m_maxLatency = qMax(m_maxLatency, latency);
+        }
+        emit statisticsChanged();
+    });
+}
+
+QList<qint64> DataManagement::FileWriter::write(const QList<Job>& jobs)
+{
+    QList<qint64> latencies;
+    for (const auto& job : jobs)
+    {
+        auto const data = job.serializer();
+
+        QDir().mkpath(QFileInfo(job.fileName).path());
+        QSaveFile file(job.fileName);
+        if (!file.open(QIODevice::WriteOnly))
+        {
+            qWarning() << "FileWriter: Unable to open" << job.fileName << file.errorString();
+            continue;
+        }
+        file.write(data);
+        if (!file.commit())
+        {
+            qWarning() << "FileWriter: Unable to write" << job.fileName << file.errorString();
+            continue;
+        }
+        latencies.append(job.scheduled.elapsed());
+    }
+    return latencies;
+}
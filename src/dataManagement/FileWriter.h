@@ -0,0 +1,181 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QThreadPool>
+#include <QTimer>
+#include <functional>
+
+#include "GlobalObject.h"
+
+namespace DataManagement
+{
+
+/*! \brief Write-behind persistence for small data files
+ *
+ *  This class saves files such as the waypoint library, the current flight
+ *  route or the current aircraft, without blocking the GUI thread. Callers
+ *  schedule a write by handing over a file name and a serializer, which
+ *  typically captures a copy of the data. Writes start once no further write
+ *  has been scheduled for half a second, but no later than two seconds after
+ *  the first pending write was scheduled. Writes to the same file that are
+ *  scheduled in the meantime are coalesced, so that only the last one is
+ *  carried out. Serialization and writing happen in a background thread, and
+ *  files are written atomically with QSaveFile.
+ *
+ *  Pending writes are carried out before the application quits, and when
+ *  the instance is destroyed.
+ */
+
+class FileWriter : public GlobalObject
+{
+    Q_OBJECT
+
+public:
+    /*! \brief Standard constructor
+     *
+     *  @param parent The standard QObject parent pointer.
+     */
+    explicit FileWriter(QObject* parent = nullptr);
+
+    /*! \brief Destructor
+     *
+     *  The destructor calls flush().
+     */
+    ~FileWriter() override;
+
+
+    //
+    // Properties
+    //
+
+    /*! \brief Number of writes scheduled so far */
+    Q_PROPERTY(int scheduledCount READ scheduledCount NOTIFY statisticsChanged)
+
+    /*! \brief Number of files written so far */
+    Q_PROPERTY(int writeCount READ writeCount NOTIFY statisticsChanged)
+
+    /*! \brief Latency of the last write
+     *
+     *  This property holds the time, in milliseconds, between the first
+     *  scheduling of the last write and its completion.
+     */
+    Q_PROPERTY(qint64 lastLatency READ lastLatency NOTIFY statisticsChanged)
+
+    /*! \brief Maximal latency of all writes so far, in milliseconds */
+    Q_PROPERTY(qint64 maxLatency READ maxLatency NOTIFY statisticsChanged)
+
+
+    //
+    // Getter Methods
+    //
+
+    /*! \brief Getter function for the property with the same name
+     *
+     *  @returns Property scheduledCount
+     */
+    [[nodiscard]] int scheduledCount() const { return m_scheduledCount; }
+
+    /*! \brief Getter function for the property with the same name
+     *
+     *  @returns Property writeCount
+     */
+    [[nodiscard]] int writeCount() const { return m_writeCount; }
+
+    /*! \brief Getter function for the property with the same name
+     *
+     *  @returns Property lastLatency
+     */
+    [[nodiscard]] qint64 lastLatency() const { return m_lastLatency; }
+
+    /*! \brief Getter function for the property with the same name
+     *
+     *  @returns Property maxLatency
+     */
+    [[nodiscard]] qint64 maxLatency() const { return m_maxLatency; }
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Schedule a write
+     *
+     *  @param fileName Name of the file to be written
+     *
+     *  @param serializer Function that computes the file content. The
+     *  function is called in a background thread and must therefore not
+     *  access any QObject. Typically, it captures a copy of the data.
+     */
+    void schedule(const QString& fileName, std::function<QByteArray()> serializer);
+
+    /*! \brief Carry out all pending writes
+     *
+     *  This method blocks until all writes scheduled so far are complete.
+     */
+    void flush();
+
+signals:
+    /*! \brief Notification signal for the statistics properties */
+    void statisticsChanged();
+
+private:
+    Q_DISABLE_COPY_MOVE(FileWriter)
+
+    struct Job
+    {
+        QString fileName;
+        std::function<QByteArray()> serializer;
+        QElapsedTimer scheduled;
+    };
+
+    // Hands all pending jobs over to m_threadPool
+    void startPendingJobs();
+
+    // Serializes and writes the files. Returns the latencies of the
+    // successful writes. This method is run in m_threadPool.
+    static QList<qint64> write(const QList<Job>& jobs);
+
+    // Pending jobs, by file name
+    QHash<QString, Job> m_pendingJobs;
+
+    // Starts the pending writes. The timer is restarted whenever a write is
+    // scheduled.
+    QTimer m_delayTimer;
+
+    // Time since the first pending write was scheduled. Invalid if there are
+    // no pending writes.
+    QElapsedTimer m_pendingSince;
+
+    // Pool with a single thread, so that writes are carried out in the order
+    // in which they were started
+    QThreadPool m_threadPool;
+
+    // Statistics
+    int m_scheduledCount {0};
+    int m_writeCount {0};
+    qint64 m_lastLatency {0};
+    qint64 m_maxLatency {0};
+};
+
+} // namespace DataManagement
@@ -18,113 +18,10 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
-#include <QFile>
-#include <QTextStream>
-
 #include "fileFormats/CSV.h"
-
+#include "fileFormats/CSVReader.h"
 #include "fileFormats/DataFileAbstract.h"
 
-//
-// Private helper functions
-//
-
-QStringList FileFormats::CSV::parseCSV(const QString& string)
-{
-    // Thanks to https://stackoverflow.com/questions/27318631/parsing-through-a-csv-file-in-qt
-
-    enum State : quint8
-    {
-        Normal,
-        Quote
-    } state = Normal;
-    QStringList fields;
-    fields.reserve(10);
-    QString value;
-
-    for (int i = 0; i < string.size(); i++)
-    {
-        const QChar current = string.at(i);
-
-        // Normal state
-        if (state == Normal)
-        {
-            // Comma
-            if (current == ',')
-            {
-                // Save field
-                fields.append(value.trimmed());
-                value.clear();
-            }
-
-            // Double-quote
-            else if (current == '"')
-            {
-                state = Quote;
-                value += current;
-            }
-
-            // Other character
-            else
-            {
-                value += current;
-            }
-        }
-
-        // In-quote state
-        else if (state == Quote)
-        {
-            // Another double-quote
-            if (current == '"')
-            {
-                if (i < string.size())
-                {
-                    // A double double-quote?
-                    if (i + 1 < string.size() && string.at(i + 1) == '"')
-                    {
-                        value += '"';
-
-                        // Skip a second quote character in a row
-                        i++;
-                    }
-                    else
-                    {
-                        state = Normal;
-                        value += '"';
-                    }
-                }
-            }
-
-            // Other character
-            else
-            {
-                value += current;
-            }
-        }
-    }
-
-    if (!value.isEmpty())
-    {
-        fields.append(value.trimmed());
-    }
-
-    // Quotes are left in until here; so when fields are trimmed, only whitespace outside of
-    // quotes is removed.  The outermost quotes are removed here.
-    for (auto &field : fields)
-    {
-        if (field.length() >= 1 && field.at(0) == '"')
-        {
-            field = field.mid(1);
-            if (field.length() >= 1 && field.right(1) == '"')
-            {
-                field = field.left(field.length() - 1);
-            }
-        }
-    }
-
-    return fields;
-}
-
 
 FileFormats::CSV::CSV(const QString& fileName)
 {
@@ -136,11 +33,16 @@ FileFormats::CSV::CSV(const QString& fileName)
         return;
     }
 
-    QTextStream stream(file.data());
-    QString line;
-    stream.readLineInto(&line);
-    while (stream.readLineInto(&line))
+    CSVReader reader(file->readAll());
+    reader.readRecord();
+    while (reader.readRecord())
     {
-        m_lines << parseCSV(line);
+        QStringList fields;
+        fields.reserve(reader.size());
+        for (qsizetype i = 0; i < reader.size(); i++)
+        {
+            fields << reader.field(i);
+        }
+        m_lines << fields;
     }
 }
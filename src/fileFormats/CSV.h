@@ -69,9 +69,6 @@ namespace FileFormats
         [[nodiscard]] static QStringList mimeTypes() { return {u"text/csv"_s, u"text/plain"_s}; }
 
     private:
-        // Private helper functions
-        static QStringList parseCSV(const QString& string);
-
         QVector<QStringList> m_lines;
     };
 
@@ -0,0 +1,189 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <QStringConverter>
+
+#include "fileFormats/CSVReader.h"
+
+
+FileFormats::CSVReader::CSVReader(const QByteArray& data)
+    : m_data(data)
+{
+    // Handle byte order marks, as QTextStream does
+    auto encoding = QStringConverter::encodingForData(m_data);
+    if (!encoding.has_value() || (encoding.value() == QStringConverter::Utf8))
+    {
+        if (m_data.startsWith("\xEF\xBB\xBF"))
+        {
+            m_position = 3;
+        }
+        return;
+    }
+    QStringDecoder decoder(encoding.value());
+    QString const string = decoder(m_data);
+    m_data = string.toUtf8();
+}
+
+
+//
+// Methods
+//
+
+bool FileFormats::CSVReader::readRecord()
+{
+    m_fields.clear();
+
+    auto const size = m_data.size();
+    if (m_position >= size)
+    {
+        return false;
+    }
+
+    const char* data = m_data.constData();
+    auto begin = m_position;
+    auto position = m_position;
+    bool quote = false;
+    bool hasDoubledQuotes = false;
+    while (position < size)
+    {
+        auto const character = data[position];
+        if (quote)
+        {
+            if (character == '"')
+            {
+                if ((position + 1 < size) && (data[position + 1] == '"'))
+                {
+                    hasDoubledQuotes = true;
+                    position += 2;
+                    continue;
+                }
+                quote = false;
+            }
+            position++;
+            continue;
+        }
+
+        if (character == ',')
+        {
+            m_fields.append({QByteArrayView(data + begin, position - begin), hasDoubledQuotes});
+            position++;
+            begin = position;
+            hasDoubledQuotes = false;
+            continue;
+        }
+        if (character == '"')
+        {
+            quote = true;
+            position++;
+            continue;
+        }
+        if (character == '\n')
+        {
+            m_position = position + 1;
+            if ((position > begin) && (data[position - 1] == '\r'))
+            {
+                position--;
+            }
+            if (position > begin)
+            {
+                m_fields.append({QByteArrayView(data + begin, position - begin), hasDoubledQuotes});
+            }
+            return true;
+        }
+        position++;
+    }
+
+    // Last record, without line break
+    m_position = size;
+    if (position > begin)
+    {
+        m_fields.append({QByteArrayView(data + begin, position - begin), hasDoubledQuotes});
+    }
+    return true;
+}
+
+QString FileFormats::CSVReader::field(qsizetype index) const
+{
+    const auto& field = m_fields.at(index);
+
+    QString result;
+    if (field.hasDoubledQuotes)
+    {
+        // Collapse doubled quotes inside quoted sections, leaving all other
+        // quotes in place
+        QByteArray bytes;
+        bytes.reserve(field.raw.size());
+        bool quote = false;
+        for (qsizetype position = 0; position < field.raw.size(); position++)
+        {
+            auto const character = field.raw.at(position);
+            if (character == '"')
+            {
+                if (quote && (position + 1 < field.raw.size()) && (field.raw.at(position + 1) == '"'))
+                {
+                    bytes += '"';
+                    position++;
+                    continue;
+                }
+                quote = !quote;
+            }
+            bytes += character;
+        }
+        result = QString::fromUtf8(bytes);
+    }
+    else
+    {
+        result = QString::fromUtf8(field.raw);
+    }
+
+    // Quotes are left in until here; so when fields are trimmed, only
+    // whitespace outside of quotes is removed. The outermost quotes are
+    // removed here.
+    result = result.trimmed();
+    if (result.startsWith(u'"'))
+    {
+        result.remove(0, 1);
+        if (result.endsWith(u'"'))
+        {
+            result.chop(1);
+        }
+    }
+    return result;
+}
+
+QByteArrayView FileFormats::CSVReader::fieldBytes(qsizetype index) const
+{
+    const auto& field = m_fields.at(index);
+    if (field.hasDoubledQuotes)
+    {
+        return {};
+    }
+
+    auto result = field.raw.trimmed();
+    if (result.startsWith('"'))
+    {
+        result = result.sliced(1);
+        if (result.endsWith('"'))
+        {
+            result.chop(1);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,123 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+#include <QVarLengthArray>
+
+
+namespace FileFormats
+{
+
+/*! \brief Byte-level CSV tokenizer
+ *
+ *  This class splits CSV data, as described in RFC 4180, into records and
+ *  fields. It works on the raw UTF-8 bytes and does not copy them: fields are
+ *  views into the data, and are decoded only when field() is called. Data
+ *  in UTF-16 or UTF-32 with byte order mark is converted to UTF-8 once, in
+ *  the constructor.
+ *
+ *  The values returned by field() are those that earlier, line-based
+ *  versions of this program computed: whitespace around fields is removed,
+ *  outer quotes are removed, and doubled quotes inside quoted sections are
+ *  collapsed. An empty last field is dropped, so that a trailing comma does
+ *  not produce a field. Line breaks inside quoted sections belong to the
+ *  field.
+ */
+
+class CSVReader
+{
+public:
+    /*! \brief Constructor
+     *
+     *  @param data CSV data, typically the content of a file
+     */
+    explicit CSVReader(const QByteArray& data);
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Advance to the next record
+     *
+     *  @returns False if the end of the data has been reached. Empty lines
+     *  are returned as records without fields.
+     */
+    bool readRecord();
+
+    /*! \brief Number of fields in the current record
+     *
+     *  @returns Number of fields
+     */
+    [[nodiscard]] qsizetype size() const { return m_fields.size(); }
+
+    /*! \brief Field of the current record
+     *
+     *  @param index Index of the field, must be in the range [0, size())
+     *
+     *  @returns Decoded field value
+     */
+    [[nodiscard]] QString field(qsizetype index) const;
+
+    /*! \brief Field of the current record, as bytes
+     *
+     *  This method is meant for fast paths that parse numbers or fixed-format
+     *  data without decoding. Only ASCII whitespace is removed, so the result
+     *  agrees with the UTF-8 encoding of field() whenever it consists of
+     *  printable ASCII characters. Callers whose fast path fails should fall
+     *  back to field().
+     *
+     *  @param index Index of the field, must be in the range [0, size())
+     *
+     *  @returns View of the field, without surrounding whitespace and outer
+     *  quotes. Empty if the field contains doubled quotes.
+     */
+    [[nodiscard]] QByteArrayView fieldBytes(qsizetype index) const;
+
+    /*! \brief Raw field of the current record
+     *
+     *  @param index Index of the field, must be in the range [0, size())
+     *
+     *  @returns View of the field, exactly as it appears in the data
+     */
+    [[nodiscard]] QByteArrayView rawField(qsizetype index) const { return m_fields.at(index).raw; }
+
+private:
+    struct Field
+    {
+        QByteArrayView raw;
+        bool hasDoubledQuotes {false};
+    };
+
+    // CSV data, in UTF-8
+    QByteArray m_data;
+
+    // Position of the next record in m_data
+    qsizetype m_position {0};
+
+    // Fields of the current record
+    QVarLengthArray<Field, 16> m_fields;
+};
+
+} // namespace FileFormats
@@ -21,7 +21,7 @@
 #include <QFile>
 #include <cmath>
 
-#include "fileFormats/CSV.h"
+#include "fileFormats/CSVReader.h"
 #include "fileFormats/CUP.h"
 
 using namespace Qt::Literals::StringLiterals;
@@ -31,113 +31,196 @@ using namespace Qt::Literals::StringLiterals;
 // Private helper functions
 //
 
-GeoMaps::Waypoint FileFormats::CUP::readWaypoint(const QStringList& fields)
+bool FileFormats::CUP::readCoordinate(QByteArrayView bytes, qsizetype degreeDigits, char positive, char negative, double& result)
 {
-    if (fields.size() < 6)
+    // Fixed format: degreeDigits digits for the degrees, then "MM.mmm", then
+    // the hemisphere. The minutes are read as an integer number of
+    // thousandths and divided by 1000, which gives the same correctly rounded
+    // double as QString::toDouble.
+    if (bytes.size() != degreeDigits + 7)
     {
-        return {};
+        return false;
     }
-
-    // Get Name
-    const auto &name = fields[0];
-
-    // Get Latitude
-    double lat = NAN;
+    auto const hemisphere = bytes.at(degreeDigits + 6);
+    if ((hemisphere != positive) && (hemisphere != negative))
     {
-        auto latString = fields[3];
-        if (latString.size() != 9)
-        {
-            return {};
-        }
-        if ((latString[8] != 'N') && (latString[8] != 'S'))
+        return false;
+    }
+    int degrees = 0;
+    int thousandthMinutes = 0;
+    for (qsizetype i = 0; i < degreeDigits + 6; i++)
+    {
+        auto const character = bytes.at(i);
+        if (i == degreeDigits + 2)
         {
-            return {};
+            if (character != '.')
+            {
+                return false;
+            }
+            continue;
         }
-        bool ok = false;
-        lat = latString.left(2).toDouble(&ok);
-        if (!ok)
+        if ((character < '0') || (character > '9'))
         {
-            return {};
+            return false;
         }
-        lat = lat + latString.mid(2, 6).toDouble(&ok) / 60.0;
-        if (!ok)
+        if (i < degreeDigits)
         {
-            return {};
+            degrees = (10 * degrees) + (character - '0');
         }
-        if (latString[8] == 'S')
+        else
         {
-            lat = -lat;
+            thousandthMinutes = (10 * thousandthMinutes) + (character - '0');
         }
     }
+    result = degrees + ((thousandthMinutes / 1000.0) / 60.0);
+    if (hemisphere == negative)
+    {
+        result = -result;
+    }
+    return true;
+}
 
-    // Get Longitude
-    double lon = NAN;
+bool FileFormats::CUP::readCoordinate(const QString& string, qsizetype degreeDigits, char positive, char negative, double& result)
+{
+    if (string.size() != degreeDigits + 7)
     {
-        auto longString = fields[4];
-        if (longString.size() != 10)
-        {
-            return {};
-        }
-        if ((longString[9] != 'W') && (longString[9] != 'E'))
-        {
-            return {};
-        }
-        bool ok = false;
-        lon = longString.left(3).toDouble(&ok);
-        if (!ok)
-        {
-            return {};
-        }
-        lon = lon + longString.mid(3, 6).toDouble(&ok) / 60.0;
-        if (!ok)
-        {
-            return {};
-        }
-        if (longString[9] == 'W')
+        return false;
+    }
+    auto const hemisphere = string[degreeDigits + 6];
+    if ((hemisphere != QChar(positive)) && (hemisphere != QChar(negative)))
+    {
+        return false;
+    }
+    bool ok = false;
+    result = string.left(degreeDigits).toDouble(&ok);
+    if (!ok)
+    {
+        return false;
+    }
+    result = result + string.mid(degreeDigits, 6).toDouble(&ok) / 60.0;
+    if (!ok)
+    {
+        return false;
+    }
+    if (hemisphere == QChar(negative))
+    {
+        result = -result;
+    }
+    return true;
+}
+
+bool FileFormats::CUP::readElevation(QByteArrayView bytes, double& result)
+{
+    // Only plain decimal numbers take the fast path
+    double factor = 1.0;
+    if (bytes.endsWith("m"))
+    {
+        bytes.chop(1);
+    }
+    else if (bytes.endsWith("ft"))
+    {
+        bytes.chop(2);
+        factor = 0.3048;
+    }
+    else
+    {
+        return false;
+    }
+    if (bytes.isEmpty())
+    {
+        return false;
+    }
+    for (auto character : bytes)
+    {
+        if (((character < '0') || (character > '9')) && (character != '.') && (character != '-') && (character != '+'))
         {
-            lon = -lon;
+            return false;
         }
     }
+    bool ok = false;
+    result = bytes.toDouble(&ok);
+    if (!ok)
+    {
+        return false;
+    }
+    if (factor != 1.0)
+    {
+        result = result * factor;
+    }
+    return true;
+}
+
+bool FileFormats::CUP::readElevation(const QString& string, double& result)
+{
+    bool ok = false;
+    if (string.endsWith(u"m"))
+    {
+        result = string.chopped(1).toDouble(&ok);
+    }
+    if (string.endsWith(u"ft"))
+    {
+        result = string.chopped(2).toDouble(&ok) * 0.3048;
+    }
+    return ok;
+}
 
+GeoMaps::Waypoint FileFormats::CUP::readWaypoint(const CSVReader& reader)
+{
+    if (reader.size() < 6)
+    {
+        return {};
+    }
+
+    // Get Latitude, Longitude and Elevation. Try the fast path on raw bytes
+    // first, and fall back to decoded strings if that fails.
+    double lat = NAN;
+    if (!readCoordinate(reader.fieldBytes(3), 2, 'N', 'S', lat) && !readCoordinate(reader.field(3), 2, 'N', 'S', lat))
+    {
+        return {};
+    }
+    double lon = NAN;
+    if (!readCoordinate(reader.fieldBytes(4), 3, 'E', 'W', lon) && !readCoordinate(reader.field(4), 3, 'E', 'W', lon))
+    {
+        return {};
+    }
     double ele = NAN;
+    if (!readElevation(reader.fieldBytes(5), ele) && !readElevation(reader.field(5), ele))
     {
-        const auto &eleString = fields[5];
-        bool ok = false;
-        if (eleString.endsWith(u"m"))
-        {
-            ele = eleString.chopped(1).toDouble(&ok);
-        }
-        if (eleString.endsWith(u"ft"))
-        {
-            ele = eleString.chopped(2).toDouble(&ok) * 0.3048;
-        }
-        if (!ok)
-        {
-            return {};
-        }
+        return {};
     }
 
     // Get additional information
     QStringList notes;
-    if ((fields.size() >= 8) && (!fields[7].isEmpty()))
+    if (reader.size() >= 8)
     {
-        notes += QObject::tr("Direction: %1°", "GeoMaps::CUP").arg(fields[7]);
-    }
-    if ((fields.size() >= 9) && (!fields[8].isEmpty()))
-    {
-        notes += QObject::tr("Length: %1", "GeoMaps::CUP").arg(fields[8]);
+        auto const direction = reader.field(7);
+        if (!direction.isEmpty())
+        {
+            notes += QObject::tr("Direction: %1°", "GeoMaps::CUP").arg(direction);
+        }
     }
-    if ((fields.size() >= 11) && (!fields[10].isEmpty()))
+    if (reader.size() >= 9)
     {
-        notes += fields[10];
+        auto const length = reader.field(8);
+        if (!length.isEmpty())
+        {
+            notes += QObject::tr("Length: %1", "GeoMaps::CUP").arg(length);
+        }
     }
-    if ((fields.size() >= 12) && (!fields[11].isEmpty()))
+    for (qsizetype index : {10, 11})
     {
-        notes += fields[11];
+        if (reader.size() > index)
+        {
+            auto const note = reader.field(index);
+            if (!note.isEmpty())
+            {
+                notes += note;
+            }
+        }
     }
 
     GeoMaps::Waypoint result(QGeoCoordinate(lat, lon, ele));
-    result.setName(name);
+    result.setName(reader.field(0));
     if (!notes.isEmpty())
     {
         result.setNotes(notes.join(u" • "_s));
@@ -145,26 +228,43 @@ GeoMaps::Waypoint FileFormats::CUP::readWaypoint(const QStringList& fields)
     return result;
 }
 
+bool FileFormats::CUP::isRelatedTasksMarker(const CSVReader& reader)
+{
+    // The decoded field can only equal the marker if the raw field contains
+    // it, so most fields are never decoded
+    static const QByteArray marker("-----Related Tasks-----");
+    for (qsizetype i = 0; i < reader.size(); i++)
+    {
+        if (reader.rawField(i).contains(marker) && (reader.field(i) == QString::fromLatin1(marker)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 
 FileFormats::CUP::CUP(const QString& fileName)
 {
-    CSV const csv(fileName);
-
-    if (!csv.isValid())
+    auto file = FileFormats::DataFileAbstract::openFileURL(fileName);
+    if (!file->open(QIODevice::ReadOnly))
     {
-        setError(csv.error());
+        setError(QObject::tr("Cannot open CSV file %1 for reading.", "FileFormats::CSV").arg(fileName));
         return;
     }
 
+    // Read records one by one, skipping the header line
+    CSVReader reader(file->readAll());
+    reader.readRecord();
     int lineNumber = 0;
-    foreach (auto& line, csv.lines())
+    while (reader.readRecord())
     {
         lineNumber++;
-        if (line.contains(u"-----Related Tasks-----"))
+        if (isRelatedTasksMarker(reader))
         {
             break;
         }
-        auto waypoint = readWaypoint(line);
+        auto waypoint = readWaypoint(reader);
         if (!waypoint.isValid())
         {
             setError(QObject::tr("Error reading line %1 in the CUP file %2.", "FileFormats::CUP").arg(lineNumber).arg(fileName));
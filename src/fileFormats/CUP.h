@@ -21,6 +21,7 @@
 #pragma once
 
 #include "fileFormats/CSV.h"
+#include "fileFormats/CSVReader.h"
 #include "fileFormats/DataFileAbstract.h"
 #include "geomaps/Waypoint.h"
 
@@ -71,8 +72,17 @@ namespace FileFormats
 
     private:
         // Private helper functions
-        static QStringList parseCSV(const QString& string);
-        static GeoMaps::Waypoint readWaypoint(const QStringList& fields);
+        static GeoMaps::Waypoint readWaypoint(const CSVReader& reader);
+        static bool isRelatedTasksMarker(const CSVReader& reader);
+
+        // Read coordinates in the fixed formats DDMM.mmmN and DDDMM.mmmE,
+        // and elevations such as "512m" or "1680ft". The overloads for bytes
+        // are fast paths that accept plain ASCII digits only, the overloads
+        // for strings accept everything that QString::toDouble accepts.
+        static bool readCoordinate(QByteArrayView bytes, qsizetype degreeDigits, char positive, char negative, double& result);
+        static bool readCoordinate(const QString& string, qsizetype degreeDigits, char positive, char negative, double& result);
+        static bool readElevation(QByteArrayView bytes, double& result);
+        static bool readElevation(const QString& string, double& result);
 
 
         QVector<GeoMaps::Waypoint> m_waypoints;
@@ -0,0 +1,289 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <QImage>
+#include <QSaveFile>
+#include <QtEndian>
+#include <QtMath>
+#include <algorithm>
+#include <cstring>
+
+#include "fileFormats/DEM.h"
+#include "fileFormats/TileFileAbstract.h"
+
+using namespace Qt::Literals::StringLiterals;
+
+
+namespace {
+
+// Layout of the header
+constexpr qsizetype headerLength = 32;
+constexpr quint32 version = 1;
+
+// Offset of the tile data, for an index with the given number of entries
+qsizetype tileDataOffset(qint64 numEntries)
+{
+    auto const end = headerLength + 4*numEntries;
+    return (end + 7) & ~static_cast<qint64>(7);
+}
+
+} // namespace
+
+
+FileFormats::DEM::DEM(const QString& fileName)
+{
+    m_file = openFileURL(fileName);
+    if (!m_file->open(QIODeviceBase::ReadOnly))
+    {
+        setError(QObject::tr("Unable to open DEM file.", "FileFormats::DEM"));
+        return;
+    }
+    auto const size = m_file->size();
+    const uchar* data = (size >= headerLength) ? m_file->map(0, size) : nullptr;
+    if (data == nullptr)
+    {
+        setError(QObject::tr("Unable to map DEM file into memory.", "FileFormats::DEM"));
+        return;
+    }
+
+    // Read header
+    if ((memcmp(data, "EDEM", 4) != 0) || (qFromLittleEndian<quint32>(data+4) != version))
+    {
+        setError(QObject::tr("File is not a DEM file, or was written by a different version of this program.", "FileFormats::DEM"));
+        return;
+    }
+    auto const zoom = qFromLittleEndian<qint32>(data+8);
+    auto const tileSize = qFromLittleEndian<qint32>(data+12);
+    auto const minX = qFromLittleEndian<qint32>(data+16);
+    auto const minY = qFromLittleEndian<qint32>(data+20);
+    auto const numX = qFromLittleEndian<qint32>(data+24);
+    auto const numY = qFromLittleEndian<qint32>(data+28);
+    if ((zoom < 0) || (zoom > 24) || (tileSize < 2) || (tileSize > 4096)
+        || (minX < 0) || (minY < 0) || (numX < 1) || (numY < 1)
+        || (minX+numX > (1 << zoom)) || (minY+numY > (1 << zoom)))
+    {
+        setError(QObject::tr("DEM file is damaged.", "FileFormats::DEM"));
+        return;
+    }
+
+    // Check that the index and all tiles lie within the file
+    auto const numEntries = static_cast<qint64>(numX)*numY;
+    auto const dataOffset = tileDataOffset(numEntries);
+    if (size < dataOffset)
+    {
+        setError(QObject::tr("DEM file is damaged.", "FileFormats::DEM"));
+        return;
+    }
+    quint32 maxTile = 0;
+    for(qint64 i = 0; i < numEntries; i++)
+    {
+        maxTile = qMax(maxTile, qFromLittleEndian<quint32>(data + headerLength + 4*i));
+    }
+    if (size < dataOffset + static_cast<qint64>(maxTile)*2*tileSize*tileSize)
+    {
+        setError(QObject::tr("DEM file is damaged.", "FileFormats::DEM"));
+        return;
+    }
+
+    m_zoom = zoom;
+    m_tileSize = tileSize;
+    m_minX = minX;
+    m_minY = minY;
+    m_numX = numX;
+    m_numY = numY;
+    m_index = data + headerLength;
+    m_tileData = data + dataOffset;
+}
+
+
+//
+// Methods
+//
+
+Units::Distance FileFormats::DEM::elevation(const QGeoCoordinate& coordinate) const
+{
+    if ((m_zoom < 0) || !coordinate.isValid())
+    {
+        return {};
+    }
+
+    // Tile coordinates
+    auto const scale = static_cast<double>(1 << m_zoom);
+    auto const tileX = (coordinate.longitude()+180.0)/360.0 * scale;
+    auto const tileY = (1.0 - asinh(tan(qDegreesToRadians(coordinate.latitude())))/M_PI)/2.0 * scale;
+    if (!qIsFinite(tileX) || !qIsFinite(tileY))
+    {
+        return {};
+    }
+    auto const column = qFloor(tileX) - m_minX;
+    auto const row = qFloor(tileY) - m_minY;
+    if ((column < 0) || (column >= m_numX) || (row < 0) || (row >= m_numY))
+    {
+        return {};
+    }
+    auto const tileNumber = qFromLittleEndian<quint32>(m_index + 4*(static_cast<qint64>(row)*m_numX + column));
+    if (tileNumber == 0)
+    {
+        return {};
+    }
+    const uchar* tile = m_tileData + static_cast<qint64>(tileNumber-1)*2*m_tileSize*m_tileSize;
+
+    // Position within the tile. As with the PNG tiles, the samples at the
+    // tile edges correspond to the tile boundaries.
+    auto const x = (tileX - qFloor(tileX)) * (m_tileSize-1);
+    auto const y = (tileY - qFloor(tileY)) * (m_tileSize-1);
+    auto const x0 = qFloor(x);
+    auto const y0 = qFloor(y);
+    auto const x1 = qMin(qCeil(x), m_tileSize-1);
+    auto const y1 = qMin(qCeil(y), m_tileSize-1);
+    auto const t = x - x0;
+    auto const u = y - y0;
+    auto sample = [&](int sx, int sy) {
+        return static_cast<double>(qFromLittleEndian<qint16>(tile + 2*(static_cast<qint64>(sy)*m_tileSize + sx)));
+    };
+
+    return Units::Distance::fromM((1-t)*(1-u)*sample(x0, y0) + t*(1-u)*sample(x1, y0) + t*u*sample(x1, y1) + (1-t)*u*sample(x0, y1));
+}
+
+QList<Units::Distance> FileFormats::DEM::elevations(const QList<QGeoCoordinate>& coordinates) const
+{
+    QList<Units::Distance> result;
+    result.reserve(coordinates.size());
+    for(const auto& coordinate : coordinates)
+    {
+        result.append(elevation(coordinate));
+    }
+    return result;
+}
+
+QString FileFormats::DEM::fromTerrainTiles(const QString& terrainFileName, const QString& demFileName, int maxZoom)
+{
+    auto tiles = TileFileAbstract::open(terrainFileName);
+    if (!tiles->isValid())
+    {
+        return tiles->error();
+    }
+
+    // Find tiles of the highest zoom level up to maxZoom
+    auto coordinates = tiles->tileCoordinates();
+    int zoom = -1;
+    for(const auto& tileCoordinates : std::as_const(coordinates))
+    {
+        if (tileCoordinates.zoom <= maxZoom)
+        {
+            zoom = qMax(zoom, tileCoordinates.zoom);
+        }
+    }
+    coordinates.removeIf([zoom](const TileFileAbstract::TileCoordinates& tileCoordinates) { return tileCoordinates.zoom != zoom; });
+    if (coordinates.isEmpty())
+    {
+        return QObject::tr("Terrain map contains no tiles.", "FileFormats::DEM");
+    }
+    std::sort(coordinates.begin(), coordinates.end(), [](const TileFileAbstract::TileCoordinates& a, const TileFileAbstract::TileCoordinates& b) {
+        return (a.y < b.y) || ((a.y == b.y) && (a.x < b.x));
+    });
+    int minX = coordinates.constFirst().x;
+    int maxX = minX;
+    for(const auto& tileCoordinates : std::as_const(coordinates))
+    {
+        minX = qMin(minX, tileCoordinates.x);
+        maxX = qMax(maxX, tileCoordinates.x);
+    }
+    auto const minY = coordinates.constFirst().y;
+    auto const numX = maxX-minX+1;
+    auto const numY = coordinates.constLast().y-minY+1;
+    QList<quint32> index(static_cast<qsizetype>(numX)*numY, 0);
+
+    // Write placeholders for header and index, then the tile data. The header
+    // and index are written once all tiles are known.
+    QSaveFile file(demFileName);
+    if (!file.open(QIODeviceBase::WriteOnly))
+    {
+        return QObject::tr("Unable to open file '%1' for writing.", "FileFormats::DEM").arg(demFileName);
+    }
+    file.write(QByteArray(tileDataOffset(index.size()), 0));
+
+    int tileSize = 0;
+    quint32 numTiles = 0;
+    QByteArray samples;
+    for(const auto& tileCoordinates : std::as_const(coordinates))
+    {
+        QImage image;
+        if (!image.loadFromData(tiles->tile(zoom, tileCoordinates.x, tileCoordinates.y)))
+        {
+            continue;
+        }
+        if (tileSize == 0)
+        {
+            tileSize = image.width();
+        }
+        if ((image.width() != tileSize) || (image.height() != tileSize) || (tileSize < 2))
+        {
+            continue;
+        }
+
+        // Decode elevations, as in the "Terrarium" format
+        image = image.convertToFormat(QImage::Format_RGB32);
+        samples.resize(2*tileSize*tileSize);
+        auto* out = samples.data();
+        for(int y = 0; y < tileSize; y++)
+        {
+            const auto* line = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+            for(int x = 0; x < tileSize; x++)
+            {
+                auto const elevation = (qRed(line[x]) * 256.0 + qGreen(line[x]) + qBlue(line[x]) / 256.0) - 32768.0;
+                qToLittleEndian<qint16>(static_cast<qint16>(qBound(-32768, qRound(elevation), 32767)), out);
+                out += 2;
+            }
+        }
+        if (file.write(samples) != samples.size())
+        {
+            return QObject::tr("Unable to write file '%1'.", "FileFormats::DEM").arg(demFileName);
+        }
+        numTiles++;
+        index[static_cast<qsizetype>(tileCoordinates.y-minY)*numX + (tileCoordinates.x-minX)] = numTiles;
+    }
+    if (numTiles == 0)
+    {
+        return QObject::tr("Terrain map contains no tiles that can be decoded.", "FileFormats::DEM");
+    }
+
+    QByteArray header(headerLength, 0);
+    auto* data = reinterpret_cast<uchar*>(header.data());
+    memcpy(data, "EDEM", 4);
+    qToLittleEndian<quint32>(version, data+4);
+    qToLittleEndian<qint32>(zoom, data+8);
+    qToLittleEndian<qint32>(tileSize, data+12);
+    qToLittleEndian<qint32>(minX, data+16);
+    qToLittleEndian<qint32>(minY, data+20);
+    qToLittleEndian<qint32>(numX, data+24);
+    qToLittleEndian<qint32>(numY, data+28);
+    for(auto tileNumber : std::as_const(index))
+    {
+        QByteArray entry(4, 0);
+        qToLittleEndian<quint32>(tileNumber, entry.data());
+        header += entry;
+    }
+    if (!file.seek(0) || (file.write(header) != header.size()) || !file.commit())
+    {
+        return QObject::tr("Unable to write file '%1'.", "FileFormats::DEM").arg(demFileName);
+    }
+    return {};
+}
@@ -0,0 +1,139 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QFile>
+#include <QGeoCoordinate>
+#include <QList>
+
+#include "fileFormats/DataFileAbstract.h"
+#include "units/Distance.h"
+
+
+namespace FileFormats
+{
+
+/*! \brief Memory-mapped digital elevation model
+ *
+ *  Terrain maps are distributed as MBTILES or PMTILES, whose tiles are PNG
+ *  images that encode elevations in the "Terrarium" format. Decoding these
+ *  images is expensive. This class handles a simple file format that holds
+ *  the same data as raw 16-bit integers, so that elevations can be read
+ *  directly from the memory-mapped file. Use the static method
+ *  fromTerrainTiles() to convert a terrain map into this format.
+ *
+ *  The file contains the tiles of one zoom level. It consists of a header, an
+ *  index and the tile data. All numbers are little-endian.
+ *
+ *  - Header: magic number "EDEM", version, zoom level, number of samples per
+ *    tile side, and the range of tile x- and y-coordinates covered by the
+ *    file, as 32-bit integers.
+ *  - Index: For every tile in the range, row by row, the number of the tile
+ *    in the tile data plus one, or zero if the tile does not exist. These
+ *    numbers are 32-bit integers.
+ *  - Tile data: For every tile, the elevations in meters, row by row, as
+ *    16-bit integers. The tile data is 8-byte aligned.
+ *
+ *  Elevations are rounded to full meters. All methods are thread-safe.
+ */
+
+class DEM : public DataFileAbstract
+{
+
+public:
+    /*! \brief Standard constructor
+     *
+     *  Constructs an object from a DEM file. The file is supposed to exist and
+     *  remain intact throughout the existence of this class instance.
+     *
+     *  @param fileName Name of the DEM file
+     */
+    explicit DEM(const QString& fileName);
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Elevation of terrain at a given coordinate
+     *
+     *  The elevation is interpolated bilinearly between the four nearest
+     *  samples.
+     *
+     *  @param coordinate Coordinate
+     *
+     *  @returns Elevation above sea level, or NaN if the coordinate is not
+     *  covered by the file
+     */
+    [[nodiscard]] Units::Distance elevation(const QGeoCoordinate& coordinate) const;
+
+    /*! \brief Elevations of terrain at given coordinates
+     *
+     *  @param coordinates Coordinates
+     *
+     *  @returns List of elevations, as computed by elevation()
+     */
+    [[nodiscard]] QList<Units::Distance> elevations(const QList<QGeoCoordinate>& coordinates) const;
+
+    /*! \brief Zoom level of the tiles
+     *
+     *  @returns Zoom level, or -1 if the file is invalid
+     */
+    [[nodiscard]] int zoom() const { return m_zoom; }
+
+    /*! \brief Convert terrain map to DEM
+     *
+     *  This method reads all tiles of the highest zoom level up to maxZoom from
+     *  a terrain map in MBTILES or PMTILES format, decodes them and writes the
+     *  elevations to a DEM file. The method is expensive and meant to be run
+     *  in a background thread, once, when the terrain map is installed.
+     *
+     *  @param terrainFileName Name of the terrain map file
+     *
+     *  @param demFileName Name of the DEM file. The file is written
+     *  atomically.
+     *
+     *  @param maxZoom Maximal zoom level to use
+     *
+     *  @returns A human-readable error message, or an empty string on success
+     */
+    [[nodiscard]] static QString fromTerrainTiles(const QString& terrainFileName, const QString& demFileName, int maxZoom);
+
+private:
+    Q_DISABLE_COPY_MOVE(DEM)
+
+    // Memory-mapped file
+    QSharedPointer<QFile> m_file;
+
+    // Data from the header
+    int m_zoom {-1};
+    int m_tileSize {0};
+    int m_minX {0};
+    int m_minY {0};
+    int m_numX {0};
+    int m_numY {0};
+
+    // Pointers into the memory-mapped file
+    const uchar* m_index {nullptr};
+    const uchar* m_tileData {nullptr};
+};
+
+} // namespace FileFormats
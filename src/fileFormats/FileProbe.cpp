@@ -0,0 +1,157 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <QMimeDatabase>
+
+#include "fileFormats/DataFileAbstract.h"
+#include "fileFormats/FileProbe.h"
+
+using namespace Qt::Literals::StringLiterals;
+
+
+FileFormats::FileProbe::FileProbe(const QString& fileName)
+    : m_file(FileFormats::DataFileAbstract::openFileURL(fileName))
+{
+    if (!m_file->open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+    m_prefix = m_file->read(prefixSize);
+    m_bytesRead = m_prefix.size();
+
+    QMimeDatabase const dataBase;
+    m_mimeType = dataBase.mimeTypeForData(m_prefix);
+    m_signature = classify();
+}
+
+
+//
+// Getter methods
+//
+
+QString FileFormats::FileProbe::fileName() const
+{
+    return m_file->fileName();
+}
+
+
+//
+// Methods
+//
+
+QByteArray FileFormats::FileProbe::content()
+{
+    if (!m_content.isNull() || !m_file->isOpen())
+    {
+        return m_content;
+    }
+
+    // The prefix already holds the full file
+    if (m_prefix.size() < prefixSize)
+    {
+        m_content = m_prefix;
+        return m_content;
+    }
+
+    auto const size = m_file->size();
+    auto* data = m_file->map(0, size);
+    if (data != nullptr)
+    {
+        m_content = QByteArray::fromRawData(reinterpret_cast<const char*>(data), size);
+        m_bytesRead += size - m_prefix.size();
+        return m_content;
+    }
+
+    auto const remainder = m_file->readAll();
+    m_bytesRead += remainder.size();
+    m_content = m_prefix + remainder;
+    return m_content;
+}
+
+
+//
+// Private Methods
+//
+
+FileFormats::FileProbe::Signature FileFormats::FileProbe::classify() const
+{
+    if (m_prefix.isEmpty())
+    {
+        return Unknown;
+    }
+
+    // Binary formats, by signature
+    if (m_prefix.startsWith(QByteArrayView("SQLite format 3\0", 16)))
+    {
+        return SQLite;
+    }
+    if (m_prefix.startsWith("PMTiles"))
+    {
+        return PMTiles;
+    }
+    if (m_prefix.startsWith("PK\x03\x04"))
+    {
+        return Zip;
+    }
+    auto const isText = m_mimeType.inherits(u"text/plain"_s);
+    if (m_mimeType.name().startsWith(u"image/"_s) && !isText)
+    {
+        return Image;
+    }
+    if (!isText && m_prefix.contains('\0'))
+    {
+        return Unknown;
+    }
+
+    // JSON documents begin with an object, possibly after a byte order mark
+    // and whitespace
+    QByteArrayView text(m_prefix);
+    if (text.startsWith("\xEF\xBB\xBF"))
+    {
+        text = text.sliced(3);
+    }
+    if (text.trimmed().startsWith('{'))
+    {
+        return JSON;
+    }
+
+    // OpenAir files contain lines that start with an airspace class and an
+    // airspace name record
+    bool hasClass = false;
+    bool hasName = false;
+    qsizetype position = 0;
+    while ((position < text.size()) && !(hasClass && hasName))
+    {
+        auto const line = text.sliced(position);
+        hasClass = hasClass || line.startsWith("AC ");
+        hasName = hasName || line.startsWith("AN ");
+        auto const lineBreak = line.indexOf('\n');
+        if (lineBreak < 0)
+        {
+            break;
+        }
+        position += lineBreak + 1;
+    }
+    if (hasClass && hasName)
+    {
+        return OpenAir;
+    }
+    return Text;
+}
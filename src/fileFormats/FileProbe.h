@@ -0,0 +1,140 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+#include <QMimeType>
+#include <QSharedPointer>
+
+class QFile;
+
+namespace FileFormats
+{
+
+/*! \brief Cheap, single-read file type detection
+ *
+ *  This class opens a file, a file URL or an Android content URL, reads a
+ *  bounded prefix of the file once, and classifies the file by signature and
+ *  by simple structural checks of the prefix. The MIME type is determined
+ *  from the same prefix. No importer is run.
+ *
+ *  The file stays open for the lifetime of the instance, so that the importer
+ *  selected by the caller can use the prefix, or the full content via
+ *  content(), without opening and reading the file again.
+ */
+
+class FileProbe
+{
+public:
+    /*! \brief File signatures
+     *
+     *  The signatures are mutually exclusive. Text files that do not match any
+     *  of the more specific text signatures are reported as Text.
+     */
+    enum Signature : quint8
+    {
+        Unknown, /*!< File cannot be read, or contains unrecognized binary data */
+        Text,    /*!< Text, for instance CSV, CUP, FLARM simulation data or XML */
+        JSON,    /*!< Text that begins with a JSON object */
+        OpenAir, /*!< Text with OpenAir airspace records */
+        SQLite,  /*!< SQLite database, for instance MBTILES */
+        PMTiles, /*!< PMTiles archive */
+        Image,   /*!< Image, including TIFF */
+        Zip,     /*!< Zip archive, for instance a TripKit */
+    };
+
+    /*! \brief Maximal size of the prefix, in bytes */
+    static constexpr qint64 prefixSize = 64*1024;
+
+    /*! \brief Constructor
+     *
+     *  The constructor opens the file and reads the prefix.
+     *
+     *  @param fileName A file name, a file URL or an Android content URL
+     */
+    explicit FileProbe(const QString& fileName);
+
+
+    //
+    // Getter methods
+    //
+
+    /*! \brief Number of bytes read from the file so far
+     *
+     *  @returns Number of bytes read by the constructor and by content()
+     */
+    [[nodiscard]] qint64 bytesRead() const { return m_bytesRead; }
+
+    /*! \brief Local file name
+     *
+     *  For Android content URLs, this is the name of a temporary copy.
+     *
+     *  @returns Name of a local file that can be opened by importers
+     */
+    [[nodiscard]] QString fileName() const;
+
+    /*! \brief MIME type, determined from the prefix
+     *
+     *  @returns MIME type
+     */
+    [[nodiscard]] QMimeType mimeType() const { return m_mimeType; }
+
+    /*! \brief Prefix of the file
+     *
+     *  @returns The first prefixSize bytes of the file, or the full file if
+     *  it is shorter
+     */
+    [[nodiscard]] QByteArray prefix() const { return m_prefix; }
+
+    /*! \brief File signature
+     *
+     *  @returns Signature
+     */
+    [[nodiscard]] Signature signature() const { return m_signature; }
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Full file content
+     *
+     *  The file is memory-mapped if possible and read otherwise. The returned
+     *  byte array does not own its data if the file is mapped, and must not
+     *  be used after this instance has been destroyed.
+     *
+     *  @returns Content of the file, or an empty byte array on error
+     */
+    [[nodiscard]] QByteArray content();
+
+private:
+    // Classifies m_prefix
+    [[nodiscard]] Signature classify() const;
+
+    QSharedPointer<QFile> m_file;
+    QByteArray m_prefix;
+    QByteArray m_content;
+    QMimeType m_mimeType;
+    Signature m_signature {Unknown};
+    qint64 m_bytesRead {0};
+};
+
+} // namespace FileFormats
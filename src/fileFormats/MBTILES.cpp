@@ -38,8 +38,8 @@ FileFormats::MBTILES::MBTILES()
 }
 
 FileFormats::MBTILES::MBTILES(const QString& fileName)
-    : m_fileName(fileName)
 {
+    m_fileName = fileName;
     m_file = openFileURL(fileName);
 
     m_databaseConnectionName = QStringLiteral("GeoMaps::MBTILES::format %1,%2").arg(fileName).arg(QRandomGenerator::global()->generate());
@@ -143,29 +143,6 @@ auto FileFormats::MBTILES::format() -> FileFormats::MBTILES::Format
     return Unknown;
 }
 
-auto FileFormats::MBTILES::info() -> QString
-{
-    QMapIterator<QString, QString> i(m_metadata);
-    QString intResult;
-    while (i.hasNext()) {
-        i.next();
-
-        if (i.key() == u"json")
-        {
-            continue;
-        }
-        intResult += QStringLiteral("<tr><td><strong>%1 :&nbsp;&nbsp;</strong></td><td>%2</td></tr>")
-                         .arg(i.key(), i.value());
-    }
-
-    QString result;
-    if (!intResult.isEmpty())
-    {
-        result += QStringLiteral("<table>%1</table>").arg(intResult);
-    }
-    return result;
-}
-
 auto FileFormats::MBTILES::tile(int zoom, int x, int y) -> QByteArray
 {
     auto m_dataBase = QSqlDatabase::database(m_databaseConnectionName);
@@ -187,6 +164,28 @@ auto FileFormats::MBTILES::tile(int zoom, int x, int y) -> QByteArray
     return {};
 }
 
+QList<FileFormats::MBTILES::TileCoordinates> FileFormats::MBTILES::tileCoordinates()
+{
+    auto m_dataBase = QSqlDatabase::database(m_databaseConnectionName);
+    if (!m_dataBase.open())
+    {
+        return {};
+    }
+
+    QList<TileCoordinates> result;
+    QSqlQuery query(m_dataBase);
+    if (query.exec(QStringLiteral("select zoom_level, tile_column, tile_row from tiles;")))
+    {
+        while(query.next())
+        {
+            auto const zoom = query.value(0).toInt();
+            auto const yflipped = (1<<zoom)-1-query.value(2).toInt();
+            result.append({zoom, query.value(1).toInt(), yflipped});
+        }
+    }
+    return result;
+}
+
 int FileFormats::MBTILES::tileSize()
 {
     auto m_dataBase = QSqlDatabase::database(m_databaseConnectionName);
@@ -21,11 +21,10 @@
 #pragma once
 
 #include <QFile>
-#include <QMap>
 #include <QObject>
 #include <QSharedPointer>
 
-#include "fileFormats/DataFileAbstract.h"
+#include "fileFormats/TileFileAbstract.h"
 
 
 namespace FileFormats
@@ -37,23 +36,10 @@ namespace FileFormats
    *  This class handles MBTILES and allows easy access to the data.
    */
 
-  class MBTILES : public DataFileAbstract
+  class MBTILES : public TileFileAbstract
   {
 
   public:
-    /*! \brief Format of data tiles */
-    enum Format : quint8
-    {
-      /*! \brief Unknown format */
-      Unknown,
-
-      /*! \brief Vector data in PBF format */
-      Vector,
-
-      /*! \brief Raster data in JPG, PNG or WEBP format */
-      Raster,
-    };
-
     /*! \brief Standard constructor
      *
      * Constructs an invalid object. The method tile() will return
@@ -71,27 +57,31 @@ namespace FileFormats
     MBTILES(const QString& fileName);
 
     /*! \brief Standard destructor */
-    ~MBTILES();
+    ~MBTILES() override;
 
     /*! \brief Attribution of MBTILES file
      *
      *  @returns A human-readable HTML-String with attribution, or an empty
      *  string on error.
      */
-    [[nodiscard]] QString attribution();
+    [[nodiscard]] QString attribution() override;
 
     /*! \brief Determine type of data contained in an MBTILES file
      *
      *  @returns Type of data, or Unknown on error.
      */
-    [[nodiscard]] FileFormats::MBTILES::Format format();
+    [[nodiscard]] FileFormats::MBTILES::Format format() override;
 
-    /*! \brief Information about an MBTILES file
+    /*! \brief Check if tile data is gzip-compressed
+     *
+     *  Vector tiles in MBTILES files are always compressed with gzip.
      *
-     *  @returns A human-readable HTML-String with information about the MBTILES
-     *  file, or an empty string on error.
+     *  @returns True if the file contains vector data
      */
-    [[nodiscard]] QString info();
+    [[nodiscard]] bool isTileDataGzipped() const override
+    {
+      return m_metadata.value(QStringLiteral("format")) == u"pbf";
+    }
 
     /*! \brief Retrieve tile from an MBTILES file
      *
@@ -104,7 +94,10 @@ namespace FileFormats
      *  @returns A QByteArray with the tile data, or an empty QByteArray on
      *  error.
      */
-    [[nodiscard]] QByteArray tile(int zoom, int x, int y);
+    [[nodiscard]] QByteArray tile(int zoom, int x, int y) override;
+
+    // Re-implemented from TileFileAbstract
+    [[nodiscard]] QList<TileCoordinates> tileCoordinates() override;
 
     /*! \brief Retrieve tile size from an MBTILES file in raster format
      *
@@ -114,41 +107,17 @@ namespace FileFormats
      *  512 if the data is not available. The value returned is never
      *  negative.
      */
-    [[nodiscard]] int tileSize();
-
-    /*! \brief Retrieve metadata of the MBTILES file
-     *
-     *  MBTILES files contain metadata, in the form of a list of key/value
-     *  pairs.
-     *
-     *  @returns A QMap containing the metadata, or an empty QMap on error.
-     */
-    [[nodiscard]] QMap<QString, QString> metaData() const
-    {
-      return m_metadata;
-    }
-
-    /*! \brief Retrieve name of the MBTILES file
-     *
-     *  @returns Filename, as given in the constructor
-     */
-    [[nodiscard]] QString fileName() const
-    {
-      return m_fileName;
-    }
+    [[nodiscard]] int tileSize() override;
 
   private:
     //
     Q_DISABLE_COPY_MOVE(MBTILES)
 
-    // Name of the MBTILES file
-    QString m_fileName;
     QSharedPointer<QFile> m_file;
 
     // Name of the data base connection. This name is unique to each instance of
     // this class, and should therefore not be copied.
     QString m_databaseConnectionName;
-    QMap<QString, QString> m_metadata;
   };
 
 } // namespace FileFormats
@@ -0,0 +1,804 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <QCryptographicHash>
+#include <QHash>
+#include <QImage>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+#include <zlib.h>
+
+#include "fileFormats/MBTILES.h"
+#include "fileFormats/PMTILES.h"
+
+using namespace Qt::Literals::StringLiterals;
+
+
+namespace {
+
+// Layout of the header, as specified in the PMTILES specification
+constexpr qsizetype headerLength = 127;
+constexpr qsizetype rootDirectoryOffset = 8;
+constexpr qsizetype rootDirectoryLength = 16;
+constexpr qsizetype metadataOffset = 24;
+constexpr qsizetype metadataLength = 32;
+constexpr qsizetype leafDirectoriesOffset = 40;
+constexpr qsizetype leafDirectoriesLength = 48;
+constexpr qsizetype tileDataOffset = 56;
+constexpr qsizetype tileDataLength = 64;
+constexpr qsizetype addressedTilesCount = 72;
+constexpr qsizetype tileEntriesCount = 80;
+constexpr qsizetype tileContentsCount = 88;
+constexpr qsizetype clustered = 96;
+constexpr qsizetype internalCompression = 97;
+constexpr qsizetype tileCompression = 98;
+constexpr qsizetype tileType = 99;
+constexpr qsizetype minZoom = 100;
+constexpr qsizetype maxZoom = 101;
+constexpr qsizetype minPosition = 102;
+constexpr qsizetype maxPosition = 110;
+constexpr qsizetype centerZoom = 118;
+constexpr qsizetype centerPosition = 119;
+
+// The header and the root directory must fit into the first 16kB of a file
+constexpr qsizetype maxRootDirectoryLength = 16384 - headerLength;
+
+// Directories are nested at most this deep
+constexpr int maxDirectoryDepth = 4;
+
+// Checks if the section [offset, offset+length) lies within [0, size)
+bool isWithin(quint64 offset, quint64 length, quint64 size)
+{
+    return (offset <= size) && (length <= size - offset);
+}
+
+// Reads a variable-length integer, as used in protocol buffers. Returns false
+// on error.
+bool readVarint(QByteArrayView data, qsizetype& position, quint64& value)
+{
+    value = 0;
+    for(int shift = 0; shift < 64; shift += 7)
+    {
+        if (position >= data.size())
+        {
+            return false;
+        }
+        auto const byte = static_cast<quint8>(data[position++]);
+        value |= static_cast<quint64>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Appends a variable-length integer
+void writeVarint(QByteArray& data, quint64 value)
+{
+    while (value >= 0x80)
+    {
+        data += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    data += static_cast<char>(value);
+}
+
+// Position in the header, as a pair of integers in units of 10^-7 degrees
+void writePosition(char* data, double longitude, double latitude)
+{
+    qToLittleEndian<qint32>(qRound(longitude*1e7), data);
+    qToLittleEndian<qint32>(qRound(latitude*1e7), data+4);
+}
+
+} // namespace
+
+
+FileFormats::PMTILES::PMTILES(const QString& fileName)
+{
+    m_fileName = fileName;
+    m_file = openFileURL(fileName);
+    if (!m_file->open(QIODeviceBase::ReadOnly))
+    {
+        setError(QObject::tr("Unable to open PMTILES file.", "FileFormats::PMTILES"));
+        return;
+    }
+    m_size = m_file->size();
+    if (m_size < headerLength)
+    {
+        setError(QObject::tr("PMTILES file is too short.", "FileFormats::PMTILES"));
+        return;
+    }
+    m_data = m_file->map(0, m_size);
+    if (m_data == nullptr)
+    {
+        setError(QObject::tr("Unable to map PMTILES file into memory.", "FileFormats::PMTILES"));
+        return;
+    }
+
+    // Read header
+    const auto* header = reinterpret_cast<const char*>(m_data);
+    if (!QByteArrayView(header, 7).startsWith("PMTiles") || (header[7] != 3))
+    {
+        setError(QObject::tr("File is not in PMTILES format, version 3.", "FileFormats::PMTILES"));
+        return;
+    }
+    auto const rootOffset = qFromLittleEndian<quint64>(header+rootDirectoryOffset);
+    auto const rootLength = qFromLittleEndian<quint64>(header+rootDirectoryLength);
+    auto const metaOffset = qFromLittleEndian<quint64>(header+metadataOffset);
+    auto const metaLength = qFromLittleEndian<quint64>(header+metadataLength);
+    m_leafDirectoriesOffset = qFromLittleEndian<quint64>(header+leafDirectoriesOffset);
+    m_leafDirectoriesLength = qFromLittleEndian<quint64>(header+leafDirectoriesLength);
+    m_tileDataOffset = qFromLittleEndian<quint64>(header+tileDataOffset);
+    m_tileDataLength = qFromLittleEndian<quint64>(header+tileDataLength);
+    m_internalCompression = static_cast<Compression>(header[internalCompression]);
+    m_tileCompression = static_cast<Compression>(header[tileCompression]);
+    m_tileType = static_cast<TileType>(header[tileType]);
+    auto const size = static_cast<quint64>(m_size);
+    if (!isWithin(rootOffset, rootLength, size)
+        || !isWithin(metaOffset, metaLength, size)
+        || !isWithin(m_leafDirectoriesOffset, m_leafDirectoriesLength, size)
+        || !isWithin(m_tileDataOffset, m_tileDataLength, size))
+    {
+        setError(QObject::tr("PMTILES file is damaged.", "FileFormats::PMTILES"));
+        return;
+    }
+    if ((m_internalCompression != None) && (m_internalCompression != Gzip))
+    {
+        setError(QObject::tr("PMTILES file uses an unsupported compression method.", "FileFormats::PMTILES"));
+        return;
+    }
+    if ((m_tileCompression != UnknownCompression) && (m_tileCompression != None) && (m_tileCompression != Gzip))
+    {
+        setError(QObject::tr("PMTILES file uses an unsupported compression method for tiles.", "FileFormats::PMTILES"));
+        return;
+    }
+
+    // Read root directory
+    m_rootDirectory = directory(rootOffset, rootLength);
+    if (m_rootDirectory.isEmpty())
+    {
+        setError(QObject::tr("Unable to read root directory from PMTILES file.", "FileFormats::PMTILES"));
+        return;
+    }
+
+    // Read metadata. String and number values are stored as they are. All
+    // other values are collected in a JSON object, which is stored under the
+    // key "json", as in MBTILES files.
+    auto const metadata = QJsonDocument::fromJson(decompress({header+metaOffset, static_cast<qsizetype>(metaLength)})).object();
+    QJsonObject json;
+    for(auto it = metadata.begin(); it != metadata.end(); it++)
+    {
+        if (it.value().isString())
+        {
+            m_metadata.insert(it.key(), it.value().toString());
+            continue;
+        }
+        if (it.value().isDouble())
+        {
+            m_metadata.insert(it.key(), QString::number(it.value().toDouble()));
+            continue;
+        }
+        json.insert(it.key(), it.value());
+    }
+    if (!json.isEmpty())
+    {
+        m_metadata.insert(u"json"_s, QString::fromUtf8(QJsonDocument(json).toJson(QJsonDocument::Compact)));
+    }
+
+    // Complete metadata with the information from the header
+    if (!m_metadata.contains(u"format"_s))
+    {
+        switch(m_tileType)
+        {
+        case MVT:
+            m_metadata.insert(u"format"_s, u"pbf"_s);
+            break;
+        case PNG:
+            m_metadata.insert(u"format"_s, u"png"_s);
+            break;
+        case JPEG:
+            m_metadata.insert(u"format"_s, u"jpg"_s);
+            break;
+        case WEBP:
+            m_metadata.insert(u"format"_s, u"webp"_s);
+            break;
+        case AVIF:
+        case UnknownTileType:
+            break;
+        }
+    }
+    if (!m_metadata.contains(u"minzoom"_s))
+    {
+        m_metadata.insert(u"minzoom"_s, QString::number(static_cast<quint8>(header[minZoom])));
+    }
+    if (!m_metadata.contains(u"maxzoom"_s))
+    {
+        m_metadata.insert(u"maxzoom"_s, QString::number(static_cast<quint8>(header[maxZoom])));
+    }
+}
+
+
+//
+// Methods
+//
+
+QString FileFormats::PMTILES::attribution()
+{
+    return m_metadata.value(u"attribution"_s);
+}
+
+FileFormats::TileFileAbstract::Format FileFormats::PMTILES::format()
+{
+    if (!isValid())
+    {
+        return Unknown;
+    }
+    switch(m_tileType)
+    {
+    case MVT:
+        return Vector;
+    case PNG:
+    case JPEG:
+    case WEBP:
+        return Raster;
+    case AVIF:
+    case UnknownTileType:
+        break;
+    }
+    return Unknown;
+}
+
+QByteArray FileFormats::PMTILES::tile(int zoom, int x, int y)
+{
+    if (!isValid() || (zoom < 0) || (zoom > 31))
+    {
+        return {};
+    }
+    auto const numTiles = static_cast<qint64>(1) << zoom;
+    if ((x < 0) || (x >= numTiles) || (y < 0) || (y >= numTiles))
+    {
+        return {};
+    }
+    auto const id = tileID(zoom, x, y);
+
+    auto currentDirectory = m_rootDirectory;
+    for(int depth = 0; depth < maxDirectoryDepth; depth++)
+    {
+        // Find the last entry whose tile ID is not larger than id
+        auto it = std::upper_bound(currentDirectory.cbegin(), currentDirectory.cend(), id, [](quint64 value, const Entry& entry) {
+            return value < entry.tileID;
+        });
+        if (it == currentDirectory.cbegin())
+        {
+            return {};
+        }
+        auto const entry = *(--it);
+
+        if (entry.runLength > 0)
+        {
+            if ((id - entry.tileID >= entry.runLength) || !isWithin(entry.offset, entry.length, m_tileDataLength))
+            {
+                return {};
+            }
+            return QByteArray::fromRawData(reinterpret_cast<const char*>(m_data + m_tileDataOffset + entry.offset), entry.length);
+        }
+
+        // Entry points to a leaf directory
+        QMutexLocker const locker(&m_leafDirectoriesMutex);
+        auto* leafDirectory = m_leafDirectories.object(entry.offset);
+        if (leafDirectory != nullptr)
+        {
+            currentDirectory = *leafDirectory;
+            continue;
+        }
+        if (!isWithin(entry.offset, entry.length, m_leafDirectoriesLength))
+        {
+            return {};
+        }
+        currentDirectory = directory(m_leafDirectoriesOffset + entry.offset, entry.length);
+        m_leafDirectories.insert(entry.offset, new Directory(currentDirectory));
+    }
+    return {};
+}
+
+QList<FileFormats::TileFileAbstract::TileCoordinates> FileFormats::PMTILES::tileCoordinates()
+{
+    if (!isValid())
+    {
+        return {};
+    }
+
+    // Walk the root directory and all leaf directories, depth first
+    QList<TileCoordinates> result;
+    QList<QPair<Directory, int>> stack {{m_rootDirectory, 0}};
+    while (!stack.isEmpty())
+    {
+        auto const [currentDirectory, depth] = stack.takeLast();
+        for(auto it = currentDirectory.crbegin(); it != currentDirectory.crend(); it++)
+        {
+            if (it->runLength > 0)
+            {
+                continue;
+            }
+            if ((depth+1 < maxDirectoryDepth) && isWithin(it->offset, it->length, m_leafDirectoriesLength))
+            {
+                stack.append({directory(m_leafDirectoriesOffset + it->offset, it->length), depth+1});
+            }
+        }
+        for(const auto& entry : currentDirectory)
+        {
+            for(quint64 i = 0; i < entry.runLength; i++)
+            {
+                result.append(coordinates(entry.tileID + i));
+            }
+        }
+    }
+    return result;
+}
+
+int FileFormats::PMTILES::tileSize()
+{
+    bool ok = false;
+    auto const size = m_metadata.value(u"tileSize"_s).toInt(&ok);
+    if (ok && (size > 0))
+    {
+        return size;
+    }
+
+    // If not in metadata, read actual tile dimensions from the first tile
+    auto currentDirectory = m_rootDirectory;
+    for(int depth = 0; !currentDirectory.isEmpty() && (depth < maxDirectoryDepth); depth++)
+    {
+        auto const entry = currentDirectory.constFirst();
+        if (entry.runLength == 0)
+        {
+            if (!isWithin(entry.offset, entry.length, m_leafDirectoriesLength))
+            {
+                break;
+            }
+            currentDirectory = directory(m_leafDirectoriesOffset + entry.offset, entry.length);
+            continue;
+        }
+        if (!isWithin(entry.offset, entry.length, m_tileDataLength))
+        {
+            break;
+        }
+        QImage image;
+        if (image.loadFromData(m_data + m_tileDataOffset + entry.offset, static_cast<int>(entry.length))
+            && (image.width() == image.height()))
+        {
+            return image.width();
+        }
+        break;
+    }
+
+    // Default fallback for raster tiles
+    return 512;
+}
+
+quint64 FileFormats::PMTILES::tileID(int zoom, quint32 x, quint32 y)
+{
+    if (zoom == 0)
+    {
+        return 0;
+    }
+
+    // Number of tiles on lower zoom levels, plus the position on the Hilbert
+    // curve that fills the square of all tiles on this zoom level
+    quint64 result = ((static_cast<quint64>(1) << (2*zoom)) - 1) / 3;
+    for(quint32 s = static_cast<quint32>(1) << (zoom-1); s > 0; s >>= 1)
+    {
+        quint32 const rx = ((x & s) != 0) ? 1 : 0;
+        quint32 const ry = ((y & s) != 0) ? 1 : 0;
+        result += static_cast<quint64>(s) * s * ((3*rx) ^ ry);
+
+        // Rotate. The subtraction might wrap around, but only the bits below
+        // s are relevant in the next iterations.
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = s-1-x;
+                y = s-1-y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return result;
+}
+
+FileFormats::TileFileAbstract::TileCoordinates FileFormats::PMTILES::coordinates(quint64 tileID)
+{
+    // Find zoom level, then walk down the Hilbert curve
+    int zoom = 0;
+    while ((zoom < 31) && (((static_cast<quint64>(1) << (2*(zoom+1))) - 1) / 3 <= tileID))
+    {
+        zoom++;
+    }
+    auto position = tileID - ((static_cast<quint64>(1) << (2*zoom)) - 1) / 3;
+    quint32 x = 0;
+    quint32 y = 0;
+    for(quint32 s = 1; s < (static_cast<quint64>(1) << zoom); s <<= 1)
+    {
+        quint32 const rx = 1 & (position/2);
+        quint32 const ry = 1 & (position ^ rx);
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = s-1-x;
+                y = s-1-y;
+            }
+            std::swap(x, y);
+        }
+        x += s*rx;
+        y += s*ry;
+        position /= 4;
+    }
+    return {zoom, static_cast<int>(x), static_cast<int>(y)};
+}
+
+bool FileFormats::PMTILES::isPMTILES(const QString& fileName)
+{
+    QFile file(fileName.startsWith(u"file://"_s) ? fileName.mid(7) : fileName);
+    if (!file.open(QIODeviceBase::ReadOnly))
+    {
+        return false;
+    }
+    return file.read(7) == "PMTiles";
+}
+
+QString FileFormats::PMTILES::fromMBTILES(const QString& mbtilesFileName, const QString& pmtilesFileName)
+{
+    MBTILES mbtiles(mbtilesFileName);
+    if (!mbtiles.isValid())
+    {
+        return mbtiles.error();
+    }
+
+    // Sort tiles by tile ID
+    struct Item
+    {
+        quint64 tileID;
+        TileCoordinates coordinates;
+    };
+    QList<Item> items;
+    for(const auto& coordinates : mbtiles.tileCoordinates())
+    {
+        items.append({tileID(coordinates.zoom, coordinates.x, coordinates.y), coordinates});
+    }
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) { return a.tileID < b.tileID; });
+
+    // First pass: compute directory entries. Identical tiles are stored only
+    // once, and runs of identical tiles share a single entry.
+    Directory entries;
+    QHash<QByteArray, quint64> offsetsByHash;
+    QList<TileCoordinates> contents;
+    quint64 dataLength = 0;
+    quint64 numAddressedTiles = 0;
+    int minZoomLevel = 31;
+    int maxZoomLevel = 0;
+    for(const auto& item : std::as_const(items))
+    {
+        auto const data = mbtiles.tile(item.coordinates.zoom, item.coordinates.x, item.coordinates.y);
+        if (data.isEmpty())
+        {
+            continue;
+        }
+        numAddressedTiles++;
+        minZoomLevel = qMin(minZoomLevel, item.coordinates.zoom);
+        maxZoomLevel = qMax(maxZoomLevel, item.coordinates.zoom);
+
+        auto const hash = QCryptographicHash::hash(data, QCryptographicHash::Sha256);
+        auto it = offsetsByHash.constFind(hash);
+        quint64 offset = 0;
+        if (it != offsetsByHash.constEnd())
+        {
+            offset = it.value();
+        }
+        else
+        {
+            offset = dataLength;
+            dataLength += data.size();
+            offsetsByHash.insert(hash, offset);
+            contents.append(item.coordinates);
+        }
+
+        if (!entries.isEmpty()
+            && (entries.constLast().offset == offset)
+            && (entries.constLast().tileID + entries.constLast().runLength == item.tileID))
+        {
+            entries.last().runLength++;
+            continue;
+        }
+        entries.append({item.tileID, offset, static_cast<quint32>(data.size()), 1});
+    }
+    if (entries.isEmpty())
+    {
+        return QObject::tr("MBTILES file contains no tiles.", "FileFormats::PMTILES");
+    }
+
+    // Compute directories. If the root directory is too large, move the
+    // entries to leaf directories, and grow leaf directories until the root
+    // directory fits.
+    auto rootDirectory = serialize(entries);
+    QByteArray leafDirectories;
+    for(qsizetype leafSize = 4096; rootDirectory.size() > maxRootDirectoryLength; leafSize *= 2)
+    {
+        Directory rootEntries;
+        leafDirectories.clear();
+        for(qsizetype i = 0; i < entries.size(); i += leafSize)
+        {
+            auto const leafDirectory = serialize(entries.mid(i, leafSize));
+            rootEntries.append({entries.at(i).tileID, static_cast<quint64>(leafDirectories.size()), static_cast<quint32>(leafDirectory.size()), 0});
+            leafDirectories += leafDirectory;
+        }
+        rootDirectory = serialize(rootEntries);
+    }
+
+    // Compute metadata. The content of the MBTILES key "json" is merged into
+    // the top-level object.
+    QJsonObject metadata;
+    auto const mbtilesMetadata = mbtiles.metaData();
+    for(auto it = mbtilesMetadata.cbegin(); it != mbtilesMetadata.cend(); it++)
+    {
+        if (it.key() == u"json"_s)
+        {
+            auto const json = QJsonDocument::fromJson(it.value().toUtf8()).object();
+            for(auto jt = json.begin(); jt != json.end(); jt++)
+            {
+                metadata.insert(jt.key(), jt.value());
+            }
+            continue;
+        }
+        metadata.insert(it.key(), it.value());
+    }
+    auto const metadataBytes = QJsonDocument(metadata).toJson(QJsonDocument::Compact);
+
+    // Compute header
+    QByteArray header(headerLength, 0);
+    auto* data = header.data();
+    memcpy(data, "PMTiles", 7);
+    data[7] = 3;
+    quint64 const metaOffset = headerLength + rootDirectory.size();
+    quint64 const leafOffset = metaOffset + metadataBytes.size();
+    quint64 const tileOffset = leafOffset + leafDirectories.size();
+    qToLittleEndian<quint64>(headerLength, data+rootDirectoryOffset);
+    qToLittleEndian<quint64>(rootDirectory.size(), data+rootDirectoryLength);
+    qToLittleEndian<quint64>(metaOffset, data+metadataOffset);
+    qToLittleEndian<quint64>(metadataBytes.size(), data+metadataLength);
+    qToLittleEndian<quint64>(leafOffset, data+leafDirectoriesOffset);
+    qToLittleEndian<quint64>(leafDirectories.size(), data+leafDirectoriesLength);
+    qToLittleEndian<quint64>(tileOffset, data+tileDataOffset);
+    qToLittleEndian<quint64>(dataLength, data+tileDataLength);
+    qToLittleEndian<quint64>(numAddressedTiles, data+addressedTilesCount);
+    qToLittleEndian<quint64>(entries.size(), data+tileEntriesCount);
+    qToLittleEndian<quint64>(contents.size(), data+tileContentsCount);
+    data[clustered] = 1;
+    data[internalCompression] = None;
+
+    // Tiles in MBTILES files are stored as they are served. As in TileHandler,
+    // vector tiles are assumed to be compressed with gzip.
+    auto const tileFormat = mbtilesMetadata.value(u"format"_s);
+    data[tileCompression] = (tileFormat == u"pbf"_s) ? Gzip : None;
+    data[tileType] = UnknownTileType;
+    if (tileFormat == u"pbf"_s)
+    {
+        data[tileType] = MVT;
+    }
+    if (tileFormat == u"png"_s)
+    {
+        data[tileType] = PNG;
+    }
+    if ((tileFormat == u"jpg"_s) || (tileFormat == u"jpeg"_s))
+    {
+        data[tileType] = JPEG;
+    }
+    if (tileFormat == u"webp"_s)
+    {
+        data[tileType] = WEBP;
+    }
+    data[minZoom] = static_cast<char>(minZoomLevel);
+    data[maxZoom] = static_cast<char>(maxZoomLevel);
+
+    // Bounds and center are taken from the metadata, if available
+    double west = -180.0;
+    double south = -85.051129;
+    double east = 180.0;
+    double north = 85.051129;
+    auto const bounds = mbtilesMetadata.value(u"bounds"_s).split(u',');
+    if (bounds.size() == 4)
+    {
+        west = bounds[0].toDouble();
+        south = bounds[1].toDouble();
+        east = bounds[2].toDouble();
+        north = bounds[3].toDouble();
+    }
+    writePosition(data+minPosition, west, south);
+    writePosition(data+maxPosition, east, north);
+    auto const center = mbtilesMetadata.value(u"center"_s).split(u',');
+    if (center.size() == 3)
+    {
+        writePosition(data+centerPosition, center[0].toDouble(), center[1].toDouble());
+        data[centerZoom] = static_cast<char>(center[2].toInt());
+    }
+    else
+    {
+        writePosition(data+centerPosition, (west+east)/2.0, (south+north)/2.0);
+        data[centerZoom] = static_cast<char>(minZoomLevel);
+    }
+
+    // Second pass: write file
+    QSaveFile file(pmtilesFileName);
+    if (!file.open(QIODeviceBase::WriteOnly))
+    {
+        return QObject::tr("Unable to open file '%1' for writing.", "FileFormats::PMTILES").arg(pmtilesFileName);
+    }
+    file.write(header);
+    file.write(rootDirectory);
+    file.write(metadataBytes);
+    file.write(leafDirectories);
+    for(const auto& coordinates : std::as_const(contents))
+    {
+        file.write(mbtiles.tile(coordinates.zoom, coordinates.x, coordinates.y));
+    }
+    if (!file.commit())
+    {
+        return QObject::tr("Unable to write file '%1'.", "FileFormats::PMTILES").arg(pmtilesFileName);
+    }
+    return {};
+}
+
+
+//
+// Private Methods
+//
+
+FileFormats::PMTILES::Directory FileFormats::PMTILES::directory(quint64 offset, quint64 length) const
+{
+    auto const data = decompress({reinterpret_cast<const char*>(m_data + offset), static_cast<qsizetype>(length)});
+    qsizetype position = 0;
+
+    quint64 numEntries = 0;
+    if (!readVarint(data, position, numEntries) || (numEntries > static_cast<quint64>(data.size())))
+    {
+        return {};
+    }
+
+    Directory result(static_cast<qsizetype>(numEntries));
+    quint64 value = 0;
+    quint64 currentTileID = 0;
+    for(auto& entry : result)
+    {
+        if (!readVarint(data, position, value))
+        {
+            return {};
+        }
+        currentTileID += value;
+        entry.tileID = currentTileID;
+    }
+    for(auto& entry : result)
+    {
+        if (!readVarint(data, position, value))
+        {
+            return {};
+        }
+        entry.runLength = static_cast<quint32>(value);
+    }
+    for(auto& entry : result)
+    {
+        if (!readVarint(data, position, value))
+        {
+            return {};
+        }
+        entry.length = static_cast<quint32>(value);
+    }
+    for(qsizetype i = 0; i < result.size(); i++)
+    {
+        if (!readVarint(data, position, value))
+        {
+            return {};
+        }
+        // The value 0 means that the tile data follows the data of the
+        // previous entry
+        if ((value == 0) && (i > 0))
+        {
+            result[i].offset = result[i-1].offset + result[i-1].length;
+        }
+        else
+        {
+            result[i].offset = value - 1;
+        }
+    }
+    return result;
+}
+
+QByteArray FileFormats::PMTILES::decompress(QByteArrayView data) const
+{
+    if (m_internalCompression != Gzip)
+    {
+        return data.toByteArray();
+    }
+
+    z_stream stream {};
+    if (inflateInit2(&stream, 15+16) != Z_OK)
+    {
+        return {};
+    }
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+
+    QByteArray result;
+    int status = Z_OK;
+    while (status == Z_OK)
+    {
+        auto const size = result.size();
+        result.resize(size + qMax<qsizetype>(4096, 2*data.size()));
+        stream.next_out = reinterpret_cast<Bytef*>(result.data() + size);
+        stream.avail_out = static_cast<uInt>(result.size() - size);
+        status = inflate(&stream, Z_NO_FLUSH);
+        result.resize(result.size() - stream.avail_out);
+    }
+    inflateEnd(&stream);
+    if (status != Z_STREAM_END)
+    {
+        return {};
+    }
+    return result;
+}
+
+QByteArray FileFormats::PMTILES::serialize(const Directory& directory)
+{
+    QByteArray result;
+    writeVarint(result, directory.size());
+    quint64 previousTileID = 0;
+    for(const auto& entry : directory)
+    {
+        writeVarint(result, entry.tileID - previousTileID);
+        previousTileID = entry.tileID;
+    }
+    for(const auto& entry : directory)
+    {
+        writeVarint(result, entry.runLength);
+    }
+    for(const auto& entry : directory)
+    {
+        writeVarint(result, entry.length);
+    }
+    for(qsizetype i = 0; i < directory.size(); i++)
+    {
+        auto const& entry = directory.at(i);
+        if ((i > 0) && (entry.offset == directory.at(i-1).offset + directory.at(i-1).length))
+        {
+            writeVarint(result, 0);
+        }
+        else
+        {
+            writeVarint(result, entry.offset + 1);
+        }
+    }
+    return result;
+}
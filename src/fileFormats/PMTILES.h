@@ -0,0 +1,209 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QCache>
+#include <QFile>
+#include <QMutex>
+
+#include "fileFormats/TileFileAbstract.h"
+
+
+namespace FileFormats
+{
+
+/*! \brief Utility class for archives in PMTILES format
+ *
+ *  PMTILES are single-file archives of tiled map data, specified here:
+ *  https://github.com/protomaps/PMTiles/blob/main/spec/v3/spec.md This class
+ *  handles version 3 of the format. Other than MBTILES, PMTILES do not
+ *  require a database. The file is mapped into memory, tiles are found by
+ *  their Hilbert tile ID in the root directory and in leaf directories, and
+ *  tile() returns the tile data without copying it.
+ *
+ *  Leaf directories are decoded on first use and kept in a cache. All methods
+ *  are thread-safe.
+ */
+
+class PMTILES : public TileFileAbstract
+{
+
+public:
+    /*! \brief Standard constructor
+     *
+     * Constructs an object from a PMTILES file. The file is supposed to exist
+     * and remain intact throughout the existence of this class instance.
+     *
+     * @param fileName Name of the PMTILES file
+     */
+    explicit PMTILES(const QString& fileName);
+
+    /*! \brief Standard destructor */
+    ~PMTILES() override = default;
+
+
+    //
+    // Methods
+    //
+
+    // Re-implemented from TileFileAbstract
+    [[nodiscard]] QString attribution() override;
+
+    // Re-implemented from TileFileAbstract
+    [[nodiscard]] Format format() override;
+
+    // Re-implemented from TileFileAbstract
+    [[nodiscard]] bool isTileDataGzipped() const override { return m_tileCompression == Gzip; }
+
+    /*! \brief Retrieve tile from a PMTILES file
+     *
+     *  @param zoom Zoom level of the tile
+     *
+     *  @param x x-Coordinate of the tile
+     *
+     *  @param y y-Coordinate of the tile
+     *
+     *  @returns A QByteArray with the tile data, or an empty QByteArray on
+     *  error. The QByteArray refers to the memory-mapped file, and must not
+     *  be used after this instance has been destroyed.
+     */
+    [[nodiscard]] QByteArray tile(int zoom, int x, int y) override;
+
+    // Re-implemented from TileFileAbstract
+    [[nodiscard]] QList<TileCoordinates> tileCoordinates() override;
+
+    // Re-implemented from TileFileAbstract
+    [[nodiscard]] int tileSize() override;
+
+    /*! \brief Hilbert tile ID
+     *
+     *  @param zoom Zoom level of the tile, in the range [0, 31]
+     *
+     *  @param x x-Coordinate of the tile
+     *
+     *  @param y y-Coordinate of the tile
+     *
+     *  @returns Tile ID, as specified in the PMTILES specification
+     */
+    [[nodiscard]] static quint64 tileID(int zoom, quint32 x, quint32 y);
+
+    /*! \brief Tile coordinates of a Hilbert tile ID
+     *
+     *  This method is the inverse of tileID().
+     *
+     *  @param tileID Tile ID, as specified in the PMTILES specification
+     *
+     *  @returns Coordinates of the tile
+     */
+    [[nodiscard]] static TileCoordinates coordinates(quint64 tileID);
+
+    /*! \brief Check if a file is in PMTILES format
+     *
+     *  @param fileName Name of the file
+     *
+     *  @returns True if the file begins with the PMTILES magic number
+     */
+    [[nodiscard]] static bool isPMTILES(const QString& fileName);
+
+    /*! \brief Convert MBTILES file to PMTILES
+     *
+     *  This method reads all tiles from an MBTILES file and writes them,
+     *  together with the metadata, to a PMTILES file. Identical tiles are
+     *  stored only once. Directories are not compressed, tiles are copied
+     *  as they are. The method reads the MBTILES file twice and is expensive.
+     *
+     *  @param mbtilesFileName Name of the MBTILES file
+     *
+     *  @param pmtilesFileName Name of the PMTILES file. The file is written
+     *  atomically.
+     *
+     *  @returns A human-readable error message, or an empty string on success
+     */
+    [[nodiscard]] static QString fromMBTILES(const QString& mbtilesFileName, const QString& pmtilesFileName);
+
+private:
+    Q_DISABLE_COPY_MOVE(PMTILES)
+
+    // Compression types, as specified in the PMTILES specification
+    enum Compression : quint8
+    {
+        UnknownCompression = 0,
+        None = 1,
+        Gzip = 2,
+        Brotli = 3,
+        Zstd = 4,
+    };
+
+    // Tile types, as specified in the PMTILES specification
+    enum TileType : quint8
+    {
+        UnknownTileType = 0,
+        MVT = 1,
+        PNG = 2,
+        JPEG = 3,
+        WEBP = 4,
+        AVIF = 5,
+    };
+
+    // Directory entry, as specified in the PMTILES specification. Entries
+    // with runLength == 0 point to leaf directories.
+    struct Entry
+    {
+        quint64 tileID {0};
+        quint64 offset {0};
+        quint32 length {0};
+        quint32 runLength {0};
+    };
+    using Directory = QList<Entry>;
+
+    // Decodes a directory. Returns an empty directory on error.
+    [[nodiscard]] Directory directory(quint64 offset, quint64 length) const;
+
+    // Decompresses data according to m_internalCompression. Returns an empty
+    // QByteArray on error.
+    [[nodiscard]] QByteArray decompress(QByteArrayView data) const;
+
+    // Serializes a directory
+    [[nodiscard]] static QByteArray serialize(const Directory& directory);
+
+    // Memory-mapped file
+    QSharedPointer<QFile> m_file;
+    const uchar* m_data {nullptr};
+    qint64 m_size {0};
+
+    // Data from the header
+    quint64 m_leafDirectoriesOffset {0};
+    quint64 m_leafDirectoriesLength {0};
+    quint64 m_tileDataOffset {0};
+    quint64 m_tileDataLength {0};
+    Compression m_internalCompression {UnknownCompression};
+    Compression m_tileCompression {UnknownCompression};
+    TileType m_tileType {UnknownTileType};
+
+    // Root directory
+    Directory m_rootDirectory;
+
+    // Leaf directories, by offset. Access is protected by m_leafDirectoriesMutex.
+    QCache<quint64, Directory> m_leafDirectories {64};
+    QMutex m_leafDirectoriesMutex;
+};
+
+} // namespace FileFormats
@@ -0,0 +1,59 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "fileFormats/MBTILES.h"
+#include "fileFormats/PMTILES.h"
+#include "fileFormats/TileFileAbstract.h"
+
+using namespace Qt::Literals::StringLiterals;
+
+
+QString FileFormats::TileFileAbstract::info() const
+{
+    QMapIterator<QString, QString> i(m_metadata);
+    QString intResult;
+    while (i.hasNext()) {
+        i.next();
+
+        if (i.key() == u"json")
+        {
+            continue;
+        }
+        intResult += QStringLiteral("<tr><td><strong>%1 :&nbsp;&nbsp;</strong></td><td>%2</td></tr>")
+                         .arg(i.key(), i.value());
+    }
+
+    QString result;
+    if (!intResult.isEmpty())
+    {
+        result += QStringLiteral("<table>%1</table>").arg(intResult);
+    }
+    return result;
+}
+
+
+QSharedPointer<FileFormats::TileFileAbstract> FileFormats::TileFileAbstract::open(const QString& fileName)
+{
+    if (PMTILES::isPMTILES(fileName))
+    {
+        return QSharedPointer<TileFileAbstract>(new PMTILES(fileName));
+    }
+    return QSharedPointer<TileFileAbstract>(new MBTILES(fileName));
+}
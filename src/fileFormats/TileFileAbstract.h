@@ -0,0 +1,169 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QMap>
+#include <QSharedPointer>
+#include <QString>
+
+#include "fileFormats/DataFileAbstract.h"
+
+
+namespace FileFormats
+{
+
+/*! \brief Base class for files that contain tiled map data
+ *
+ *  This is an abstract base class for MBTILES and PMTILES. It describes the
+ *  methods that TileServer and GeoMapProvider use to access tile data, so
+ *  that files of both formats can be used interchangeably. Use the static
+ *  method open() to construct an instance of the appropriate subclass.
+ */
+
+class TileFileAbstract : public DataFileAbstract
+{
+
+public:
+    /*! \brief Format of data tiles */
+    enum Format : quint8
+    {
+        /*! \brief Unknown format */
+        Unknown,
+
+        /*! \brief Vector data in PBF format */
+        Vector,
+
+        /*! \brief Raster data in JPG, PNG or WEBP format */
+        Raster,
+    };
+
+    /*! \brief Coordinates of a tile */
+    struct TileCoordinates
+    {
+        int zoom {0};
+        int x {0};
+        int y {0};
+    };
+
+    TileFileAbstract() = default;
+    virtual ~TileFileAbstract() = default;
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Attribution of the file
+     *
+     *  @returns A human-readable HTML-String with attribution, or an empty
+     *  string on error.
+     */
+    [[nodiscard]] virtual QString attribution() = 0;
+
+    /*! \brief Determine type of data contained in the file
+     *
+     *  @returns Type of data, or Unknown on error.
+     */
+    [[nodiscard]] virtual Format format() = 0;
+
+    /*! \brief Information about the file
+     *
+     *  @returns A human-readable HTML-String with the metadata of the file,
+     *  or an empty string on error.
+     */
+    [[nodiscard]] QString info() const;
+
+    /*! \brief Retrieve tile
+     *
+     *  @param zoom Zoom level of the tile
+     *
+     *  @param x x-Coordinate of the tile
+     *
+     *  @param y y-Coordinate of the tile
+     *
+     *  @returns A QByteArray with the tile data, or an empty QByteArray on
+     *  error. Depending on the subclass, the QByteArray might refer to memory
+     *  owned by this instance, and must not be used after the instance has
+     *  been destroyed.
+     */
+    [[nodiscard]] virtual QByteArray tile(int zoom, int x, int y) = 0;
+
+    /*! \brief List all tiles
+     *
+     *  @returns A list with the coordinates of all tiles, or an empty list on
+     *  error. As in tile(), the y-coordinate counts from the north.
+     */
+    [[nodiscard]] virtual QList<TileCoordinates> tileCoordinates() = 0;
+
+    /*! \brief Check if tile data is gzip-compressed
+     *
+     *  @returns True if the data returned by tile() is compressed with gzip,
+     *  and must be served with the HTTP header "Content-Encoding: gzip".
+     */
+    [[nodiscard]] virtual bool isTileDataGzipped() const = 0;
+
+    /*! \brief Retrieve tile size of raster data
+     *
+     *  @returns A tile size (typically 256 or 512), or the default value
+     *  512 if the data is not available. The value returned is never
+     *  negative.
+     */
+    [[nodiscard]] virtual int tileSize() = 0;
+
+    /*! \brief Retrieve metadata
+     *
+     *  @returns A QMap containing the metadata, as a list of key/value
+     *  pairs, or an empty QMap on error.
+     */
+    [[nodiscard]] QMap<QString, QString> metaData() const { return m_metadata; }
+
+    /*! \brief Retrieve file name
+     *
+     *  @returns Filename, as given in the constructor
+     */
+    [[nodiscard]] QString fileName() const { return m_fileName; }
+
+    /*! \brief Open file with tiled map data
+     *
+     *  This method checks if the file is in PMTILES format and constructs an
+     *  instance of PMTILES or MBTILES accordingly.
+     *
+     *  @param fileName Name of the file
+     *
+     *  @returns Pointer to the new instance. This is never a nullptr, but the
+     *  instance might be invalid.
+     */
+    [[nodiscard]] static QSharedPointer<TileFileAbstract> open(const QString& fileName);
+
+protected:
+    // Name of the file
+    QString m_fileName;
+
+    // Metadata
+    QMap<QString, QString> m_metadata;
+
+private:
+    Q_DISABLE_COPY_MOVE(TileFileAbstract)
+};
+
+} // namespace FileFormats
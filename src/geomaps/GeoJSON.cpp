@@ -37,14 +37,20 @@ GeoMaps::GeoJSON::fileContent GeoMaps::GeoJSON::inspect(const QString& fileName)
         return GeoMaps::GeoJSON::invalid;
     }
     auto fileContent = file->readAll();
-    if (fileContent.isEmpty())
+    file->close();
+    return inspect(fileContent);
+}
+
+
+GeoMaps::GeoJSON::fileContent GeoMaps::GeoJSON::inspect(const QByteArray& data)
+{
+    if (data.isEmpty())
     {
         return GeoMaps::GeoJSON::invalid;
     }
-    file->close();
 
     QJsonParseError parseError{};
-    auto document = QJsonDocument::fromJson(fileContent, &parseError);
+    auto document = QJsonDocument::fromJson(data, &parseError);
     if (parseError.error != QJsonParseError::NoError)
     {
         return GeoMaps::GeoJSON::invalid;
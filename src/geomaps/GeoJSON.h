@@ -78,6 +78,17 @@ namespace GeoMaps
          */
         static fileContent inspect(const QString& fileName);
 
+        /*! \brief Inspect data
+         *
+         *  Same as inspect(const QString&), for data that has already been
+         *  read, such as the content of a FileFormats::FileProbe.
+         *
+         *  @param data File content
+         *
+         *  @returns Most probably file type
+         */
+        static fileContent inspect(const QByteArray& data);
+
         /*! \brief Read a GeoJSON file
          *
          *  This method reads a GeoJSON file and generates a vector of waypoints.
@@ -1,5 +1,5 @@
 /***************************************************************************
- *   Copyright (C) 2019-2025 by Stefan Kebekus                             *
+ *   Copyright (C) 2019-2026 by Stefan Kebekus                             *
  *   stefan.kebekus@gmail.com                                              *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
@@ -18,6 +18,8 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <QCryptographicHash>
+#include <QDir>
 #include <QImage>
 #include <QJsonArray>
 #include <QJsonDocument>
@@ -26,10 +28,13 @@
 #include <QQmlEngine>
 #include <QRandomGenerator>
 #include <QtConcurrent/QtConcurrentRun>
+#include <numeric>
 
 #include "GlobalSettings.h"
 #include "Librarian.h"
+#include "Trace.h"
 #include "dataManagement/DataManager.h"
+#include "fileFormats/DEM.h"
 #include "fileFormats/MBTILES.h"
 #include "fileFormats/VACCollection.h"
 #include "geomaps/GeoMapProvider.h"
@@ -58,8 +63,10 @@ GeoMaps::GeoMapProvider::GeoMapProvider(QObject *parent)
     }
     geoJSONCacheFile.close();
 
+    m_terrainMapThreadPool.setMaxThreadCount(1);
+
     // Pass signal through when the tile server changes its URL
-    connect(&m_tileServer, &GeoMaps::TileServer::serverUrlChanged, this, [this]() {emit styleFileURLChanged();});
+    connect(&m_tileServer, &GeoMaps::TileServer::serverUrlChanged, this, [this]() {m_tileServer.removeStyles(); emit styleFileURLChanged();});
 }
 
 void GeoMaps::GeoMapProvider::deferredInitialization()
@@ -69,7 +76,7 @@ void GeoMaps::GeoMapProvider::deferredInitialization()
     connect(GlobalObject::dataManager()->baseMaps(), &DataManagement::Downloadable_Abstract::filesChanged, this, &GeoMaps::GeoMapProvider::onMBTILESChanged);
     connect(GlobalObject::dataManager()->terrainMaps(), &DataManagement::Downloadable_Abstract::fileContentChanged_delayed, this, &GeoMaps::GeoMapProvider::onMBTILESChanged);
     connect(GlobalObject::globalSettings(), &GlobalSettings::hideGlidingSectorsChanged, this, &GeoMaps::GeoMapProvider::onAviationMapsChanged);
-    connect(GlobalObject::globalSettings(), &GlobalSettings::nightModeChanged, this, [this]() {delete m_styleFile; emit styleFileURLChanged();});
+    connect(GlobalObject::globalSettings(), &GlobalSettings::nightModeChanged, this, &GeoMaps::GeoMapProvider::styleFileURLChanged);
 
     connect(&m_tileServer, &GeoMaps::TileServer::serverUrlChanged, this, &GeoMaps::GeoMapProvider::serverUrlChanged);
 
@@ -180,43 +187,51 @@ QString GeoMaps::GeoMapProvider::copyrightNotice()
 
 QString GeoMaps::GeoMapProvider::styleFileURL()
 {
-    if (m_styleFile.isNull())
+    // The night-mode style refers to the night-mode sprite sheets, which are
+    // prepared in the background once night mode is first switched on
+    if (GlobalObject::globalSettings()->nightMode())
     {
-        QFile file;
-        if (GlobalObject::dataManager()->baseMaps()->hasFile())
+        m_tileServer.prepareNightSprites();
+    }
+
+    QString fileName = u":/flightMap/empty.json"_s;
+    if (GlobalObject::dataManager()->baseMaps()->hasFile())
+    {
+        if (GlobalObject::globalSettings()->nightMode())
         {
-            if (GlobalObject::globalSettings()->nightMode())
-            {
-                file.setFileName(QStringLiteral(":/flightMap/osm-liberty-dark.json"));
-            }
-            else
-            {
-                file.setFileName(QStringLiteral(":/flightMap/osm-liberty.json"));
-            }
+            fileName = u":/flightMap/osm-liberty-dark.json"_s;
         }
         else
         {
-            file.setFileName(QStringLiteral(":/flightMap/empty.json"));
+            fileName = u":/flightMap/osm-liberty.json"_s;
         }
+    }
 
+    return styleURL(m_tileServer, fileName, _currentBaseMapPath, _currentTerrainMapPath);
+}
+
+QString GeoMaps::GeoMapProvider::styleURL(GeoMaps::TileServer& tileServer, const QString& fileName, const QString& baseMapPath, const QString& terrainMapPath)
+{
+    // The style document contains the URL of the base map, so its name
+    // includes the base map path, which changes whenever the base map does.
+    // Documents for all variants stay on the tile server until they become
+    // invalid, so that switching between day and night mode is cheap.
+    auto const styleName = u"%1-%2.json"_s.arg(QFileInfo(fileName).baseName(), baseMapPath);
+    if (!tileServer.hasStyle(styleName))
+    {
+        QFile file(fileName);
         QByteArray data;
         if (file.open(QIODevice::ReadOnly))
         {
             data = file.readAll();
-            data.replace("%URL%", (m_tileServer.serverUrl() + u"/"_s + _currentBaseMapPath).toLatin1());
-            data.replace("%URLT%", (m_tileServer.serverUrl() + u"/"_s + _currentTerrainMapPath).toLatin1());
-            data.replace("%URL2%", m_tileServer.serverUrl().toLatin1());
+            data.replace("%URL%", (tileServer.serverUrl() + u"/"_s + baseMapPath).toLatin1());
+            data.replace("%URLT%", (tileServer.serverUrl() + u"/"_s + terrainMapPath).toLatin1());
+            data.replace("%URL2%", tileServer.serverUrl().toLatin1());
             file.close();
         }
-
-        m_styleFile = new QTemporaryFile(this);
-        if (m_styleFile->open())
-        {
-            m_styleFile->write(data);
-            m_styleFile->close();
-        }
+        tileServer.addStyle(styleName, data);
     }
-    return u"file://"_s + m_styleFile->fileName();
+    return tileServer.serverUrl() + u"/style/"_s + styleName;
 }
 
 
@@ -225,10 +240,19 @@ QString GeoMaps::GeoMapProvider::styleFileURL()
 //
 
 QVariantList GeoMaps::GeoMapProvider::airspacesAtPosition(const QGeoCoordinate& position)
+{
+    QVariantList final;
+    foreach(auto airspace, airspacesAtPosition(m_airspaces.value(), position))
+        final.append( QVariant::fromValue(airspace) );
+
+    return final;
+}
+
+QVector<GeoMaps::Airspace> GeoMaps::GeoMapProvider::airspacesAtPosition(const QVector<Airspace>& airspaces, const QGeoCoordinate& position)
 {
     QVector<Airspace> result;
     result.reserve(10);
-    foreach(auto airspace, m_airspaces.value()) {
+    foreach(auto airspace, airspaces) {
         if (airspace.polygon().contains(position)) {
             result.append(airspace);
         }
@@ -244,51 +268,22 @@ QVariantList GeoMaps::GeoMapProvider::airspacesAtPosition(const QGeoCoordinate&
         }
         return (first.estimatedUpperBoundMSL(Units::Distance::fromFT(0), Units::Pressure::fromHPa(1013.2), Units::Distance::fromFT(0), Units::Distance::fromFT(0)) > second.estimatedUpperBoundMSL(Units::Distance::fromFT(0), Units::Pressure::fromHPa(1013.2), Units::Distance::fromFT(0), Units::Distance::fromFT(0)));
     });
-
-    QVariantList final;
-    foreach(auto airspace, result)
-        final.append( QVariant::fromValue(airspace) );
-
-    return final;
+    return result;
 }
 
 GeoMaps::Waypoint GeoMaps::GeoMapProvider::closestWaypoint(QGeoCoordinate position, const QGeoCoordinate& distPosition)
 {
     position.setAltitude(qQNaN());
 
-    Waypoint result;
-    const auto wayppoints = waypoints();
-    for(const auto& waypoint : wayppoints)
-    {
-        if (!waypoint.isValid())
-        {
-            continue;
-        }
-        if (!result.isValid())
-        {
-            result = waypoint;
-        }
-        if (position.distanceTo(waypoint.coordinate()) < position.distanceTo(result.coordinate()))
-        {
-            result = waypoint;
-        }
-    }
+    // Waypoints that are further away than distPosition are not interesting
+    auto const radius = Units::Distance::fromM(position.distanceTo(distPosition));
 
-    const auto wpLibrary = GlobalObject::waypointLibrary()->waypoints();
-    for(const auto& wayppoint : wpLibrary)
+    auto result = m_waypointSpatialIndex.nearestWithin(position, radius);
+    auto const libraryCandidate = GlobalObject::waypointLibrary()->spatialIndex().nearestWithin(position, radius);
+    if (libraryCandidate.isValid() &&
+        (!result.isValid() || (position.distanceTo(libraryCandidate.coordinate()) < position.distanceTo(result.coordinate()))))
     {
-        if (!wayppoint.isValid())
-        {
-            continue;
-        }
-        if (!result.isValid())
-        {
-            result = wayppoint;
-        }
-        if (position.distanceTo(wayppoint.coordinate()) < position.distanceTo(result.coordinate()))
-        {
-            result = wayppoint;
-        }
+        result = libraryCandidate;
     }
 
     for(auto& waypoint : GlobalObject::navigator()->flightRoute()->midFieldWaypoints() )
@@ -297,13 +292,17 @@ GeoMaps::Waypoint GeoMaps::GeoMapProvider::closestWaypoint(QGeoCoordinate positi
         {
             continue;
         }
-        if (position.distanceTo(waypoint.coordinate()) < position.distanceTo(result.coordinate()))
+        if (position.distanceTo(waypoint.coordinate()) > radius.toM())
+        {
+            continue;
+        }
+        if (!result.isValid() || (position.distanceTo(waypoint.coordinate()) < position.distanceTo(result.coordinate())))
         {
             result = waypoint;
         }
     }
 
-    if (!result.isValid() || (position.distanceTo(result.coordinate()) > position.distanceTo(distPosition)))
+    if (!result.isValid())
     {
         position.setAltitude( terrainElevationAMSL(position).toM() );
         return {position};
@@ -311,6 +310,10 @@ GeoMaps::Waypoint GeoMaps::GeoMapProvider::closestWaypoint(QGeoCoordinate positi
     return result;
 }
 
+// Range of zoom levels used for terrain elevation
+constexpr int terrainZoomMin = 6;
+constexpr int terrainZoomMax = 10;
+
 Units::Distance decodeImageData(const QImage* image, double intraTileX, double intraTileY)
 {
     if ((image == nullptr) || !qIsFinite(intraTileX) || !qIsFinite(intraTileY) ||
@@ -346,10 +349,24 @@ Units::Distance GeoMaps::GeoMapProvider::terrainElevationAMSL(const QGeoCoordina
         return {};
     }
 
-    const int zoomMin = 6;
-    const int zoomMax = 10;
+    // Prefer the elevation models, which do not require decoding
+    for(const auto& dem : std::as_const(m_terrainDEMs))
+    {
+        auto const elevation = dem->elevation(coordinate);
+        if (elevation.isFinite())
+        {
+            return elevation;
+        }
+    }
+
+    return terrainElevationFromTiles(m_terrainMapTiles, terrainTileCache, coordinate);
+}
 
-    for(int zoom = zoomMax; zoom >= zoomMin; zoom--)
+Units::Distance GeoMaps::GeoMapProvider::terrainElevationFromTiles(const QList<QSharedPointer<FileFormats::TileFileAbstract>>& terrainMapTiles,
+                                                                   QCache<qint64,QImage>& cache,
+                                                                   const QGeoCoordinate& coordinate)
+{
+    for(int zoom = terrainZoomMax; zoom >= terrainZoomMin; zoom--)
     {
         auto tilex = (coordinate.longitude()+180.0)/360.0 * (1<<zoom);
         auto tiley = (1.0 - asinh(tan(qDegreesToRadians(coordinate.latitude())))/M_PI)/2.0 * (1<<zoom);
@@ -360,16 +377,16 @@ Units::Distance GeoMaps::GeoMapProvider::terrainElevationAMSL(const QGeoCoordina
         const qint64 keyB = qFloor(tiley) & 0xFFFF;
         const qint64 key = (keyA << 32) + (keyB << 16) + zoom;
 
-        if (terrainTileCache.contains(key))
+        if (cache.contains(key))
         {
-            auto* tileImg = terrainTileCache.object(key);
+            auto* tileImg = cache.object(key);
             if (!tileImg->isNull())
             {
                 return decodeImageData(tileImg, intraTileX, intraTileY);
             }
         }
 
-        foreach(auto mbtPtr, m_terrainMapTiles)
+        foreach(auto mbtPtr, terrainMapTiles)
         {
             if (mbtPtr.isNull())
             {
@@ -390,7 +407,7 @@ Units::Distance GeoMaps::GeoMapProvider::terrainElevationAMSL(const QGeoCoordina
                 continue;
             }
 
-            terrainTileCache.insert(key, tileImg);
+            cache.insert(key, tileImg);
             return decodeImageData(tileImg, intraTileX, intraTileY);
         }
     }
@@ -409,60 +426,33 @@ QByteArray GeoMaps::GeoMapProvider::emptyGeoJSON()
 
 QVector<GeoMaps::Waypoint> GeoMaps::GeoMapProvider::filteredWaypoints(const QString& filter)
 {
+    auto const filterWords = WaypointSearchIndex::searchWords(filter);
 
-    QStringList filterWords;
-    foreach(auto word, filter.simplified().split(' ', Qt::SkipEmptyParts)) {
-        QString const simplifiedWord = GlobalObject::librarian()->simplifySpecialChars(word);
-        if (simplifiedWord.isEmpty()) {
-            continue;
-        }
-        filterWords.append(simplifiedWord);
-    }
-
-    QVector<GeoMaps::Waypoint> result;
-
-    const auto wps = waypoints();
-    for(const auto& waypoint : wps) {
-        if (!waypoint.isValid()) {
-            continue;
-        }
-        bool allWordsFound = true;
-        foreach(auto word, filterWords) {
-            QString const fullName = GlobalObject::librarian()->simplifySpecialChars(waypoint.name());
-            if (!fullName.contains(word, Qt::CaseInsensitive) && !waypoint.ICAOCode().contains(word, Qt::CaseInsensitive)) {
-                allWordsFound = false;
-                break;
-            }
-        }
-        if (allWordsFound) {
-            result.append( waypoint );
-        }
+    // Waypoints from the map. If the user has just typed one more character,
+    // search within the result of the previous search.
+    QVector<qsizetype> matches;
+    if (m_lastFilterValid && WaypointSearchIndex::isRefinement(m_lastFilterWords, filterWords))
+    {
+        matches = m_waypointSearchIndex.refine(m_lastFilterMatches, filterWords);
     }
-
-    const auto wpsLib = GlobalObject::waypointLibrary()->waypoints();
-    for(const auto& waypoint : wpsLib)
+    else
     {
-        if (!waypoint.isValid())
-        {
-            continue;
-        }
-        bool allWordsFound = true;
-        for(auto& word : filterWords)
-        {
-            QString const fullName = GlobalObject::librarian()->simplifySpecialChars(waypoint.name());
-            if (!fullName.contains(word, Qt::CaseInsensitive) && !waypoint.ICAOCode().contains(word, Qt::CaseInsensitive))
-            {
-                allWordsFound = false;
-                break;
-            }
-        }
-        if (allWordsFound) {
-            result.append( waypoint );
-        }
+        matches = m_waypointSearchIndex.search(filterWords);
     }
+    m_lastFilterWords = filterWords;
+    m_lastFilterMatches = matches;
+    m_lastFilterValid = true;
+    auto const mapResult = m_waypointSearchIndex.waypoints(matches);
 
-    std::sort(result.begin(), result.end(), [](const Waypoint& first, const Waypoint& second) {return first.name() < second.name(); });
+    // Waypoints from the library
+    const auto& libraryIndex = GlobalObject::waypointLibrary()->searchIndex();
+    auto const libraryResult = libraryIndex.waypoints(libraryIndex.search(filterWords));
 
+    // Both lists are sorted by name, merge them
+    QVector<GeoMaps::Waypoint> result;
+    result.reserve(mapResult.size() + libraryResult.size());
+    std::merge(mapResult.cbegin(), mapResult.cend(), libraryResult.cbegin(), libraryResult.cend(), std::back_inserter(result),
+               [](const Waypoint& first, const Waypoint& second) {return first.name() < second.name(); });
     return result;
 }
 
@@ -485,39 +475,18 @@ GeoMaps::Waypoint GeoMaps::GeoMapProvider::findByID(const QString& icaoID)
 
 QList<GeoMaps::Waypoint> GeoMaps::GeoMapProvider::nearbyWaypoints(const QGeoCoordinate& position, const QString& type)
 {
-    QVector<Waypoint> tWps;
-
-    auto wps = waypoints();
-    for(auto& waypoint : wps)
-    {
-        if (!waypoint.isValid())
-        {
-            continue;
-        }
-        if (waypoint.type() != type)
-        {
-            continue;
-        }
-        tWps.append(waypoint);
-    }
+    const qsizetype maxCount = 20;
 
-    auto wpsLib = GlobalObject::waypointLibrary()->waypoints();
-    for(const auto& waypoint : std::as_const(wpsLib))
-    {
-        if (!waypoint.isValid())
-        {
-            continue;
-        }
-        if (waypoint.type() != type)
-        {
-            continue;
-        }
-        tWps.append(waypoint);
-    }
+    // Both lists are sorted by distance, merge them
+    auto const mapResult = m_waypointSpatialIndex.nearest(position, maxCount, type);
+    auto const libraryResult = GlobalObject::waypointLibrary()->spatialIndex().nearest(position, maxCount, type);
 
-    std::sort(tWps.begin(), tWps.end(), [position](const Waypoint& first, const Waypoint& second) {return position.distanceTo(first.coordinate()) < position.distanceTo(second.coordinate()); });
+    QVector<Waypoint> result;
+    result.reserve(mapResult.size() + libraryResult.size());
+    std::merge(mapResult.cbegin(), mapResult.cend(), libraryResult.cbegin(), libraryResult.cend(), std::back_inserter(result),
+               [position](const Waypoint& first, const Waypoint& second) {return position.distanceTo(first.coordinate()) < position.distanceTo(second.coordinate()); });
 
-    return tWps.mid(0,20);
+    return result.mid(0, maxCount);
 }
 
 QVector<GeoMaps::Waypoint> GeoMaps::GeoMapProvider::waypoints()
@@ -532,7 +501,7 @@ void GeoMaps::GeoMapProvider::setCurrentRasterMap(const QString& mapName)
         return;
     }
 
-    auto newRasterMap = QSharedPointer<FileFormats::MBTILES>(new FileFormats::MBTILES());
+    QSharedPointer<FileFormats::TileFileAbstract> newRasterMap(new FileFormats::MBTILES());
     QString newRasterMapName;
     if (!mapName.isEmpty())
     {
@@ -549,7 +518,7 @@ void GeoMaps::GeoMapProvider::setCurrentRasterMap(const QString& mapName)
 
     const QScopedPropertyUpdateGroup guard;
     m_tileServer.removeMbtilesFileSet(u"rasterMap"_s);
-    const QVector<QSharedPointer<FileFormats::MBTILES>> single {newRasterMap};
+    const QVector<QSharedPointer<FileFormats::TileFileAbstract>> single {newRasterMap};
     m_tileServer.addMbtilesFileSet(u"rasterMap"_s, single);
     m_currentRasterMap = newRasterMapName;
     m_currentRasterMapTileSize = newRasterMap->tileSize();
@@ -557,6 +526,63 @@ void GeoMaps::GeoMapProvider::setCurrentRasterMap(const QString& mapName)
 }
 
 
+QList<Units::Distance> GeoMaps::GeoMapProvider::terrainElevationsAMSL(const QList<QGeoCoordinate>& coordinates)
+{
+    Trace::Span const span("GeoMapProvider::terrainElevationsAMSL");
+
+    // Every elevation model is queried once, with all coordinates that have
+    // no elevation yet. The terrain map tiles are decoded only for the rest.
+    QList<Units::Distance> result(coordinates.size());
+    QList<qsizetype> missing(coordinates.size());
+    std::iota(missing.begin(), missing.end(), 0);
+    for(const auto& dem : std::as_const(m_terrainDEMs))
+    {
+        if (missing.isEmpty())
+        {
+            break;
+        }
+
+        QList<Units::Distance> elevations;
+        if (missing.size() == coordinates.size())
+        {
+            elevations = dem->elevations(coordinates);
+        }
+        else
+        {
+            QList<QGeoCoordinate> query;
+            query.reserve(missing.size());
+            for(auto index : std::as_const(missing))
+            {
+                query.append(coordinates[index]);
+            }
+            elevations = dem->elevations(query);
+        }
+
+        QList<qsizetype> stillMissing;
+        for(qsizetype i = 0; i < missing.size(); i++)
+        {
+            if (elevations[i].isFinite())
+            {
+                result[missing[i]] = elevations[i];
+            }
+            else
+            {
+                stillMissing.append(missing[i]);
+            }
+        }
+        missing = stillMissing;
+    }
+
+    for(auto index : std::as_const(missing))
+    {
+        if (coordinates[index].isValid())
+        {
+            result[index] = terrainElevationFromTiles(m_terrainMapTiles, terrainTileCache, coordinates[index]);
+        }
+    }
+    return result;
+}
+
 //
 // Private Methods and Slots
 //
@@ -608,12 +634,17 @@ void GeoMaps::GeoMapProvider::onAviationMapsChanged()
         JSONFileNames += geoMapPtr->fileName();
     }
 
-    _aviationDataCacheFuture = QtConcurrent::run(&GeoMaps::GeoMapProvider::fillAviationDataCache, this, JSONFileNames, GlobalObject::globalSettings()->hideGlidingSectors());
+    _aviationDataCacheFuture = QtConcurrent::run([this, JSONFileNames, hideGlidingSectors = GlobalObject::globalSettings()->hideGlidingSectors()]() {
+        return fillAviationDataCache(m_aviationMapSegments, JSONFileNames, hideGlidingSectors);
+    });
     _aviationDataCacheFuture.then(this, [this](GeoMaps::GeoMapProvider::aviationDataCacheResult result) {
         m_airspaces = result.airspaces;
         if (_waypoints_ != result.waypoints)
         {
             _waypoints_ = result.waypoints;
+            m_waypointSearchIndex = result.waypointSearchIndex;
+            m_waypointSpatialIndex = result.waypointSpatialIndex;
+            m_lastFilterValid = false;
             emit waypointsChanged();
         }
         m_combinedGeoJSON = result.combinedGeoJSON;
@@ -630,7 +661,7 @@ void GeoMaps::GeoMapProvider::onMBTILESChanged()
 {
     terrainTileCache.clear();
 
-    QList<QSharedPointer<FileFormats::MBTILES>> newBaseMapRasterTiles;
+    QList<QSharedPointer<FileFormats::TileFileAbstract>> newBaseMapRasterTiles;
     for (auto* downloadableX : GlobalObject::dataManager()->baseMapsRaster()->downloadables())
     {
         auto* downloadable = qobject_cast<DataManagement::Downloadable_SingleFile*>(downloadableX);
@@ -643,7 +674,7 @@ void GeoMaps::GeoMapProvider::onMBTILESChanged()
             continue;
         }
 
-        newBaseMapRasterTiles.append(QSharedPointer<FileFormats::MBTILES>(new FileFormats::MBTILES(downloadable->fileName())));
+        newBaseMapRasterTiles.append(FileFormats::TileFileAbstract::open(downloadable->fileName()));
     }
     m_baseMapRasterTiles = newBaseMapRasterTiles;
 
@@ -661,7 +692,7 @@ void GeoMaps::GeoMapProvider::onMBTILESChanged()
             continue;
         }
 
-        m_baseMapVectorTiles.append(QSharedPointer<FileFormats::MBTILES>(new FileFormats::MBTILES(downloadable->fileName())));
+        m_baseMapVectorTiles.append(FileFormats::TileFileAbstract::open(downloadable->fileName()));
     }
 
     m_terrainMapTiles.clear();
@@ -677,8 +708,10 @@ void GeoMaps::GeoMapProvider::onMBTILESChanged()
             continue;
         }
 
-        m_terrainMapTiles.append(QSharedPointer<FileFormats::MBTILES>(new FileFormats::MBTILES(downloadable->fileName())));
+        m_terrainMapTiles.append(FileFormats::TileFileAbstract::open(downloadable->fileName()));
     }
+    m_terrainDEMs.clear();
+    updateTerrainDEMs();
     emit terrainMapTilesChanged();
 
     // Stop serving tiles
@@ -692,103 +725,214 @@ void GeoMaps::GeoMapProvider::onMBTILESChanged()
     m_tileServer.addMbtilesFileSet(_currentTerrainMapPath, m_terrainMapTiles);
 
     // Update style file
-    delete m_styleFile;
+    m_tileServer.removeStyles();
     emit styleFileURLChanged();
 }
 
-GeoMaps::GeoMapProvider::aviationDataCacheResult GeoMaps::GeoMapProvider::fillAviationDataCache(QStringList JSONFileNames, bool hideGlidingSectors)
+void GeoMaps::GeoMapProvider::updateTerrainDEMs()
 {
-    // Ensure that order is the same every time
-    JSONFileNames.sort();
-
-    //
-    // Generate new GeoJSON array and new list of waypoints
-    //
+    QStringList terrainFileNames;
+    for(const auto& terrainMapTiles : std::as_const(m_terrainMapTiles))
+    {
+        if (terrainMapTiles->isValid())
+        {
+            terrainFileNames += terrainMapTiles->fileName();
+        }
+    }
 
-    // First, create a vector of JSON objects.
-    // We use a QSet to keep track of objects that have already been added in order to avoid duplicated entries.
-    // The vector is used to ensure that the order of the objects remains identical during runs.
-    // A QSet seems to have some built-in randomness and does not do that.
-    QVector<QJsonObject> objectVector;
-    {
-        QSet<QJsonObject> objectSet;
-        for(const auto& JSONFileName : JSONFileNames)
-        {
-            // Read the lock file
-            QLockFile lockFile(JSONFileName + u".lock"_s);
-            lockFile.lock();
-            QFile file(JSONFileName);
-            QJsonDocument document;
-            if (file.open(QIODevice::ReadOnly))
+    auto const generation = ++m_terrainDEMGeneration;
+    QtConcurrent::run(&m_terrainMapThreadPool, &GeoMaps::GeoMapProvider::buildTerrainDEMs, terrainFileNames).then(this, [this, generation](const QStringList& demFileNames) {
+        if (generation != m_terrainDEMGeneration)
+        {
+            return;
+        }
+        m_terrainDEMs.clear();
+        for(const auto& demFileName : demFileNames)
+        {
+            auto dem = QSharedPointer<FileFormats::DEM>(new FileFormats::DEM(demFileName));
+            if (dem->isValid())
             {
-                document = QJsonDocument::fromJson(file.readAll());
-                file.close();
+                m_terrainDEMs.append(dem);
             }
-            lockFile.unlock();
+        }
+        terrainTileCache.clear();
+        emit terrainMapTilesChanged();
+    });
+}
 
-            for(const auto& value : document.object()[QStringLiteral("features")].toArray())
+QStringList GeoMaps::GeoMapProvider::buildTerrainDEMs(const QStringList& terrainFileNames)
+{
+    Trace::Span const span("GeoMapProvider::buildTerrainDEMs");
+
+    QString const directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + u"/terrain"_s;
+    QDir().mkpath(directory);
+
+    // Elevation models are named after a digest of the name, modification
+    // time and size of the terrain map, so that they are rebuilt when the map
+    // is updated. Unlike qHash(), the digest does not change between runs.
+    QStringList result;
+    for(const auto& terrainFileName : terrainFileNames)
+    {
+        QFileInfo const info(terrainFileName);
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        hash.addData(terrainFileName.toUtf8());
+        hash.addData("\n" + QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+        hash.addData("\n" + QByteArray::number(info.size()));
+        auto const demFileName = u"%1/%2.dem"_s.arg(directory, QString::fromLatin1(hash.result().toHex()));
+        if (!QFile::exists(demFileName))
+        {
+            auto const error = FileFormats::DEM::fromTerrainTiles(terrainFileName, demFileName, terrainZoomMax);
+            if (!error.isEmpty())
             {
-                auto object = value.toObject();
-                if (objectSet.contains(object))
-                {
-                    continue;
-                }
-                objectVector += object;
-                objectSet += object;
+                qWarning() << "GeoMapProvider: Unable to convert terrain map" << terrainFileName << error;
+                continue;
             }
         }
+        result += demFileName;
     }
 
-    // Create vectors of airspaces and waypoints
-    QVector<Airspace> newAirspaces;
-    QVector<Waypoint> newWaypoints;
-    for(const auto& object : std::as_const(objectVector))
+    // Delete outdated elevation models
+    for(const auto& entry : QDir(directory).entryInfoList({u"*.dem"_s}, QDir::Files))
     {
-        // Check if the current object is a waypoint. If so, add it to the list of waypoints.
-        Waypoint const waypoint(object);
-        if (waypoint.isValid())
+        if (!result.contains(entry.filePath()))
         {
-            newWaypoints.append(waypoint);
-            continue;
+            QFile::remove(entry.filePath());
         }
+    }
+    return result;
+}
+
+GeoMaps::GeoMapProvider::aviationDataCacheResult GeoMaps::GeoMapProvider::fillAviationDataCache(QHash<QString, AviationMapSegment>& segments, QStringList JSONFileNames, bool hideGlidingSectors)
+{
+    Trace::Span const span("GeoMapProvider::fillAviationDataCache");
 
-        // Check if the current object is an airspace. If so, add it to the list of airspaces.
-        Airspace const airspace(object);
-        if (airspace.isValid())
+    // Ensure that order is the same every time
+    JSONFileNames.sort();
+
+    //
+    // Update the segment cache. Only files that are new or have changed are
+    // read and parsed; segments of files that are no longer installed are
+    // removed.
+    //
+    QSet<QString> const JSONFileNameSet(JSONFileNames.cbegin(), JSONFileNames.cend());
+    segments.removeIf([&JSONFileNameSet](const QHash<QString, AviationMapSegment>::iterator& it) {return !JSONFileNameSet.contains(it.key());});
+    for(const auto& JSONFileName : std::as_const(JSONFileNames))
+    {
+        QFileInfo const info(JSONFileName);
+        auto iterator = segments.constFind(JSONFileName);
+        if ((iterator != segments.constEnd()) &&
+            (iterator->lastModified == info.lastModified()) &&
+            (iterator->size == info.size()))
         {
-            newAirspaces.append(airspace);
             continue;
         }
+        segments.insert(JSONFileName, readAviationMapSegment(JSONFileName));
     }
 
-    // Then, create a new JSONArray of features and a new list of waypoints
-    QJsonArray newFeatures;
-    for(const auto& object : std::as_const(objectVector))
+    //
+    // Merge the segments. Features are merged in the order of the files, and
+    // duplicated features are added only once. Features are compared by their
+    // compact JSON representation.
+    //
+    QSet<QByteArray> featuresSeen;
+    QVector<Airspace> newAirspaces;
+    QVector<Waypoint> newWaypoints;
+    QByteArray newGeoJSON = R"({"type":"FeatureCollection","features":[)";
+    bool firstFeature = true;
+    for(const auto& JSONFileName : std::as_const(JSONFileNames))
     {
-        // If 'hideGlidingSector' is set, ignore all objects that are airspaces
-        // and that are gliding sectors
-        if (hideGlidingSectors)
+        const auto& segment = segments[JSONFileName];
+        for(const auto& feature : segment.features)
         {
-            Airspace const airspaceTest(object);
-            if (airspaceTest.CAT() == u"GLD"_s)
+            if (featuresSeen.contains(feature.json))
             {
                 continue;
             }
+            featuresSeen += feature.json;
+
+            if (feature.waypoint >= 0)
+            {
+                newWaypoints.append(segment.waypoints.at(feature.waypoint));
+            }
+            if (feature.airspace >= 0)
+            {
+                newAirspaces.append(segment.airspaces.at(feature.airspace));
+            }
+
+            // If 'hideGlidingSector' is set, ignore all objects that are airspaces
+            // and that are gliding sectors
+            if (hideGlidingSectors && feature.glidingSector)
+            {
+                continue;
+            }
+            if (!firstFeature)
+            {
+                newGeoJSON += ',';
+            }
+            newGeoJSON += feature.json;
+            firstFeature = false;
         }
-        newFeatures += object;
     }
+    newGeoJSON += "]}";
+
+    // Sort waypoints by name
+    std::sort(newWaypoints.begin(), newWaypoints.end(), [](const Waypoint& first, const Waypoint& second) {return first.name() < second.name(); });
 
-    QByteArray newGeoJSON;
+    // Build search indices
+    WaypointSearchIndex const newWaypointSearchIndex(newWaypoints);
+    WaypointSpatialIndex const newWaypointSpatialIndex(newWaypoints);
+
+    return {newWaypoints, newAirspaces, newGeoJSON, newWaypointSearchIndex, newWaypointSpatialIndex};
+}
+
+GeoMaps::GeoMapProvider::AviationMapSegment GeoMaps::GeoMapProvider::readAviationMapSegment(const QString& JSONFileName)
+{
+    AviationMapSegment segment;
+
+    // Read the file, using the lock file
+    QLockFile lockFile(JSONFileName + u".lock"_s);
+    lockFile.lock();
+    QFileInfo const info(JSONFileName);
+    segment.lastModified = info.lastModified();
+    segment.size = info.size();
+    QFile file(JSONFileName);
+    QJsonDocument document;
+    if (file.open(QIODevice::ReadOnly))
     {
-        QJsonObject resultObject;
-        resultObject.insert(QStringLiteral("type"), "FeatureCollection");
-        resultObject.insert(QStringLiteral("features"), newFeatures);
-        QJsonDocument const geoDoc(resultObject);
-        newGeoJSON = geoDoc.toJson();
+        document = QJsonDocument::fromJson(file.readAll());
+        file.close();
     }
+    lockFile.unlock();
 
-    // Sort waypoints by name
-    std::sort(newWaypoints.begin(), newWaypoints.end(), [](const Waypoint& first, const Waypoint& second) {return first.name() < second.name(); });
+    // Parse the features
+    const auto features = document.object()[QStringLiteral("features")].toArray();
+    segment.features.reserve(features.size());
+    for(const auto& value : features)
+    {
+        auto object = value.toObject();
+
+        AviationMapFeature feature;
+        feature.json = QJsonDocument(object).toJson(QJsonDocument::Compact);
 
-    return {newWaypoints, newAirspaces, newGeoJSON};
+        // Check if the current object is a waypoint. If so, add it to the list of waypoints.
+        Waypoint const waypoint(object);
+        if (waypoint.isValid())
+        {
+            feature.waypoint = segment.waypoints.size();
+            segment.waypoints.append(waypoint);
+        }
+        else
+        {
+            // Check if the current object is an airspace. If so, add it to the list of airspaces.
+            Airspace const airspace(object);
+            feature.glidingSector = (airspace.CAT() == u"GLD"_s);
+            if (airspace.isValid())
+            {
+                feature.airspace = segment.airspaces.size();
+                segment.airspaces.append(airspace);
+            }
+        }
+        segment.features.append(feature);
+    }
+    return segment;
 }
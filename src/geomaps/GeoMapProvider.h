@@ -1,5 +1,5 @@
 /***************************************************************************
- *   Copyright (C) 2019-2024 by Stefan Kebekus                             *
+ *   Copyright (C) 2019-2026 by Stefan Kebekus                             *
  *   stefan.kebekus@gmail.com                                              *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
@@ -27,17 +27,22 @@
 #include <QProperty>
 #include <QQmlEngine>
 #include <QStandardPaths>
-#include <QTemporaryFile>
+#include <QThreadPool>
 #include <QTimer>
 
 #include "Airspace.h"
 #include "GlobalObject.h"
 #include "TileServer.h"
 #include "Waypoint.h"
-#include "fileFormats/MBTILES.h"
+#include "WaypointSearchIndex.h"
+#include "WaypointSpatialIndex.h"
+#include "fileFormats/DEM.h"
+#include "fileFormats/TileFileAbstract.h"
 
 using namespace Qt::Literals::StringLiterals;
 
+class Benchmark;
+
 
 namespace GeoMaps
 {
@@ -67,6 +72,9 @@ class GeoMapProvider : public GlobalObject
     QML_ELEMENT
     QML_SINGLETON
 
+    // The benchmarks call private static methods directly
+    friend class ::Benchmark;
+
 public:
     /*! \brief Creates a new GeoMap provider
      *
@@ -155,15 +163,16 @@ public:
      *
      * This property holds a URL where a mapbox style file for the base map can
      * be retrieved. The style file is adjusted, so that its source element
-     * points to the local TileServer URL where the base map is served. Whenever
-     * the base map changes (e.g. because new maps have been downloaded or
-     * removed), the style file is deleted, a new style file is generated and a
-     * notification signal is emitted.
+     * points to the local TileServer URL where the base map is served. The
+     * style file is served from memory by the TileServer. Whenever the base
+     * map changes (e.g. because new maps have been downloaded or removed), a
+     * new style file is generated under a new URL and a notification signal is
+     * emitted.
      */
     Q_PROPERTY(QString styleFileURL READ styleFileURL NOTIFY styleFileURLChanged)
 
-    /*! \brief List of terrain map MBTILES */
-    Q_PROPERTY(QList<QSharedPointer<FileFormats::MBTILES>> terrainMapTiles READ terrainMapTiles NOTIFY terrainMapTilesChanged)
+    /*! \brief List of terrain map MBTILES or PMTILES */
+    Q_PROPERTY(QList<QSharedPointer<FileFormats::TileFileAbstract>> terrainMapTiles READ terrainMapTiles NOTIFY terrainMapTilesChanged)
 
     /*! \brief Waypoints
      *
@@ -266,7 +275,7 @@ public:
      *
      * @returns Property terrainMapTiles
      */
-    [[nodiscard]] QList<QSharedPointer<FileFormats::MBTILES>> terrainMapTiles() const
+    [[nodiscard]] QList<QSharedPointer<FileFormats::TileFileAbstract>> terrainMapTiles() const
     {
         return m_terrainMapTiles;
     }
@@ -332,6 +341,10 @@ public:
     }
 
     /*! \brief Elevation of terrain at a given coordinate, above sea level
+     *
+     *  The elevation is read from the memory-mapped elevation models that are
+     *  generated for the terrain maps in the background. Where no such model
+     *  is available yet, the terrain map tiles are decoded.
      *
      *  @param coordinate Coordinate
      *
@@ -340,6 +353,18 @@ public:
      */
     [[nodiscard]] Q_INVOKABLE Units::Distance terrainElevationAMSL(const QGeoCoordinate& coordinate);
 
+    /*! \brief Elevations of terrain at given coordinates, above sea level
+     *
+     *  This method is meant for callers that need the terrain along a line or
+     *  over an area. Each elevation model is queried only once, with all
+     *  coordinates that it might cover.
+     *
+     *  @param coordinates Coordinates
+     *
+     *  @return List of elevations, as computed by terrainElevationAMSL()
+     */
+    [[nodiscard]] Q_INVOKABLE QList<Units::Distance> terrainElevationsAMSL(const QList<QGeoCoordinate>& coordinates);
+
     /*! \brief Create empty GeoJSON document
      *
      *  @returns Empty, but valid GeoJSON document
@@ -387,7 +412,12 @@ signals:
     /*! \brief Notification signal for the property with the same name */
     void serverUrlChanged();
 
-    /*! \brief Notification signal for the property with the same name */
+    /*! \brief Notification signal for the property with the same name
+     *
+     *  This signal is also emitted when the elevation models for the terrain
+     *  maps become available, because terrain elevations might change
+     *  slightly.
+     */
     void terrainMapTilesChanged();
 
     /*! \brief Notification signal for the property with the same name */
@@ -404,15 +434,70 @@ private:
     // sets up the tile server to and generates a new style file.
     void onMBTILESChanged();
 
+    // Generates elevation models for the terrain maps in m_terrainMapThreadPool,
+    // and loads them into m_terrainDEMs when done.
+    void updateTerrainDEMs();
+
+    // Converts terrain maps into elevation models in the cache directory,
+    // unless this has already been done. Deletes all other elevation models
+    // in the cache directory. Returns the file names of the elevation models.
+    // This function is meant to be run in m_terrainMapThreadPool.
+    static QStringList buildTerrainDEMs(const QStringList& terrainFileNames);
+
+    // Elevation of terrain at a given coordinate, read from the PNG tiles of
+    // the terrain maps. Decoded tiles are kept in the cache. Implements the
+    // public method terrainElevationAMSL() where no elevation model is
+    // available.
+    static Units::Distance terrainElevationFromTiles(const QList<QSharedPointer<FileFormats::TileFileAbstract>>& terrainMapTiles,
+                                                     QCache<qint64,QImage>& cache,
+                                                     const QGeoCoordinate& coordinate);
+
+    // Parsed content of one aviation map file. The file is identified by its
+    // modification time and size.
+    struct AviationMapFeature {
+        QByteArray json;              // Compact JSON representation of the feature
+        qsizetype waypoint {-1};      // Index in AviationMapSegment::waypoints, or -1
+        qsizetype airspace {-1};      // Index in AviationMapSegment::airspaces, or -1
+        bool glidingSector {false};   // Feature is an airspace of category GLD
+    };
+    struct AviationMapSegment {
+        QDateTime lastModified;
+        qint64 size {-1};
+        QList<AviationMapFeature> features;
+        QList<Waypoint> waypoints;
+        QList<Airspace> airspaces;
+    };
+    static AviationMapSegment readAviationMapSegment(const QString& JSONFileName);
+
     // Interal function that does most of the work for aviationMapsChanged()
-    // emits geoJSONChanged() when done. This function is meant to be run in a
+    // emits geoJSONChanged() when done. The segments of files that are new or
+    // have changed are read into the cache, segments of files that are no
+    // longer installed are removed. This function is meant to be run in a
     // separate thread.
     struct aviationDataCacheResult {
         QList<Waypoint> waypoints;
         QList<Airspace> airspaces;
         QByteArray combinedGeoJSON;
+        WaypointSearchIndex waypointSearchIndex;
+        WaypointSpatialIndex waypointSpatialIndex;
     };
-    aviationDataCacheResult fillAviationDataCache(QStringList JSONFileNames, bool hideGlidingSectors);
+    static aviationDataCacheResult fillAviationDataCache(QHash<QString, AviationMapSegment>& segments, QStringList JSONFileNames, bool hideGlidingSectors);
+
+    // URL of the style document that the tile server generates from the
+    // style template with the given file name. The document is generated and
+    // added to the tile server unless it is already there. Implements the
+    // public method styleFileURL().
+    static QString styleURL(GeoMaps::TileServer& tileServer, const QString& fileName, const QString& baseMapPath, const QString& terrainMapPath);
+
+    // Airspaces from the list that exist over the given position, sorted
+    // according to their lower boundaries. Implements the public method
+    // airspacesAtPosition().
+    static QVector<Airspace> airspacesAtPosition(const QVector<Airspace>& airspaces, const QGeoCoordinate& position);
+
+    // Segments of the aviation map files, by file name. This member is used
+    // by fillAviationDataCache() only, and never accessed from more than one
+    // thread at a time.
+    QHash<QString, AviationMapSegment> m_aviationMapSegments;
 
     // Caches used to speed up the method simplifySpecialChars
     QRegularExpression specialChars{QStringLiteral("[^a-zA-Z0-9]")};
@@ -427,9 +512,6 @@ private:
     // Tile Server
     TileServer m_tileServer;
 
-    // Temporary file that holds the current style file
-    QPointer<QTemporaryFile> m_styleFile;
-
     //
     // Aviation Data Cache
     //
@@ -437,11 +519,18 @@ private:
     QTimer _aviationDataCacheTimer;         // Timer used to start another run of fillAviationDataCache()
 
     //
-    // MBTILES
+    // MBTILES and PMTILES
     //
-    QList<QSharedPointer<FileFormats::MBTILES>> m_baseMapVectorTiles;
-    QProperty<QList<QSharedPointer<FileFormats::MBTILES>>> m_baseMapRasterTiles;
-    QList<QSharedPointer<FileFormats::MBTILES>> m_terrainMapTiles;
+    QList<QSharedPointer<FileFormats::TileFileAbstract>> m_baseMapVectorTiles;
+    QProperty<QList<QSharedPointer<FileFormats::TileFileAbstract>>> m_baseMapRasterTiles;
+    QList<QSharedPointer<FileFormats::TileFileAbstract>> m_terrainMapTiles;
+
+    // Elevation models generated from m_terrainMapTiles. The pool has a single
+    // thread, so that elevation models are built one after the other. The
+    // generation counter is used to discard outdated results.
+    QList<QSharedPointer<FileFormats::DEM>> m_terrainDEMs;
+    QThreadPool m_terrainMapThreadPool;
+    int m_terrainDEMGeneration {0};
 
     QProperty<QStringList> m_availableRasterMaps;
     QStringList computeAvailableRasterMaps();
@@ -452,6 +541,14 @@ private:
 
     Q_OBJECT_BINDABLE_PROPERTY(GeoMaps::GeoMapProvider, QByteArray, m_combinedGeoJSON, &GeoMaps::GeoMapProvider::geoJSONChanged)
     QList<Waypoint> _waypoints_; // Cache: Waypoints
+    WaypointSearchIndex m_waypointSearchIndex; // Cache: Search index for _waypoints_
+    WaypointSpatialIndex m_waypointSpatialIndex; // Cache: Spatial index for _waypoints_
+
+    // Words and result of the last call to filteredWaypoints(), used to answer
+    // incremental queries. Invalidated whenever m_waypointSearchIndex changes.
+    QStringList m_lastFilterWords;
+    QVector<qsizetype> m_lastFilterMatches;
+    bool m_lastFilterValid {false};
     QProperty<QList<Airspace>> m_airspaces; // Cache: Airspaces
 
     // TerrainImageCache
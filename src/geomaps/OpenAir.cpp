@@ -23,6 +23,8 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QTextStream>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtMath>
 
 #include "OpenAir.h"
 #include "fileFormats/DataFileAbstract.h"
@@ -31,6 +33,67 @@
 
 using namespace Qt::Literals::StringLiterals;
 
+
+/*
+ * Points on a circle around a given center. The computation uses the same
+ * spherical model as QGeoCoordinate::atDistanceAndAzimuth, but computes the
+ * trigonometric functions of center and radius only once, and not once per
+ * point.
+ */
+class Circle {
+public:
+    Circle(const QGeoCoordinate& center, double radius)
+        : m_longitude(qDegreesToRadians(center.longitude()))
+    {
+        auto const latitude = qDegreesToRadians(center.latitude());
+        auto const angularRadius = radius / earthMeanRadius;
+        m_sinLatitude = std::sin(latitude);
+        m_cosLatitude = std::cos(latitude);
+        m_sinRadius = std::sin(angularRadius);
+        m_cosRadius = std::cos(angularRadius);
+    }
+
+    [[nodiscard]] QGeoCoordinate at(double azimuth) const
+    {
+        auto const azimuthRad = qDegreesToRadians(azimuth);
+        auto const sinLatitude = (m_sinLatitude * m_cosRadius) + (m_cosLatitude * m_sinRadius * std::cos(azimuthRad));
+        auto longitude = m_longitude + std::atan2(std::sin(azimuthRad) * m_sinRadius * m_cosLatitude, m_cosRadius - (m_sinLatitude * sinLatitude));
+        longitude = std::fmod(longitude + (3 * M_PI), 2 * M_PI) - M_PI;
+        return {qRadiansToDegrees(std::asin(sinLatitude)), qRadiansToDegrees(longitude)};
+    }
+
+    /*
+     * Angular step, in degrees, for the tessellation of arcs. This is the
+     * largest step for which chords deviate from the arc by at most
+     * maxChordError, bounded to [minStep, maxStep]. The upper bound is the
+     * fixed step used in earlier versions of this importer.
+     */
+    static double step(double radius)
+    {
+        auto const ratio = 1.0 - (maxChordError / radius);
+        auto const result = (ratio > -1.0) ? 2.0 * qRadiansToDegrees(std::acos(ratio)) : maxStep;
+        return qBound(minStep, result, maxStep);
+    }
+
+private:
+    static constexpr double earthMeanRadius {6371.0072 * 1000.0};
+    static constexpr double maxChordError {50.0};
+    static constexpr double minStep {2.0};
+    static constexpr double maxStep {10.0};
+
+    double m_longitude;
+    double m_sinLatitude {0.0};
+    double m_cosLatitude {0.0};
+    double m_sinRadius {0.0};
+    double m_cosRadius {0.0};
+};
+
+
+/*
+ * One airspace. Points are appended to the polygon in the order in which they
+ * appear in the file. The orientation of the polygon is fixed once, in
+ * finalize().
+ */
 class AirSpace {
 public:
     QString ac;
@@ -43,8 +106,7 @@ public:
 
     void addPoint(const QString& qs)
     {
-        QGeoCoordinate const point = toCoord(qs);
-        polygon.prepend(point);
+        polygon.append(toCoord(qs));
     }
 
     void addCircle(const QString& qs)
@@ -57,9 +119,12 @@ public:
         }
         if (variableX.isValid())
         {
-            for (int i=0; i <= 360; i += 10)
+            Circle const circle(variableX, radius);
+            auto const steps = qCeil(360.0 / Circle::step(radius));
+            polygon.reserve(polygon.size() + steps + 1);
+            for (int i=0; i <= steps; i++)
             {
-                polygon.prepend(variableX.atDistanceAndAzimuth(radius, i));
+                polygon.append(circle.at(360.0 * i / steps));
             }
         }
         else
@@ -113,7 +178,7 @@ public:
                     addArcClockwise(radius,angleStart, angleEnd);
                 }
             }
-            polygon.prepend(variableX.atDistanceAndAzimuth(radius, angleEnd));
+            polygon.append(variableX.atDistanceAndAzimuth(radius, angleEnd));
         }
         else
         {
@@ -161,7 +226,7 @@ public:
                 addArcClockwise(radius,angleStart, angleEnd);
             }
         }
-        polygon.prepend(variableX.atDistanceAndAzimuth(radius, angleEnd));
+        polygon.append(variableX.atDistanceAndAzimuth(radius, angleEnd));
     }
 
     void addArcClockwise(double radius, double start, double end)
@@ -171,11 +236,7 @@ public:
             throw QObject::tr("Invalid arc specification", "OpenAir");
         }
 
-        do
-        {
-            polygon.prepend(variableX.atDistanceAndAzimuth(radius, start));
-            start += 10;
-        } while (start < end);
+        appendArc(radius, start, end);
     }
 
     void addArcCounterClockwise(double radius, double start, double end)
@@ -185,18 +246,27 @@ public:
             throw QObject::tr("Invalid arc specification", "OpenAir");
         }
 
-        do
+        appendArc(radius, start, end);
+    }
+
+    // Appends points on the arc from start to end, including start but
+    // excluding end, in equal steps no larger than Circle::step(radius)
+    void appendArc(double radius, double start, double end)
+    {
+        Circle const circle(variableX, radius);
+        auto const steps = qMax(1, qCeil(qAbs(end - start) / Circle::step(radius)));
+        polygon.reserve(polygon.size() + steps);
+        for (int i=0; i < steps; i++)
         {
-            polygon.prepend(variableX.atDistanceAndAzimuth(radius, start));
-            start -= 10;
-        } while (start > end);
+            polygon.append(circle.at(start + ((end - start) * i / steps)));
+        }
     }
 
     /*
      * Final check if all information regarding one AirSpace is read:
      *  - close polygon if it is open
      *  - delete doubled points from the polygon
-     *  - reverse polygon if it is clockwise
+     *  - orient polygon counterclockwise, reversing it at most once
      *  - check if necessary information is complete (e.g. lower limit and upper limit are defined)
      */
     void finalize(QStringList& errorList)
@@ -204,24 +274,22 @@ public:
         if  (polygon.size() > 1)
         {
             //close polygon if it is open
-            auto last = polygon.size() - 1;
-            if ((polygon.at(0).latitude() != polygon.at(last).latitude()) ||
-                (polygon.at(0).longitude() != polygon.at(last).longitude()))
+            if ((polygon.constFirst().latitude() != polygon.constLast().latitude()) ||
+                (polygon.constFirst().longitude() != polygon.constLast().longitude()))
             {
-                polygon.prepend(polygon.at(last));
+                polygon.append(polygon.constFirst());
             }
             //delete doubled points
-            for (auto i=polygon.size() - 1; i > 0; i--) {
-                if ((polygon.at(i).latitude()  == polygon.at(i - 1).latitude() ) &&
-                    (polygon.at(i).longitude() == polygon.at(i - 1).longitude()) )
-                {
-                    polygon.removeAt(i);
-                }
-            }
-            //reverse polygon if it is clockwise
-            if (isClockwise())
+            auto newEnd = std::unique(polygon.begin(), polygon.end(), [](const QGeoCoordinate& first, const QGeoCoordinate& second) {
+                return (first.latitude() == second.latitude()) && (first.longitude() == second.longitude());
+            });
+            polygon.erase(newEnd, polygon.end());
+            //reverse polygon unless it is counterclockwise. Polygons without
+            //area are reversed as well, as in earlier versions of this
+            //importer, which built the polygon back to front.
+            if (signedArea() <= 0)
             {
-                reversePolygon();
+                std::reverse(polygon.begin(), polygon.end());
             }
         }
         if (al.size() < 1)
@@ -327,26 +395,19 @@ private:
         return ret;
     }
 
-    [[nodiscard]] bool isClockwise() const
+    // Twice the signed area of the polygon in the (longitude, latitude)
+    // plane. The area is positive if the polygon is counterclockwise.
+    [[nodiscard]] double signedArea() const
     {
         double area = 0;
         qsizetype j = 0;
 
-        for (auto i=0; i < polygon.size(); i++)
+        for (qsizetype i=0; i < polygon.size(); i++)
         {
-            j = (i + 1) % polygon.size();
+            j = (i + 1 == polygon.size()) ? 0 : i + 1;
             area += polygon.at(i).longitude() * polygon.at(j).latitude() - polygon.at(j).longitude() * polygon.at(i).latitude();
         }
-        // If the area is positive, the polygon is defined clockwise, otherwise counterclockwise
-        return (area < 0);
-    }
-
-    void reversePolygon() {
-        auto j = polygon.size() - 1;
-        for (int i=0; i < j;i++, j--)
-        {
-            polygon.swapItemsAt(i, j);
-        }
+        return area;
     }
 
     static QGeoCoordinate toCoord(const QString& qs)
@@ -391,167 +452,43 @@ private:
 };
 
 
-class AirSpaceVector {
-private:
-    QVector<AirSpace> airSpaceVector;
-
-public:
-    void addAirSpace(const AirSpace& airSpace)
-    {
-        airSpaceVector.append(airSpace);
-    }
-
-    bool isSameName(const QString& qs)
-    {
-        return (!airSpaceVector.empty()) && (airSpaceVector.last().an.compare(qs) == 0);
-    }
-
-    QGeoCoordinate getLastX()
-    {
-        return airSpaceVector.last().variableX;
-    }
-
-    QJsonDocument getJson(const QString& fileName)
-    {
-        QJsonObject recObj;
-        QJsonObject featureObj;
-        QJsonObject propObj;
-        QJsonObject geomObj;
-        QJsonArray featureArray;
-        QJsonArray polygonArray;
-        QJsonArray coordArray;
-        QJsonArray coord;
-        QGeoCoordinate const point;
-
-        recObj.insert(u"type"_s, QJsonValue::fromVariant("FeatureCollection"));
-        recObj.insert(u"info"_s, QJsonValue::fromVariant(fileName));
-
-        for (const auto &i : std::as_const(airSpaceVector))
-        {
-            featureObj.insert(u"type"_s, QJsonValue::fromVariant("Feature"));
-            propObj = QJsonObject();
-            propObj.insert(u"NAM"_s, QJsonValue::fromVariant(i.an));
-            propObj.insert(u"ID"_s, QJsonValue::fromVariant(i.an));
-            propObj.insert(u"CAT"_s, QJsonValue::fromVariant(i.ac));
-            propObj.insert(u"TYP"_s, QJsonValue::fromVariant("AS"));
-            if (!i.al.isEmpty()) {
-                propObj.insert(u"BOT"_s, QJsonValue::fromVariant(i.al));
-            }
-            if (!i.ah.isEmpty()) {
-                propObj.insert(u"TOP"_s, QJsonValue::fromVariant(i.ah));
-            }
-
-            // Compute SBO: simplified bottom altitude in feet
-            if (!i.al.isEmpty())
-            {
-                int sbo = 0;
-                const QString& al = i.al;
-                if (al.compare(u"GND"_s) == 0)
-                {
-                    sbo = 0;
-                }
-                else if (al.startsWith(u"FL "_s))
-                {
-                    // "FL 90" → 9000 ft, "FL 100" → 10000 ft, etc.
-                    bool ok = false;
-                    const int fl = al.sliced(3).toInt(&ok);
-                    sbo = ok ? fl * 100 : 0;
-                }
-                else
-                {
-                    // Plain feet AMSL ("3500") or feet AGL ("3500 AGL") — take the leading number
-                    bool ok = false;
-                    const int ft = al.split(u' ', Qt::SkipEmptyParts).first().toInt(&ok);
-                    sbo = ok ? ft : 0;
-                }
-                propObj.insert(u"SBO"_s, QJsonValue::fromVariant(sbo));
-            }
-
-            featureObj.insert(u"properties"_s, propObj);
-
-            while (coordArray.count() != 0)
-            {
-                coordArray.pop_back();
-            }
-            for (const auto &j : i.polygon) {
-                while (coord.count() != 0) {
-                    coord.pop_back();
-                }
-                coord.append(j.longitude());
-                coord.append(j.latitude());
-                coordArray.append(coord);
-            }
-            while (polygonArray.count() != 0)
-            {
-                polygonArray.pop_back();
-            }
-            polygonArray.append(coordArray);
-            if (i.polygon.size() > 1) {
-                geomObj.insert(u"type"_s, QJsonValue::fromVariant("Polygon"));
-                geomObj.insert(u"coordinates"_s, polygonArray);
-                featureObj.insert(u"geometry"_s, geomObj);
-            }
-
-            featureArray.append(featureObj);
-        }
-
-        if (featureArray.isEmpty())
-        {
-            return {};
-        }
+namespace {
 
-        recObj.insert(u"features"_s, featureArray);
-        QJsonDocument json(recObj);
-        return json;
-    }
+/*
+ * Lines of an OpenAir file that describe one airspace. Blocks begin with an
+ * "AC" line that follows a previous "AC" line with non-empty class; lines
+ * before the first such "AC" line belong to the first block.
+ */
+struct AirSpaceBlock {
+    int firstLineNo {1};
+    QStringList lines;
 };
 
 
-bool GeoMaps::openAir::isValid(const QString& fileName, QString* info)
-{
-    QStringList errorList;
+/*
+ * Result of parsing one block
+ */
+struct AirSpaceBlockResult {
+    AirSpace airSpace;
+    bool hadError {false};
+    QStringList names;
+    QStringList errors;
     QStringList warnings;
-    auto json = parse(fileName, errorList, warnings);
-
-    if (info != nullptr)
-    {
-        *info = {};
-        if (!warnings.isEmpty())
-        {
-            *info += u"<p>"_s + QObject::tr("Warnings", "OpenAir") + u"</p>"_s;
-            *info += u"<ul style='margin-left:-25px;'>"_s;
-            foreach(auto warning, warnings)
-            {
-                *info += u"<li>"_s + warning + u"</li>"_s;
-            }
-            *info += u"</ul>"_s;
-        }
-    }
-
-    return (!json.isEmpty()) && errorList.isEmpty();
-}
+};
 
 
-QJsonDocument GeoMaps::openAir::parse(const QString& fileName, QStringList& errorList, QStringList& warningList)
+/*
+ * Parses one block. If previous is not nullptr, it points to the last
+ * airspace that was read successfully. If the block carries the same name,
+ * the variable X is inherited from that airspace.
+ */
+AirSpaceBlockResult parseBlock(const AirSpaceBlock& block, const AirSpace* previous)
 {
-    QString line;
-    AirSpace airSpace;
-    AirSpaceVector airSpaceVector;
-
+    AirSpaceBlockResult result;
+    auto& airSpace = result.airSpace;
 
-    auto inputFile = FileFormats::DataFileAbstract::openFileURL(fileName);
-    if (!inputFile->open(QIODeviceBase::ReadOnly))
-    {
-        errorList << QObject::tr("Cannot open file %1", "OpenAir").arg(fileName);
-        return {};
-    }
-
-    QTextStream inputStream(inputFile.data());
-    inputStream.setEncoding(QStringConverter::Latin1);
-
-    bool hadError = false;
-    int lineNo = 0;
-    while (inputStream.readLineInto(&line))
+    int lineNo = block.firstLineNo - 1;
+    for (const auto& line : block.lines)
     {
         lineNo++;
 
@@ -562,26 +499,16 @@ QJsonDocument GeoMaps::openAir::parse(const QString& fileName, QStringList& erro
             }
             if (line.startsWith(u"AC "_s))
             {
-                //if airSpace is already filled, the existing airSpace must be added to the list and a new airSpace must be initialized
-                if (airSpace.isSet())
-                {
-                    if (!hadError)
-                    {
-                        airSpace.finalize(errorList);
-                        airSpaceVector.addAirSpace(airSpace);
-                    }
-                    airSpace = AirSpace();
-                    hadError = false;
-                }
                 airSpace.ac = line.sliced(3).trimmed();
                 continue;
             }
             if (line.startsWith(u"AN "_s))
             {
                 airSpace.an = line.sliced(3);
-                if (airSpaceVector.isSameName(airSpace.an))
+                result.names.append(airSpace.an);
+                if ((previous != nullptr) && (previous->an.compare(airSpace.an) == 0))
                 {
-                    airSpace.variableX = airSpaceVector.getLastX();
+                    airSpace.variableX = previous->variableX;
                 }
                 continue;
             }
@@ -624,19 +551,288 @@ QJsonDocument GeoMaps::openAir::parse(const QString& fileName, QStringList& erro
             {
                 continue;
             }
-            warningList.append(QObject::tr("Unrecognized record type in line %1: %2; Line ignored.", "OpenAir").arg(QString::number(lineNo), line));
+            result.warnings.append(QObject::tr("Unrecognized record type in line %1: %2; Line ignored.", "OpenAir").arg(QString::number(lineNo), line));
         }
         catch (QString& ex)
         {
-            hadError = true;
-            warningList.append(QObject::tr("Error in line %1: %2; Airspace %3 ignored.", "OpenAir").arg(QString::number(lineNo), ex, airSpace.an));
+            result.hadError = true;
+            result.warnings.append(QObject::tr("Error in line %1: %2; Airspace %3 ignored.", "OpenAir").arg(QString::number(lineNo), ex, airSpace.an));
         }
     }
-    if (airSpace.isSet())
+
+    if (airSpace.isSet() && !result.hadError)
+    {
+        airSpace.finalize(result.errors);
+    }
+    return result;
+}
+
+
+/*
+ * Reads an OpenAir file and hands the airspaces that were read successfully
+ * to the consumer, in the order in which they appear in the file.
+ *
+ * The file is read once, and split into blocks. The blocks are parsed in
+ * parallel, in batches of batchSize blocks, so that only one batch is held in
+ * memory at any time. Blocks are independent, except that an airspace
+ * inherits the variable X from the previous airspace if both carry the same
+ * name. Blocks where this might happen are parsed again, sequentially, once
+ * the previous airspace is known.
+ */
+template<typename F>
+void readAirSpaces(const QString& fileName, QStringList& errorList, QStringList& warningList, F consumer)
+{
+    constexpr qsizetype batchSize = 1024;
+
+    auto inputFile = FileFormats::DataFileAbstract::openFileURL(fileName);
+    if (!inputFile->open(QIODeviceBase::ReadOnly))
     {
-        airSpace.finalize(errorList);
-        airSpaceVector.addAirSpace(airSpace);
+        errorList << QObject::tr("Cannot open file %1", "OpenAir").arg(fileName);
+        return;
     }
 
-    return airSpaceVector.getJson(fileName);
+    QTextStream inputStream(inputFile.data());
+    inputStream.setEncoding(QStringConverter::Latin1);
+
+    AirSpace previous;
+    bool hasPrevious = false;
+    QVector<AirSpaceBlock> blocks(1);
+    auto parseBlocks = [&]() {
+        auto results = QtConcurrent::blockingMapped<QVector<AirSpaceBlockResult>>(blocks, [](const AirSpaceBlock& block) {
+            return parseBlock(block, nullptr);
+        });
+        for (qsizetype i=0; i < results.size(); i++)
+        {
+            if (hasPrevious && results.at(i).names.contains(previous.an))
+            {
+                results[i] = parseBlock(blocks.at(i), &previous);
+            }
+            const auto& result = results.at(i);
+            errorList += result.errors;
+            warningList += result.warnings;
+            if (result.airSpace.isSet() && !result.hadError)
+            {
+                consumer(result.airSpace);
+                previous = result.airSpace;
+                hasPrevious = true;
+            }
+        }
+        blocks.clear();
+    };
+
+    QString line;
+    bool classSet = false;
+    int lineNo = 0;
+    while (inputStream.readLineInto(&line))
+    {
+        lineNo++;
+        if (line.startsWith(u"AC "_s))
+        {
+            if (classSet)
+            {
+                if (blocks.size() >= batchSize)
+                {
+                    parseBlocks();
+                }
+                blocks.append({lineNo, {}});
+            }
+            classSet = !line.sliced(3).trimmed().isEmpty();
+        }
+        blocks.last().lines.append(line);
+    }
+    parseBlocks();
+}
+
+
+/*
+ * Reads an OpenAir file and returns the list of airspaces that were read
+ * successfully.
+ */
+QVector<AirSpace> readAirSpaces(const QString& fileName, QStringList& errorList, QStringList& warningList)
+{
+    QVector<AirSpace> airSpaces;
+    readAirSpaces(fileName, errorList, warningList, [&](const AirSpace& airSpace) {
+        airSpaces.append(airSpace);
+    });
+    return airSpaces;
+}
+
+
+/*
+ * GeoJSON properties of an airspace
+ */
+QJsonObject properties(const AirSpace& airSpace)
+{
+    QJsonObject propObj;
+    propObj.insert(u"NAM"_s, airSpace.an);
+    propObj.insert(u"ID"_s, airSpace.an);
+    propObj.insert(u"CAT"_s, airSpace.ac);
+    propObj.insert(u"TYP"_s, u"AS"_s);
+    if (!airSpace.al.isEmpty()) {
+        propObj.insert(u"BOT"_s, airSpace.al);
+    }
+    if (!airSpace.ah.isEmpty()) {
+        propObj.insert(u"TOP"_s, airSpace.ah);
+    }
+
+    // Compute SBO: simplified bottom altitude in feet
+    if (!airSpace.al.isEmpty())
+    {
+        int sbo = 0;
+        const QString& al = airSpace.al;
+        if (al.compare(u"GND"_s) == 0)
+        {
+            sbo = 0;
+        }
+        else if (al.startsWith(u"FL "_s))
+        {
+            // "FL 90" → 9000 ft, "FL 100" → 10000 ft, etc.
+            bool ok = false;
+            const int fl = al.sliced(3).toInt(&ok);
+            sbo = ok ? fl * 100 : 0;
+        }
+        else
+        {
+            // Plain feet AMSL ("3500") or feet AGL ("3500 AGL") — take the leading number
+            bool ok = false;
+            const int ft = al.split(u' ', Qt::SkipEmptyParts).first().toInt(&ok);
+            sbo = ok ? ft : 0;
+        }
+        propObj.insert(u"SBO"_s, sbo);
+    }
+    return propObj;
+}
+
+
+} // namespace
+
+
+bool GeoMaps::openAir::isValid(const QString& fileName, QString* info)
+{
+    QStringList errorList;
+    QStringList warnings;
+    qsizetype numAirSpaces = 0;
+    readAirSpaces(fileName, errorList, warnings, [&](const AirSpace& /*airSpace*/) {
+        numAirSpaces++;
+    });
+
+    if (info != nullptr)
+    {
+        *info = {};
+        if (!warnings.isEmpty())
+        {
+            *info += u"<p>"_s + QObject::tr("Warnings", "OpenAir") + u"</p>"_s;
+            *info += u"<ul style='margin-left:-25px;'>"_s;
+            foreach(auto warning, warnings)
+            {
+                *info += u"<li>"_s + warning + u"</li>"_s;
+            }
+            *info += u"</ul>"_s;
+        }
+    }
+
+    return (numAirSpaces > 0) && errorList.isEmpty();
+}
+
+
+QJsonDocument GeoMaps::openAir::parse(const QString& fileName, QStringList& errorList, QStringList& warningList)
+{
+    auto airSpaces = readAirSpaces(fileName, errorList, warningList);
+    if (airSpaces.isEmpty())
+    {
+        return {};
+    }
+
+    QJsonArray featureArray;
+    for (const auto& airSpace : std::as_const(airSpaces))
+    {
+        QJsonObject featureObj;
+        featureObj.insert(u"type"_s, u"Feature"_s);
+        featureObj.insert(u"properties"_s, properties(airSpace));
+        if (airSpace.polygon.size() > 1)
+        {
+            QJsonArray coordArray;
+            for (const auto& point : airSpace.polygon)
+            {
+                coordArray.append(QJsonArray{point.longitude(), point.latitude()});
+            }
+            QJsonObject geomObj;
+            geomObj.insert(u"type"_s, u"Polygon"_s);
+            geomObj.insert(u"coordinates"_s, QJsonArray{coordArray});
+            featureObj.insert(u"geometry"_s, geomObj);
+        }
+        featureArray.append(featureObj);
+    }
+
+    QJsonObject recObj;
+    recObj.insert(u"type"_s, u"FeatureCollection"_s);
+    recObj.insert(u"info"_s, fileName);
+    recObj.insert(u"features"_s, featureArray);
+    return QJsonDocument(recObj);
+}
+
+
+bool GeoMaps::openAir::writeGeoJSON(const QString& fileName, QIODevice& device, QStringList& errorList, QStringList& warningList)
+{
+    // Header. QJsonDocument writes the keys in alphabetical order, so that
+    // removing the closing brace leaves room for the feature array.
+    QJsonObject recObj;
+    recObj.insert(u"type"_s, u"FeatureCollection"_s);
+    recObj.insert(u"info"_s, fileName);
+    auto header = QJsonDocument(recObj).toJson(QJsonDocument::Compact);
+    header.chop(1);
+    header += R"(,"features":[)";
+    bool writeError = (device.write(header) != header.size());
+
+    // Features, one at a time, as they are read. Coordinates are written
+    // directly, without building QJsonArrays for them.
+    qsizetype numAirSpaces = 0;
+    QByteArray buffer;
+    readAirSpaces(fileName, errorList, warningList, [&](const AirSpace& airSpace) {
+        if (writeError)
+        {
+            return;
+        }
+
+        buffer.clear();
+        if (numAirSpaces > 0)
+        {
+            buffer += ',';
+        }
+        numAirSpaces++;
+        buffer += R"({"type":"Feature","properties":)";
+        buffer += QJsonDocument(properties(airSpace)).toJson(QJsonDocument::Compact);
+        if (airSpace.polygon.size() > 1)
+        {
+            buffer += R"(,"geometry":{"type":"Polygon","coordinates":[[)";
+            for (qsizetype j=0; j < airSpace.polygon.size(); j++)
+            {
+                const auto& point = airSpace.polygon.at(j);
+                if (j > 0)
+                {
+                    buffer += ',';
+                }
+                buffer += '[';
+                buffer += QByteArray::number(point.longitude(), 'g', QLocale::FloatingPointShortest);
+                buffer += ',';
+                buffer += QByteArray::number(point.latitude(), 'g', QLocale::FloatingPointShortest);
+                buffer += ']';
+            }
+            buffer += "]]}";
+        }
+        buffer += '}';
+        writeError = (device.write(buffer) != buffer.size());
+    });
+    writeError = writeError || (device.write("]}") != 2);
+
+    if (writeError)
+    {
+        errorList << QObject::tr("Error writing GeoJSON data: %1", "OpenAir").arg(device.errorString());
+        return false;
+    }
+    if (errorList.isEmpty() && (numAirSpaces == 0))
+    {
+        errorList << QObject::tr("The file does not contain any airspace.", "OpenAir");
+    }
+    return errorList.isEmpty();
 }
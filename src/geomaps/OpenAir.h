@@ -17,6 +17,7 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <QIODevice>
 #include <QJsonDocument>
 
 namespace GeoMaps
@@ -54,6 +55,29 @@ public:
      *  If error messages were appended, returns an empty QJsonDocument
      */
     static QJsonDocument parse(const QString& fileName, QStringList& errorList, QStringList& warningList);
+
+    /*! \brief Reads a file in openAIR format and writes GeoJSON to a device
+     *
+     *  This method produces the same GeoJSON as parse(), in compact form. It
+     *  writes every airspace as soon as it has been read, and holds neither
+     *  the full document nor the list of all airspaces in memory, which makes
+     *  it the preferred method for importing large files.
+     *
+     *  @param fileName Name of the openAIR file
+     *
+     *  @param device Device, open for writing, to which GeoJSON is written.
+     *  If this method returns false, the data written is incomplete and
+     *  should be discarded, for instance with QSaveFile::cancelWriting().
+     *
+     *  @param errorList Reference to a QStringList where error messages will be appended.
+     *
+     *  @param warningList Reference to a QStringList where warnings will be appended.
+     *
+     *  @return True if no error messages were appended. In that case, the
+     *  GeoJSON data contains at least one airspace. Otherwise, at least one
+     *  error message was appended.
+     */
+    static bool writeGeoJSON(const QString& fileName, QIODevice& device, QStringList& errorList, QStringList& warningList);
 };
 
 
@@ -1,5 +1,5 @@
 /***************************************************************************
- *   Copyright (C) 2019-2024 by Stefan Kebekus                             *
+ *   Copyright (C) 2019-2026 by Stefan Kebekus                             *
  *   stefan.kebekus@gmail.com                                              *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
@@ -24,11 +24,12 @@
 #include <QPointer>
 
 #include "TileHandler.h"
+#include "Trace.h"
 
 using namespace Qt::Literals::StringLiterals;
 
 
-GeoMaps::TileHandler::TileHandler(const QVector<QSharedPointer<FileFormats::MBTILES>>& mbtileFiles, const QString& baseURL) :
+GeoMaps::TileHandler::TileHandler(const QVector<QSharedPointer<FileFormats::TileFileAbstract>>& mbtileFiles, const QString& baseURL) :
     m_mbtiles(mbtileFiles)
 {
     QString _name;
@@ -121,6 +122,8 @@ GeoMaps::TileHandler::TileHandler(const QVector<QSharedPointer<FileFormats::MBTI
 
 bool GeoMaps::TileHandler::process(QHttpServerResponder* responder, const QStringList &pathElements)
 {
+    Trace::Span const span("TileHandler::process");
+
     // Serve tileJSON file, if requested
     if (pathElements.isEmpty() || pathElements[0].endsWith(u"json"_s, Qt::CaseInsensitive))
     {
@@ -153,7 +156,7 @@ bool GeoMaps::TileHandler::process(QHttpServerResponder* responder, const QStrin
             continue;
         }
 
-        if (m_format == u"pbf"_s)
+        if (mbtilesPtr->isTileDataGzipped())
         {
             QHttpHeaders headers;
             headers.append("Content-Type", "application/octet-stream");
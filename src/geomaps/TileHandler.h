@@ -22,16 +22,17 @@
 
 #include <QJsonDocument>
 
-#include "fileFormats/MBTILES.h"
+#include "fileFormats/TileFileAbstract.h"
 
 class QHttpServerResponder;
 
 namespace GeoMaps {
 
 
-/*! \brief Implementation of QHttpEngine::Handler that serves mbtile files
+/*! \brief Implementation of QHttpEngine::Handler that serves tile files
  *
- *  This is a helper clas for TileServer. It gathers a set of MBTiles files.
+ *  This is a helper clas for TileServer. It gathers a set of MBTiles or
+ *  PMTiles files.
  *  The method process() takes the path of an incoming HTTP request and uses a
  *  QHttpServerResponder to reply with appropriate tile data, and with TileJSON
  *  (following the TileJSON Specification 2.2.0 found in
@@ -46,7 +47,7 @@ public:
     *
     *  This constructor sets up a new tile handler.
     *
-    *  @param mbtileFiles A list of pointers to MBTiles. The MBTiles are
+    *  @param mbtileFiles A list of pointers to MBTiles or PMTiles. The files are
     *  expected to agree in their metadata, and the metadata (attribution,
     *  description, format, name, minzoom, maxzoom) is read only from one of the
     *  files (a random one, in fact). If a tile is contained in more than one of
@@ -56,7 +57,7 @@ public:
     *  access to this tile. Typically, this is a string of the form
     *  "http://localhost:8080/osm"
     */
-    explicit TileHandler(const QVector<QSharedPointer<FileFormats::MBTILES>>& mbtileFiles, const QString& baseURLName);
+    explicit TileHandler(const QVector<QSharedPointer<FileFormats::TileFileAbstract>>& mbtileFiles, const QString& baseURLName);
 
     // Standard descructor
     ~TileHandler() = default;
@@ -78,8 +79,8 @@ public:
 private:
     Q_DISABLE_COPY_MOVE(TileHandler)
 
-    // List of MBTiles
-    QVector<QSharedPointer<FileFormats::MBTILES>> m_mbtiles;
+    // List of MBTiles or PMTiles
+    QVector<QSharedPointer<FileFormats::TileFileAbstract>> m_mbtiles;
 
     // Format of tiles. This is a short string such as "jpg", "pbf", "png" or
     // "webp".
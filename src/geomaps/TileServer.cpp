@@ -1,5 +1,5 @@
 /***************************************************************************
- *   Copyright (C) 2019-2024 by Stefan Kebekus                             *
+ *   Copyright (C) 2019-2026 by Stefan Kebekus                             *
  *   stefan.kebekus@gmail.com                                              *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
@@ -19,55 +19,56 @@
  ***************************************************************************/
 
 #include <QBuffer>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QDirIterator>
 #include <QGuiApplication>
 #include <QHttpServerRequest>
 #include <QHttpServerResponder>
 #include <QImage>
+#include <QSaveFile>
+#include <QSet>
+#include <QStandardPaths>
 #include <QTcpServer>
+#include <QtConcurrent/QtConcurrentRun>
 
 #include "TileServer.h"
+#include "Trace.h"
 #include "geomaps/GeoMapProvider.h"
 
 using namespace Qt::Literals::StringLiterals;
 
 
-// Night-mode version of a sprite sheet PNG from the resource system. Two-part
-// transform, following the night-mode conventions established in FlightMap.qml
-// and Global.qml: colors with little saturation (the white icon halos, dark
-// glyphs) have their brightness flipped, like the label and halo colors on the
-// moving map; saturated colors are muted, calibrated so that the icon hues
-// #1000b0 and #ff0000 land near the night-mode airspace hues of Global.qml.
-// The two regimes are blended by saturation, so that anti-aliasing pixels do
-// not produce seams.
-static QByteArray nightVersionOf(const QString& fileName)
-{
-    QImage image(fileName);
-    image.convertTo(QImage::Format_ARGB32);
+namespace {
 
-    for (int y = 0; y < image.height(); ++y)
-    {
-        auto* line = reinterpret_cast<QRgb*>(image.scanLine(y));
-        for (int x = 0; x < image.width(); ++x)
-        {
-            const QColor color = QColor::fromRgb(line[x] | 0xFF000000U);
+// Version of the night-mode transform. Increase this number whenever
+// nightColorOf() changes, so that stale files in the disk cache are no longer
+// used.
+constexpr int nightTransformVersion = 1;
 
-            const qreal vFlipped = 0.88 * (1.0 - color.valueF());
-            const qreal vMuted = 0.45 + 0.4 * color.valueF();
-            const qreal saturation = color.saturationF();
-            const qreal value = (1.0 - saturation) * vFlipped + saturation * vMuted;
 
-            const auto newColor = QColor::fromHsvF(qMax(color.hsvHueF(), 0.0), 0.55 * saturation, value);
-            line[x] = (line[x] & 0xFF000000U) | (newColor.rgb() & 0x00FFFFFFU);
-        }
-    }
+// Night-mode version of a color. Two-part transform, following the night-mode
+// conventions established in FlightMap.qml and Global.qml: colors with little
+// saturation (the white icon halos, dark glyphs) have their brightness
+// flipped, like the label and halo colors on the moving map; saturated colors
+// are muted, calibrated so that the icon hues #1000b0 and #ff0000 land near
+// the night-mode airspace hues of Global.qml. The two regimes are blended by
+// saturation, so that anti-aliasing pixels do not produce seams. The alpha
+// channel is ignored.
+QRgb nightColorOf(QRgb rgb)
+{
+    const QColor color = QColor::fromRgb(rgb | 0xFF000000U);
 
-    QByteArray result;
-    QBuffer buffer(&result);
-    buffer.open(QIODevice::WriteOnly);
-    image.save(&buffer, "PNG");
-    return result;
+    const qreal vFlipped = 0.88 * (1.0 - color.valueF());
+    const qreal vMuted = 0.45 + 0.4 * color.valueF();
+    const qreal saturation = color.saturationF();
+    const qreal value = (1.0 - saturation) * vFlipped + saturation * vMuted;
+
+    return QColor::fromHsvF(qMax(color.hsvHueF(), 0.0), 0.55 * saturation, value).rgb() & 0x00FFFFFFU;
 }
 
+} // namespace
+
 
 GeoMaps::TileServer::TileServer(QObject* parent)
     : QAbstractHttpServer(parent)
@@ -98,7 +99,7 @@ GeoMaps::TileServer::TileServer(QObject* parent)
 }
 
 
-void GeoMaps::TileServer::addMbtilesFileSet(const QString& baseName, const QVector<QSharedPointer<FileFormats::MBTILES>>& MBTilesFiles)
+void GeoMaps::TileServer::addMbtilesFileSet(const QString& baseName, const QVector<QSharedPointer<FileFormats::TileFileAbstract>>& MBTilesFiles)
 {
     QString const URL = serverUrl()+"/"+baseName;
     auto* handler = new TileHandler(MBTilesFiles, URL);
@@ -117,10 +118,117 @@ QString GeoMaps::TileServer::serverUrl()
 }
 
 
+void GeoMaps::TileServer::prepareNightSprites()
+{
+    if (m_nightSpritesStarted)
+    {
+        return;
+    }
+    m_nightSpritesStarted = true;
+    m_nightSprites = QtConcurrent::run(&GeoMaps::TileServer::nightSprites);
+}
+
+
 // Private Methods
 
+QByteArray GeoMaps::TileServer::nightVersionOf(const QByteArray& dayPNG)
+{
+    auto image = QImage::fromData(dayPNG, "PNG");
+    image.convertTo(QImage::Format_ARGB32);
+
+    // Night-mode colors computed so far, keyed by day-mode color. Pixels
+    // mostly come in runs of one color, so the last color is checked first.
+    QHash<QRgb, QRgb> nightColors;
+    QRgb lastRGB = 0;
+    QRgb lastNightRGB = nightColorOf(lastRGB);
+    for (int y = 0; y < image.height(); ++y)
+    {
+        auto* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x)
+        {
+            auto const rgb = line[x] & 0x00FFFFFFU;
+            if (rgb != lastRGB)
+            {
+                auto iterator = nightColors.constFind(rgb);
+                if (iterator == nightColors.constEnd())
+                {
+                    iterator = nightColors.insert(rgb, nightColorOf(rgb));
+                }
+                lastRGB = rgb;
+                lastNightRGB = iterator.value();
+            }
+            line[x] = (line[x] & 0xFF000000U) | lastNightRGB;
+        }
+    }
+
+    QByteArray result;
+    QBuffer buffer(&result);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "PNG");
+    return result;
+}
+
+
+QMap<QString, QByteArray> GeoMaps::TileServer::nightSprites()
+{
+    QString const cacheDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + u"/sprites-night"_s;
+    QDir().mkpath(cacheDirectory);
+
+    QMap<QString, QByteArray> result;
+    QSet<QString> cacheFileNames;
+    QDirIterator iterator(u":/flightMap/sprites"_s, {u"*.png"_s}, QDir::Files);
+    while (iterator.hasNext())
+    {
+        auto const dayPath = iterator.next();
+        QFile dayFile(dayPath);
+        if (!dayFile.open(QIODevice::ReadOnly))
+        {
+            continue;
+        }
+        auto const dayPNG = dayFile.readAll();
+
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        hash.addData(QByteArray::number(nightTransformVersion));
+        hash.addData(dayPNG);
+        auto const cacheFileName = QString::fromLatin1(hash.result().toHex()) + u".png"_s;
+        cacheFileNames += cacheFileName;
+
+        QFile cacheFile(cacheDirectory + u"/"_s + cacheFileName);
+        if (cacheFile.open(QIODevice::ReadOnly))
+        {
+            result[dayPath] = cacheFile.readAll();
+            if (!result[dayPath].isEmpty())
+            {
+                continue;
+            }
+        }
+
+        result[dayPath] = nightVersionOf(dayPNG);
+        QSaveFile saveFile(cacheFile.fileName());
+        if (saveFile.open(QIODevice::WriteOnly))
+        {
+            saveFile.write(result[dayPath]);
+            saveFile.commit();
+        }
+    }
+
+    // Remove stale files from the cache
+    const auto entries = QDir(cacheDirectory).entryList({u"*.png"_s}, QDir::Files);
+    for (const auto& entry : entries)
+    {
+        if (!cacheFileNames.contains(entry))
+        {
+            QFile::remove(cacheDirectory + u"/"_s + entry);
+        }
+    }
+    return result;
+}
+
+
 bool GeoMaps::TileServer::handleRequest(const QHttpServerRequest& request, QHttpServerResponder& responder)
 {
+    Trace::Span const span("TileServer::handleRequest");
+
     auto path = request.url().path();
     auto pathElements = path.split('/', Qt::SkipEmptyParts);
 
@@ -142,8 +250,27 @@ bool GeoMaps::TileServer::handleRequest(const QHttpServerRequest& request, QHttp
     }
 
     //
-    // Night-mode sprite sheet, recolored on the fly from the day-mode sprite
-    // sheet in the resource system
+    // Style document, from memory
+    //
+    if ((pathElements.size() == 2) && (pathElements[0] == u"style"_s))
+    {
+        auto iterator = m_styles.constFind(pathElements[1]);
+        if (iterator == m_styles.constEnd())
+        {
+            return false;
+        }
+
+        // The content under a given name never changes
+        QHttpHeaders headers;
+        headers.append(QHttpHeaders::WellKnownHeader::ContentType, "application/json");
+        headers.append(QHttpHeaders::WellKnownHeader::CacheControl, "public, max-age=31536000, immutable");
+        responder.write(iterator.value(), headers);
+        return true;
+    }
+
+    //
+    // Night-mode sprite sheet, recolored from the day-mode sprite sheet in the
+    // resource system
     //
     if (path.startsWith(u"/flightMap/sprites-night/"_s))
     {
@@ -161,10 +288,27 @@ bool GeoMaps::TileServer::handleRequest(const QHttpServerRequest& request, QHttp
         }
         if (path.endsWith(u".png"_s))
         {
-            auto& nightSprite = m_nightSprites[dayPath];
+            // While the sprite sheets are still being prepared, serve the
+            // day-mode sheet instead of blocking the server thread. It must
+            // not be cached, so that the night-mode sheet is used once ready.
+            prepareNightSprites();
+            if (!m_nightSprites.isFinished())
+            {
+                QFile dayFile(dayPath);
+                if (!dayFile.open(QIODevice::ReadOnly))
+                {
+                    return false;
+                }
+                QHttpHeaders headers;
+                headers.append(QHttpHeaders::WellKnownHeader::ContentType, "image/png");
+                headers.append(QHttpHeaders::WellKnownHeader::CacheControl, "no-store");
+                responder.write(dayFile.readAll(), headers);
+                return true;
+            }
+            auto nightSprite = m_nightSprites.result().value(dayPath);
             if (nightSprite.isEmpty())
             {
-                nightSprite = nightVersionOf(dayPath);
+                return false;
             }
             responder.write(nightSprite, "image/png");
             return true;
@@ -20,12 +20,16 @@
 
 #pragma once
 
-#include "fileFormats/MBTILES.h"
+#include "fileFormats/TileFileAbstract.h"
 #include "geomaps/TileHandler.h"
 
 #include <QAbstractHttpServer>
+#include <QFuture>
+#include <QHash>
 #include <QSharedPointer>
 
+class Benchmark;
+
 
 namespace GeoMaps {
 
@@ -40,6 +44,13 @@ namespace GeoMaps {
  *    night-mode version of the flight map sprite sheet found in the resource
  *    system under "flightMap/sprites/xyz". The JSON files are served
  *    unchanged, the PNG files are recolored for use over the dark map style.
+ *    The recolored PNGs are prepared in the background once
+ *    prepareNightSprites() is called, or else on the first request, and
+ *    cached on disk.
+ *  - If path is of the form "style/name", the server serves the style
+ *    document that was added under that name with addStyle(). Style
+ *    documents are expected never to change under a given name, and are
+ *    served with headers that allow clients to cache them indefinitely.
  *  - If path equals "aviationData.geojson", the server returns a GeoJSON
  *    document that contains the full aviation data, as provided by
  *    GlobalObject::geoMapProvider()->geoJSON().
@@ -63,6 +74,9 @@ class TileServer : public QAbstractHttpServer
 {
     Q_OBJECT
 
+    // The benchmarks call private static methods directly
+    friend class ::Benchmark;
+
 public:
     /*! \brief Create a new tile server
      *
@@ -113,10 +127,10 @@ public slots:
      *
      *  @param baseName The path under which the tiles will be available.
      *
-     *  @param MBTilesFiles The name of one or more mbtile files on the disk,
+     *  @param MBTilesFiles The name of one or more tile files on the disk,
      *  which are expected to conform to the MBTiles Specification 1.3
-     *  (https://github.com/mapbox/mbtiles-spec/blob/master/1.3/spec.md). These
-     *  files must exist until the file set is removed or the sever is destructed,
+     *  (https://github.com/mapbox/mbtiles-spec/blob/master/1.3/spec.md) or to
+     *  version 3 of the PMTiles Specification. These files must exist until the file set is removed or the sever is destructed,
      *  or else replies to tile requests will yield undefined results. The tile
      *  files are expected to agree in their metadata, and the metadata
      *  (attribution, description, format, name, minzoom, maxzoom) is read only
@@ -124,7 +138,7 @@ public slots:
      *  more than one of the files, the data is expected to be identical in each
      *  of the files.
      */
-    void addMbtilesFileSet(const QString& baseName, const QVector<QSharedPointer<FileFormats::MBTILES>>& MBTilesFiles);
+    void addMbtilesFileSet(const QString& baseName, const QVector<QSharedPointer<FileFormats::TileFileAbstract>>& MBTilesFiles);
 
     /*! \brief Removes a set of tile files
      *
@@ -138,6 +152,39 @@ public slots:
      */
     void removeMbtilesFileSets() {m_tileHandlers.clear();}
 
+    /*! \brief Add a style document
+     *
+     *  This method adds a style document, which will be available under
+     *  serverUrl()+"/style/name". The document must not change later on; to
+     *  change a style, add a document under a new name.
+     *
+     *  @param name Name of the style document
+     *
+     *  @param data Content of the style document, typically a mapbox style
+     *  in JSON format
+     */
+    void addStyle(const QString& name, const QByteArray& data) {m_styles[name] = data;}
+
+    /*! \brief Check if a style document exists
+     *
+     *  @param name Name of the style document
+     *
+     *  @returns True if a style document was added under the given name
+     */
+    [[nodiscard]] bool hasStyle(const QString& name) const {return m_styles.contains(name);}
+
+    /*! \brief Removes all style documents */
+    void removeStyles() {m_styles.clear();}
+
+    /*! \brief Prepare the night-mode sprite sheets
+     *
+     *  This method starts the preparation of the night-mode sprite sheets in
+     *  a background thread, unless it has already been started. Call it as
+     *  soon as night mode is switched on, so that the first night-mode map
+     *  load does not stall.
+     */
+    void prepareNightSprites();
+
 
 signals:
     /*! \brief Notification signal for the property with the same name */
@@ -164,14 +211,31 @@ private:
      */
     void restart();
 
+    // Night-mode version of a sprite sheet PNG. Sprite sheets contain only
+    // few distinct colors, so the transform is computed once per distinct
+    // color and remembered in a hash. The result is identical to recoloring
+    // every pixel.
+    static QByteArray nightVersionOf(const QByteArray& dayPNG);
+
+    // Night-mode versions of all sprite sheet PNGs in the resource system,
+    // keyed by resource file name of the day-mode original. The PNGs are
+    // stored in a disk cache, under a name derived from the content of the
+    // day-mode original and from the version of the transform, so that they
+    // are computed only once per installed version. Files in the cache that
+    // are no longer needed are removed.
+    static QMap<QString, QByteArray> nightSprites();
+
     // List of tile handlers
     QMap<QString, QSharedPointer<GeoMaps::TileHandler>> m_tileHandlers;
 
+    // Style documents, keyed by name
+    QHash<QString, QByteArray> m_styles;
+
     // Night-mode sprite sheets, keyed by resource file name of the day-mode
-    // original. Computing the recolored PNGs is not free, so they are cached
-    // here after the first request. The transform is deterministic, so entries
-    // never need to be invalidated.
-    QMap<QString, QByteArray> m_nightSprites;
+    // original. The sheets are prepared in a background thread by
+    // prepareNightSprites(), and kept in a disk cache between runs.
+    QFuture<QMap<QString, QByteArray>> m_nightSprites;
+    bool m_nightSpritesStarted {false};
 
     // Internal variable. Indicates if the app has been suspended.
     // This is used on changes of QGuiApplication::applicationState,
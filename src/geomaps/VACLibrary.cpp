@@ -25,14 +25,19 @@
 #include <QImage>
 #include <QRegularExpression>
 #include <QSaveFile>
+#include <QSet>
 #include <QTemporaryDir>
 #include <QTimer>
+#include <QtConcurrent/QtConcurrentRun>
+#include <cmath>
 
-#include "Librarian.h"
 #include "VACLibrary.h"
 #include "dataManagement/DataManager.h"
 #include "fileFormats/TripKit.h"
 #include "fileFormats/VACCollection.h"
+#include "geomaps/WaypointSearchIndex.h"
+#include "navigation/FlightRoute.h"
+#include "navigation/Navigator.h"
 
 
 
@@ -46,6 +51,9 @@ GeoMaps::VACLibrary::VACLibrary(QObject *parent)
     // Wire up: Save library whenever the content changes
     connect(this, &GeoMaps::VACLibrary::dataChanged, this, &GeoMaps::VACLibrary::save, Qt::QueuedConnection);
 
+    // Wire up: Invalidate the chart index whenever the content changes
+    connect(this, &GeoMaps::VACLibrary::dataChanged, this, [this]() { m_indexDirty = true; });
+
     // Restore previously saves VAC library
     if (m_dataFile.open(QIODeviceBase::ReadOnly))
     {
@@ -69,11 +77,22 @@ GeoMaps::VACLibrary::VACLibrary(QObject *parent)
         connect(vacCollections, &DataManagement::Downloadable_Abstract::fileContentChanged_delayed,
                 &m_updateCollectionsTimer, qOverload<>(&QTimer::start));
         updateCollections();
+
+        // Wire up: extract charts for the airfields on the flight route ahead
+        // of time. The timer compresses the notifications that arrive while
+        // the user edits the route.
+        connect(GlobalObject::navigator()->flightRoute(), &Navigation::FlightRoute::waypointsChanged,
+                &m_preMaterializeTimer, qOverload<>(&QTimer::start));
+        m_preMaterializeTimer.start();
     });
+    m_preMaterializeTimer.setSingleShot(true);
+    m_preMaterializeTimer.setInterval(1000);
+    connect(&m_preMaterializeTimer, &QTimer::timeout, this, &GeoMaps::VACLibrary::preMaterialize);
 }
 
 GeoMaps::VACLibrary::~VACLibrary()
 {
+    m_preMaterializeFuture.waitForFinished();
     save();
 }
 
@@ -239,23 +258,12 @@ GeoMaps::VAC GeoMaps::VACLibrary::materialize(const GeoMaps::VAC& vac)
         return vac;
     }
 
-    QFileInfo const containerInfo(vac.fileName);
-    if (!containerInfo.exists())
+    auto cacheFileName = GeoMaps::VACLibrary::cacheFileName(vac, m_cacheDirectory);
+    if (cacheFileName.isEmpty())
     {
         return vac;
     }
 
-    // Compute the name of the cache file. The modification date of the
-    // collection file is encoded in the file name, so the cache entry (and the
-    // file URL used by the moving map) changes whenever the collection is
-    // updated.
-    static const QRegularExpression forbiddenCharacters(uR"([/\\:*?"<>|])"_s);
-    auto safeName = vac.name;
-    safeName.replace(forbiddenCharacters, u"_"_s);
-    auto cacheDirName = m_cacheDirectory + u"/"_s + containerInfo.completeBaseName();
-    auto cacheFileName = cacheDirName + u"/"_s + safeName + u"-"_s
-            + QString::number(containerInfo.lastModified().toSecsSinceEpoch()) + u".webp"_s;
-
     auto result = vac;
     result.fileName = cacheFileName;
     if (QFile::exists(cacheFileName))
@@ -263,19 +271,24 @@ GeoMaps::VAC GeoMaps::VACLibrary::materialize(const GeoMaps::VAC& vac)
         return result;
     }
 
-    // Extract the raster image from the collection file
-    FileFormats::VACCollection collection(vac.fileName);
-    if (!collection.isValid())
+    // Extract the raster image from the collection file, reusing the database
+    // connection opened in updateCollections()
+    auto collection = m_collections.value(QFileInfo(vac.fileName).absoluteFilePath());
+    if (collection.isNull())
+    {
+        collection = QSharedPointer<FileFormats::VACCollection>::create(vac.fileName);
+    }
+    if (!collection->isValid())
     {
         return vac;
     }
-    auto imageData = collection.imageData(vac.name);
+    auto imageData = collection->imageData(vac.name);
     if (imageData.isEmpty())
     {
         return vac;
     }
     QDir const dir;
-    dir.mkpath(cacheDirName);
+    dir.mkpath(QFileInfo(cacheFileName).path());
     QSaveFile cacheFile(cacheFileName);
     if (!cacheFile.open(QIODeviceBase::WriteOnly))
     {
@@ -345,27 +358,18 @@ QString GeoMaps::VACLibrary::rename(const QString& oldName, const QString& newNa
 
 QVector<GeoMaps::VAC> GeoMaps::VACLibrary::vacsByDistance(const QGeoCoordinate& position, const QString& filter)
 {
-    QStringList filterWords;
-    foreach(auto word, filter.simplified().split(' ', Qt::SkipEmptyParts)) {
-        QString const simplifiedWord = GlobalObject::librarian()->simplifySpecialChars(word);
-        if (simplifiedWord.isEmpty()) {
-            continue;
-        }
-        filterWords.append(simplifiedWord);
-    }
+    updateIndex();
+    auto const filterWords = GeoMaps::WaypointSearchIndex::searchWords(filter);
 
-    QVector<GeoMaps::VAC> result;
-    const auto constvacs = m_vacs + m_collectionVacs;
-    for(const auto& vac : constvacs) {
-        if (!vac.isValid())
-        {
-            continue;
-        }
+    // Compute every distance once, then sort by distance
+    QVector<std::pair<double, qsizetype>> matches;
+    for(qsizetype index = 0; index < m_index.size(); index++)
+    {
+        const auto& entry = m_index.at(index);
         bool allWordsFound = true;
         for(const auto& word : filterWords)
         {
-            QString const fullName = GlobalObject::librarian()->simplifySpecialChars(vac.name);
-            if (!fullName.contains(word, Qt::CaseInsensitive))
+            if (!entry.simplifiedName.contains(word))
             {
                 allWordsFound = false;
                 break;
@@ -373,29 +377,43 @@ QVector<GeoMaps::VAC> GeoMaps::VACLibrary::vacsByDistance(const QGeoCoordinate&
         }
         if (allWordsFound)
         {
-            result.append(vac);
+            matches.append({position.distanceTo(entry.center), index});
         }
     }
+    std::stable_sort(matches.begin(), matches.end(), [](const auto& first, const auto& second) {return first.first < second.first; });
 
-    std::sort(result.begin(), result.end(), [position](const GeoMaps::VAC& first, const GeoMaps::VAC& second) {return position.distanceTo(first.center()) < position.distanceTo(second.center()); });
+    QVector<GeoMaps::VAC> result;
+    result.reserve(matches.size());
+    for(const auto& match : std::as_const(matches))
+    {
+        result.append(m_index.at(match.second).vac);
+    }
     return result;
 }
 
 QVector<GeoMaps::VAC> GeoMaps::VACLibrary::vacs4Point(const QGeoCoordinate& position)
 {
+    if (!position.isValid())
+    {
+        return {};
+    }
+    updateIndex();
+
+    // Candidates are the charts listed in the grid cell of the position, and
+    // the ungridded charts. Since m_index is sorted by name, sorting the
+    // indices sorts the result by name.
+    auto indices = m_indexGrid.value(indexGridKey(position.latitude(), position.longitude())) + m_indexUngridded;
+    std::sort(indices.begin(), indices.end());
+
     QVector<GeoMaps::VAC> result;
-    const auto constvacs = m_vacs + m_collectionVacs;
-    for(const auto& vac : constvacs) {
-        if (!vac.isValid())
-        {
-            continue;
-        }
-        if (vac.boundingBox().contains(position))
+    for(auto index : std::as_const(indices))
+    {
+        const auto& entry = m_index.at(index);
+        if (entry.boundingBox.contains(position))
         {
-            result.append(vac);
+            result.append(entry.vac);
         }
     }
-    std::sort(result.begin(), result.end(), [](const GeoMaps::VAC& first, const GeoMaps::VAC& second) {return first.name < second.name; });
     return result;
 }
 
@@ -471,6 +489,8 @@ void GeoMaps::VACLibrary::janitor()
         QFile::remove(fInfo.filePath());
     }
 
+    // File names might have changed above, even if hasChange is false
+    m_indexDirty = true;
     if (hasChange)
     {
         emit dataChanged();
@@ -480,20 +500,23 @@ void GeoMaps::VACLibrary::janitor()
 void GeoMaps::VACLibrary::updateCollections()
 {
     // Rebuild m_collectionVacs from the collection files that are currently
-    // installed
+    // installed. The collections are kept open, so that materialize() does
+    // not need to open a new database connection for every chart.
     m_collectionVacs.clear();
+    m_collections.clear();
     QMap<QString, QDateTime> collectionModificationDates;
     const auto files = GlobalObject::dataManager()->vacCollections()->files();
     for (const auto& file : files)
     {
-        FileFormats::VACCollection const collection(file);
-        if (!collection.isValid())
+        auto collection = QSharedPointer<FileFormats::VACCollection>::create(file);
+        if (!collection->isValid())
         {
-            qWarning() << "VACLibrary: Ignoring invalid VAC collection file" << file << collection.error();
+            qWarning() << "VACLibrary: Ignoring invalid VAC collection file" << file << collection->error();
             continue;
         }
         collectionModificationDates.insert(QFileInfo(file).completeBaseName(), QFileInfo(file).lastModified());
-        m_collectionVacs.append(collection.charts());
+        m_collectionVacs.append(collection->charts());
+        m_collections.insert(QFileInfo(file).absoluteFilePath(), collection);
     }
 
     // Clean the extraction cache: remove cache directories for collections
@@ -523,6 +546,7 @@ void GeoMaps::VACLibrary::updateCollections()
     }
 
     emit dataChanged();
+    m_preMaterializeTimer.start();
 }
 
 void GeoMaps::VACLibrary::save()
@@ -544,3 +568,154 @@ QString GeoMaps::VACLibrary::absolutePathForVac(const QString& name)
 {
     return m_vacDirectory + "/" + name + ".webp";
 }
+
+QString GeoMaps::VACLibrary::cacheFileName(const GeoMaps::VAC& vac, const QString& cacheDirectory)
+{
+    QFileInfo const containerInfo(vac.fileName);
+    if (!containerInfo.exists())
+    {
+        return {};
+    }
+
+    static const QRegularExpression forbiddenCharacters(uR"([/\\:*?"<>|])"_s);
+    auto safeName = vac.name;
+    safeName.replace(forbiddenCharacters, u"_"_s);
+    return cacheDirectory + u"/"_s + containerInfo.completeBaseName() + u"/"_s + safeName + u"-"_s
+           + QString::number(containerInfo.lastModified().toSecsSinceEpoch()) + u".webp"_s;
+}
+
+void GeoMaps::VACLibrary::extractCharts(const QList<std::pair<GeoMaps::VAC, QString>>& jobs)
+{
+    // Jobs are sorted by collection file, so every collection is opened once.
+    // Database connections cannot be shared between threads, so this method
+    // opens its own.
+    std::unique_ptr<FileFormats::VACCollection> collection;
+    QString collectionFileName;
+    QDir const dir;
+    for(const auto& [vac, cacheFileName] : jobs)
+    {
+        if (!collection || (collectionFileName != vac.fileName))
+        {
+            collection = std::make_unique<FileFormats::VACCollection>(vac.fileName);
+            collectionFileName = vac.fileName;
+        }
+        if (!collection->isValid())
+        {
+            continue;
+        }
+        auto imageData = collection->imageData(vac.name);
+        if (imageData.isEmpty())
+        {
+            continue;
+        }
+        dir.mkpath(QFileInfo(cacheFileName).path());
+        QSaveFile cacheFile(cacheFileName);
+        if (!cacheFile.open(QIODeviceBase::WriteOnly))
+        {
+            continue;
+        }
+        cacheFile.write(imageData);
+        cacheFile.commit();
+    }
+}
+
+void GeoMaps::VACLibrary::preMaterialize()
+{
+    // Try again later if an extraction is still running
+    if (m_preMaterializeFuture.isRunning())
+    {
+        m_preMaterializeTimer.start();
+        return;
+    }
+
+    // Find the collection charts for airfields on the route that have not
+    // been extracted yet
+    QList<std::pair<GeoMaps::VAC, QString>> jobs;
+    QSet<QString> cacheFileNames;
+    const auto waypoints = GlobalObject::navigator()->flightRoute()->waypoints();
+    for(const auto& waypoint : waypoints)
+    {
+        if (waypoint.type() != u"AD"_s)
+        {
+            continue;
+        }
+        const auto charts = vacs4Point(waypoint.coordinate());
+        for(const auto& vac : charts)
+        {
+            if (vac.collection.isEmpty())
+            {
+                continue;
+            }
+            auto cacheFileName = GeoMaps::VACLibrary::cacheFileName(vac, m_cacheDirectory);
+            if (cacheFileName.isEmpty() || cacheFileNames.contains(cacheFileName) || QFile::exists(cacheFileName))
+            {
+                continue;
+            }
+            cacheFileNames.insert(cacheFileName);
+            jobs.append({vac, cacheFileName});
+        }
+    }
+    if (jobs.isEmpty())
+    {
+        return;
+    }
+    std::stable_sort(jobs.begin(), jobs.end(), [](const auto& first, const auto& second) {return first.first.fileName < second.first.fileName; });
+    m_preMaterializeFuture = QtConcurrent::run(&GeoMaps::VACLibrary::extractCharts, jobs);
+}
+
+qint32 GeoMaps::VACLibrary::indexGridKey(double latitude, double longitude)
+{
+    auto const latitudeCell = qBound(0, static_cast<int>(std::floor(latitude)) + 90, 180);
+    auto const longitudeCell = qBound(0, static_cast<int>(std::floor(longitude)) + 180, 360);
+    return (latitudeCell * 361) + longitudeCell;
+}
+
+void GeoMaps::VACLibrary::updateIndex()
+{
+    if (!m_indexDirty)
+    {
+        return;
+    }
+    m_indexDirty = false;
+
+    // Collect all valid charts, sorted by name. Validity involves a check for
+    // file existence, which is done here once and not on every query.
+    m_index.clear();
+    m_indexGrid.clear();
+    m_indexUngridded.clear();
+    const auto constvacs = m_vacs + m_collectionVacs;
+    for(const auto& vac : constvacs)
+    {
+        if (!vac.isValid())
+        {
+            continue;
+        }
+        m_index.append({vac, vac.boundingBox(), vac.center(), GeoMaps::WaypointSearchIndex::simplify(vac.name)});
+    }
+    std::stable_sort(m_index.begin(), m_index.end(), [](const IndexEntry& first, const IndexEntry& second) {return first.vac.name < second.vac.name; });
+
+    // Enter every chart into the cells touched by its bounding box. Charts
+    // are visited in order, so every cell list is sorted. Bounding boxes that
+    // cross the date line, or that cover more than a few dozen cells, are
+    // not worth entering into the grid.
+    for(qsizetype index = 0; index < m_index.size(); index++)
+    {
+        const auto& boundingBox = m_index.at(index).boundingBox;
+        auto const minLatitude = static_cast<int>(std::floor(boundingBox.bottomLeft().latitude()));
+        auto const maxLatitude = static_cast<int>(std::floor(boundingBox.topRight().latitude()));
+        auto const minLongitude = static_cast<int>(std::floor(boundingBox.bottomLeft().longitude()));
+        auto const maxLongitude = static_cast<int>(std::floor(boundingBox.topRight().longitude()));
+        if ((minLongitude > maxLongitude) || ((maxLatitude-minLatitude+1)*(maxLongitude-minLongitude+1) > 64))
+        {
+            m_indexUngridded.append(index);
+            continue;
+        }
+        for(auto latitude = minLatitude; latitude <= maxLatitude; latitude++)
+        {
+            for(auto longitude = minLongitude; longitude <= maxLongitude; longitude++)
+            {
+                m_indexGrid[indexGridKey(latitude, longitude)].append(index);
+            }
+        }
+    }
+}
@@ -21,11 +21,19 @@
 #pragma once
 
 #include <QFile>
+#include <QFuture>
+#include <QHash>
+#include <QSharedPointer>
 #include <QStandardPaths>
 #include <QTimer>
 
 #include "geomaps/VAC.h"
 
+namespace FileFormats
+{
+class VACCollection;
+} // namespace FileFormats
+
 
 namespace GeoMaps
 {
@@ -40,7 +48,13 @@ namespace GeoMaps
  * contained in the VAC collections managed by DataManagement::DataManager.
  * These charts are not stored in the library data file, cannot be renamed or
  * removed individually, and their raster data is extracted on demand; see
- * materialize().
+ * materialize(). Charts for the airfields on the current flight route are
+ * extracted in the background, ahead of time.
+ *
+ * To answer vacs4Point() and vacsByDistance() quickly, the class maintains an
+ * index of all valid charts, with precomputed bounding boxes and simplified
+ * names, together with a grid of 1°x1° cells that lists the charts touching
+ * each cell. The index is rebuilt lazily after every change.
  */
 
 class VACLibrary : public QObject
@@ -224,6 +238,29 @@ private:
     // This method saves m_vacs to m_dataFile.
     void save();
 
+    // Returns the name of the file in cacheDirectory that holds the raster data
+    // of a chart from a VAC collection. The modification date of the
+    // collection file is encoded in the file name, so the cache entry (and the
+    // file URL used by the moving map) changes whenever the collection is
+    // updated.
+    [[nodiscard]] static QString cacheFileName(const GeoMaps::VAC& vac, const QString& cacheDirectory);
+
+    // Extracts the raster data of charts from VAC collections into the given
+    // cache files. Charts from the same collection share one database
+    // connection. This method is meant to be run in a separate thread, and
+    // therefore opens its own connections.
+    static void extractCharts(const QList<std::pair<GeoMaps::VAC, QString>>& jobs);
+
+    // Starts extraction of the charts for all airfields on the current flight
+    // route in a separate thread, unless they have been extracted already.
+    void preMaterialize();
+
+    // Rebuilds m_index and m_indexGrid if m_indexDirty is set.
+    void updateIndex();
+
+    // Key of the 1°x1° grid cell containing the given coordinate
+    [[nodiscard]] static qint32 indexGridKey(double latitude, double longitude);
+
     // This method returns the absolute path of a given VAC. Needed for iOS
     // after App Update. See GeoMaps::VACLibrary::janitor
     QString absolutePathForVac(const GeoMaps::VAC&);
@@ -239,6 +276,32 @@ private:
     // call to updateCollections()
     QTimer m_updateCollectionsTimer;
 
+    // Open VAC collections, by absolute file name. Each collection holds one
+    // database connection, which is reused whenever charts are materialized.
+    QHash<QString, QSharedPointer<FileFormats::VACCollection>> m_collections;
+
+    // Chart index. The list m_index contains all VACs that were valid at the
+    // time the index was built, sorted by name. This avoids repeated checks
+    // for file existence in VAC::isValid(). The grid m_indexGrid maps grid
+    // cells to sorted lists of indices into m_index. Charts that are too large
+    // for the grid, or that cross the date line, are listed in
+    // m_indexUngridded.
+    struct IndexEntry
+    {
+        GeoMaps::VAC vac;
+        QGeoRectangle boundingBox;
+        QGeoCoordinate center;
+        QString simplifiedName;
+    };
+    QVector<IndexEntry> m_index;
+    QHash<qint32, QVector<qsizetype>> m_indexGrid;
+    QVector<qsizetype> m_indexUngridded;
+    bool m_indexDirty {true};
+
+    // Background extraction of charts for the current flight route
+    QFuture<void> m_preMaterializeFuture;
+    QTimer m_preMaterializeTimer;
+
 };
 
 } // namespace GeoMaps
@@ -22,8 +22,12 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QXmlStreamWriter>
+#include <QtMath>
+#include <array>
+#include <cmath>
 
 #include "Librarian.h"
+#include "dataManagement/FileWriter.h"
 #include "fileFormats/CUP.h"
 #include "fileFormats/FPL.h"
 #include "fileFormats/PLN.h"
@@ -31,16 +35,105 @@
 #include "geomaps/GeoJSON.h"
 #include "geomaps/WaypointLibrary.h"
 
+
+namespace {
+
+/*
+ * Spatial hash for proximity tests in the sense of GeoMaps::Waypoint::isNear.
+ * Coordinates are mapped to unit vectors in 3-space, which are quantized to
+ * cubes whose edge length corresponds to the proximity radius. Chords are
+ * never longer than arcs, so every waypoint near a given position lies in
+ * the cube of that position or in one of its 26 neighbours, at any latitude.
+ */
+class ProximityHash
+{
+public:
+    void insert(const GeoMaps::Waypoint& waypoint)
+    {
+        if (!waypoint.coordinate().isValid())
+        {
+            return;
+        }
+        auto const cell = cellOf(waypoint.coordinate());
+        m_cells[key(cell[0], cell[1], cell[2])].append(waypoint);
+    }
+
+    [[nodiscard]] bool hasNearbyEntry(const GeoMaps::Waypoint& waypoint) const
+    {
+        if (!waypoint.coordinate().isValid())
+        {
+            return false;
+        }
+        auto const cell = cellOf(waypoint.coordinate());
+        for (int dx = -1; dx <= 1; dx++)
+        {
+            for (int dy = -1; dy <= 1; dy++)
+            {
+                for (int dz = -1; dz <= 1; dz++)
+                {
+                    auto iterator = m_cells.constFind(key(cell[0]+dx, cell[1]+dy, cell[2]+dz));
+                    if (iterator == m_cells.constEnd())
+                    {
+                        continue;
+                    }
+                    for (const auto& other : iterator.value())
+                    {
+                        if (other.isNear(waypoint))
+                        {
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+    // Edge length of the cubes, as a fraction of the earth radius. Slightly
+    // larger than the 2km radius used in GeoMaps::Waypoint::isNear.
+    static constexpr double cellSize = 2000.0 / 6371000.0;
+
+    static std::array<int, 3> cellOf(const QGeoCoordinate& coordinate)
+    {
+        auto const latitude = qDegreesToRadians(coordinate.latitude());
+        auto const longitude = qDegreesToRadians(coordinate.longitude());
+        return {static_cast<int>(std::floor(qCos(latitude)*qCos(longitude)/cellSize)),
+                static_cast<int>(std::floor(qCos(latitude)*qSin(longitude)/cellSize)),
+                static_cast<int>(std::floor(qSin(latitude)/cellSize))};
+    }
+
+    static quint64 key(int x, int y, int z)
+    {
+        return (quint64(quint16(x)) << 32) | (quint64(quint16(y)) << 16) | quint64(quint16(z));
+    }
+
+    QHash<quint64, QVector<GeoMaps::Waypoint>> m_cells;
+};
+
+bool lessByName(const GeoMaps::Waypoint& first, const GeoMaps::Waypoint& second)
+{
+    return first.name() < second.name();
+}
+
+} // namespace
+
 GeoMaps::WaypointLibrary::WaypointLibrary(QObject *parent)
     : GlobalObject(parent)
 {
+    connect(this, &GeoMaps::WaypointLibrary::waypointsChanged, this, [this]() {
+        m_searchIndexDirty = true;
+        m_spatialIndexDirty = true;
+    });
 }
 
 
 void GeoMaps::WaypointLibrary::deferredInitialization()
 {
     (void)loadFromGeoJSON();
-    connect(this, &GeoMaps::WaypointLibrary::waypointsChanged, this, [this]() { (void)save(); });
+    connect(this, &GeoMaps::WaypointLibrary::waypointsChanged, this, [this]() {
+        GlobalObject::fileWriter()->schedule(stdFileName, [waypoints = m_waypoints]() { return toGeoJSON(waypoints); });
+    });
 }
 
 
@@ -48,10 +141,10 @@ void GeoMaps::WaypointLibrary::deferredInitialization()
 // Getter Methods
 //
 
-QByteArray GeoMaps::WaypointLibrary::GeoJSON() const
+QByteArray GeoMaps::WaypointLibrary::toGeoJSON(const QList<GeoMaps::Waypoint>& waypoints)
 {
     QJsonArray waypointArray;
-    foreach (const auto& waypoint, m_waypoints)
+    for (const auto& waypoint : waypoints)
     {
         if (waypoint.isValid())
         {
@@ -69,6 +162,26 @@ QByteArray GeoMaps::WaypointLibrary::GeoJSON() const
     return doc.toJson();
 }
 
+const GeoMaps::WaypointSearchIndex& GeoMaps::WaypointLibrary::searchIndex() const
+{
+    if (m_searchIndexDirty)
+    {
+        m_searchIndex = WaypointSearchIndex(m_waypoints);
+        m_searchIndexDirty = false;
+    }
+    return m_searchIndex;
+}
+
+const GeoMaps::WaypointSpatialIndex& GeoMaps::WaypointLibrary::spatialIndex() const
+{
+    if (m_spatialIndexDirty)
+    {
+        m_spatialIndex = WaypointSpatialIndex(m_waypoints);
+        m_spatialIndexDirty = false;
+    }
+    return m_spatialIndex;
+}
+
 
 //
 // Methods
@@ -81,9 +194,49 @@ void GeoMaps::WaypointLibrary::add(const GeoMaps::Waypoint &waypoint)
         return;
     }
 
-    m_waypoints.append(waypoint);
-    std::sort(m_waypoints.begin(), m_waypoints.end(), [](const Waypoint &a, const Waypoint &b)
-    { return a.name() < b.name(); });
+    m_waypoints.insert(std::upper_bound(m_waypoints.begin(), m_waypoints.end(), waypoint, lessByName), waypoint);
+    emit waypointsChanged();
+}
+
+void GeoMaps::WaypointLibrary::addMany(const QVector<GeoMaps::Waypoint>& waypoints, bool skipNearby)
+{
+    ProximityHash proximityHash;
+    if (skipNearby)
+    {
+        for (const auto& waypoint : std::as_const(m_waypoints))
+        {
+            proximityHash.insert(waypoint);
+        }
+    }
+
+    QVector<GeoMaps::Waypoint> newWaypoints;
+    newWaypoints.reserve(waypoints.size());
+    for (const auto& waypoint : waypoints)
+    {
+        if (!waypoint.isValid())
+        {
+            continue;
+        }
+        if (skipNearby)
+        {
+            if (proximityHash.hasNearbyEntry(waypoint))
+            {
+                continue;
+            }
+            proximityHash.insert(waypoint);
+        }
+        newWaypoints.append(waypoint);
+    }
+    if (newWaypoints.isEmpty())
+    {
+        return;
+    }
+
+    std::stable_sort(newWaypoints.begin(), newWaypoints.end(), lessByName);
+    QList<GeoMaps::Waypoint> merged;
+    merged.reserve(m_waypoints.size() + newWaypoints.size());
+    std::merge(m_waypoints.cbegin(), m_waypoints.cend(), newWaypoints.cbegin(), newWaypoints.cend(), std::back_inserter(merged), lessByName);
+    m_waypoints = merged;
     emit waypointsChanged();
 }
 
@@ -100,30 +253,22 @@ void GeoMaps::WaypointLibrary::clear()
 
 QVector<GeoMaps::Waypoint> GeoMaps::WaypointLibrary::filteredWaypoints(const QString &filter) const
 {
-    QVector<GeoMaps::Waypoint> result;
-
-    QString const simplifiedFilter = GlobalObject::librarian()->simplifySpecialChars(filter);
-    foreach (auto waypoint, m_waypoints)
+    QStringList words;
+    auto simplifiedFilter = WaypointSearchIndex::simplify(filter);
+    if (!simplifiedFilter.isEmpty())
     {
-        auto simplifiedName = GlobalObject::librarian()->simplifySpecialChars(waypoint.name());
-        if (simplifiedName.contains(simplifiedFilter, Qt::CaseInsensitive))
-        {
-            result.append(waypoint);
-        }
+        words.append(simplifiedFilter);
     }
-    return result;
+
+    const auto& index = searchIndex();
+    return index.waypoints(index.search(words, false));
 }
 
 bool GeoMaps::WaypointLibrary::hasNearbyEntry(const GeoMaps::Waypoint &waypoint) const
 {
-    for (const auto &wp :  std::as_const(m_waypoints))
-    {
-        if (wp.isNear(waypoint))
-        {
-            return true;
-        }
-    }
-    return false;
+    // The nearest waypoint is near if any waypoint is
+    auto nearest = spatialIndex().nearest(waypoint.coordinate(), 1);
+    return !nearest.isEmpty() && nearest.constFirst().isNear(waypoint);
 }
 
 auto GeoMaps::WaypointLibrary::loadFromGeoJSON(QString fileName) -> QString
@@ -164,6 +309,7 @@ auto GeoMaps::WaypointLibrary::loadFromGeoJSON(QString fileName) -> QString
         }
         newWaypoints.append(wp);
     }
+    std::stable_sort(newWaypoints.begin(), newWaypoints.end(), lessByName);
 
     m_waypoints = newWaypoints;
     emit waypointsChanged();
@@ -205,34 +351,7 @@ auto GeoMaps::WaypointLibrary::import(const QString& fileName, bool skip) -> QSt
         return tr("Error reading waypoints from file '%1'.").arg(fileName);
     }
 
-    if (skip)
-    {
-        foreach(const auto& newWaypoint, result)
-        {
-            bool skip = false;
-            foreach(const auto& existingWaypoint, m_waypoints)
-            {
-                if (newWaypoint.isNear(existingWaypoint))
-                {
-                    skip = true;
-                    break;
-                }
-            }
-            if (!skip)
-            {
-                m_waypoints.append(newWaypoint);
-            }
-        }
-    }
-    else
-    {
-        m_waypoints += result;
-    }
-
-    std::sort(m_waypoints.begin(), m_waypoints.end(), [](const Waypoint &a, const Waypoint &b)
-    { return a.name() < b.name(); });
-
-    emit waypointsChanged();
+    addMany(result, skip);
     return {};
 }
 
@@ -255,9 +374,7 @@ bool GeoMaps::WaypointLibrary::replace(const GeoMaps::Waypoint& oldWaypoint, con
 
     if (m_waypoints.removeOne(oldWaypoint))
     {
-        m_waypoints.append(newWaypoint);
-        std::sort(m_waypoints.begin(), m_waypoints.end(), [](const Waypoint &a, const Waypoint &b)
-        { return a.name() < b.name(); });
+        m_waypoints.insert(std::upper_bound(m_waypoints.begin(), m_waypoints.end(), newWaypoint, lessByName), newWaypoint);
         emit waypointsChanged();
         return true;
     }
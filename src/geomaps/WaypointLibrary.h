@@ -25,6 +25,10 @@
 
 #include "GlobalObject.h"
 #include "geomaps/Waypoint.h"
+#include "geomaps/WaypointSearchIndex.h"
+#include "geomaps/WaypointSpatialIndex.h"
+
+class Benchmark;
 
 namespace GeoMaps
 {
@@ -42,6 +46,9 @@ namespace GeoMaps
         QML_ELEMENT
         QML_SINGLETON
 
+        // The benchmarks call private static methods directly
+        friend class ::Benchmark;
+
     public:
         /*! \brief Creates a new waypoin library
          *
@@ -99,7 +106,23 @@ namespace GeoMaps
          *
          * @returns Property GeoJSON
          */
-        [[nodiscard]] QByteArray GeoJSON() const;
+        [[nodiscard]] QByteArray GeoJSON() const { return toGeoJSON(m_waypoints); }
+
+        /*! \brief Search index for the waypoints in the library
+         *
+         *  The index is built on first use after the library has changed.
+         *
+         *  @returns Search index
+         */
+        [[nodiscard]] const GeoMaps::WaypointSearchIndex& searchIndex() const;
+
+        /*! \brief Spatial index for the waypoints in the library
+         *
+         *  The index is built on first use after the library has changed.
+         *
+         *  @returns Spatial index
+         */
+        [[nodiscard]] const GeoMaps::WaypointSpatialIndex& spatialIndex() const;
 
 
         //
@@ -113,6 +136,22 @@ namespace GeoMaps
          */
         Q_INVOKABLE void add(const GeoMaps::Waypoint &waypoint);
 
+        /*! \brief Adds a list of waypoints to the library
+         *
+         *  This method sorts the new waypoints and merges them into the
+         *  library in one pass. It emits waypointsChanged at most once, so
+         *  that the library is saved only once.
+         *
+         *  @param waypoints Waypoints to be added. Invalid waypoints are
+         *  ignored.
+         *
+         *  @param skipNearby If true, skip over waypoints that are near (in
+         *  the sense of GeoMaps::Waypoint::isNear) to a waypoint that is
+         *  already in the library, or to a waypoint that appears earlier in
+         *  the list.
+         */
+        void addMany(const QVector<GeoMaps::Waypoint>& waypoints, bool skipNearby = false);
+
         /*! \brief Clears the waypoint library */
         Q_INVOKABLE void clear();
 
@@ -236,11 +275,21 @@ namespace GeoMaps
     private:
         Q_DISABLE_COPY_MOVE(WaypointLibrary)
 
+        // GeoJSON document for a list of waypoints. This method does not
+        // access any QObject and can be called from any thread.
+        [[nodiscard]] static QByteArray toGeoJSON(const QList<GeoMaps::Waypoint>& waypoints);
+
         // Standard file name for save() and loadFromGeoJGON() methods
         QString stdFileName{QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/waypoint library.geojson"};
 
-        // Acutual list of waypoints.
+        // Acutual list of waypoints, sorted by name
         QList<GeoMaps::Waypoint> m_waypoints;
+
+        // Search indices for m_waypoints, built lazily by searchIndex() and spatialIndex()
+        mutable GeoMaps::WaypointSearchIndex m_searchIndex;
+        mutable bool m_searchIndexDirty {true};
+        mutable GeoMaps::WaypointSpatialIndex m_spatialIndex;
+        mutable bool m_spatialIndexDirty {true};
     };
 
 } // namespace GeoMaps
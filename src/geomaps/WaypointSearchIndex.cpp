@@ -0,0 +1,209 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "geomaps/WaypointSearchIndex.h"
+
+
+GeoMaps::WaypointSearchIndex::WaypointSearchIndex(const QVector<GeoMaps::Waypoint>& waypoints)
+{
+    m_waypoints.reserve(waypoints.size());
+    for(const auto& waypoint : waypoints)
+    {
+        if (waypoint.isValid())
+        {
+            m_waypoints.append(waypoint);
+        }
+    }
+    std::stable_sort(m_waypoints.begin(), m_waypoints.end(), [](const Waypoint& first, const Waypoint& second) {return first.name() < second.name(); });
+
+    m_names.reserve(m_waypoints.size());
+    m_codes.reserve(m_waypoints.size());
+    for(qsizetype index = 0; index < m_waypoints.size(); index++)
+    {
+        const auto& waypoint = m_waypoints.at(index);
+        m_names.append(simplify(waypoint.name()));
+        m_codes.append(waypoint.ICAOCode().toCaseFolded());
+
+        // Indices are visited in increasing order, so that every posting list
+        // is sorted. A trigram can appear several times in the same waypoint,
+        // so we check the last entry to avoid duplicates.
+        for(const auto& key : {m_names.constLast(), m_codes.constLast()})
+        {
+            for(qsizetype pos = 0; pos + 3 <= key.size(); pos++)
+            {
+                auto& postings = m_postings[trigram(key, pos)];
+                if (postings.isEmpty() || (postings.constLast() != index))
+                {
+                    postings.append(index);
+                }
+            }
+        }
+    }
+}
+
+
+//
+// Methods
+//
+
+QVector<GeoMaps::Waypoint> GeoMaps::WaypointSearchIndex::waypoints(const QVector<qsizetype>& indices) const
+{
+    QVector<GeoMaps::Waypoint> result;
+    result.reserve(indices.size());
+    for(auto index : indices)
+    {
+        result.append(m_waypoints.at(index));
+    }
+    return result;
+}
+
+QVector<qsizetype> GeoMaps::WaypointSearchIndex::search(const QStringList& words, bool matchICAOCodes) const
+{
+    // Find the shortest posting list among all trigrams of all words. Every
+    // match must appear in that list. If a trigram does not appear at all,
+    // there cannot be any match.
+    const QVector<qsizetype>* shortestPostings = nullptr;
+    for(const auto& word : words)
+    {
+        for(qsizetype pos = 0; pos + 3 <= word.size(); pos++)
+        {
+            auto iterator = m_postings.constFind(trigram(word, pos));
+            if (iterator == m_postings.constEnd())
+            {
+                return {};
+            }
+            if ((shortestPostings == nullptr) || (iterator->size() < shortestPostings->size()))
+            {
+                shortestPostings = &iterator.value();
+            }
+        }
+    }
+    if (shortestPostings != nullptr)
+    {
+        return refine(*shortestPostings, words, matchICAOCodes);
+    }
+
+    // All words are shorter than three characters. Scan the full list.
+    QVector<qsizetype> result;
+    for(qsizetype index = 0; index < m_waypoints.size(); index++)
+    {
+        if (matches(index, words, matchICAOCodes))
+        {
+            result.append(index);
+        }
+    }
+    return result;
+}
+
+QVector<qsizetype> GeoMaps::WaypointSearchIndex::refine(const QVector<qsizetype>& candidates, const QStringList& words, bool matchICAOCodes) const
+{
+    QVector<qsizetype> result;
+    for(auto index : candidates)
+    {
+        if (matches(index, words, matchICAOCodes))
+        {
+            result.append(index);
+        }
+    }
+    return result;
+}
+
+bool GeoMaps::WaypointSearchIndex::isRefinement(const QStringList& previousWords, const QStringList& words)
+{
+    for(const auto& previousWord : previousWords)
+    {
+        bool found = false;
+        for(const auto& word : words)
+        {
+            if (word.contains(previousWord))
+            {
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+QStringList GeoMaps::WaypointSearchIndex::searchWords(const QString& filter)
+{
+    QStringList result;
+    const auto words = filter.simplified().split(' ', Qt::SkipEmptyParts);
+    for(const auto& word : words)
+    {
+        auto simplifiedWord = simplify(word);
+        if (simplifiedWord.isEmpty())
+        {
+            continue;
+        }
+        result.append(simplifiedWord);
+    }
+    return result;
+}
+
+QString GeoMaps::WaypointSearchIndex::simplify(const QString& string)
+{
+    auto const normalizedString = string.normalized(QString::NormalizationForm_KD);
+
+    QString result;
+    result.reserve(normalizedString.size());
+    for(auto character : normalizedString)
+    {
+        auto const unicode = character.unicode();
+        if ((unicode >= 'a' && unicode <= 'z') || (unicode >= '0' && unicode <= '9'))
+        {
+            result.append(character);
+            continue;
+        }
+        if (unicode >= 'A' && unicode <= 'Z')
+        {
+            result.append(QChar(unicode - 'A' + 'a'));
+        }
+    }
+    return result;
+}
+
+
+//
+// Private Methods
+//
+
+bool GeoMaps::WaypointSearchIndex::matches(qsizetype index, const QStringList& words, bool matchICAOCodes) const
+{
+    const auto& name = m_names.at(index);
+    const auto& code = m_codes.at(index);
+    for(const auto& word : words)
+    {
+        if (name.contains(word))
+        {
+            continue;
+        }
+        if (matchICAOCodes && code.contains(word))
+        {
+            continue;
+        }
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,171 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QHash>
+
+#include "geomaps/Waypoint.h"
+
+
+namespace GeoMaps
+{
+
+/*! \brief Name search index for waypoints
+ *
+ *  This class holds a list of valid waypoints, sorted by name, together with
+ *  pre-normalized names and ICAO codes and a trigram index. It answers the
+ *  queries made by the waypoint search dialogs without normalizing any
+ *  waypoint name at query time, and without scanning the full list for words
+ *  of three or more characters.
+ *
+ *  Search results are lists of indices into the list of waypoints. Since the
+ *  list is sorted by name, these results are sorted by name as well.
+ *
+ *  Instances are immutable once constructed and can therefore be built in a
+ *  worker thread and handed over to the GUI thread.
+ */
+
+class WaypointSearchIndex
+{
+public:
+    /*! \brief Constructs an empty index */
+    WaypointSearchIndex() = default;
+
+    /*! \brief Constructs an index
+     *
+     *  @param waypoints List of waypoints. Invalid waypoints are ignored. The
+     *  list need not be sorted.
+     */
+    explicit WaypointSearchIndex(const QVector<GeoMaps::Waypoint>& waypoints);
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Number of waypoints in the index
+     *
+     *  @returns Number of waypoints
+     */
+    [[nodiscard]] qsizetype size() const { return m_waypoints.size(); }
+
+    /*! \brief Waypoint
+     *
+     *  @param index Index of the waypoint, must be in the range [0, size())
+     *
+     *  @returns Waypoint at the given index
+     */
+    [[nodiscard]] const GeoMaps::Waypoint& waypoint(qsizetype index) const { return m_waypoints.at(index); }
+
+    /*! \brief Waypoints for a list of indices
+     *
+     *  @param indices List of indices, as returned by search() or refine()
+     *
+     *  @returns Waypoints, in the order given by the indices
+     */
+    [[nodiscard]] QVector<GeoMaps::Waypoint> waypoints(const QVector<qsizetype>& indices) const;
+
+    /*! \brief Search
+     *
+     *  @param words List of search words, as returned by searchWords()
+     *
+     *  @param matchICAOCodes If true, a word matches a waypoint if it is
+     *  contained in the normalized name or in the ICAO code. If false, only
+     *  the name is considered.
+     *
+     *  @returns Sorted list of indices of those waypoints that match every one
+     *  of the words. If the list of words is empty, all waypoints match.
+     */
+    [[nodiscard]] QVector<qsizetype> search(const QStringList& words, bool matchICAOCodes = true) const;
+
+    /*! \brief Search within the result of a previous search
+     *
+     *  This method is meant for incremental queries, where the user refines a
+     *  search keystroke by keystroke. If isRefinement(previousWords, words)
+     *  holds, then refine(search(previousWords), words) equals search(words),
+     *  but is typically much cheaper to compute.
+     *
+     *  @param candidates Sorted list of indices, as returned by search()
+     *
+     *  @param words List of search words, as returned by searchWords()
+     *
+     *  @param matchICAOCodes See search()
+     *
+     *  @returns Sorted list of indices of those candidates that match every one
+     *  of the words.
+     */
+    [[nodiscard]] QVector<qsizetype> refine(const QVector<qsizetype>& candidates, const QStringList& words, bool matchICAOCodes = true) const;
+
+    /*! \brief Check if a search refines another one
+     *
+     *  @param previousWords Search words of the previous search
+     *
+     *  @param words Search words of the current search
+     *
+     *  @returns True if every waypoint that matches words is guaranteed to
+     *  match previousWords. This is the case if every word in previousWords
+     *  is contained in some word of words.
+     */
+    [[nodiscard]] static bool isRefinement(const QStringList& previousWords, const QStringList& words);
+
+    /*! \brief Split a filter string into normalized search words
+     *
+     *  @param filter Filter string, as typed by the user
+     *
+     *  @returns List of non-empty words, each normalized with simplify()
+     */
+    [[nodiscard]] static QStringList searchWords(const QString& filter);
+
+    /*! \brief Normalize string for searching
+     *
+     *  This method computes the same string as
+     *  Librarian::simplifySpecialChars, converted to lower case. It does not
+     *  use regular expressions and can safely be called from any thread.
+     *
+     *  @param string Input string
+     *
+     *  @returns Normalized string, containing only characters in [a-z0-9]
+     */
+    [[nodiscard]] static QString simplify(const QString& string);
+
+private:
+    // Checks if the waypoint with the given index matches all words
+    [[nodiscard]] bool matches(qsizetype index, const QStringList& words, bool matchICAOCodes) const;
+
+    // Trigram key for the three characters starting at the given position
+    [[nodiscard]] static quint64 trigram(const QString& string, qsizetype pos)
+    {
+        return (quint64(string.at(pos).unicode()) << 32) | (quint64(string.at(pos+1).unicode()) << 16) | quint64(string.at(pos+2).unicode());
+    }
+
+    // Valid waypoints, sorted by name
+    QVector<GeoMaps::Waypoint> m_waypoints;
+
+    // Normalized names and case-folded ICAO codes, with the same indices as m_waypoints
+    QStringList m_names;
+    QStringList m_codes;
+
+    // For every trigram that appears in a name or ICAO code, the sorted list
+    // of indices of waypoints containing it
+    QHash<quint64, QVector<qsizetype>> m_postings;
+};
+
+} // namespace GeoMaps
@@ -0,0 +1,164 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <QtMath>
+
+#include "geomaps/WaypointSpatialIndex.h"
+
+
+GeoMaps::WaypointSpatialIndex::WaypointSpatialIndex(const QVector<GeoMaps::Waypoint>& waypoints)
+{
+    m_waypoints.reserve(waypoints.size());
+    m_types.reserve(waypoints.size());
+    m_nodes.reserve(waypoints.size());
+    for(const auto& waypoint : waypoints)
+    {
+        if (!waypoint.isValid())
+        {
+            continue;
+        }
+        m_nodes.append(Node{toVector(waypoint.coordinate()), m_waypoints.size()});
+        m_waypoints.append(waypoint);
+        m_types.append(waypoint.type());
+    }
+    build(0, m_nodes.size(), 0);
+}
+
+
+//
+// Methods
+//
+
+QVector<GeoMaps::Waypoint> GeoMaps::WaypointSpatialIndex::nearest(const QGeoCoordinate& position, qsizetype count, const QString& type) const
+{
+    if (!position.isValid() || (count <= 0))
+    {
+        return {};
+    }
+
+    QVector<Candidate> best;
+    best.reserve(count+1);
+    search(0, m_nodes.size(), 0, toVector(position), count, type, best);
+
+    QVector<GeoMaps::Waypoint> result;
+    result.reserve(best.size());
+    for(const auto& candidate : std::as_const(best))
+    {
+        result.append(m_waypoints.at(candidate.waypointIndex));
+    }
+    return result;
+}
+
+GeoMaps::Waypoint GeoMaps::WaypointSpatialIndex::nearestWithin(const QGeoCoordinate& position, Units::Distance radius) const
+{
+    if (!position.isValid())
+    {
+        return {};
+    }
+
+    QVector<Candidate> best;
+    best.reserve(2);
+    search(0, m_nodes.size(), 0, toVector(position), 1, {}, best);
+    if (best.isEmpty())
+    {
+        return {};
+    }
+
+    const auto& result = m_waypoints.at(best.constFirst().waypointIndex);
+    if (position.distanceTo(result.coordinate()) > radius.toM())
+    {
+        return {};
+    }
+    return result;
+}
+
+
+//
+// Private Methods
+//
+
+GeoMaps::WaypointSpatialIndex::Vector GeoMaps::WaypointSpatialIndex::toVector(const QGeoCoordinate& coordinate)
+{
+    auto const latitude = qDegreesToRadians(coordinate.latitude());
+    auto const longitude = qDegreesToRadians(coordinate.longitude());
+    return {qCos(latitude)*qCos(longitude), qCos(latitude)*qSin(longitude), qSin(latitude)};
+}
+
+void GeoMaps::WaypointSpatialIndex::build(qsizetype begin, qsizetype end, int depth)
+{
+    if (end - begin <= 1)
+    {
+        return;
+    }
+
+    auto const axis = depth % 3;
+    auto const mid = begin + ((end - begin) / 2);
+    std::nth_element(m_nodes.begin()+begin, m_nodes.begin()+mid, m_nodes.begin()+end,
+                     [axis](const Node& first, const Node& second) {return first.vector[axis] < second.vector[axis]; });
+    build(begin, mid, depth+1);
+    build(mid+1, end, depth+1);
+}
+
+void GeoMaps::WaypointSpatialIndex::search(qsizetype begin, qsizetype end, int depth, const Vector& vector, qsizetype count, const QString& type, QVector<Candidate>& best) const
+{
+    if (begin >= end)
+    {
+        return;
+    }
+
+    auto const axis = depth % 3;
+    auto const mid = begin + ((end - begin) / 2);
+    const auto& node = m_nodes.at(mid);
+
+    if (type.isEmpty() || (m_types.at(node.waypointIndex) == type))
+    {
+        auto const squaredChord = squaredDistance(node.vector, vector);
+        if ((best.size() < count) || (squaredChord < best.constLast().squaredChord))
+        {
+            auto position = std::upper_bound(best.begin(), best.end(), squaredChord,
+                                             [](double value, const Candidate& candidate) {return value < candidate.squaredChord; });
+            best.insert(position, Candidate{squaredChord, node.waypointIndex});
+            if (best.size() > count)
+            {
+                best.removeLast();
+            }
+        }
+    }
+
+    // Descend first into the half that contains the vector, then into the
+    // other half if the splitting plane is closer than the worst candidate
+    auto const difference = vector[axis] - node.vector[axis];
+    if (difference < 0)
+    {
+        search(begin, mid, depth+1, vector, count, type, best);
+        if ((best.size() < count) || (difference*difference < best.constLast().squaredChord))
+        {
+            search(mid+1, end, depth+1, vector, count, type, best);
+        }
+    }
+    else
+    {
+        search(mid+1, end, depth+1, vector, count, type, best);
+        if ((best.size() < count) || (difference*difference < best.constLast().squaredChord))
+        {
+            search(begin, mid, depth+1, vector, count, type, best);
+        }
+    }
+}
@@ -0,0 +1,133 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <array>
+
+#include "geomaps/Waypoint.h"
+#include "units/Distance.h"
+
+
+namespace GeoMaps
+{
+
+/*! \brief Spatial index for waypoints
+ *
+ *  This class holds a list of valid waypoints in a KD-tree over unit vectors
+ *  in 3-space. The euclidean distance between two unit vectors is a monotone
+ *  function of the great-circle distance between the corresponding points, so
+ *  that the nearest neighbours found in the tree are exactly the waypoints
+ *  closest to the query position, without calling QGeoCoordinate::distanceTo
+ *  in the search.
+ *
+ *  The tree is stored implicitly in a flat array, so that lookups do not
+ *  allocate. Instances are immutable once constructed and can therefore be
+ *  built in a worker thread and handed over to the GUI thread.
+ */
+
+class WaypointSpatialIndex
+{
+public:
+    /*! \brief Constructs an empty index */
+    WaypointSpatialIndex() = default;
+
+    /*! \brief Constructs an index
+     *
+     *  @param waypoints List of waypoints. Invalid waypoints are ignored.
+     */
+    explicit WaypointSpatialIndex(const QVector<GeoMaps::Waypoint>& waypoints);
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Nearest waypoints
+     *
+     *  @param position Position near which waypoints are searched for
+     *
+     *  @param count Maximal number of waypoints returned
+     *
+     *  @param type If not empty, only waypoints of this type (AD, NAV, WP)
+     *  are considered
+     *
+     *  @returns List of at most count waypoints that are closest to the
+     *  position, sorted by distance
+     */
+    [[nodiscard]] QVector<GeoMaps::Waypoint> nearest(const QGeoCoordinate& position, qsizetype count, const QString& type = {}) const;
+
+    /*! \brief Nearest waypoint within a given radius
+     *
+     *  @param position Position near which waypoints are searched for
+     *
+     *  @param radius Search radius
+     *
+     *  @returns The waypoint closest to position, provided that its distance
+     *  to position does not exceed radius. Otherwise, an invalid waypoint.
+     */
+    [[nodiscard]] GeoMaps::Waypoint nearestWithin(const QGeoCoordinate& position, Units::Distance radius) const;
+
+    /*! \brief Number of waypoints in the index
+     *
+     *  @returns Number of waypoints
+     */
+    [[nodiscard]] qsizetype size() const { return m_nodes.size(); }
+
+private:
+    using Vector = std::array<double, 3>;
+
+    struct Node
+    {
+        Vector vector;
+        qsizetype waypointIndex {-1};
+    };
+
+    struct Candidate
+    {
+        double squaredChord {0.0};
+        qsizetype waypointIndex {-1};
+    };
+
+    // Unit vector for the given coordinate
+    [[nodiscard]] static Vector toVector(const QGeoCoordinate& coordinate);
+
+    // Squared euclidean distance
+    [[nodiscard]] static double squaredDistance(const Vector& a, const Vector& b)
+    {
+        return ((a[0]-b[0])*(a[0]-b[0])) + ((a[1]-b[1])*(a[1]-b[1])) + ((a[2]-b[2])*(a[2]-b[2]));
+    }
+
+    // Arranges the nodes in [begin, end) as a KD-tree, splitting along the axis depth%3
+    void build(qsizetype begin, qsizetype end, int depth);
+
+    // Collects the 'count' nodes in [begin, end) closest to vector whose type
+    // matches, keeping the list 'best' sorted by distance
+    void search(qsizetype begin, qsizetype end, int depth, const Vector& vector, qsizetype count, const QString& type, QVector<Candidate>& best) const;
+
+    // Waypoints, and their types
+    QVector<GeoMaps::Waypoint> m_waypoints;
+    QStringList m_types;
+
+    // Implicit KD-tree: the node at the center of every range splits that range
+    QVector<Node> m_nodes;
+};
+
+} // namespace GeoMaps
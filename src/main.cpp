@@ -1,5 +1,5 @@
 /***************************************************************************
- *   Copyright (C) 2019-2025 by Stefan Kebekus                             *
+ *   Copyright (C) 2019-2026 by Stefan Kebekus                             *
  *   stefan.kebekus@gmail.com                                              *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
@@ -20,6 +20,7 @@
 
 #include <QCommandLineParser>
 #include <QFile>
+#include <QFileInfo>
 #include <QGuiApplication>
 #include <QIcon>
 #include <QQmlApplicationEngine>
@@ -29,6 +30,7 @@
 #include <QQuickStyle>
 #include <QQuickWindow>
 #include <QSettings>
+#include <QTimer>
 #include <QTranslator>
 
 #if __has_include (<QtWebView/QtWebView>)
@@ -49,12 +51,20 @@
 #include "DemoRunner.h"
 #include "GlobalObject.h"
 #include "Librarian.h"
+#include "Trace.h"
 #include "config.h"
+#include "fileFormats/PMTILES.h"
 #include "geomaps/Airspace.h"
 #include "platform/FileExchange.h"
 #include "platform/PlatformAdaptor.h"
+#include "traffic/TrafficDataProvider.h"
+#include "traffic/TrafficDataSource_File.h"
 #include "traffic/Warning.h"
 
+#if defined(ENROUTE_BENCHMARK)
+#include "Benchmark.h"
+#endif
+
 using namespace std::chrono_literals;
 using namespace Qt::Literals::StringLiterals;
 
@@ -164,6 +174,39 @@ auto main(int argc, char *argv[]) -> int
             "main", "look up string using Librarian::getStringFromRessource and print it to stdout"),
         QCoreApplication::translate("main", "string name"));
     parser.addOption(extractStringOption);
+#if defined(ENROUTE_BENCHMARK)
+    QCommandLineOption const benchmarkOption(
+        u"benchmark"_s,
+        QCoreApplication::translate(
+            "main", "run headless benchmarks and write the results in JSON format to a file, or to stdout if the file name is '-'"),
+        QCoreApplication::translate("main", "file name"));
+    parser.addOption(benchmarkOption);
+#endif
+    QCommandLineOption const pmtilesOption(
+        u"pmtiles"_s,
+        QCoreApplication::translate(
+            "main", "convert a map file from MBTILES to PMTILES format, writing the result to a file with the same name and suffix '.pmtiles'"),
+        QCoreApplication::translate("main", "file name"));
+    parser.addOption(pmtilesOption);
+    QCommandLineOption const traceOption(
+        u"trace"_s,
+        QCoreApplication::translate(
+            "main", "record execution times of hot paths and write them in Chrome trace event format to a file when the app quits"),
+        QCoreApplication::translate("main", "file name"));
+    parser.addOption(traceOption);
+    QCommandLineOption const replayOption(
+        u"replay"_s,
+        QCoreApplication::translate(
+            "main", "replay a FLARM simulator file without starting the GUI and print a summary with the throughput of the traffic pipeline"),
+        QCoreApplication::translate("main", "file name"));
+    parser.addOption(replayOption);
+    QCommandLineOption const speedOption(
+        u"speed"_s,
+        QCoreApplication::translate(
+            "main", "speed of the replay: 1 replays in real time, N replays N times as fast, 0 replays as fast as possible"),
+        QCoreApplication::translate("main", "speed"),
+        u"0"_s);
+    parser.addOption(speedOption);
     parser.addPositionalArgument(QStringLiteral("[fileName]"), QCoreApplication::translate("main", "File to import."));
     parser.process(app);
 
@@ -179,6 +222,67 @@ auto main(int argc, char *argv[]) -> int
         out << Librarian::getStringFromRessource(stringName);
         return 0;
     }
+    QString const traceFileName = parser.value(traceOption);
+    if (!traceFileName.isEmpty())
+    {
+        Trace::enabled = true;
+        QObject::connect(&app, &QCoreApplication::aboutToQuit, [traceFileName]() { Trace::write(traceFileName); });
+    }
+    QString const mbtilesFileName = parser.value(pmtilesOption);
+    if (!mbtilesFileName.isEmpty())
+    {
+        QFileInfo const info(mbtilesFileName);
+        auto const pmtilesFileName = info.path() + u"/"_s + info.completeBaseName() + u".pmtiles"_s;
+        auto const error = FileFormats::PMTILES::fromMBTILES(mbtilesFileName, pmtilesFileName);
+        if (!error.isEmpty())
+        {
+            QTextStream(stderr) << error << Qt::endl;
+            return 1;
+        }
+        return 0;
+    }
+    QString const replayFileName = parser.value(replayOption);
+    if (!replayFileName.isEmpty())
+    {
+        bool ok = false;
+        auto const speed = parser.value(speedOption).toDouble(&ok);
+        if (!ok || (speed < 0.0))
+        {
+            QTextStream(stderr) << QCoreApplication::translate("main", "Invalid replay speed: %1").arg(parser.value(speedOption)) << Qt::endl;
+            return 1;
+        }
+
+        // The traffic data provider takes ownership of the source and handles
+        // the traffic factors, as it would with a real traffic receiver
+        auto* source = new Traffic::TrafficDataSource_File(false, replayFileName, nullptr);
+        source->setReplaySpeed(speed);
+        source->setReplaySummary(true);
+        GlobalObject::trafficDataProvider()->addDataSource(source);
+        QObject::connect(source, &Traffic::TrafficDataSource_File::replayFinished, &app, [](const QString& summary) {
+            QTextStream(stdout) << summary << Qt::endl;
+            QCoreApplication::exit(0);
+        });
+        QObject::connect(source, &Traffic::TrafficDataSource_File::errorStringChanged, &app, [source]() {
+            if (!source->errorString().isEmpty())
+            {
+                QTextStream(stderr) << source->errorString() << Qt::endl;
+                QCoreApplication::exit(1);
+            }
+        });
+        QTimer::singleShot(0, source, &Traffic::TrafficDataSource_File::connectToTrafficReceiver);
+        auto const result = QCoreApplication::exec();
+        GlobalObject::clear();
+        return result;
+    }
+#if defined(ENROUTE_BENCHMARK)
+    QString const benchmarkFileName = parser.value(benchmarkOption);
+    if (!benchmarkFileName.isEmpty())
+    {
+        auto const result = Benchmark::run(benchmarkFileName);
+        GlobalObject::clear();
+        return result;
+    }
+#endif
 
 #if !defined(Q_OS_ANDROID) and !defined(Q_OS_IOS)
     // Single application on desktops
@@ -0,0 +1,117 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QGeoCoordinate>
+#include <QQmlEngine>
+
+#include "geomaps/Airspace.h"
+#include "units/Distance.h"
+#include "units/Timespan.h"
+
+
+namespace Navigation {
+
+class AirspaceIncursionPredictor;
+
+/*! \brief Predicted airspace incursion
+ *
+ *  This class describes the first airspace that the own aircraft will enter
+ *  if it continues on its present track, with its present ground speed and
+ *  vertical speed. It is computed by AirspaceIncursionPredictor on every
+ *  position update.
+ *
+ *  Consumers of this class can expect the properties airspace, time,
+ *  distance and coordinate to be valid if boundary is not NoIncursion.
+ */
+
+class AirspaceIncursion {
+    Q_GADGET
+    QML_VALUE_TYPE(airspaceIncursion)
+
+    /*! \brief Comparison */
+    friend bool operator==(const Navigation::AirspaceIncursion&, const Navigation::AirspaceIncursion&) = default;
+    friend class Navigation::AirspaceIncursionPredictor;
+
+public:
+    /*! \brief Type of the boundary that will be crossed */
+    enum Boundary : quint8 {
+        /*! \brief No incursion predicted within the look-ahead time */
+        NoIncursion,
+
+        /*! \brief The aircraft will cross the lateral boundary of the airspace */
+        Lateral,
+
+        /*! \brief The aircraft will cross the lower or upper limit of the airspace */
+        Vertical
+    };
+    Q_ENUM(Boundary)
+
+    //
+    // PROPERTIES
+    //
+
+    /*! \brief Airspace that will be entered */
+    Q_PROPERTY(GeoMaps::Airspace airspace MEMBER airspace CONSTANT)
+
+    /*! \brief Type of the boundary that will be crossed */
+    Q_PROPERTY(Navigation::AirspaceIncursion::Boundary boundary MEMBER boundary CONSTANT)
+
+    /*! \brief Point where the airspace will be entered */
+    Q_PROPERTY(QGeoCoordinate coordinate MEMBER coordinate CONSTANT)
+
+    /*! \brief Horizontal distance to the point where the airspace will be entered */
+    Q_PROPERTY(Units::Distance distance MEMBER distance CONSTANT)
+
+    /*! \brief Time until the airspace will be entered */
+    Q_PROPERTY(Units::Timespan time MEMBER time CONSTANT)
+
+
+    //
+    // Getter Methods
+    //
+
+    /*! \brief Indicates whether an incursion is predicted
+     *
+     *  @returns True if boundary is not NoIncursion
+     */
+    [[nodiscard]] bool isValid() const { return boundary != NoIncursion; }
+
+private:
+    GeoMaps::Airspace airspace;
+    Boundary boundary {NoIncursion};
+    QGeoCoordinate coordinate;
+    Units::Distance distance {};
+    Units::Timespan time {};
+};
+
+} // namespace Navigation
+
+// Make enums available in QML
+namespace AirspaceIncursionQML
+{
+    Q_NAMESPACE
+    QML_FOREIGN_NAMESPACE(Navigation::AirspaceIncursion)
+    QML_NAMED_ELEMENT(AirspaceIncursion)
+} // namespace AirspaceIncursionQML
+
+// Declare meta types
+Q_DECLARE_METATYPE(Navigation::AirspaceIncursion)
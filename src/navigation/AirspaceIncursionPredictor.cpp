@@ -0,0 +1,292 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <QGeoRectangle>
+#include <QPolygonF>
+#include <QVarLengthArray>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+#include "navigation/AirspaceIncursionPredictor.h"
+
+using namespace Qt::Literals::StringLiterals;
+
+
+namespace {
+
+// Categories of airspaces that are searched for incursions
+const QStringList airspaceCategories = {u"ATZ"_s, u"TMZ"_s, u"RMZ"_s, u"TIA"_s, u"TIZ"_s, u"NRA"_s, u"DNG"_s, u"D"_s, u"C"_s, u"B"_s, u"A"_s, u"CTR"_s, u"R"_s, u"P"_s, u"PJE"_s, u"SUA"_s};
+
+// Length of one degree of latitude, in meters
+constexpr double metersPerDegreeLatitude = 6371000.0*M_PI/180.0;
+
+// Ground speed below which vertical speed is ignored, in meters per second.
+// At low speed, vertical speed info is typically too jittery to be useful.
+constexpr double minimalGroundSpeedForVerticalSpeed = 5.0;
+
+double cross(QPointF a, QPointF b)
+{
+    return a.x()*b.y() - a.y()*b.x();
+}
+
+} // namespace
+
+
+Navigation::AirspaceIncursionPredictor::AirspaceIncursionPredictor(Units::Timespan lookAhead)
+    : m_lookAhead(lookAhead.toS())
+{
+}
+
+
+//
+// Methods
+//
+
+void Navigation::AirspaceIncursionPredictor::setAirspaces(const QList<GeoMaps::Airspace>& airspaces)
+{
+    m_airspaces.clear();
+    for(const auto& airspace : airspaces)
+    {
+        if (airspaceCategories.contains(airspace.CAT()))
+        {
+            m_airspaces << airspace;
+        }
+    }
+    m_center = {};
+    m_candidates.clear();
+}
+
+
+Navigation::AirspaceIncursion Navigation::AirspaceIncursionPredictor::predict(const Positioning::PositionInfo& positionInfo, Units::Distance terrainElevation, Units::Pressure QNH, Units::Distance pressureAltitude)
+{
+    AirspaceIncursion result;
+
+    //
+    // Motion of the aircraft
+    //
+    auto const coordinate = positionInfo.coordinate();
+    auto const altitude = positionInfo.trueAltitudeAMSL();
+    auto const groundSpeed = positionInfo.groundSpeed();
+    auto const track = positionInfo.trueTrack();
+    if (!coordinate.isValid() || !altitude.isFinite() || !groundSpeed.isFinite() || !track.isFinite())
+    {
+        return result;
+    }
+    double climb = 0.0;
+    auto const verticalSpeed = positionInfo.verticalSpeed();
+    if (verticalSpeed.isFinite() && (groundSpeed.toMPS() >= minimalGroundSpeedForVerticalSpeed))
+    {
+        climb = verticalSpeed.toMPS()*m_lookAhead;
+    }
+    if (!terrainElevation.isFinite())
+    {
+        terrainElevation = Units::Distance::fromM(0.0);
+    }
+    if (!pressureAltitude.isFinite())
+    {
+        pressureAltitude = altitude;
+    }
+
+    // Projected track, as a line segment from start to start+direction.
+    // Recompute the corridor if the line segment is not contained in it.
+    auto const length = groundSpeed.toMPS()*m_lookAhead;
+    QPointF const direction(length*qSin(track.toRAD()), length*qCos(track.toRAD()));
+    auto start = toPlane(coordinate);
+    if (!m_center.isValid() || !m_corridor.contains(start) || !m_corridor.contains(start+direction))
+    {
+        updateCorridor(coordinate, qMax(2.0*length, minimalCorridorHalfSize));
+        start = toPlane(coordinate);
+    }
+    auto const end = start + direction;
+    auto const minX = qMin(start.x(), end.x());
+    auto const maxX = qMax(start.x(), end.x());
+    auto const minY = qMin(start.y(), end.y());
+    auto const maxY = qMax(start.y(), end.y());
+
+    //
+    // Find the first incursion. Positions along the line segment are
+    // described by a parameter in [0,1].
+    //
+    double first = qInf();
+    QVarLengthArray<double, 16> crossings;
+    for(const auto& candidate : std::as_const(m_candidates))
+    {
+        const auto& boundingRect = candidate.boundingRect;
+        if ((maxX < boundingRect.left()) || (minX > boundingRect.right()) || (maxY < boundingRect.top()) || (minY > boundingRect.bottom()))
+        {
+            continue;
+        }
+
+        // Find out whether the aircraft is laterally inside at present, and
+        // where the line segment crosses the lateral boundary
+        bool inside = false;
+        crossings.clear();
+        const auto& vertices = candidate.vertices;
+        for(qsizetype i=0; i<vertices.size(); i++)
+        {
+            auto const a = vertices[i];
+            auto const b = vertices[(i+1)%vertices.size()];
+            if ((a.y() > start.y()) != (b.y() > start.y()))
+            {
+                if (start.x() < a.x() + (start.y()-a.y())*(b.x()-a.x())/(b.y()-a.y()))
+                {
+                    inside = !inside;
+                }
+            }
+
+            auto const edge = b - a;
+            auto const denominator = cross(direction, edge);
+            if (denominator == 0.0)
+            {
+                continue;
+            }
+            auto const offset = a - start;
+            auto const t = cross(offset, edge)/denominator;
+            auto const s = cross(offset, direction)/denominator;
+            if ((t > 0.0) && (t <= 1.0) && (s >= 0.0) && (s < 1.0))
+            {
+                crossings << t;
+            }
+        }
+        if (!inside && crossings.isEmpty())
+        {
+            continue;
+        }
+
+        // Find the interval where the aircraft is vertically inside
+        auto const lower = candidate.airspace.estimatedLowerBoundMSL(terrainElevation, QNH, altitude, pressureAltitude);
+        auto const upper = candidate.airspace.estimatedUpperBoundMSL(terrainElevation, QNH, altitude, pressureAltitude);
+        if (!lower.isFinite() || !upper.isFinite() || !(lower < upper))
+        {
+            continue;
+        }
+        double verticalBegin = 0.0;
+        double verticalEnd = 1.0;
+        if (climb == 0.0)
+        {
+            if ((altitude < lower) || (altitude > upper))
+            {
+                continue;
+            }
+        }
+        else
+        {
+            auto const tLower = (lower - altitude).toM()/climb;
+            auto const tUpper = (upper - altitude).toM()/climb;
+            verticalBegin = qMax(0.0, qMin(tLower, tUpper));
+            verticalEnd = qMin(1.0, qMax(tLower, tUpper));
+        }
+        if ((verticalBegin > verticalEnd) || (verticalBegin >= first))
+        {
+            continue;
+        }
+
+        // Go through the intervals where the aircraft is laterally inside,
+        // and find the first one that meets the vertical interval. Ignore
+        // the airspace if it contains the aircraft at present.
+        std::sort(crossings.begin(), crossings.end());
+        crossings << 1.0;
+        double lateralBegin = inside ? 0.0 : qInf();
+        for(auto crossing : std::as_const(crossings))
+        {
+            if (!inside)
+            {
+                lateralBegin = crossing;
+                inside = true;
+                continue;
+            }
+            inside = false;
+            auto const entry = qMax(lateralBegin, verticalBegin);
+            if (entry > qMin(crossing, verticalEnd))
+            {
+                continue;
+            }
+            if ((entry > 0.0) && (entry < first))
+            {
+                first = entry;
+                result.airspace = candidate.airspace;
+                result.boundary = ((entry == lateralBegin) && (lateralBegin > 0.0)) ? AirspaceIncursion::Lateral : AirspaceIncursion::Vertical;
+            }
+            break;
+        }
+    }
+    if (!result.isValid())
+    {
+        return result;
+    }
+
+    auto const point = start + first*direction;
+    result.coordinate = fromPlane(point);
+    result.coordinate.setAltitude(altitude.toM() + first*climb);
+    result.distance = Units::Distance::fromM(first*length);
+    result.time = Units::Timespan::fromS(first*m_lookAhead);
+    return result;
+}
+
+
+//
+// Private Methods
+//
+
+void Navigation::AirspaceIncursionPredictor::updateCorridor(const QGeoCoordinate& center, double halfSize)
+{
+    m_center = QGeoCoordinate(center.latitude(), center.longitude());
+    m_metersPerDegreeLongitude = metersPerDegreeLatitude*qCos(qDegreesToRadians(center.latitude()));
+    m_corridor = QRectF(-halfSize, -halfSize, 2.0*halfSize, 2.0*halfSize);
+
+    QGeoRectangle const corridor(fromPlane(m_corridor.bottomLeft()), fromPlane(m_corridor.topRight()));
+    m_candidates.clear();
+    for(const auto& airspace : std::as_const(m_airspaces))
+    {
+        auto const polygon = airspace.polygon();
+        if (!polygon.boundingGeoRectangle().intersects(corridor))
+        {
+            continue;
+        }
+
+        Candidate candidate {airspace, {}, {}};
+        candidate.vertices.reserve(polygon.size());
+        for(const auto& vertex : polygon.perimeter())
+        {
+            candidate.vertices << toPlane(vertex);
+        }
+        if (candidate.vertices.size() < 3)
+        {
+            continue;
+        }
+        candidate.boundingRect = QPolygonF(candidate.vertices).boundingRect();
+        m_candidates << candidate;
+    }
+}
+
+
+QPointF Navigation::AirspaceIncursionPredictor::toPlane(const QGeoCoordinate& coordinate) const
+{
+    return {std::remainder(coordinate.longitude()-m_center.longitude(), 360.0)*m_metersPerDegreeLongitude,
+            (coordinate.latitude()-m_center.latitude())*metersPerDegreeLatitude};
+}
+
+
+QGeoCoordinate Navigation::AirspaceIncursionPredictor::fromPlane(QPointF point) const
+{
+    return {m_center.latitude() + point.y()/metersPerDegreeLatitude,
+            std::remainder(m_center.longitude() + point.x()/m_metersPerDegreeLongitude, 360.0)};
+}
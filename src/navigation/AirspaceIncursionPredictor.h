@@ -0,0 +1,138 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QList>
+#include <QPointF>
+#include <QRectF>
+
+#include "navigation/AirspaceIncursion.h"
+#include "positioning/PositionInfo.h"
+#include "units/Pressure.h"
+
+namespace Navigation {
+
+/*! \brief Predicts airspace incursions along the projected track
+ *
+ *  This class extrapolates the motion of the own aircraft, with its present
+ *  true track, ground speed and vertical speed, over the look-ahead time. It
+ *  computes the first point along this straight line where the aircraft
+ *  enters an airspace, either by crossing the lateral boundary or the lower
+ *  or upper limit.
+ *
+ *  To keep the cost per position update low, the class keeps a corridor:
+ *  a square around the aircraft, large enough to contain the projected track
+ *  for some time to come, together with the airspaces whose bounding
+ *  rectangles meet the corridor. The airspace polygons are projected once,
+ *  to a plane tangent to the earth at the center of the corridor. Each call
+ *  to predict() then intersects the projected track with these polygons
+ *  only. The corridor is recomputed whenever the projected track leaves it,
+ *  and whenever the list of airspaces changes.
+ *
+ *  Airspaces that contain the aircraft at present are ignored. Airspace
+ *  limits that are given above ground are estimated with the terrain
+ *  elevation under the aircraft.
+ */
+
+class AirspaceIncursionPredictor
+{
+public:
+    /*! \brief Standard constructor
+     *
+     *  @param lookAhead Time over which the motion of the aircraft is
+     *  extrapolated
+     */
+    explicit AirspaceIncursionPredictor(Units::Timespan lookAhead = Units::Timespan::fromS(5*60));
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief Set airspaces
+     *
+     *  This method sets the list of airspaces that are searched for
+     *  incursions, and discards the corridor. Only airspaces whose category
+     *  is relevant for navigation are kept.
+     *
+     *  @param airspaces List of airspaces
+     */
+    void setAirspaces(const QList<GeoMaps::Airspace>& airspaces);
+
+    /*! \brief Predict the first incursion
+     *
+     *  @param positionInfo Current position of the own aircraft
+     *
+     *  @param terrainElevation Elevation of the terrain under the aircraft,
+     *  used for airspace limits that are given above ground. If not finite,
+     *  sea level is assumed.
+     *
+     *  @param QNH QNH, used for airspace limits that are given above QNH
+     *
+     *  @param pressureAltitude Barometric altitude of the own aircraft. If
+     *  not finite, the geometric altitude is used instead.
+     *
+     *  @returns First predicted incursion. If the position info lacks
+     *  coordinate, altitude, ground speed or track, or if no airspace is
+     *  entered within the look-ahead time, the boundary of the result is
+     *  AirspaceIncursion::NoIncursion.
+     */
+    [[nodiscard]] AirspaceIncursion predict(const Positioning::PositionInfo& positionInfo, Units::Distance terrainElevation, Units::Pressure QNH, Units::Distance pressureAltitude);
+
+private:
+    struct Candidate
+    {
+        GeoMaps::Airspace airspace;
+
+        // Polygon in the plane of the corridor, in meters, and its bounding
+        // rectangle
+        QList<QPointF> vertices;
+        QRectF boundingRect;
+    };
+
+    // Recomputes the corridor, centered at the given coordinate, with the
+    // given half side length in meters
+    void updateCorridor(const QGeoCoordinate& center, double halfSize);
+
+    // Conversion between coordinates and points in the plane of the
+    // corridor, in meters
+    [[nodiscard]] QPointF toPlane(const QGeoCoordinate& coordinate) const;
+    [[nodiscard]] QGeoCoordinate fromPlane(QPointF point) const;
+
+    // Minimal half side length of the corridor, in meters
+    static constexpr double minimalCorridorHalfSize = 20000.0;
+
+    // Look-ahead time, in seconds
+    double m_lookAhead;
+
+    // Airspaces that are searched for incursions
+    QList<GeoMaps::Airspace> m_airspaces;
+
+    // Corridor, as a rectangle in the plane of the corridor, center of the
+    // corridor, and airspaces that meet the corridor. The corridor is
+    // invalid if m_center is invalid.
+    QGeoCoordinate m_center;
+    double m_metersPerDegreeLongitude {0.0};
+    QRectF m_corridor;
+    QList<Candidate> m_candidates;
+};
+
+} // namespace Navigation
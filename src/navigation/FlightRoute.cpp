@@ -1,5 +1,5 @@
 /***************************************************************************
- *   Copyright (C) 2019-2025 by Stefan Kebekus                             *
+ *   Copyright (C) 2019-2026 by Stefan Kebekus                             *
  *   stefan.kebekus@gmail.com                                              *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
@@ -237,25 +237,7 @@ auto Navigation::FlightRoute::contains(const GeoMaps::Waypoint& waypoint) const
 
 qsizetype Navigation::FlightRoute::currentLeg(const Positioning::PositionInfo& pInfo) const
 {
-    // Take the last leg that we are following (if there is one)
-    for(auto i=m_legs.value().size()-1; i>=0; i--)
-    {
-        if (m_legs.value()[i].isFollowing(pInfo))
-        {
-            return i;
-        }
-    }
-
-    // Take the last leg that we are near to (if there is one)
-    for(auto i=m_legs.value().size()-1; i>=0; i--)
-    {
-        if (m_legs.value()[i].isNear(pInfo))
-        {
-            return i;
-        }
-    }
-
-    return -1;
+    return m_legTracker.currentLeg(m_legs.value(), pInfo);
 }
 
 void Navigation::FlightRoute::directTo(const GeoMaps::Waypoint& target, const Positioning::PositionInfo& pInfo)
@@ -606,10 +588,10 @@ auto Navigation::FlightRoute::suggestedFilename() const -> QString
     return start + " - " + end;
 }
 
-auto Navigation::FlightRoute::toGeoJSON() const -> QByteArray
+auto Navigation::FlightRoute::toGeoJSON(const QList<GeoMaps::Waypoint>& waypoints) -> QByteArray
 {
     QJsonArray waypointArray;
-    foreach(const auto& waypoint, m_waypoints.value())
+    for(const auto& waypoint : waypoints)
     {
         if (waypoint.isValid())
         {
@@ -729,6 +711,9 @@ QList<QGeoCoordinate> Navigation::FlightRoute::computeGeoPath()
 
 QVector<Navigation::Leg> Navigation::FlightRoute::computeLegs()
 {
+    // The legs change, so the index remembered by the tracker is meaningless
+    m_legTracker.reset();
+
     QVector<Leg> result;
 
     for(int i=0; i<m_waypoints.value().size()-1; i++)
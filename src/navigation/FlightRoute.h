@@ -1,5 +1,5 @@
 /***************************************************************************
- *   Copyright (C) 2019-2025 by Stefan Kebekus                             *
+ *   Copyright (C) 2019-2026 by Stefan Kebekus                             *
  *   stefan.kebekus@gmail.com                                              *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
@@ -31,6 +31,7 @@
 
 #include "geomaps/Waypoint.h"
 #include "navigation/Leg.h"
+#include "navigation/LegTracker.h"
 
 namespace GeoMaps
 {
@@ -360,7 +361,18 @@ namespace Navigation
          *
          * @returns QByteArray describing the flight route
          */
-        [[nodiscard]] Q_INVOKABLE QByteArray toGeoJSON() const;
+        [[nodiscard]] Q_INVOKABLE QByteArray toGeoJSON() const { return toGeoJSON(m_waypoints.value()); }
+
+        /*! \brief Exports a list of waypoints to GeoJSON
+         *
+         * This method produces the same document as toGeoJSON(). It does not
+         * access any QObject and can be called from any thread.
+         *
+         * @param waypoints List of waypoints
+         *
+         * @returns QByteArray describing a flight route with the given waypoints
+         */
+        [[nodiscard]] static QByteArray toGeoJSON(const QList<GeoMaps::Waypoint>& waypoints);
 
         /*! \brief Exports to route to GPX
          *
@@ -424,6 +436,9 @@ namespace Navigation
         QProperty<QVector<Leg>> m_legs;
         QVector<Leg> computeLegs();
 
+        // Remembers the current leg between calls to currentLeg()
+        mutable LegTracker m_legTracker;
+
         QLocale myLocale;
     };
 
@@ -1,5 +1,5 @@
 /***************************************************************************
- *   Copyright (C) 2019-2025 by Stefan Kebekus                             *
+ *   Copyright (C) 2019-2026 by Stefan Kebekus                             *
  *   stefan.kebekus@gmail.com                                              *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
@@ -20,61 +20,21 @@
 
 #include "Leg.h"
 
+#include <cmath>
 #include <utility>
 
+#include <QtMath>
 
-namespace {
-
-double deg2rad(double deg)
-{
-    return deg * M_PI / 180.0;
-}
 
-double haversine(double lat1, double lon1, double lat2, double lon2)
-{
-    const double R = 6371000.0; // Earth radius (meters)
-    const double dLat = lat2 - lat1;
-    const double dLon = lon2 - lon1;
-    const double a = sin(dLat/2)*sin(dLat/2) + cos(lat1)*cos(lat2)*sin(dLon/2)*sin(dLon/2);
-    return 2 * R * atan2(sqrt(a), sqrt(1-a));
-}
+namespace {
 
-double bearing(double lat1, double lon1, double lat2, double lon2)
-{
-    const double y = sin(lon2-lon1) * cos(lat2);
-    const double x = cos(lat1)*sin(lat2) - sin(lat1)*cos(lat2)*cos(lon2-lon1);
-    return atan2(y, x);
-}
+constexpr double earthRadius = 6371000.0; // Earth radius (meters)
 
-Units::Distance distancePointToSegment(const QGeoCoordinate& segmentStart, const QGeoCoordinate& segmentEnd, const QGeoCoordinate& P)
+// Angle between two n-vectors, in radians
+double angle(const Navigation::Leg::Vector& a, const Navigation::Leg::Vector& b)
 {
-    const double R = 6371000.0;
-
-    const double lat1 = deg2rad(segmentStart.latitude());
-    const double lon1 = deg2rad(segmentStart.longitude());
-    const double lat2 = deg2rad(segmentEnd.latitude());
-    const double lon2 = deg2rad(segmentEnd.longitude());
-    const double latP = deg2rad(P.latitude());
-    const double lonP = deg2rad(P.longitude());
-
-    const double d13 = haversine(lat1, lon1, latP, lonP) / R;
-    const double d12 = haversine(lat1, lon1, lat2, lon2) / R;
-    const double brg13 = bearing(lat1, lon1, latP, lonP);
-    const double brg12 = bearing(lat1, lon1, lat2, lon2);
-
-    const double dxt = asin(sin(d13) * sin(brg13 - brg12)); // radians
-
-    // Check if projection lies outside the segment
-    const double dat = acos( cos(d13) / cos(dxt) );  // along-track distance
-    if (dat < 0)
-    {
-        return Units::Distance::fromM(haversine(latP, lonP, lat1, lon1)); // closest to A
-    }
-    if (dat > d12)
-    {
-        return Units::Distance::fromM(haversine(latP, lonP, lat2, lon2)); // closest to B
-    }
-    return Units::Distance::fromM(fabs(dxt) * R); // perpendicular distance
+    auto const c = Navigation::Leg::cross(a, b);
+    return atan2(sqrt(Navigation::Leg::dot(c, c)), Navigation::Leg::dot(a, b));
 }
 
 } // namespace
@@ -88,6 +48,19 @@ Units::Distance distancePointToSegment(const QGeoCoordinate& segmentStart, const
 Navigation::Leg::Leg(GeoMaps::Waypoint start, GeoMaps::Waypoint end) :
     m_start(std::move(start)), m_end(std::move(end))
 {
+    // Precompute the geometry used by isNear()
+    if (!isValid())
+    {
+        return;
+    }
+    m_startVector = nVector(m_start.coordinate());
+    m_endVector = nVector(m_end.coordinate());
+    auto normal = cross(m_startVector, m_endVector);
+    auto const length = sqrt(dot(normal, normal));
+    if (length > 1e-12)
+    {
+        m_normal = {normal[0]/length, normal[1]/length, normal[2]/length};
+    }
 }
 
 
@@ -195,7 +168,7 @@ bool Navigation::Leg::isNear(const Positioning::PositionInfo& positionInfo) cons
         return false;
     }
 
-    auto dp2s = distancePointToSegment(m_start.coordinate(), m_end.coordinate(), positionInfo.coordinate());
+    auto dp2s = distanceTo(positionInfo.coordinate());
     if (!dp2s.isFinite())
     {
         return false;
@@ -248,6 +221,33 @@ auto Navigation::Leg::description(Weather::Wind wind, const Navigation::Aircraft
 }
 
 
+auto Navigation::Leg::nVector(const QGeoCoordinate& coordinate) -> Vector
+{
+    auto const latitude = qDegreesToRadians(coordinate.latitude());
+    auto const longitude = qDegreesToRadians(coordinate.longitude());
+    return {cos(latitude)*cos(longitude), cos(latitude)*sin(longitude), sin(latitude)};
+}
+
+
+auto Navigation::Leg::distanceTo(const QGeoCoordinate& coordinate) const -> Units::Distance
+{
+    auto const position = nVector(coordinate);
+
+    // If the projection of the position to the great circle through start
+    // and end point lies between these points, return the cross-track
+    // distance.
+    if ((m_normal != Vector {}) &&
+        (dot(cross(m_startVector, position), m_normal) >= 0.0) &&
+        (dot(cross(position, m_endVector), m_normal) >= 0.0))
+    {
+        return Units::Distance::fromM(earthRadius*fabs(asin(qBound(-1.0, dot(position, m_normal), 1.0))));
+    }
+
+    // Otherwise, return the distance to the closer end point
+    return Units::Distance::fromM(earthRadius*qMin(angle(position, m_startVector), angle(position, m_endVector)));
+}
+
+
 auto Navigation::Leg::hasDataForWindTriangle(Weather::Wind wind, const Navigation::Aircraft& aircraft) -> bool
 {
 
@@ -1,5 +1,5 @@
 /***************************************************************************
- *   Copyright (C) 2019-2025 by Stefan Kebekus                             *
+ *   Copyright (C) 2019-2026 by Stefan Kebekus                             *
  *   stefan.kebekus@gmail.com                                              *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <array>
+
 #include <QGeoPath>
 #include <QQmlEngine>
 
@@ -221,7 +223,25 @@ public:
     // Width of the leg. A position is considered near the leg if the distance is less.
     static constexpr Units::Distance nearThreshold = Units::Distance::fromNM(5.0);
 
+    // Vectors in 3-space, and some elementary vector algebra
+    using Vector = std::array<double, 3>;
+    static constexpr auto cross(const Vector& a, const Vector& b) -> Vector
+    {
+        return {a[1]*b[2] - a[2]*b[1], a[2]*b[0] - a[0]*b[2], a[0]*b[1] - a[1]*b[0]};
+    }
+    static constexpr auto dot(const Vector& a, const Vector& b) -> double
+    {
+        return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+    }
+
 private:
+    // n-vector (unit vector in 3-space) describing a coordinate
+    [[nodiscard]] static auto nVector(const QGeoCoordinate& coordinate) -> Vector;
+
+    // Distance from the coordinate to the leg, computed with the vectors
+    // cached in m_startVector, m_endVector and m_normal
+    [[nodiscard]] auto distanceTo(const QGeoCoordinate& coordinate) const -> Units::Distance;
+
     // Necessary data for computation of wind triangle?
     [[nodiscard]] static auto hasDataForWindTriangle(Weather::Wind wind, const Navigation::Aircraft& aircraft) -> bool;
 
@@ -230,6 +250,13 @@ private:
 
     GeoMaps::Waypoint m_start;
     GeoMaps::Waypoint m_end;
+
+    // Geometry of the leg, computed in the constructor: n-vectors of start and
+    // end point, and unit normal of the great circle through these points. The
+    // normal is zero if start and end point agree.
+    Vector m_startVector {};
+    Vector m_endVector {};
+    Vector m_normal {};
 };
 
 } // namespace Navigation
@@ -0,0 +1,71 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "navigation/LegTracker.h"
+
+
+qsizetype Navigation::LegTracker::currentLeg(const QList<Leg>& legs, const Positioning::PositionInfo& positionInfo)
+{
+    // Neighbourhood of the last current leg. The next leg is checked before
+    // the last current leg, so that the tracker advances as soon as the
+    // aircraft turns onto the next leg.
+    auto const hasLastLeg = (m_lastLeg >= 0) && (m_lastLeg < legs.size());
+    auto const first = hasLastLeg ? qMax(m_lastLeg-1, qsizetype(0)) : qsizetype(0);
+    auto const last = hasLastLeg ? qMin(m_lastLeg+1, legs.size()-1) : qsizetype(-1);
+
+    // Take the last leg that we are following, neighbours first
+    for(auto i=last; i>=first; i--)
+    {
+        if (legs[i].isFollowing(positionInfo))
+        {
+            m_lastLeg = i;
+            return i;
+        }
+    }
+    for(auto i=legs.size()-1; i>=0; i--)
+    {
+        if (legs[i].isFollowing(positionInfo))
+        {
+            m_lastLeg = i;
+            return i;
+        }
+    }
+
+    // Take the last leg that we are near to, neighbours first
+    for(auto i=last; i>=first; i--)
+    {
+        if (legs[i].isNear(positionInfo))
+        {
+            m_lastLeg = i;
+            return i;
+        }
+    }
+    for(auto i=legs.size()-1; i>=0; i--)
+    {
+        if (legs[i].isNear(positionInfo))
+        {
+            m_lastLeg = i;
+            return i;
+        }
+    }
+
+    m_lastLeg = -1;
+    return -1;
+}
@@ -0,0 +1,68 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QList>
+
+#include "navigation/Leg.h"
+
+namespace Navigation {
+
+/*! \brief Finds the current leg of a flight route, incrementally
+ *
+ *  The current leg is the last leg that the aircraft is following or, if
+ *  there is no such leg, the last leg that the aircraft is near to. Finding
+ *  it requires a scan over all legs. This class remembers the leg found in
+ *  the last call to currentLeg() and checks that leg and its neighbours
+ *  first, so that the full scan is only necessary when the aircraft leaves
+ *  the route, or when the route changes substantially.
+ *
+ *  Following a leg always takes precedence over being near to a leg. Within
+ *  each of the two tests, a matching neighbour of the last current leg is
+ *  preferred over later legs of the route. For routes that pass the same
+ *  segment more than once, this keeps the current leg in step with the
+ *  progress of the flight.
+ *
+ *  Call reset() whenever the legs change.
+ */
+
+class LegTracker
+{
+public:
+    /*! \brief Current leg
+     *
+     *  @param legs Legs of the flight route
+     *
+     *  @param positionInfo Current position
+     *
+     *  @returns Index of the current leg in legs, or -1 if there is none
+     */
+    [[nodiscard]] qsizetype currentLeg(const QList<Leg>& legs, const Positioning::PositionInfo& positionInfo);
+
+    /*! \brief Forget the leg found in the last call to currentLeg() */
+    void reset() { m_lastLeg = -1; }
+
+private:
+    // Index of the leg found in the last call to currentLeg(), or -1
+    qsizetype m_lastLeg {-1};
+};
+
+} // namespace Navigation
@@ -24,8 +24,12 @@
 #include "GlobalObject.h"
 #include "GlobalSettings.h"
 #include "dataManagement/DataManager.h"
+#include "Trace.h"
+#include "dataManagement/FileWriter.h"
+#include "geomaps/GeoMapProvider.h"
 #include "navigation/Navigator.h"
 #include "positioning/PositionProvider.h"
+#include "weather/WeatherDataProvider.h"
 
 
 //
@@ -73,10 +77,20 @@ void Navigation::Navigator::deferredInitialization()
     connect(GlobalObject::positionProvider(), &Positioning::PositionProvider::positionInfoChanged, this, &Navigation::Navigator::updateAltitudeLimit);
     connect(GlobalObject::positionProvider(), &Positioning::PositionProvider::positionInfoChanged, this, &Navigation::Navigator::updateFlightStatus);
 
+    m_airspaceIncursionPredictor.setAirspaces(GlobalObject::geoMapProvider()->airspaces());
+    m_airspacesNotifier = GlobalObject::geoMapProvider()->bindableAirspaces().addNotifier([this]() {
+        m_airspaceIncursionPredictor.setAirspaces(GlobalObject::geoMapProvider()->airspaces());
+        updateAirspaceIncursion();
+    });
+    connect(GlobalObject::positionProvider(), &Positioning::PositionProvider::positionInfoChanged, this, &Navigation::Navigator::updateAirspaceIncursion);
+
     connect(GlobalObject::positionProvider(), &Positioning::PositionProvider::positionInfoChanged, this, &Navigation::Navigator::updateRemainingRouteInfo);
     connect(this, &Navigation::Navigator::aircraftChanged, this, [this](){ updateRemainingRouteInfo(); });
     connect(this, &Navigation::Navigator::windChanged, this, [this](){ updateRemainingRouteInfo(); });
-    connect(flightRoute(), &Navigation::FlightRoute::waypointsChanged, this, [this](){ updateRemainingRouteInfo(); });
+    connect(flightRoute(), &Navigation::FlightRoute::waypointsChanged, this, [this](){
+        m_legTracker.reset();
+        updateRemainingRouteInfo();
+    });
 
     m_hasAviationMapForCurrentLocation.setBinding([this]() {return computeHasAviationMapForCurrentLocation();});
 }
@@ -92,7 +106,12 @@ Navigation::FlightRoute* Navigation::Navigator::flightRoute()
     {
         m_flightRoute = new FlightRoute(this);
         m_flightRoute->load(m_flightRouteFileName);
-        connect(m_flightRoute, &Navigation::FlightRoute::waypointsChanged, this, [this]() {if (m_flightRoute != nullptr) {(void)m_flightRoute->save(m_flightRouteFileName);}});
+        connect(m_flightRoute, &Navigation::FlightRoute::waypointsChanged, this, [this]() {
+            if (m_flightRoute != nullptr)
+            {
+                GlobalObject::fileWriter()->schedule(m_flightRouteFileName, [waypoints = m_flightRoute->waypoints()]() { return Navigation::FlightRoute::toGeoJSON(waypoints); });
+            }
+        });
         QQmlEngine::setObjectOwnership(m_flightRoute, QQmlEngine::CppOwnership);
     }
     return m_flightRoute;
@@ -111,11 +130,7 @@ void Navigation::Navigator::setAircraft(const Navigation::Aircraft& newAircraft)
     }
 
     // Save aircraft
-    QFile file(m_aircraftFileName);
-    if (file.open(QIODevice::WriteOnly))
-    {
-        file.write(newAircraft.toJSON());
-    }
+    GlobalObject::fileWriter()->schedule(m_aircraftFileName, [newAircraft]() { return newAircraft.toJSON(); });
 
     // Set new aircraft
     m_aircraft = newAircraft;
@@ -179,6 +194,23 @@ void Navigation::Navigator::updateAltitudeLimit()
 }
 
 
+void Navigation::Navigator::updateAirspaceIncursion()
+{
+    Trace::Span const span("Navigator::updateAirspaceIncursion");
+
+    auto info = GlobalObject::positionProvider()->positionInfo();
+    if (!info.isValid())
+    {
+        m_airspaceIncursion = AirspaceIncursion();
+        return;
+    }
+    m_airspaceIncursion = m_airspaceIncursionPredictor.predict(info,
+                                                               info.terrainElevationAMSL(),
+                                                               GlobalObject::weatherDataProvider()->QNH(),
+                                                               GlobalObject::positionProvider()->pressureAltitude());
+}
+
+
 void Navigation::Navigator::updateFlightStatus()
 {
     auto info = GlobalObject::positionProvider()->positionInfo();
@@ -263,31 +295,10 @@ void Navigation::Navigator::updateRemainingRouteInfo()
         legs += Leg(start, end);
     }
 
-    // Check legs that we are following, and take the last one
-    qsizetype currentLeg = -1;
-    for(auto i=legs.size()-1; i>=0; i--)
-    {
-        if (legs[i].isFollowing(info))
-        {
-            currentLeg = i;
-            break;
-        }
-    }
-
-    // If no current leg found, check legs that we are near to, and take the last one.
-    if (currentLeg < 0)
-    {
-        for(auto i=legs.size()-1; i>=0; i--)
-        {
-            if (legs[i].isNear(info))
-            {
-                currentLeg = i;
-                break;
-            }
-        }
-    }
+    // Find the current leg, starting the search near the one found last time
+    auto const currentLeg = m_legTracker.currentLeg(legs, info);
 
-    // If still no current leg found, then abort
+    // If no current leg found, then abort
     if (currentLeg < 0)
     {
         RemainingRouteInfo rrInfo;
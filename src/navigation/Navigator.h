@@ -25,7 +25,10 @@
 
 #include "FlightRoute.h"
 #include "GlobalObject.h"
+#include "navigation/AirspaceIncursion.h"
+#include "navigation/AirspaceIncursionPredictor.h"
 #include "navigation/FlightRoute.h"
+#include "navigation/LegTracker.h"
 #include "navigation/RemainingRouteInfo.h"
 
 using namespace Qt::Literals::StringLiterals;
@@ -97,6 +100,17 @@ public:
     [[nodiscard]] QBindable<Navigation::Aircraft> bindableAircraft() { return &m_aircraft; }
     void setAircraft(const Navigation::Aircraft& newAircraft);
 
+    /*! \brief First airspace incursion predicted along the projected track
+     *
+     *  This property is updated on every position update. It describes the
+     *  first airspace that the own aircraft enters within the next few
+     *  minutes, if it continues with its present track, ground speed and
+     *  vertical speed.
+     */
+    Q_PROPERTY(Navigation::AirspaceIncursion airspaceIncursion READ airspaceIncursion BINDABLE bindableAirspaceIncursion)
+    [[nodiscard]] Navigation::AirspaceIncursion airspaceIncursion() const {return m_airspaceIncursion.value();}
+    [[nodiscard]] QBindable<Navigation::AirspaceIncursion> bindableAirspaceIncursion() {return &m_airspaceIncursion;}
+
     /*! \brief Indicates whether an aviation map is installed for the current location
      *
      *  For performance reasons, this method only checks whether the approximate last valid coordinate provided by PositionProvider
@@ -160,6 +174,9 @@ private slots:
     // Update flight status. Connected to positioning source.
     void updateFlightStatus();
 
+    // Re-computes the airspace incursion. Connected to positioning source.
+    void updateAirspaceIncursion();
+
     // Re-computes the Remaining Route Info. The argument must be the current position info of the own aircraft.
     void updateRemainingRouteInfo();
 
@@ -188,6 +205,13 @@ private:
     QString m_aircraftFileName;
 
     QProperty<RemainingRouteInfo> m_remainingRouteInfo;
+
+    // Remembers the current leg between calls to updateRemainingRouteInfo()
+    LegTracker m_legTracker;
+
+    QProperty<AirspaceIncursion> m_airspaceIncursion;
+    AirspaceIncursionPredictor m_airspaceIncursionPredictor;
+    QPropertyNotifier m_airspacesNotifier; // Hands new airspaces to m_airspaceIncursionPredictor
 };
 
 } // namespace Navigation
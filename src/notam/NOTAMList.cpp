@@ -21,6 +21,8 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QtGlobal>
+#include <QtMath>
+#include <numeric>
 
 #include "notam/NOTAMList.h"
 #include "notam/NOTAMProvider.h"
@@ -76,6 +78,7 @@ NOTAM::NOTAMList::NOTAMList(const QJsonDocument& jsonDoc, const QGeoCircle& regi
 
     m_retrieved = QDateTime::currentDateTimeUtc();
     m_region = region;
+    updateIndex();
 }
 
 
@@ -128,7 +131,8 @@ NOTAM::NOTAMList NOTAM::NOTAMList::cleaned(const QSet<QString>& cancelledNotamNu
     result.m_region = m_region;
     result.m_retrieved = m_retrieved;
 
-    foreach(auto notam, m_notams)
+    QSet<QString> numbersSeen;
+    for(const auto& notam : m_notams)
     {
         if (!notam.isValid())
         {
@@ -142,12 +146,14 @@ NOTAM::NOTAMList NOTAM::NOTAMList::cleaned(const QSet<QString>& cancelledNotamNu
         {
             continue;
         }
-        if (result.m_notams.contains(notam))
+        if (numbersSeen.contains(notam.number()))
         {
             continue;
         }
+        numbersSeen += notam.number();
         result.m_notams.append(notam);
     }
+    result.updateIndex();
 
     return result;
 }
@@ -161,8 +167,34 @@ NOTAM::NOTAMList NOTAM::NOTAMList::restricted(const GeoMaps::Waypoint& waypoint)
 
     result.m_region = QGeoCircle(waypoint.coordinate(), radius);
 
-    foreach(auto notam, m_notams)
+    // Find candidates in the index. Near the poles, all NOTAMs are candidates.
+    QList<qsizetype> candidates;
+    auto const latitude = waypoint.coordinate().latitude();
+    auto const latitudeDelta = restrictionRadius.toNM()/60.0;
+    auto const cosLatitude = qCos(qDegreesToRadians(qMin(qAbs(latitude) + latitudeDelta, 90.0)));
+    if (cosLatitude > 0.1)
     {
+        auto const longitude = waypoint.coordinate().longitude();
+        auto const longitudeDelta = latitudeDelta/cosLatitude;
+        for(auto latCell = qFloor(latitude - latitudeDelta); latCell <= qFloor(latitude + latitudeDelta); latCell++)
+        {
+            for(auto lonCell = qFloor(longitude - longitudeDelta); lonCell <= qFloor(longitude + longitudeDelta); lonCell++)
+            {
+                candidates += m_index.value(indexKey(latCell, lonCell));
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+    }
+    else
+    {
+        candidates.resize(m_notams.size());
+        std::iota(candidates.begin(), candidates.end(), 0);
+    }
+
+    QSet<QString> numbersSeen;
+    for(auto candidate : std::as_const(candidates))
+    {
+        auto notam = m_notams.at(candidate);
         if (!notam.isValid())
         {
             continue;
@@ -175,7 +207,7 @@ NOTAM::NOTAMList NOTAM::NOTAMList::restricted(const GeoMaps::Waypoint& waypoint)
         {
             continue;
         }
-        if (result.m_notams.contains(notam))
+        if (numbersSeen.contains(notam.number()))
         {
             continue;
         }
@@ -183,9 +215,11 @@ NOTAM::NOTAMList NOTAM::NOTAMList::restricted(const GeoMaps::Waypoint& waypoint)
         {
             continue;
         }
+        numbersSeen += notam.number();
         notam.updateSectionTitle();
         result.m_notams.append(notam);
     }
+    result.updateIndex();
 
     std::sort(result.m_notams.begin(), result.m_notams.end(),
               [](const NOTAM& first, const NOTAM& second)
@@ -213,6 +247,34 @@ NOTAM::NOTAMList NOTAM::NOTAMList::restricted(const GeoMaps::Waypoint& waypoint)
 
 
 
+//
+// Private Methods
+//
+
+qint32 NOTAM::NOTAMList::indexKey(int latCell, int lonCell)
+{
+    // Wrap longitude cells into the range [-180, 179]
+    lonCell = ((lonCell + 180) % 360 + 360) % 360 - 180;
+    return ((latCell + 90) * 361) + (lonCell + 180);
+}
+
+
+void NOTAM::NOTAMList::updateIndex()
+{
+    m_index.clear();
+    for(qsizetype i = 0; i < m_notams.size(); i++)
+    {
+        auto const coordinate = m_notams.at(i).coordinate();
+        if (!coordinate.isValid())
+        {
+            continue;
+        }
+        m_index[indexKey(qFloor(coordinate.latitude()), qFloor(coordinate.longitude()))].append(i);
+    }
+}
+
+
+
 //
 // Non-Member Methods
 //
@@ -232,6 +294,7 @@ QDataStream& NOTAM::operator>>(QDataStream& stream, NOTAMList& notamList)
     stream >> notamList.m_notams;
     stream >> notamList.m_region;
     stream >> notamList.m_retrieved;
+    notamList.updateIndex();
 
     return stream;
 }
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <QHash>
 #include <QQmlEngine>
 
 #include "geomaps/Waypoint.h"
@@ -184,9 +185,19 @@ public:
     static constexpr Units::Distance restrictionRadius = Units::Distance::fromNM(20.0);
 
 private:
+    /* Key of a 1°×1° cell in m_index */
+    static qint32 indexKey(int latCell, int lonCell);
+
+    /* Rebuilds m_index. This method must be called whenever m_notams changes. */
+    void updateIndex();
+
     /* List of Notams */
     QList<NOTAM> m_notams;
 
+    /* Spatial index: indices of the NOTAMs in m_notams, by 1°×1° cell of
+       their coordinate */
+    QHash<qint32, QList<qsizetype>> m_index;
+
     /* Region */
     QGeoCircle m_region;
 
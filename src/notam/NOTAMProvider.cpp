@@ -1,5 +1,5 @@
 /***************************************************************************
- *   Copyright (C) 2023-2024 by Stefan Kebekus                             *
+ *   Copyright (C) 2023-2026 by Stefan Kebekus                             *
  *   stefan.kebekus@gmail.com                                              *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
@@ -21,8 +21,10 @@
 #include <QFile>
 #include <QJsonArray>
 #include <QTimer>
+#include <QtConcurrent/QtConcurrentRun>
 #include <chrono>
 
+#include "Trace.h"
 #include "config.h"
 #include "navigation/Navigator.h"
 #include "notam/NOTAMProvider.h"
@@ -139,8 +141,15 @@ NOTAM::NOTAMList NOTAM::NOTAMProvider::notams(const GeoMaps::Waypoint& waypoint)
         }
     }
 
-    // Check if internet requests NOTAMs for the location are pending.
-    // In that case, return an empty list.
+    // Check if internet requests NOTAMs for the location are pending, or if
+    // downloaded data is being parsed. In that case, return an empty list.
+    for(const auto& region : m_parsingRegions)
+    {
+        if (region.contains(waypoint.coordinate()))
+        {
+            return {};
+        }
+    }
     for(const auto& networkReply : m_networkReplies)
     {
         // Paranoid safety checks
@@ -223,8 +232,10 @@ QList<NOTAM::NOTAMList> NOTAM::NOTAMProvider::cleaned(const QList<NOTAMList>& no
 
 void NOTAM::NOTAMProvider::downloadFinished()
 {
-    auto newNotamList = m_notamLists.value();
-    QSet<QString> cancelledNotams;
+    Trace::Span const span("NOTAMProvider::downloadFinished");
+
+    QList<QGeoCircle> regions;
+    QList<QByteArray> data;
 
     m_networkReplies.removeAll(nullptr);
     for(const auto& networkReply : m_networkReplies)
@@ -250,19 +261,48 @@ void NOTAM::NOTAMProvider::downloadFinished()
             continue;
         }
 
-        auto region = networkReply->property("area").value<QGeoCircle>();
-        auto data = networkReply->readAll();
+        regions << networkReply->property("area").value<QGeoCircle>();
+        data << networkReply->readAll();
         networkReply->deleteLater();
+    }
+    if (data.isEmpty())
+    {
+        return;
+    }
+
+    // Parse data in a separate thread. Until the data is merged, the regions
+    // count as running downloads.
+    m_parsingRegions += regions;
+    QtConcurrent::run(&NOTAMProvider::parse, data, regions).then(this, [this, regions](const ParseResult& result) {
+        for(const auto& region : regions)
+        {
+            m_parsingRegions.removeOne(region);
+        }
+
+        auto newNotamList = m_notamLists.value();
+        for(const auto& notamList : result.notamLists)
+        {
+            newNotamList.prepend(notamList);
+        }
+        m_notamLists = cleaned(newNotamList, result.cancelledNotamNumbers);
+    });
+}
 
-        auto jsonDoc = QJsonDocument::fromJson(data);
+NOTAM::NOTAMProvider::ParseResult NOTAM::NOTAMProvider::parse(const QList<QByteArray>& data, const QList<QGeoCircle>& regions)
+{
+    Trace::Span const span("NOTAMProvider::parse");
+
+    ParseResult result;
+    for(qsizetype i = 0; i < data.size(); i++)
+    {
+        auto jsonDoc = QJsonDocument::fromJson(data.at(i));
         if (jsonDoc.isNull())
         {
             continue;
         }
-        NOTAMList const notamList(jsonDoc, region, &cancelledNotams);
-        newNotamList.prepend(notamList);
+        result.notamLists << NOTAMList(jsonDoc, regions.at(i), &result.cancelledNotamNumbers);
     }
-    m_notamLists = cleaned(newNotamList, cancelledNotams);
+    return result;
 }
 
 bool NOTAM::NOTAMProvider::hasDataForPosition(const QGeoCoordinate& position, bool includeDataThatNeedsUpdate, bool includeRunningDownloads) const
@@ -296,6 +336,13 @@ bool NOTAM::NOTAMProvider::hasDataForPosition(const QGeoCoordinate& position, bo
 
     if (includeRunningDownloads)
     {
+        for(const auto& region : m_parsingRegions)
+        {
+            if (region.radius() - region.center().distanceTo(position) >= minimumRadiusPoint.toM())
+            {
+                return true;
+            }
+        }
         for(const auto& networkReply : m_networkReplies)
         {
             // Paranoid safety checks
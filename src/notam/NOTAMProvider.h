@@ -197,13 +197,24 @@ private:
     Q_REQUIRED_RESULT static QList<NOTAMList> cleaned(const QList<NOTAMList>& notamLists, const QSet<QString>& cancelledNotams = {});
 
     // This method reads the incoming data from network replies and adds it to
-    // the database. It cleans up the list of network replies in
-    // m_networkReplies. On error, it requests a call to updateData in five
-    // minutes. This method is connected to signals QNetworkReply::finished and
-    // QNetworkReply::errorOccurred of the QNetworkReply contained in the list
-    // in m_networkReply.
+    // the database, once it has been parsed in a separate thread. It cleans up
+    // the list of network replies in m_networkReplies. On error, it requests a
+    // call to updateData in five minutes. This method is connected to signals
+    // QNetworkReply::finished and QNetworkReply::errorOccurred of the
+    // QNetworkReply contained in the list in m_networkReply.
     void downloadFinished();
 
+    // NOTAMLists and numbers of cancelled NOTAMs, parsed from downloaded data
+    struct ParseResult
+    {
+        QList<NOTAMList> notamLists;
+        QSet<QString> cancelledNotamNumbers;
+    };
+
+    // Parses JSON data from the FAA. The lists data and regions are expected
+    // to be of equal size. This method is run in a separate thread.
+    static ParseResult parse(const QList<QByteArray>& data, const QList<QGeoCircle>& regions);
+
     // Check if current NOTAM data exists for a circle of radius minimalRadius
     // around position. This method ignores outdated NOTAM data. An invalid
     // position is always considered to be covered.
@@ -243,6 +254,9 @@ private:
     // List of pending network requests
     QList<QPointer<QNetworkReply>> m_networkReplies;
 
+    // Regions of downloaded data that is currently being parsed
+    QList<QGeoCircle> m_parsingRegions;
+
     // List of NOTAMLists, sorted so that newest lists come first
     QProperty<QList<NOTAMList>> m_notamLists;
 
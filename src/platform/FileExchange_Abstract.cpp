@@ -19,18 +19,18 @@
  ***************************************************************************/
 
 #include <QImage>
-#include <QMimeDatabase>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QUrl>
 
 #include "fileFormats/CUP.h"
+#include "fileFormats/FileProbe.h"
 #include "fileFormats/FPL.h"
 #include "fileFormats/GeoTIFF.h"
-#include "fileFormats/MBTILES.h"
 #include "fileFormats/MapURL.h"
 #include "fileFormats/PLN.h"
+#include "fileFormats/TileFileAbstract.h"
 #include "fileFormats/TripKit.h"
 #include "geomaps/GeoJSON.h"
 #include "geomaps/OpenAir.h"
@@ -85,15 +85,16 @@ void Platform::FileExchange_Abstract::processFileOpenRequest(const QString& path
     }
 
 
-    auto file = FileFormats::DataFileAbstract::openFileURL(path);
-    const QString myPath = file->fileName();
-
     /*
-     * Get MIME Type
+     * Read a prefix of the file once, and determine MIME type and signature
+     * from it. The expensive checks below run only for files whose signature
+     * matches.
      */
 
-    QMimeDatabase const dataBase;
-    auto mimeType = dataBase.mimeTypeForData(file.data());
+    FileFormats::FileProbe probe(path);
+    const QString myPath = probe.fileName();
+    auto const mimeType = probe.mimeType();
+    auto const signature = probe.signature();
 
 
     /*
@@ -120,25 +121,28 @@ void Platform::FileExchange_Abstract::processFileOpenRequest(const QString& path
     }
 
     // GeoJSON file
-    auto fileContent = GeoMaps::GeoJSON::inspect(myPath);
-    if (fileContent == GeoMaps::GeoJSON::flightRoute)
-    {
-        emit openFileRequest(path, {}, FlightRoute);
-        return;
-    }
-    if (fileContent == GeoMaps::GeoJSON::waypointLibrary)
+    if (signature == FileFormats::FileProbe::JSON)
     {
-        emit openFileRequest(path, {}, WaypointLibrary);
-        return;
-    }
-    if (fileContent == GeoMaps::GeoJSON::valid)
-    {
-        emit openFileRequest(path, {}, FlightRouteOrWaypointLibrary);
-        return;
+        auto fileContent = GeoMaps::GeoJSON::inspect(probe.content());
+        if (fileContent == GeoMaps::GeoJSON::flightRoute)
+        {
+            emit openFileRequest(path, {}, FlightRoute);
+            return;
+        }
+        if (fileContent == GeoMaps::GeoJSON::waypointLibrary)
+        {
+            emit openFileRequest(path, {}, WaypointLibrary);
+            return;
+        }
+        if (fileContent == GeoMaps::GeoJSON::valid)
+        {
+            emit openFileRequest(path, {}, FlightRouteOrWaypointLibrary);
+            return;
+        }
     }
 
     // FLARM Simulator file
-    if (Traffic::TrafficDataSource_File::containsFLARMSimulationData(myPath))
+    if ((signature == FileFormats::FileProbe::Text) && Traffic::TrafficDataSource_File::containsFLARMSimulationData(probe.prefix()))
     {
         auto* source = new Traffic::TrafficDataSource_File(false, myPath, GlobalObject::trafficDataProvider());
         GlobalObject::trafficDataProvider()->addDataSource(source); // Will take ownership of source
@@ -146,23 +150,33 @@ void Platform::FileExchange_Abstract::processFileOpenRequest(const QString& path
         return;
     }
 
-    // MBTiles containing a vector map
-    FileFormats::MBTILES mbtiles(myPath);
-    if (mbtiles.format() == FileFormats::MBTILES::Vector)
+    // MBTiles or PMTiles
+    if ((signature == FileFormats::FileProbe::SQLite) || (signature == FileFormats::FileProbe::PMTiles))
     {
-        emit openFileRequest(path, {}, VectorMap);
-        return;
+        auto tileFile = FileFormats::TileFileAbstract::open(myPath);
+        auto const tileFormat = tileFile->format();
+        if (tileFormat == FileFormats::TileFileAbstract::Vector)
+        {
+            emit openFileRequest(path, {}, VectorMap);
+            return;
+        }
+        if (tileFormat == FileFormats::TileFileAbstract::Raster)
+        {
+            emit openFileRequest(path, {}, RasterMap);
+            return;
+        }
     }
 
-    // MBTiles containing a raster map
-    if (mbtiles.format() == FileFormats::MBTILES::Raster)
+    // OpenAir
+    QString info;
+    if ((signature == FileFormats::FileProbe::OpenAir) && GeoMaps::openAir::isValid(myPath, &info))
     {
-        emit openFileRequest(path, {}, RasterMap);
+        emit openFileRequest(path, info, OpenAir);
         return;
     }
 
     // CUP file
-    if (FileFormats::CUP::mimeTypes().contains(mimeType.name()))
+    if ((signature == FileFormats::FileProbe::Text) && FileFormats::CUP::mimeTypes().contains(mimeType.name()))
     {
         FileFormats::CUP const cup(myPath);
         if (cup.isValid())
@@ -198,7 +212,7 @@ void Platform::FileExchange_Abstract::processFileOpenRequest(const QString& path
     }
 
     // Image
-    if (mimeType.name().startsWith(u"image"_s))
+    if (signature == FileFormats::FileProbe::Image)
     {
         QImage const img(myPath);
         if (!img.isNull())
@@ -209,7 +223,7 @@ void Platform::FileExchange_Abstract::processFileOpenRequest(const QString& path
     }
 
     // TripKits
-    if (FileFormats::TripKit::mimeTypes().contains(mimeType.name()))
+    if ((signature == FileFormats::FileProbe::Zip) && FileFormats::TripKit::mimeTypes().contains(mimeType.name()))
     {
         FileFormats::TripKit const tripKit(myPath);
         if (tripKit.isValid())
@@ -220,7 +234,7 @@ void Platform::FileExchange_Abstract::processFileOpenRequest(const QString& path
     }
 
     // ZipFiles
-    if (FileFormats::ZipFile::mimeTypes().contains(mimeType.name()))
+    if ((signature == FileFormats::FileProbe::Zip) && FileFormats::ZipFile::mimeTypes().contains(mimeType.name()))
     {
         FileFormats::ZipFile const zipFile(myPath);
         if (zipFile.isValid())
@@ -230,9 +244,8 @@ void Platform::FileExchange_Abstract::processFileOpenRequest(const QString& path
         }
     }
 
-    // OpenAir
-    QString info;
-    if (GeoMaps::openAir::isValid(myPath, &info))
+    // OpenAir files whose airspace records begin beyond the prefix
+    if ((signature == FileFormats::FileProbe::Text) && GeoMaps::openAir::isValid(myPath, &info))
     {
         emit openFileRequest(path, info, OpenAir);
         return;
@@ -17,55 +17,35 @@
  */
 
 #include <QDebug>
-#include <QFile>
+#include <QResource>
 #include <QtEndian>
 #include <QtMath>
 
 #include "positioning/Geoid.h"
 
-// Static member variable
 
-QVector<qint16> Positioning::Geoid::egm {};
+// The geoid data is stored in little-endian byte order in an uncompressed
+// resource, so that it can be used in place on all supported platforms. This
+// avoids copying 2MB of data at first use. Resources are not guaranteed to be
+// aligned, so all access goes through qFromLittleEndian, which compiles to a
+// plain (unaligned) load on little-endian hosts.
 
 
-// reading binary geoid data was carefully optimized for speed. We read the
-// binary content at once and do the byte order conversion afterwards.  This
-// turned out to be up to 60x faster compared to using QDataStream with
-// setByteOrder(QDataStream::BigEndian) and reading the shorts one after the
-// other with the QDataStream >> operator.
-
-
-void Positioning::Geoid::readEGM()
+auto Positioning::Geoid::grid() -> const uchar*
 {
-    QFile file(QStringLiteral(":/WW15MGH.DAC"));
-
-    qint64 const egm96_size_2 = (qint64) egm96_size * (qint64) 2;
-
-    if (!file.open(QIODevice::ReadOnly) || file.size() != (egm96_size_2))
-    {
-        qDebug() << "Geoid::Geoid failed to open " << file.fileName();
-        return;
-    }
-
-    egm.resize(egm96_size);
-
-    qint64 const nread = file.read(static_cast<char *>(static_cast<void *>(egm.data())),
-                                   egm96_size_2);
-
-    file.close();
-
-    if (nread != egm96_size_2)
-    {
-        qDebug() << "Geoid::Geoid expected " << egm96_size_2
-                 << " bytes from " << file.fileName() << " but got " << nread;
-        egm.clear();
-        return;
-    }
-
-    if (QSysInfo::ByteOrder == QSysInfo::LittleEndian) {
-        qFromBigEndian<qint16>(egm.data(), egm96_size, egm.data());
-    }
+    static const uchar* const data = []() -> const uchar* {
+        QResource const resource(QStringLiteral(":/WW15MGH-LE.DAC"));
+        qint64 const egm96_size_2 = (qint64) egm96_size * (qint64) 2;
 
+        if (!resource.isValid() || (resource.compressionAlgorithm() != QResource::NoCompression)
+            || (resource.size() != egm96_size_2))
+        {
+            qDebug() << "Geoid::Geoid failed to access " << resource.fileName();
+            return nullptr;
+        }
+        return resource.data();
+    }();
+    return data;
 }
 
 // 90 >= latitude >= -90
@@ -74,28 +54,12 @@ void Positioning::Geoid::readEGM()
 // points according to Numerical Recipies in C++ 3.6 "Interpolation in Two or
 // More Dimensions".
 //
-Units::Distance Positioning::Geoid::separation(const QGeoCoordinate& coord)
+auto Positioning::Geoid::interpolate(const uchar* data, const QGeoCoordinate& coord) -> double
 {
-    // Paranoid safety checks
-    if (!coord.isValid())
-    {
-        return Units::Distance::fromM( qQNaN() );
-    }
-
-    // Read EGM vector if this has not been done already
-    if (egm.empty())
-    {
-        readEGM();
-        if (egm.empty())
-        {
-            return Units::Distance::fromM( qQNaN() );
-        }
-    }
-
-    // Get lat/long
+    // Get lat/long. Valid coordinates have longitude in [-180, 180].
     auto latitude = coord.latitude();
     auto longitude = coord.longitude();
-    while (longitude < 0)
+    if (longitude < 0)
     {
         longitude += 360.;
     }
@@ -104,39 +68,66 @@ Units::Distance Positioning::Geoid::separation(const QGeoCoordinate& coord)
     // system.  The returning row and col are still reals (_not_ data index
     // integers).  We do not care about cyclic overflows yet, col might > 1400.
     //
-    auto row = []  (double lat) -> double { return (90 - lat) * 4; }; // [0; 720] from north to south
-    auto col = []  (double lon) -> double { return    lon     * 4; }; // [0; 1440[
+    double const row = (90 - latitude) * 4; // [0; 720] from north to south
+    double const col = longitude * 4;       // [0; 1440[
 
     // integer row north and south of latitude
     //
-    int const north = qFloor(row(latitude));
+    int const north = qFloor(row);
     int const south = (north + 1) < egm96_rows ? (north + 1) : north;
 
     // integer column west and east of latitude
     //
-    int const west = qFloor(col(longitude)) % egm96_cols;
+    int const west = qFloor(col) % egm96_cols;
     int const east = (west + 1) % egm96_cols;
 
-    auto geoid = [&](int row, int col) -> qreal {
-        int const idx = row * egm96_cols + col;
-        return idx >=0 && idx < egm96_size ? egm.at(idx) * 0.01 : 0.0;
+    // For valid coordinates, all indices are in range by construction
+    auto geoid = [data](int row, int col) -> double {
+        return qFromLittleEndian<qint16>(data + (2 * (row * egm96_cols + col))) * 0.01;
     };
 
     // here we do a bilinear interpolation between the 4 neighbouring data
     // points of the requested location.
     //
-    double interpolated = 0;
-    double row_dist = row(latitude) - north;
-    double col_dist = col(longitude) - qFloor(col(longitude));
-    for (int const irow : {north, south})
+    double const row_dist = row - north;
+    double const col_dist = col - qFloor(col);
+    return (geoid(north, west) * (1 - row_dist) * (1 - col_dist))
+           + (geoid(north, east) * (1 - row_dist) * col_dist)
+           + (geoid(south, west) * row_dist * (1 - col_dist))
+           + (geoid(south, east) * row_dist * col_dist);
+}
+
+Units::Distance Positioning::Geoid::separation(const QGeoCoordinate& coord)
+{
+    // Paranoid safety checks
+    if (!coord.isValid())
     {
-        for (int const icol : {west, east})
+        return Units::Distance::fromM( qQNaN() );
+    }
+
+    const auto* data = grid();
+    if (data == nullptr)
+    {
+        return Units::Distance::fromM( qQNaN() );
+    }
+
+    return Units::Distance::fromM( interpolate(data, coord) );
+}
+
+QList<Units::Distance> Positioning::Geoid::separation(const QList<QGeoCoordinate>& coords)
+{
+    QList<Units::Distance> result;
+    result.reserve(coords.size());
+
+    const auto* data = grid();
+    for(const auto& coord : coords)
+    {
+        if ((data == nullptr) || !coord.isValid())
         {
-            interpolated += geoid(irow, icol) * (1 - row_dist) * (1 - col_dist);
-            col_dist = 1 - col_dist;
+            result.append( Units::Distance::fromM( qQNaN() ) );
+            continue;
         }
-        row_dist = 1 - row_dist;
+        result.append( Units::Distance::fromM( interpolate(data, coord) ) );
     }
-
-    return Units::Distance::fromM( interpolated );
+    return result;
 }
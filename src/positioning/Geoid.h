@@ -63,11 +63,28 @@ public:
      */
     static auto separation(const QGeoCoordinate& coord) -> Units::Distance;
 
+    /*! \brief return geoidal separation for a list of coordinates
+     *
+     * This method is equivalent to calling separation() for every coordinate
+     * in the list, but looks up the grid only once.
+     *
+     * @param coords locations for which the geoidal separation should be calculated.
+     *
+     * @returns Geoidal separations, in the order of coords. Entries are NAN
+     * for invalid coordinates, or if the method fails.
+     */
+    static auto separation(const QList<QGeoCoordinate>& coords) -> QList<Units::Distance>;
+
 private:
-    // Reads data into the vector egm
-    static void readEGM();
+    // Returns a pointer to the grid data (little-endian qint16, possibly
+    // unaligned), or nullptr if the data cannot be accessed. The data is
+    // used in place from the uncompressed resource file WW15MGH-LE.DAC, which
+    // is generated from WW15MGH.DAC by generatedSources/generateGeoid.py.
+    // Thread-safe.
+    static auto grid() -> const uchar*;
 
-    static QVector<qint16> egm; // holds the data read from the binaray data file WW15MGH.DAC
+    // Bilinear interpolation at a valid coordinate, in meters
+    static auto interpolate(const uchar* data, const QGeoCoordinate& coord) -> double;
 
     // https://earth-info.nga.mil/GandG/wgs84/gravitymod/egm96/binary/readme.txt
     // https://earth-info.nga.mil/GandG/wgs84/gravitymod/egm96/binary/binarygeoid.html
@@ -1,5 +1,5 @@
 /***************************************************************************
- *   Copyright (C) 2025 by Stefan Kebekus                                  *
+ *   Copyright (C) 2025-2026 by Stefan Kebekus                             *
  *   stefan.kebekus@gmail.com                                              *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
@@ -33,10 +33,9 @@ SideviewQuickItem {
     // Night-mode-aware colors. Sky and terrain have no equivalent on the moving
     // map; the night hues are picked to blend with the dark base map. The
     // airspace hues themselves live in the Global singleton (Global.airspaceBlue
-    // etc.), see FlightMap.
-    readonly property color skyColor:           GlobalSettings.nightMode ? "#101820" : "lightblue"
-    readonly property color terrainFillColor:   GlobalSettings.nightMode ? "#33251a" : "brown"
-    readonly property color terrainStrokeColor: GlobalSettings.nightMode ? "#54402c" : "saddlebrown"
+    // etc.), see FlightMap. Sky and terrain are drawn by SideviewQuickItem.
+    skyColor:           GlobalSettings.nightMode ? "#101820" : "lightblue"
+    terrainFillColor:   GlobalSettings.nightMode ? "#33251a" : "brown"
 
     // Same role as the properties of the same name in FlightMap: the
     // semi-transparent airspace bands and fills wash out to near-invisible over
@@ -44,27 +43,12 @@ SideviewQuickItem {
     readonly property real airspaceBandOpacity: GlobalSettings.nightMode ? 0.35 : 0.2
     readonly property real airspaceFillOpacity: GlobalSettings.nightMode ? 0.30 : 0.2
 
-    Rectangle {
-        id: sky
-        anchors.fill: parent
-        color: rawSideView.skyColor
-    }
-
     Shape {
         id: shp
 
         preferredRendererType: Shape.CurveRenderer
         asynchronous: true
 
-        ShapePath {
-            id: terrain
-            strokeWidth: -1
-            strokeColor: rawSideView.terrainStrokeColor
-            fillColor: rawSideView.terrainFillColor
-
-            PathPolyline { path: rawSideView.terrain }
-        }
-
         ShapePath {
             id: airspacesABorder
             strokeWidth: 10
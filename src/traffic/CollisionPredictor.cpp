@@ -0,0 +1,178 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+#include "traffic/CollisionPredictor.h"
+
+
+namespace {
+
+// Length of one degree of latitude, in meters
+constexpr double metersPerDegreeLatitude = 6371000.0*M_PI/180.0;
+
+// Extrapolates the position to the given time, using ground speed, track and
+// vertical speed if available
+QGeoCoordinate extrapolatedCoordinate(const Positioning::PositionInfo& info, const QDateTime& time)
+{
+    auto coordinate = info.coordinate();
+    auto const groundSpeed = info.groundSpeed();
+    auto const track = info.trueTrack();
+    if (!groundSpeed.isFinite() || !track.isFinite() || !info.timestamp().isValid())
+    {
+        return coordinate;
+    }
+    auto const seconds = static_cast<double>(info.timestamp().msecsTo(time))/1000.0;
+    auto verticalSpeed = info.verticalSpeed().toMPS();
+    if (!qIsFinite(verticalSpeed) || (coordinate.type() != QGeoCoordinate::Coordinate3D))
+    {
+        verticalSpeed = 0.0;
+    }
+    return coordinate.atDistanceAndAzimuth(groundSpeed.toMPS()*seconds, track.toDEG(), verticalSpeed*seconds);
+}
+
+// Velocity in east, north and up direction, in meters per second. Unknown
+// components are zero.
+void velocity(const Positioning::PositionInfo& info, double& east, double& north, double& up)
+{
+    east = 0.0;
+    north = 0.0;
+    up = 0.0;
+    auto const groundSpeed = info.groundSpeed();
+    auto const track = info.trueTrack();
+    if (groundSpeed.isFinite() && track.isFinite())
+    {
+        east = groundSpeed.toMPS()*qSin(track.toRAD());
+        north = groundSpeed.toMPS()*qCos(track.toRAD());
+    }
+    auto const verticalSpeed = info.verticalSpeed().toMPS();
+    if (qIsFinite(verticalSpeed))
+    {
+        up = verticalSpeed;
+    }
+}
+
+} // namespace
+
+
+//
+// Methods
+//
+
+bool Traffic::CollisionPredictor::setOwnship(const Positioning::PositionInfo& ownship, const QDateTime& time)
+{
+    m_east.clear();
+    m_north.clear();
+    m_up.clear();
+    m_velocityEast.clear();
+    m_velocityNorth.clear();
+    m_velocityUp.clear();
+
+    m_time = time;
+    m_ownship = extrapolatedCoordinate(ownship, time);
+    if (!m_ownship.isValid() || (m_ownship.type() != QGeoCoordinate::Coordinate3D))
+    {
+        return false;
+    }
+    m_metersPerDegreeLongitude = metersPerDegreeLatitude*qCos(qDegreesToRadians(m_ownship.latitude()));
+    velocity(ownship, m_ownshipVelocityEast, m_ownshipVelocityNorth, m_ownshipVelocityUp);
+    return true;
+}
+
+
+void Traffic::CollisionPredictor::addTarget(const Positioning::PositionInfo& target)
+{
+    auto const coordinate = extrapolatedCoordinate(target, m_time);
+    double velocityEast = 0.0;
+    double velocityNorth = 0.0;
+    double velocityUp = 0.0;
+    velocity(target, velocityEast, velocityNorth, velocityUp);
+
+    m_east << std::remainder(coordinate.longitude()-m_ownship.longitude(), 360.0)*m_metersPerDegreeLongitude;
+    m_north << (coordinate.latitude()-m_ownship.latitude())*metersPerDegreeLatitude;
+    m_velocityEast << velocityEast - m_ownshipVelocityEast;
+    m_velocityNorth << velocityNorth - m_ownshipVelocityNorth;
+    if (coordinate.type() == QGeoCoordinate::Coordinate3D)
+    {
+        m_up << coordinate.altitude()-m_ownship.altitude();
+        m_velocityUp << velocityUp - m_ownshipVelocityUp;
+    }
+    else
+    {
+        m_up << 0.0;
+        m_velocityUp << 0.0;
+    }
+}
+
+
+void Traffic::CollisionPredictor::compute()
+{
+    auto const count = m_east.size();
+    m_timeToCPA.resize(count);
+    m_hDistCPA.resize(count);
+    m_vDistCPA.resize(count);
+    m_alarmLevel.resize(count);
+
+    // Plain pointers, so that the loop below contains no detach checks and
+    // can be vectorized
+    const double* east = m_east.constData();
+    const double* north = m_north.constData();
+    const double* up = m_up.constData();
+    const double* velocityEast = m_velocityEast.constData();
+    const double* velocityNorth = m_velocityNorth.constData();
+    const double* velocityUp = m_velocityUp.constData();
+    double* timeToCPA = m_timeToCPA.data();
+    double* hDistCPA = m_hDistCPA.data();
+    double* vDistCPA = m_vDistCPA.data();
+    int* alarmLevel = m_alarmLevel.data();
+
+    for(qsizetype i=0; i<count; i++)
+    {
+        // Time of horizontal CPA. For targets that do not move relative to
+        // the own aircraft, the denominator is tiny and the time is zero.
+        // Targets whose unclamped time is not positive are moving away, or
+        // not moving at all, and never raise an alarm.
+        auto const speedSquared = velocityEast[i]*velocityEast[i] + velocityNorth[i]*velocityNorth[i];
+        auto const unclampedTime = -(east[i]*velocityEast[i] + north[i]*velocityNorth[i])/std::max(speedSquared, 1e-6);
+        auto const time = std::clamp(unclampedTime, 0.0, lookAhead);
+
+        auto const cpaEast = east[i] + velocityEast[i]*time;
+        auto const cpaNorth = north[i] + velocityNorth[i]*time;
+        auto const hDist = std::sqrt(cpaEast*cpaEast + cpaNorth*cpaNorth);
+        auto const vDist = up[i] + velocityUp[i]*time;
+
+        auto const conflict = (unclampedTime > 0.0) && (hDist < protectionRadius) && (std::abs(vDist) < protectionHeight);
+        auto const level = (time <= 8.0) ? 3 : ((time <= 12.0) ? 2 : ((time <= 18.0) ? 1 : 0));
+
+        timeToCPA[i] = time;
+        hDistCPA[i] = hDist;
+        vDistCPA[i] = vDist;
+        alarmLevel[i] = conflict ? level : 0;
+    }
+}
+
+
+bool Traffic::CollisionPredictor::isAirborne(const Positioning::PositionInfo& info)
+{
+    auto const groundSpeed = info.groundSpeed();
+    return groundSpeed.isFinite() && (groundSpeed.toMPS() >= minimumAirborneGroundSpeed);
+}
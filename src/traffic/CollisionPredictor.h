@@ -0,0 +1,184 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QDateTime>
+#include <QList>
+
+#include "positioning/PositionInfo.h"
+
+namespace Traffic {
+
+/*! \brief Closest point of approach for many traffic factors at once
+ *
+ *  This class computes, for the own aircraft and a list of traffic factors,
+ *  the time to the closest point of approach (CPA), the horizontal and
+ *  vertical distance at the CPA, and an alarm level derived from these
+ *  numbers. All traffic factors are assumed to continue in a straight line,
+ *  with their present ground speed, track and vertical speed.
+ *
+ *  The data is held in structure-of-arrays form, in a plane tangent to the
+ *  earth at the own position, so that compute() is a single loop over plain
+ *  arrays that the compiler can vectorize. Typical use is as follows.
+ *
+ *  - Call setOwnship() to set the own position and the reference time.
+ *  - Call addTarget() once for every traffic factor.
+ *  - Call compute().
+ *  - Read the results with timeToCPA(), hDistCPA(), vDistCPA() and
+ *    alarmLevel(), in the order in which the targets were added.
+ *
+ *  The alarm levels correspond to those reported by FLARM devices: if
+ *  closing traffic comes closer than protectionRadius horizontally and
+ *  protectionHeight vertically, the alarm level is 1, 2 or 3 for a time to
+ *  CPA of at most 18, 12 or 8 seconds, respectively. Traffic that moves away
+ *  never raises an alarm, even inside the protected zone.
+ */
+
+class CollisionPredictor
+{
+public:
+    //
+    // Methods
+    //
+
+    /*! \brief Set own position and forget all targets
+     *
+     *  @param ownship Position of the own aircraft
+     *
+     *  @param time Reference time. Positions of the own aircraft and of the
+     *  targets are extrapolated to this time.
+     *
+     *  @returns False if the position of the own aircraft lacks coordinate
+     *  or altitude. In this case, targets must not be added.
+     */
+    bool setOwnship(const Positioning::PositionInfo& ownship, const QDateTime& time);
+
+    /*! \brief Add a target
+     *
+     *  Targets without altitude are treated as if they were at the altitude
+     *  of the own aircraft. Targets without ground speed or track are
+     *  treated as stationary.
+     *
+     *  @param target Position of the target
+     */
+    void addTarget(const Positioning::PositionInfo& target);
+
+    /*! \brief Compute CPA data for all targets
+     *
+     *  Targets get a non-zero alarm level only if the distance to the own
+     *  aircraft is decreasing.
+     */
+    void compute();
+
+    /*! \brief Check if an aircraft moves fast enough to be airborne
+     *
+     *  On airfields, parked and taxiing aircraft are close to each other all
+     *  the time. Predictions for them are meaningless.
+     *
+     *  @param info Position of the aircraft
+     *
+     *  @returns True if the ground speed is known and at least
+     *  minimumAirborneGroundSpeed
+     */
+    [[nodiscard]] static bool isAirborne(const Positioning::PositionInfo& info);
+
+    /*! \brief Number of targets
+     *
+     *  @returns Number of targets added since the last call to setOwnship()
+     */
+    [[nodiscard]] qsizetype size() const { return m_east.size(); }
+
+    /*! \brief Time to CPA
+     *
+     *  @param index Index of the target, in the range [0, size())
+     *
+     *  @returns Time to CPA. This is zero if the target is moving away, and
+     *  at most lookAhead.
+     */
+    [[nodiscard]] Units::Timespan timeToCPA(qsizetype index) const { return Units::Timespan::fromS(m_timeToCPA[index]); }
+
+    /*! \brief Horizontal distance at CPA
+     *
+     *  @param index Index of the target, in the range [0, size())
+     *
+     *  @returns Horizontal distance at CPA
+     */
+    [[nodiscard]] Units::Distance hDistCPA(qsizetype index) const { return Units::Distance::fromM(m_hDistCPA[index]); }
+
+    /*! \brief Vertical distance at CPA
+     *
+     *  @param index Index of the target, in the range [0, size())
+     *
+     *  @returns Vertical distance at CPA, positive if the target is above
+     */
+    [[nodiscard]] Units::Distance vDistCPA(qsizetype index) const { return Units::Distance::fromM(m_vDistCPA[index]); }
+
+    /*! \brief Alarm level
+     *
+     *  @param index Index of the target, in the range [0, size())
+     *
+     *  @returns Alarm level, in the range 0…3
+     */
+    [[nodiscard]] int alarmLevel(qsizetype index) const { return m_alarmLevel[index]; }
+
+
+    //
+    // Constants
+    //
+
+    /*! \brief Maximal time to CPA that is considered, in seconds */
+    static constexpr double lookAhead = 60.0;
+
+    /*! \brief Horizontal radius of the protected zone, in meters */
+    static constexpr double protectionRadius = 500.0;
+
+    /*! \brief Half height of the protected zone, in meters */
+    static constexpr double protectionHeight = 150.0;
+
+    /*! \brief Minimal ground speed of airborne aircraft, in meters per second (about 20 kt) */
+    static constexpr double minimumAirborneGroundSpeed = 10.0;
+
+private:
+    // Position and velocity of the own aircraft, and reference time
+    QGeoCoordinate m_ownship;
+    double m_ownshipVelocityEast {0.0};
+    double m_ownshipVelocityNorth {0.0};
+    double m_ownshipVelocityUp {0.0};
+    double m_metersPerDegreeLongitude {0.0};
+    QDateTime m_time;
+
+    // Position and velocity of the targets, relative to the own aircraft, in
+    // meters and meters per second
+    QList<double> m_east;
+    QList<double> m_north;
+    QList<double> m_up;
+    QList<double> m_velocityEast;
+    QList<double> m_velocityNorth;
+    QList<double> m_velocityUp;
+
+    // Results
+    QList<double> m_timeToCPA;
+    QList<double> m_hDistCPA;
+    QList<double> m_vDistCPA;
+    QList<int> m_alarmLevel;
+};
+
+} // namespace Traffic
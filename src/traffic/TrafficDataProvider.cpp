@@ -23,7 +23,9 @@
 #include <QFile>
 #include <QSaveFile>
 
+#include "navigation/Navigator.h"
 #include "platform/PlatformAdaptor.h"
+#include "positioning/PositionProvider.h"
 #include "traffic/TrafficDataProvider.h"
 #include "traffic/TrafficDataSource_Ogn.h"
 #include "traffic/TrafficDataSource_SerialPort.h"
@@ -70,6 +72,7 @@ Traffic::TrafficDataProvider::TrafficDataProvider(QObject *parent)
         QQmlEngine::setObjectOwnership(trafficObject, QQmlEngine::CppOwnership);
         m_trafficObjects.append( trafficObject );
     }
+    connect(l_timer, &QTimer::timeout, this, &Traffic::TrafficDataProvider::updateCollisionPrediction);
     m_trafficObjectWithoutPosition = new Traffic::TrafficFactor_DistanceOnly(this);
     QQmlEngine::setObjectOwnership(m_trafficObjectWithoutPosition, QQmlEngine::CppOwnership);
 
@@ -624,6 +627,51 @@ void Traffic::TrafficDataProvider::setWarning(const Traffic::Warning& warning)
     emit warningChanged(m_Warning);
 }
 
+void Traffic::TrafficDataProvider::updateCollisionPrediction()
+{
+    // Predict only if the own aircraft is airborne. If the navigator cannot
+    // tell, the ground speed decides.
+    auto const ownship = GlobalObject::positionProvider()->positionInfo();
+    auto const flightStatus = GlobalObject::navigator()->flightStatus();
+    auto const ownshipAirborne = (flightStatus == Navigation::Navigator::Flight)
+                                 || ((flightStatus == Navigation::Navigator::Unknown) && Traffic::CollisionPredictor::isAirborne(ownship));
+
+    // Collect valid targets, in structure-of-arrays form. Targets on the
+    // ground are ignored, and so are targets whose alarm level comes from a
+    // FLARM device.
+    QList<Traffic::TrafficFactor_WithPosition*> targets;
+    targets.reserve(m_trafficObjects.size());
+    if (ownshipAirborne && m_collisionPredictor.setOwnship(ownship, QDateTime::currentDateTimeUtc()))
+    {
+        for(auto* target : std::as_const(m_trafficObjects))
+        {
+            if (target->valid() && !target->alarmLevelFromFLARM() && Traffic::CollisionPredictor::isAirborne(target->positionInfo()))
+            {
+                m_collisionPredictor.addTarget(target->positionInfo());
+                targets << target;
+            }
+        }
+    }
+    m_collisionPredictor.compute();
+
+    // Hand results back to the targets, which appear in the same order as in
+    // m_trafficObjects. Targets without result lose their prediction.
+    qsizetype index = 0;
+    for(auto* target : std::as_const(m_trafficObjects))
+    {
+        if ((index >= targets.size()) || (targets[index] != target))
+        {
+            target->setCollisionPrediction({}, {}, {}, 0);
+            continue;
+        }
+        target->setCollisionPrediction(m_collisionPredictor.timeToCPA(index),
+                                       m_collisionPredictor.hDistCPA(index),
+                                       m_collisionPredictor.vDistCPA(index),
+                                       m_collisionPredictor.alarmLevel(index));
+        index++;
+    }
+}
+
 
 //
 // Private Methods
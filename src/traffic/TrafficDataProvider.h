@@ -25,6 +25,7 @@
 #include <QUdpSocket>
 
 #include "GlobalObject.h"
+#include "traffic/CollisionPredictor.h"
 #include "traffic/ConnectionInfo.h"
 #include "traffic/TrafficDataSource_Abstract.h"
 
@@ -515,6 +516,10 @@ private slots:
     // Setter method
     void setWarning(const Traffic::Warning& warning);
 
+    // Computes closest points of approach for all valid traffic objects, and
+    // hands the results to the objects
+    void updateCollisionPrediction();
+
 private:
     Q_DISABLE_COPY_MOVE(TrafficDataProvider)
 
@@ -535,6 +540,7 @@ private:
     // Targets
     QList<Traffic::TrafficFactor_WithPosition *> m_trafficObjects;
     QPointer<Traffic::TrafficFactor_DistanceOnly> m_trafficObjectWithoutPosition;
+    CollisionPredictor m_collisionPredictor;
 
     // TrafficData Sources
     QProperty<QList<QPointer<Traffic::TrafficDataSource_Abstract>>> m_dataSources;
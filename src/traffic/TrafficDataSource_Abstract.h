@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <QByteArrayView>
 #include <QProperty>
 
 #include "positioning/PositionInfo.h"
@@ -470,9 +471,9 @@ protected:
      *  string and updates the properties and emits signals as appropriate.
      *  Invalid messages are silently ignored.
      *
-     *  @param message A QByteArray containing a GDL90 message.
+     *  @param message A GDL90 message.
      */
-    void processGDLMessage(const QByteArray& message);
+    void processGDLMessage(QByteArrayView message);
 
     /*! \brief Process one XGPS string
      *
@@ -540,6 +541,13 @@ protected:
     QProperty<QString> m_trafficReceiverSelfTestError;
     QProperty<Traffic::ConnectionInfo> m_connectionInfo;
 
+    // Time spent in the receivers of the signals factorWithoutPosition,
+    // factorWithPosition and warning when emitted by the FLARM/NMEA parser, in
+    // nanoseconds. This is accumulated for the statistics of replays, and only
+    // if m_measureFLARMDispatch is true.
+    qint64 m_FLARMDispatchTime {0};
+    bool m_measureFLARMDispatch {false};
+
 private:
     Q_DISABLE_COPY_MOVE(TrafficDataSource_Abstract)
 
@@ -562,6 +570,10 @@ private:
     void processFLARMMessagePXCV(const QStringList& arguments); // XCVario
     QString m_FLARMDataBuffer;
 
+    // Buffer for unescaped GDL90 messages, reused between calls to
+    // processGDLMessage()
+    QByteArray m_GDLBuffer;
+
     // Property caches
     bool m_canonical = false;
     QString m_connectivityStatus;
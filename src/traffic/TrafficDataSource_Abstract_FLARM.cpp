@@ -18,7 +18,10 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <QElapsedTimer>
+
 #include "GlobalObject.h"
+#include "Trace.h"
 #include "navigation/Atmosphere.h"
 #include "positioning/PositionProvider.h"
 #include "traffic/FlarmnetDB.h"
@@ -120,6 +123,8 @@ QString extractNMEAMessage(const QString& input)
 
 void Traffic::TrafficDataSource_Abstract::processFLARMData(const QString& data)
 {
+    Trace::Span const span("TrafficDataSource::processFLARMData");
+
     m_FLARMDataBuffer += data;
 
     // Abort if the buffer is small that it cannot possibly contain a single valid NMEA sentence.
@@ -478,9 +483,15 @@ void Traffic::TrafficDataSource_Abstract::processFLARMMessagePFLAA(const QString
             pInfo.setAttribute(QGeoPositionInfo::VerticalSpeed, targetVS);
         }
 
+        QElapsedTimer dispatchTimer;
+        if (m_measureFLARMDispatch)
+        {
+            dispatchTimer.start();
+        }
         emit factorWithoutPosition(TrafficFactorData_DistanceOnly{
             .data = {
                 .alarmLevel = alarmLevel,
+                .alarmLevelFromFLARM = true,
                 .callSign = GlobalObject::flarmnetDB()->registration(targetID),
                 .hDist = hDist,
                 .ID = targetID,
@@ -489,6 +500,10 @@ void Traffic::TrafficDataSource_Abstract::processFLARMMessagePFLAA(const QString
             },
             .coordinate = Positioning::PositionProvider::lastValidCoordinate(),
         });
+        if (m_measureFLARMDispatch)
+        {
+            m_FLARMDispatchTime += dispatchTimer.nsecsElapsed();
+        }
         return;
     }
 
@@ -539,9 +554,15 @@ void Traffic::TrafficDataSource_Abstract::processFLARMMessagePFLAA(const QString
     }
 
     // Construct a traffic object
+    QElapsedTimer dispatchTimer;
+    if (m_measureFLARMDispatch)
+    {
+        dispatchTimer.start();
+    }
     emit factorWithPosition(TrafficFactorData_WithPosition{
         .data = {
             .alarmLevel = alarmLevel,
+            .alarmLevelFromFLARM = true,
             .callSign = GlobalObject::flarmnetDB()->registration(targetID),
             .hDist = hDist,
             .ID = targetID,
@@ -550,6 +571,10 @@ void Traffic::TrafficDataSource_Abstract::processFLARMMessagePFLAA(const QString
         },
         .positionInfo = Positioning::PositionInfo(pInfo, sourceName()),
     });
+    if (m_measureFLARMDispatch)
+    {
+        m_FLARMDispatchTime += dispatchTimer.nsecsElapsed();
+    }
 }
 
 
@@ -802,7 +827,16 @@ void Traffic::TrafficDataSource_Abstract::processFLARMMessagePFLAU(const QString
     const auto &RelativeDistance = arguments[8];
 
     auto wrning = Traffic::Warning(AlarmLevel, RelativeBearing, AlarmType, RelativeVertical, RelativeDistance);
+    QElapsedTimer dispatchTimer;
+    if (m_measureFLARMDispatch)
+    {
+        dispatchTimer.start();
+    }
     emit warning(wrning);
+    if (m_measureFLARMDispatch)
+    {
+        m_FLARMDispatchTime += dispatchTimer.nsecsElapsed();
+    }
 }
 
 
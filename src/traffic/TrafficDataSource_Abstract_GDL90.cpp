@@ -1,5 +1,5 @@
 /***************************************************************************
- *   Copyright (C) 2021-2024 by Stefan Kebekus                             *
+ *   Copyright (C) 2021-2026 by Stefan Kebekus                             *
  *   stefan.kebekus@gmail.com                                              *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
@@ -19,8 +19,10 @@
  ***************************************************************************/
 
 #include <array>
+#include <optional>
 
 #include "GlobalObject.h"
+#include "Trace.h"
 #include "positioning/Geoid.h"
 #include "positioning/PositionProvider.h"
 #include "traffic/TrafficDataSource_Abstract.h"
@@ -28,154 +30,228 @@
 using namespace Qt::Literals::StringLiterals;
 
 
-const std::array<quint16, 256> Crc16Table =
-{ 0, 4129, 8258, 12387, 16516, 20645, 24774, 28903, 33032, 37161,
-  41290, 45419, 49548, 53677, 57806, 61935, 4657, 528, 12915,
-  8786, 21173, 17044, 29431, 25302, 37689, 33560, 45947, 41818,
-  54205, 50076, 62463, 58334, 9314, 13379, 1056, 5121, 25830,
-  29895, 17572, 21637, 42346, 46411, 34088, 38153, 58862, 62927,
-  50604, 54669, 13907, 9842, 5649, 1584, 30423, 26358, 22165,
-  18100, 46939, 42874, 38681, 34616, 63455, 59390, 55197, 51132,
-  18628, 22757, 26758, 30887, 2112, 6241, 10242, 14371, 51660,
-  55789, 59790, 63919, 35144, 39273, 43274, 47403, 23285, 19156,
-  31415, 27286, 6769, 2640, 14899, 10770, 56317, 52188, 64447,
-  60318, 39801, 35672, 47931, 43802, 27814, 31879, 19684, 23749,
-  11298, 15363, 3168, 7233, 60846, 64911, 52716, 56781, 44330,
-  48395, 36200, 40265, 32407, 28342, 24277, 20212, 15891, 11826,
-  7761, 3696, 65439, 61374, 57309, 53244, 48923, 44858, 40793,
-  36728, 37256, 33193, 45514, 41451, 53516, 49453, 61774, 57711,
-  4224, 161, 12482, 8419, 20484, 16421, 28742, 24679, 33721,
-  37784, 41979, 46042, 49981, 54044, 58239, 62302, 689, 4752,
-  8947, 13010, 16949, 21012, 25207, 29270, 46570, 42443, 38312,
-  34185, 62830, 58703, 54572, 50445, 13538, 9411, 5280, 1153,
-  29798, 25671, 21540, 17413, 42971, 47098, 34713, 38840, 59231,
-  63358, 50973, 55100, 9939, 14066, 1681, 5808, 26199, 30326,
-  17941, 22068, 55628, 51565, 63758, 59695, 39368, 35305, 47498,
-  43435, 22596, 18533, 30726, 26663, 6336, 2273, 14466, 10403,
-  52093, 56156, 60223, 64286, 35833, 39896, 43963, 48026, 19061,
-  23124, 27191, 31254, 2801, 6864, 10931, 14994, 64814, 60687,
-  56684, 52557, 48554, 44427, 40424, 36297, 31782, 27655, 23652,
-  19525, 15522, 11395, 7392, 3265, 61215, 65342, 53085, 57212,
-  44955, 49082, 36825, 40952, 28183, 32310, 20053, 24180, 11923,
-  16050, 3793, 7920 };
-
-
-// Static Helper functions
-
-// Decodes the position block that is shared by Ownship Reports (messageID 10)
-// and Traffic Reports (messageID 20), which use the same layout.
-auto pInfoFromOwnshipReport(const QByteArray &decodedData) -> QGeoPositionInfo
+namespace {
+
+// CRC tables for the CRC-CCITT polynomial 0x1021, as used by GDL90. The
+// entry crcTables[k][i] contains the CRC of the byte i, followed by k zero
+// bytes. This allows to process eight bytes per step ("slicing-by-8").
+// The table crcTables[0] is the table "Crc16Table" of the GDL90 specification.
+constexpr auto crcTables = []() {
+    std::array<std::array<quint16, 256>, 8> tables {};
+    for (quint32 i = 0; i < 256; i++)
+    {
+        quint32 crc = i << 8U;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = ((crc & 0x8000U) != 0) ? ((crc << 1U) ^ 0x1021U) : (crc << 1U);
+        }
+        tables[0][i] = static_cast<quint16>(crc);
+    }
+    for (std::size_t k = 1; k < 8; k++)
+    {
+        for (std::size_t i = 0; i < 256; i++)
+        {
+            auto const previous = tables[k-1][i];
+            tables[k][i] = static_cast<quint16>((previous << 8U) ^ tables[0][previous >> 8U]);
+        }
+    }
+    return tables;
+}();
+static_assert(crcTables[0][1] == 4129 && crcTables[0][255] == 7920);
+
+
+// Computes the GDL90 CRC of the data, as defined in the GDL90 specification:
+//
+//   crc = Crc16Table[crc >> 8] ^ (crc << 8) ^ byte
+//
+// This is the remainder of the data, read as a polynomial, modulo 0x11021.
+// For data of length at least two, it equals the standard (non-augmented)
+// CRC-CCITT of all but the last two bytes, XORed with these bytes. The
+// standard CRC is computed eight bytes at a time.
+quint16 crc(const quint8* data, qsizetype size)
+{
+    if (size < 2)
+    {
+        return (size == 1) ? data[0] : 0;
+    }
+
+    quint32 result = 0;
+    const quint8* position = data;
+    const quint8* const end = data + size - 2;
+    while (end - position >= 8)
+    {
+        result = crcTables[7][position[0] ^ (result >> 8U)]
+                 ^ crcTables[6][position[1] ^ (result & 0xFFU)]
+                 ^ crcTables[5][position[2]]
+                 ^ crcTables[4][position[3]]
+                 ^ crcTables[3][position[4]]
+                 ^ crcTables[2][position[5]]
+                 ^ crcTables[1][position[6]]
+                 ^ crcTables[0][position[7]];
+        position += 8;
+    }
+    while (position < end)
+    {
+        result = (crcTables[0][(result >> 8U) ^ *position] ^ (result << 8U)) & 0xFFFFU;
+        position++;
+    }
+    return static_cast<quint16>(result ^ (quint32(end[0]) << 8U) ^ end[1]);
+}
+
+
+// Ownship Reports (messageID 10) and Traffic Reports (messageID 20) share the
+// same 27-byte layout. This struct holds the raw fields, decoded from the
+// message in one pass, before anything is converted to Qt types.
+struct Report
+{
+    quint32 address {0};
+    qint32 latitude {0};
+    qint32 longitude {0};
+    quint16 pressureAltitude {0xFFF};
+    quint16 horizontalVelocity {0xFFF};
+    quint16 verticalVelocity {0x800};
+    quint8 alertStatus {0};
+    quint8 addressType {0};
+    quint8 miscellaneous {0};
+    quint8 NACp {0};
+    quint8 track {0};
+    quint8 emitterCategory {0};
+    std::array<char, 8> callSign {};
+};
+
+
+// Decodes a report. The message must not contain the message ID.
+auto decodeReport(const quint8* data, qsizetype size) -> std::optional<Report>
 {
     // Check message size
-    if (decodedData.size() != 27) {
+    if (size != 27)
+    {
         return {};
     }
 
-    // Find latitude
-    auto la0 = static_cast<quint8>(decodedData.at(4));
-    auto la1 = static_cast<quint8>(decodedData.at(5));
-    auto la2 = static_cast<quint8>(decodedData.at(6));
-    qint32 laInt = (la0 << 16) + (la1 << 8) + la2;
-    if (laInt > 8388607) {
-        laInt -= 16777216;
+    Report report;
+    report.alertStatus = data[0] >> 4U;
+    report.addressType = data[0] & 0x0FU;
+    report.address = (quint32(data[1]) << 16U) | (quint32(data[2]) << 8U) | data[3];
+
+    report.latitude = static_cast<qint32>((quint32(data[4]) << 16U) | (quint32(data[5]) << 8U) | data[6]);
+    if (report.latitude > 8388607)
+    {
+        report.latitude -= 16777216;
     }
-    double const lat = (180.0 / 0x800000) * laInt;
-
-    // Find longitude
-    auto ln0 = static_cast<quint8>(decodedData.at(7));
-    auto ln1 = static_cast<quint8>(decodedData.at(8));
-    auto ln2 = static_cast<quint8>(decodedData.at(9));
-    qint32 lnInt = (ln0 << 16) + (ln1 << 8) + ln2;
-    if (lnInt > 8388607) {
-        lnInt -= 16777216;
+    report.longitude = static_cast<qint32>((quint32(data[7]) << 16U) | (quint32(data[8]) << 8U) | data[9]);
+    if (report.longitude > 8388607)
+    {
+        report.longitude -= 16777216;
     }
-    double const lon = (180.0 / 0x800000) * lnInt;
 
+    report.pressureAltitude = static_cast<quint16>((quint32(data[10]) << 4U) | (data[11] >> 4U));
+    report.miscellaneous = data[11] & 0x0FU;
+    report.NACp = data[12] & 0x0FU;
+    report.horizontalVelocity = static_cast<quint16>((quint32(data[13]) << 4U) | (data[14] >> 4U));
+    report.verticalVelocity = static_cast<quint16>(((data[14] & 0x0FU) << 8U) | data[15]);
+    report.track = data[16];
+    report.emitterCategory = data[17];
+    std::copy(data + 18, data + 26, report.callSign.begin());
+    return report;
+}
+
+
+// Position information contained in a report, without altitude information.
+// Returns an invalid QGeoPositionInfo if the coordinate is invalid.
+auto positionInfo(const Report& report) -> QGeoPositionInfo
+{
     // Construct coordinate, generate position info
-    QGeoCoordinate const coordinate(lat, lon);
-    if (!coordinate.isValid()) {
+    QGeoCoordinate const coordinate((180.0 / 0x800000) * report.latitude,
+                                    (180.0 / 0x800000) * report.longitude);
+    if (!coordinate.isValid())
+    {
         return {};
     }
     QGeoPositionInfo pInfo(coordinate, QDateTime::currentDateTimeUtc());
 
-    // Find Navigation Accuracy Category for Position
-    auto a = static_cast<quint8>(decodedData.at(12)) & 0x0FU;
-    switch (a) {
+    // Navigation Accuracy Category for Position, in meters
+    static const std::array<double, 12> horizontalAccuracy {
+        qQNaN(),
+        Units::Distance::fromNM(10.0).toM(),
+        Units::Distance::fromNM(4.0).toM(),
+        Units::Distance::fromNM(2.0).toM(),
+        Units::Distance::fromNM(1.0).toM(),
+        Units::Distance::fromNM(0.5).toM(),
+        Units::Distance::fromNM(0.3).toM(),
+        Units::Distance::fromNM(0.1).toM(),
+        Units::Distance::fromNM(0.05).toM(),
+        30.0,
+        10.0,
+        3.0
+    };
+    if ((report.NACp >= 1) && (report.NACp < horizontalAccuracy.size()))
+    {
+        pInfo.setAttribute(QGeoPositionInfo::HorizontalAccuracy, horizontalAccuracy.at(report.NACp));
+    }
+
+    // Horizontal speed, if available
+    if (report.horizontalVelocity != 0xFFF)
+    {
+        pInfo.setAttribute(QGeoPositionInfo::GroundSpeed, Units::Speed::fromKN(report.horizontalVelocity).toMPS());
+    }
+
+    // Vertical speed, if available
+    if (report.verticalVelocity != 0x800)
+    {
+        auto const vvInt = (report.verticalVelocity < 0x800) ? int(report.verticalVelocity) : int(report.verticalVelocity) - (1<<12);
+        pInfo.setAttribute(QGeoPositionInfo::VerticalSpeed, Units::Speed::fromFPM(64.0*vvInt).toMPS());
+    }
+
+    // True track, if available
+    if ((report.miscellaneous & 0x03U) == 1)
+    {
+        pInfo.setAttribute(QGeoPositionInfo::Direction, report.track*360.0/256.0);
+    }
+
+    return pInfo;
+}
+
+
+// Traffic type, from the emitter category
+auto trafficType(quint8 emitterCategory) -> Traffic::TrafficFactor_Abstract::Type
+{
+    switch(emitterCategory)
+    {
     case 1:
-        pInfo.setAttribute(QGeoPositionInfo::HorizontalAccuracy, Units::Distance::fromNM(10.0).toM() );
-        break;
     case 2:
-        pInfo.setAttribute(QGeoPositionInfo::HorizontalAccuracy, Units::Distance::fromNM(4.0).toM() );
-        break;
     case 3:
-        pInfo.setAttribute(QGeoPositionInfo::HorizontalAccuracy, Units::Distance::fromNM(2.0).toM() );
-        break;
     case 4:
-        pInfo.setAttribute(QGeoPositionInfo::HorizontalAccuracy, Units::Distance::fromNM(1.0).toM() );
-        break;
     case 5:
-        pInfo.setAttribute(QGeoPositionInfo::HorizontalAccuracy, Units::Distance::fromNM(0.5).toM() );
-        break;
+        return Traffic::TrafficFactor_Abstract::Aircraft;
     case 6:
-        pInfo.setAttribute(QGeoPositionInfo::HorizontalAccuracy, Units::Distance::fromNM(0.3).toM() );
-        break;
+        return Traffic::TrafficFactor_Abstract::Jet;
     case 7:
-        pInfo.setAttribute(QGeoPositionInfo::HorizontalAccuracy, Units::Distance::fromNM(0.1).toM() );
-        break;
-    case 8:
-        pInfo.setAttribute(QGeoPositionInfo::HorizontalAccuracy, Units::Distance::fromNM(0.05).toM() );
-        break;
+        return Traffic::TrafficFactor_Abstract::Copter;
     case 9:
-        pInfo.setAttribute(QGeoPositionInfo::HorizontalAccuracy, 30.0 );
-        break;
+        return Traffic::TrafficFactor_Abstract::Glider;
     case 10:
-        pInfo.setAttribute(QGeoPositionInfo::HorizontalAccuracy, 10.0 );
-        break;
+        return Traffic::TrafficFactor_Abstract::Balloon;
     case 11:
-        pInfo.setAttribute(QGeoPositionInfo::HorizontalAccuracy, 3.0 );
-        break;
+        return Traffic::TrafficFactor_Abstract::Skydiver;
+    case 14:
+        return Traffic::TrafficFactor_Abstract::Drone;
+    case 19:
+        return Traffic::TrafficFactor_Abstract::StaticObstacle;
     default:
-        break;
-    }
-
-    // Find horizontal speed if available
-    auto hh0 = static_cast<quint8>(decodedData.at(13));
-    auto hh1 = static_cast<quint8>(decodedData.at(14));
-    quint32 const hhTmp = (hh0 << 4) + (hh1 >> 4);
-    if (hhTmp != 0xFFF) {
-        Units::Speed const hSpeed = Units::Speed::fromKN(hhTmp);
-        pInfo.setAttribute(QGeoPositionInfo::GroundSpeed, hSpeed.toMPS() );
-    }
-
-    // Find vertical speed if available
-    auto vv0 = static_cast<quint8>(decodedData.at(14)) & 0x0FU;
-    auto vv1 = static_cast<quint8>(decodedData.at(15));
-    qint32 const vvTmp = (vv0 << 8) + vv1;
-    if (vvTmp != 0x800) {
-        Units::Speed vSpeed;
-        if (vvTmp < 0x800) {
-            vSpeed = Units::Speed::fromFPM(64.0*vvTmp);
-        } else {
-            vSpeed = Units::Speed::fromFPM(-64.0*((1<<12)-vvTmp));
-        }
-        pInfo.setAttribute(QGeoPositionInfo::VerticalSpeed, vSpeed.toMPS() );
-    }
-
-    // Find true track if available
-    auto mm0 = static_cast<quint8>(decodedData.at(11)) & 0x03U;
-    if (mm0 == 1)  {
-        auto tt = static_cast<quint8>(decodedData.at(16));
-        pInfo.setAttribute(QGeoPositionInfo::Direction, tt*360.0/256.0 );
+        return Traffic::TrafficFactor_Abstract::Type::unknown;
     }
-
-    return pInfo;
 }
 
+} // namespace
+
 
 // Member functions
 
-void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& rawMessage)
+void Traffic::TrafficDataSource_Abstract::processGDLMessage(QByteArrayView rawMessage)
 {
+    Trace::Span const span("TrafficDataSource::processGDLMessage");
+
 
     //
     // Do some trivial consistency checks
@@ -188,11 +264,17 @@ void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& ra
 
 
     //
-    // Escape character decoding.
+    // Escape character decoding, into the reusable buffer m_GDLBuffer. Once
+    // the buffer has grown to the size of the largest message, no further
+    // memory is allocated.
     //
-    QByteArray message;
+    if (m_GDLBuffer.size() < rawMessage.size())
+    {
+        m_GDLBuffer.resize(rawMessage.size());
+    }
+    auto* buffer = reinterpret_cast<quint8*>(m_GDLBuffer.data());
+    qsizetype size = 0;
     {
-        message.reserve(rawMessage.size());
         bool isEscaped = false;
         for (auto byte : rawMessage)
         {
@@ -203,13 +285,14 @@ void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& ra
             }
             if (isEscaped)
             {
-                message.append( static_cast<char>(static_cast<quint8>(byte) ^ static_cast<quint8>('\x20')) );
+                buffer[size++] = static_cast<quint8>(byte) ^ 0x20U;
                 isEscaped = false;
                 continue;
             }
-            message.append(byte);
+            buffer[size++] = static_cast<quint8>(byte);
         }
-        if (isEscaped) {
+        if (isEscaped || (size < 3))
+        {
             return;
         }
     }
@@ -219,27 +302,19 @@ void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& ra
     // CRC Checksum verification
     //
     {
-        quint16 crc = 0;
-        for (auto byte : message.chopped(2))
-        {
-            crc = Crc16Table.at(crc >> 8U) ^ (crc << 8U) ^ static_cast<quint8>(byte);
-        }
-
-        // Extract CRC checksum from data
-        quint16 savedCRC = 0;
-        savedCRC += static_cast<quint8>( message.at(message.size()-1) );
-        savedCRC = (savedCRC << 8U) + static_cast<quint8>( message.at(message.size()-2) );
-        if (crc != savedCRC)
+        quint16 const savedCRC = (quint16(buffer[size-1]) << 8U) + buffer[size-2];
+        if (crc(buffer, size-2) != savedCRC)
         {
             return;
         }
     }
 
 
-    // Extract Message ID, cut off Message ID and checksum from decodedData
-    auto messageID = static_cast<quint8>( message.at(0) );
-    message.chop(2);
-    message = message.mid(1);
+    // Extract Message ID; the message proper starts after the ID and ends
+    // before the checksum
+    auto messageID = buffer[0];
+    const quint8* message = buffer+1;
+    qsizetype const messageSize = size-3;
 
 
     //
@@ -249,14 +324,14 @@ void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& ra
     // Heartbeat message
     if (messageID == 0)
     {
-        if (message.size() < 3)
+        if (messageSize < 3)
         {
             return;
         }
 
         // Handle runtime errors
         QStringList results;
-        auto status = static_cast<quint8>(message.at(0));
+        auto status = message[0];
         if ((status & 1<<7) == 0)
         {
             results += tr("No GPS reception");
@@ -278,8 +353,14 @@ void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& ra
     // Ownship report
     if (messageID == 10)
     {
+        auto report = decodeReport(message, messageSize);
+        if (!report.has_value())
+        {
+            return;
+        }
+
         // Get position info w/o altitude information
-        auto pInfo = pInfoFromOwnshipReport(message);
+        auto pInfo = positionInfo(*report);
         if (!pInfo.isValid())
         {
             return;
@@ -295,14 +376,11 @@ void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& ra
         }
 
         // Find pressure altitude and update information if need be
-        auto dd0 = static_cast<quint8>(message.at(10));
-        auto dd1 = static_cast<quint8>(message.at(11));
-        quint32 const ddTmp = (dd0 << 4) + (dd1 >> 4);
-        if (ddTmp != 0xFFF)
+        if (report->pressureAltitude != 0xFFF)
         {
             // setPressureAltitude() stores the value and (re)starts the timer that
             // invalidates it once it goes stale.
-            setPressureAltitude(Units::Distance::fromFT(25.0*ddTmp - 1000.0));
+            setPressureAltitude(Units::Distance::fromFT(25.0*report->pressureAltitude - 1000.0));
         }
         else
         {
@@ -320,15 +398,13 @@ void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& ra
     // Ownship geometric altitude
     if (messageID == 11)
     {
-        if (message.size() < 4)
+        if (messageSize < 4)
         {
             return;
         }
 
         // Find geometric alt and apply geoid correction
-        auto dd0 = static_cast<quint8>(message.at(0));
-        auto dd1 = static_cast<quint8>(message.at(1));
-        qint32 ddInt = (dd0 << 8) + dd1;
+        qint32 ddInt = (message[0] << 8) + message[1];
         if (ddInt > 32767)
         {
             ddInt -= 65536;
@@ -341,99 +417,56 @@ void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& ra
         }
 
         // Find geometric figure of merit
-        auto vm0 = static_cast<quint8>(message.at(2)) & 0x7FU;
-        auto vm1 = static_cast<quint8>(message.at(3));
-        auto vmInt = (vm0 << 8) + vm1;
+        auto vmInt = ((message[2] & 0x7FU) << 8) + message[3];
         m_trueAltitudeFOM = Units::Distance::fromM(vmInt);
         m_trueAltitudeTimer.start();
+        return;
     }
 
     // Traffic report
     if (messageID == 20)
     {
+        auto report = decodeReport(message, messageSize);
+        if (!report.has_value())
+        {
+            return;
+        }
+
         // Get position info w/o altitude information
-        auto pInfo = pInfoFromOwnshipReport(message);
+        auto pInfo = positionInfo(*report);
         if (!pInfo.isValid())
         {
             return;
         }
 
-        // Get ID
-        auto id0 = static_cast<quint8>(message.at(0)) & 0x0FU;
-        auto id1 = static_cast<quint8>(message.at(1));
-        auto id2 = static_cast<quint8>(message.at(2));
-        auto id3 = static_cast<quint8>(message.at(3));
         // Build a fixed-width hex ID (address-type nibble + three address bytes),
-        // zero-padding each byte to two digits so that low values are not
+        // zero-padding the address to six digits so that low values are not
         // collapsed (e.g. 0x0A → "0a", not "a"), which would otherwise produce
         // ambiguous, colliding IDs.
-        auto id = QString::number(id0, 16)
-                + QString::number(id1, 16).rightJustified(2, QLatin1Char('0'))
-                + QString::number(id2, 16).rightJustified(2, QLatin1Char('0'))
-                + QString::number(id3, 16).rightJustified(2, QLatin1Char('0'));
+        auto id = QString::number(report->addressType, 16)
+                + QString::number(report->address, 16).rightJustified(6, QLatin1Char('0'));
 
         // Alert
-        auto s0 = static_cast<quint8>(message.at(0)) >> 4;
-        auto alert = (s0 == 1) ? 1 : 0;
+        auto alert = (report->alertStatus == 1) ? 1 : 0;
 
         // Traffic type
-        auto ee = static_cast<quint8>(message.at(17));
-        auto type = TrafficFactor_Abstract::Type::unknown;
-        switch(ee)
-        {
-        case 1:
-        case 2:
-        case 3:
-        case 4:
-        case 5:
-            type = TrafficFactor_Abstract::Aircraft;
-            break;
-        case 6:
-            type = TrafficFactor_Abstract::Jet;
-            break;
-        case 7:
-            type = TrafficFactor_Abstract::Copter;
-            break;
-        case 9:
-            type = TrafficFactor_Abstract::Glider;
-            break;
-        case 10:
-            type = TrafficFactor_Abstract::Balloon;
-            break;
-        case 11:
-            type = TrafficFactor_Abstract::Skydiver;
-            break;
-        case 14:
-            type = TrafficFactor_Abstract::Drone;
-            break;
-        case 19:
-            type = TrafficFactor_Abstract::StaticObstacle;
-            break;
-        default:
-            break;
-        }
+        auto type = trafficType(report->emitterCategory);
 
         // Compute true altitude and altitude distance of traffic if
         // a recent pressure altitude reading for owncraft exists.
         Units::Distance vDist {};
-        if (m_pressureAltitudeTimer.isActive())
+        if (m_pressureAltitudeTimer.isActive() && (report->pressureAltitude != 0xFFF))
         {
-            auto dd0 = static_cast<quint8>(message.at(10));
-            auto dd1 = static_cast<quint8>(message.at(11));
-            quint32 const ddTmp = (dd0 << 4) + (dd1 >> 4);
-            if (ddTmp != 0xFFF)
+            auto trafficPressureAltitude = Units::Distance::fromFT(25.0*report->pressureAltitude - 1000.0);
+            vDist = trafficPressureAltitude - m_pressureAltitude;
+
+            // Compute true altitude of traffic if possible
+            if (m_trueAltitudeTimer.isActive())
             {
-                auto trafficPressureAltitude = Units::Distance::fromFT(25.0*ddTmp - 1000.0);
-                vDist = trafficPressureAltitude - m_pressureAltitude;
-
-                // Compute true altitude of traffic if possible
-                if (m_trueAltitudeTimer.isActive())
-                {
-                    auto trafficTrueAltitude = m_trueAltitude + vDist;
-                    auto coordinate = pInfo.coordinate();
-                    coordinate.setAltitude(trafficTrueAltitude.toM());
-                    pInfo.setCoordinate(coordinate);
-                }
+                auto trafficTrueAltitude = m_trueAltitude + vDist;
+                auto coordinate = pInfo.coordinate();
+                coordinate.setAltitude(trafficTrueAltitude.toM());
+                pInfo.setCoordinate(coordinate);
             }
         }
 
@@ -452,7 +485,7 @@ void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& ra
         }
 
         // Callsign of traffic
-        auto callSign = QString::fromLatin1(message.mid(18,8)).simplified();
+        auto callSign = QString::fromLatin1(report->callSign.data(), qsizetype(report->callSign.size())).simplified();
 
         // Expose data. Targets with the callsign "MODE S" come from a Mode-S
         // transponder, which provides no real position: the receiver synthesises a
@@ -490,4 +523,3 @@ void Traffic::TrafficDataSource_Abstract::processGDLMessage(const QByteArray& ra
     }
 
 }
-
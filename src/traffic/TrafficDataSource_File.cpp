@@ -1,5 +1,5 @@
 /***************************************************************************
- *   Copyright (C) 2021-2024 by Stefan Kebekus                             *
+ *   Copyright (C) 2021-2026 by Stefan Kebekus                             *
  *   stefan.kebekus@gmail.com                                              *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
@@ -19,6 +19,7 @@
  ***************************************************************************/
 
 #include <QRegularExpression>
+#include <QtMath>
 
 #include "traffic/TrafficDataSource_File.h"
 
@@ -29,6 +30,7 @@ Traffic::TrafficDataSource_File::TrafficDataSource_File(bool isCanonical, const
     TrafficDataSource_Abstract(isCanonical, parent), simulatorFile(fileName)
 {
 
+    simulatorTimer.setSingleShot(true);
     connect(&simulatorTimer, &QTimer::timeout, this, &Traffic::TrafficDataSource_File::readFromSimulatorStream);
 
     // Initially, set properties
@@ -51,8 +53,15 @@ void Traffic::TrafficDataSource_File::connectToTrafficReceiver()
     if (simulatorFile.open(QIODevice::ReadOnly)) {
         simulatorTextStream.setDevice(&simulatorFile);
         simulatorTextStream.setEncoding(QStringConverter::Latin1);
-        lastPayload = QString();
-        lastTime = 0;
+        buffer = QString();
+        m_firstTime = -1;
+        m_nextPayload = QString();
+        m_messageCount = 0;
+        m_peakQueueDepth = 0;
+        m_processingTime = 0;
+        m_FLARMDispatchTime = 0;
+        m_measureFLARMDispatch = m_replaySummary;
+        m_replayTimer.start();
         readFromSimulatorStream();
     }
 
@@ -69,7 +78,19 @@ auto Traffic::TrafficDataSource_File::containsFLARMSimulationData(const QString&
         return false;
     }
     QTextStream inStream(&inFile);
+    return containsFLARMSimulationData(inStream);
+}
+
+
+auto Traffic::TrafficDataSource_File::containsFLARMSimulationData(const QByteArray& data) -> bool
+{
+    QTextStream inStream(data);
+    return containsFLARMSimulationData(inStream);
+}
+
 
+auto Traffic::TrafficDataSource_File::containsFLARMSimulationData(QTextStream& inStream) -> bool
+{
     // Check ten lines. These will typically look like
     //
     // "850962 $PFLAU,0,1,2,1,0,180,0,-147,7851*4D"
@@ -101,55 +122,144 @@ void Traffic::TrafficDataSource_File::disconnectFromTrafficReceiver()
 }
 
 
-void Traffic::TrafficDataSource_File::readFromSimulatorStream()
+void Traffic::TrafficDataSource_File::finishReplay()
 {
-    if ((simulatorFile.error() != QFileDevice::NoError) || simulatorTextStream.atEnd())
+    // Pass on the remaining part of the last payload
+    if (!buffer.isEmpty())
     {
-        disconnectFromTrafficReceiver();
-        return;
+        QElapsedTimer processingTimer;
+        if (m_replaySummary)
+        {
+            processingTimer.start();
+        }
+        emit dataReceived(buffer);
+        processFLARMData(buffer);
+        if (m_replaySummary)
+        {
+            m_processingTime += processingTimer.nsecsElapsed();
+        }
+        buffer = QString();
     }
 
-    if (!lastPayload.isEmpty())
+    if (!m_replaySummary)
     {
-        // We simulate problems that we have experienced in the wild, where
-        // Bluetooth adaptors randomly split NMEA messages into smaller
-        // packages. Instead of sending the lastPayload to our FLARM/NMEA
-        // interpreter directly, we split the string up and send only one part
-        // of it, and the next part together with the next message
-        buffer += lastPayload;
-        int const i = buffer.size() / 2.0;
-        emit dataReceived(buffer.left(i));
-        processFLARMData(buffer.left(i));
-        buffer = buffer.mid(i);
+        disconnectFromTrafficReceiver();
+        emit replayFinished({});
+        return;
     }
 
-    // Read line
-    QString line;
-    if (!simulatorTextStream.readLineInto(&line))
+    auto const wallTime = m_replayTimer.nsecsElapsed();
+    auto const messagesPerSecond = (wallTime > 0) ? double(m_messageCount)*1e9/double(wallTime) : 0.0;
+    auto const summary = u"Replay of %1: %2 messages in %3 ms (%4 messages/s), parsing %5 ms, dispatch %6 ms, peak queue depth %7"_s
+                             .arg(simulatorFile.fileName())
+                             .arg(m_messageCount)
+                             .arg(wallTime/1000000)
+                             .arg(qRound(messagesPerSecond))
+                             .arg((m_processingTime-m_FLARMDispatchTime)/1000000)
+                             .arg(m_FLARMDispatchTime/1000000)
+                             .arg(m_peakQueueDepth);
+    qInfo().noquote() << summary;
+
+    disconnectFromTrafficReceiver();
+    emit replayFinished(summary);
+}
+
+
+void Traffic::TrafficDataSource_File::processPayload(const QString& payload)
+{
+    QElapsedTimer processingTimer;
+    if (m_replaySummary)
     {
-        disconnectFromTrafficReceiver();
-        return;
+        processingTimer.start();
     }
 
-    // Set lastPayload, set timer
-    auto tuple = line.split(QStringLiteral(" "));
-    if (tuple.size() < 2)
+    // We simulate problems that we have experienced in the wild, where
+    // Bluetooth adaptors randomly split NMEA messages into smaller
+    // packages. Instead of sending the payload to our FLARM/NMEA
+    // interpreter directly, we split the string up and send only one part
+    // of it, and the next part together with the next message
+    buffer += payload;
+    int const i = buffer.size() / 2.0;
+    emit dataReceived(buffer.left(i));
+    processFLARMData(buffer.left(i));
+    buffer = buffer.mid(i);
+
+    if (m_replaySummary)
     {
-        return;
+        m_processingTime += processingTimer.nsecsElapsed();
     }
-    auto time = tuple[0].toInt();
-    lastPayload = tuple[1];
+    m_messageCount++;
+}
 
-    if (lastTime == 0)
+
+bool Traffic::TrafficDataSource_File::readNextLine()
+{
+    QString line;
+    while (simulatorTextStream.readLineInto(&line))
     {
-        simulatorTimer.setInterval(0);
+        auto tuple = line.split(QStringLiteral(" "));
+        if (tuple.size() < 2)
+        {
+            continue;
+        }
+        m_nextTime = tuple[0].toLongLong();
+        m_nextPayload = tuple[1];
+        if (m_firstTime < 0)
+        {
+            m_firstTime = m_nextTime;
+        }
+        return true;
     }
-    else
+    return false;
+}
+
+
+void Traffic::TrafficDataSource_File::readFromSimulatorStream()
+{
+    QElapsedTimer sliceTimer;
+    sliceTimer.start();
+
+    qsizetype queueDepth = 0;
+    while (true)
     {
-        simulatorTimer.setInterval(time-lastTime);
+        if (simulatorFile.error() != QFileDevice::NoError)
+        {
+            disconnectFromTrafficReceiver();
+            return;
+        }
+
+        // Read the next line, unless it has been read before
+        if (m_nextPayload.isEmpty() && !readNextLine())
+        {
+            m_peakQueueDepth = qMax(m_peakQueueDepth, queueDepth);
+            finishReplay();
+            return;
+        }
+
+        if (m_replaySpeed > 0.0)
+        {
+            // The line is due once the virtual clock has reached its time stamp
+            auto const virtualTime = double(m_replayTimer.nsecsElapsed())*m_replaySpeed/1e6;
+            auto const dueTime = double(m_nextTime-m_firstTime);
+            if (dueTime > virtualTime)
+            {
+                simulatorTimer.start(qCeil((dueTime-virtualTime)/m_replaySpeed));
+                break;
+            }
+        }
+        else if (sliceTimer.elapsed() >= maxSliceDuration)
+        {
+            // Let the event loop run before the next slice
+            simulatorTimer.start(0);
+            break;
+        }
+
+        processPayload(m_nextPayload);
+        m_nextPayload = QString();
+        queueDepth++;
     }
-    simulatorTimer.start();
-    lastTime = time;
+
+    m_peakQueueDepth = qMax(m_peakQueueDepth, queueDepth);
 }
 
 
@@ -20,8 +20,10 @@
 
 #pragma once
 
+#include <QElapsedTimer>
 #include <QFile>
 #include <QTextStream>
+#include <QTimer>
 
 #include "traffic/TrafficDataSource_Abstract.h"
 
@@ -34,6 +36,16 @@ namespace Traffic {
  *
  *  For testing purposes, this class connects to a simulator file with time
  *  stamps and FLARM/NMEA sentences, as provided by FLARM Inc.
+ *
+ *  The replay is driven by a virtual clock that starts at the time stamp of
+ *  the first line and runs replaySpeed times as fast as wall-clock time. If
+ *  replaySpeed is zero, the file is replayed as fast as possible: lines are
+ *  passed to processFLARMData() in slices of at most a few milliseconds, and
+ *  the event loop runs between the slices. In either case, the lines reach
+ *  the parser in the same order and with the same splitting, so that
+ *  replays are reproducible. At the end of the file, the class emits the
+ *  signal replayFinished() with statistics that describe the throughput of
+ *  the traffic pipeline.
  */
 class TrafficDataSource_File : public TrafficDataSource_Abstract {
     Q_OBJECT
@@ -60,6 +72,14 @@ public:
      */
     static auto containsFLARMSimulationData(const QString& fileName) -> bool;
 
+    /*! \brief Checks if data contains FLARM simulation data
+     *
+     *  @param data Data to be checked, typically the beginning of a file
+     *
+     *  @returns True if the data is likely to contain FLARM simulation data
+     */
+    static auto containsFLARMSimulationData(const QByteArray& data) -> bool;
+
     /*! \brief Getter function for the property with the same name
      *
      * @returns Property dataFormat
@@ -87,6 +107,53 @@ public:
         return tr("Simulator file %1").arg(simulatorFile.fileName());
     }
 
+    /*! \brief Speed of the replay
+     *
+     *  A value of 1.0 replays the file in real time, a value of N replays it
+     *  N times as fast. A value of zero replays the file as fast as possible.
+     *  Changes take effect when the replay is started the next time.
+     *
+     *  @returns Speed of the replay
+     */
+    [[nodiscard]] double replaySpeed() const { return m_replaySpeed; }
+
+    /*! \brief Setter function for the replay speed
+     *
+     *  @param speed New replay speed, see replaySpeed(). Negative values are
+     *  treated as zero.
+     */
+    void setReplaySpeed(double speed) { m_replaySpeed = qMax(speed, 0.0); }
+
+    /*! \brief Whether a summary of the replay is requested
+     *
+     *  If true, the class measures the time spent in parsing and in
+     *  dispatching traffic data during the replay, logs a summary at the end
+     *  of the file and passes it on with replayFinished(). Measuring costs
+     *  time, so this is off by default. Changes take effect when the replay
+     *  is started the next time.
+     *
+     *  @returns True if a summary is requested
+     */
+    [[nodiscard]] bool replaySummary() const { return m_replaySummary; }
+
+    /*! \brief Setter function for replaySummary
+     *
+     *  @param enabled New value of replaySummary
+     */
+    void setReplaySummary(bool enabled) { m_replaySummary = enabled; }
+
+signals:
+    /*! \brief Notification that the replay has reached the end of the file
+     *
+     *  @param summary Human-readable summary of the replay, with the number
+     *  of messages per second, the time spent in parsing and in dispatching
+     *  traffic data to the receivers, and the peak queue depth. The peak
+     *  queue depth is the maximal number of lines that were due at the same
+     *  time and were handed to the parser in one go. The summary is empty
+     *  unless replaySummary is true.
+     */
+    void replayFinished(const QString& summary);
+
 public slots:
     /*! \brief Start attempt to connect to traffic receiver
      *
@@ -103,9 +170,8 @@ public slots:
     void disconnectFromTrafficReceiver() override;
 
 private slots:
-    // Read one line from the simulator file's text stream and passes the string
-    // on to processFLARMData.  Sets up a timer to read the next line in due
-    // time.
+    // Reads lines from the simulator file's text stream and passes those that
+    // are due on to processFLARMData. Sets up a timer to continue in due time.
     void readFromSimulatorStream();
 
     // Update the properties "errorString" and "connectivityStatus".
@@ -114,15 +180,42 @@ private slots:
 private:
     Q_DISABLE_COPY_MOVE(TrafficDataSource_File)
 
+    // Checks the next eleven lines of the stream for FLARM simulation data
+    static auto containsFLARMSimulationData(QTextStream& inStream) -> bool;
+
+    // Reads the next line with time stamp and payload into m_nextTime and
+    // m_nextPayload. Returns false at the end of the file.
+    bool readNextLine();
+
+    // Passes the payload on to processFLARMData, and updates the statistics
+    void processPayload(const QString& payload);
+
+    // Emits replayFinished() and disconnects
+    void finishReplay();
+
+    // Maximal duration of a slice when replaying as fast as possible, in ms
+    static constexpr qint64 maxSliceDuration = 10;
+
     QTextStream textStream;
 
     // Simulator related members
     QFile simulatorFile;
     QTextStream simulatorTextStream;
     QTimer simulatorTimer;
-    int lastTime = 0;
-    QString lastPayload;
     QString buffer;
+
+    // Virtual clock
+    double m_replaySpeed {1.0};
+    bool m_replaySummary {false};
+    QElapsedTimer m_replayTimer;
+    qint64 m_firstTime {-1};
+    qint64 m_nextTime {0};
+    QString m_nextPayload;
+
+    // Statistics
+    qsizetype m_messageCount {0};
+    qsizetype m_peakQueueDepth {0};
+    qint64 m_processingTime {0}; // nanoseconds
 };
 
 } // namespace Traffic
@@ -116,12 +116,21 @@ void Traffic::TrafficDataSource_Udp::onReadyRead()
         }
         else
         {
-            // Split data into raw messages
-            for (const auto &rawMessage : data.split(0x7e))
-            {                
+            // Split data into raw messages, without copying them
+            QByteArrayView const dataView(data);
+            qsizetype begin = 0;
+            while (begin < dataView.size())
+            {
+                auto end = dataView.indexOf('\x7e', begin);
+                if (end < 0)
+                {
+                    end = dataView.size();
+                }
+                auto rawMessage = dataView.sliced(begin, end-begin);
+                begin = end+1;
                 if (!rawMessage.isEmpty())
                 {
-                    emit dataReceived("0x" + rawMessage.toHex());
+                    emit dataReceived("0x" + QByteArray::fromRawData(rawMessage.data(), rawMessage.size()).toHex());
                     processGDLMessage(rawMessage);
                 }
             }
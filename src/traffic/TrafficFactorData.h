@@ -47,6 +47,9 @@ struct TrafficFactorData {
     /*! \brief Alarm level, in the range 0…3 */
     int alarmLevel = 0;
 
+    /*! \brief True if the alarm level was computed by a FLARM device */
+    bool alarmLevelFromFLARM = false;
+
     /*! \brief Call sign, or an empty string if unknown */
     QString callSign;
 
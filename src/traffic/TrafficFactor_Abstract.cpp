@@ -153,6 +153,7 @@ void Traffic::TrafficFactor_Abstract::updateFrom(const TrafficFactorData& data)
         return;
     }
 
+    m_alarmLevelFromFLARM = data.alarmLevelFromFLARM;
     setAlarmLevel(data.alarmLevel);
     if (m_callSign.value().isEmpty())
     {
@@ -172,6 +173,8 @@ void Traffic::TrafficFactor_Abstract::updateFrom(const TrafficFactorData& data)
 
 void Traffic::TrafficFactor_Abstract::replaceBy(const TrafficFactorData& data)
 {
+    m_predictedAlarmLevel = 0;
+    m_alarmLevelFromFLARM = data.alarmLevelFromFLARM;
     setAlarmLevel(data.alarmLevel);
     setCallSign(data.callSign);
     setHDist(data.hDist);
@@ -141,7 +141,8 @@ public:
      *  level is an integer in the range 0 (no alarm), …, 3 (maximal alarm). The
      *  values are not computed by this class, but reported by the traffic
      *  receiver that reports the traffic. The precise meaning depends on the
-     *  type of traffic receiver used.
+     *  type of traffic receiver used. If a higher alarm level has been set
+     *  with setPredictedAlarmLevel(), this property holds that level instead.
      *
      *  FLARM
      *
@@ -427,7 +428,8 @@ public:
             return;
         }
         startLifetime();
-        m_alarmLevel = newAlarmLevel;
+        m_reportedAlarmLevel = newAlarmLevel;
+        m_alarmLevel = qMax(m_reportedAlarmLevel, m_predictedAlarmLevel);
     }
 
     /*! \brief Setter function for property with the same name
@@ -559,6 +561,32 @@ protected:
      */
     [[nodiscard]] bool isSameFactorAs(const TrafficFactorData& data) const;
 
+    /*! \brief Check whether the alarm level was computed by a FLARM device
+     *
+     *  FLARM devices compute alarm levels themselves, with more information
+     *  than the app has. Predicted alarm levels are not set for such traffic
+     *  factors.
+     *
+     *  @returns True if the last data record came from a FLARM device
+     */
+    [[nodiscard]] bool alarmLevelFromFLARM() const { return m_alarmLevelFromFLARM; }
+
+    /*! \brief Set alarm level predicted by this app
+     *
+     *  This method is used for alarm levels that are computed by the app
+     *  rather than reported by the traffic receiver. The property alarmLevel
+     *  holds the maximum of the reported and the predicted level. Unlike
+     *  setAlarmLevel(), this method does not restart the lifetime. The
+     *  predicted level is reset to zero by replaceBy().
+     *
+     *  @param newPredictedAlarmLevel Predicted alarm level, in the range 0…3
+     */
+    void setPredictedAlarmLevel(int newPredictedAlarmLevel)
+    {
+        m_predictedAlarmLevel = newPredictedAlarmLevel;
+        m_alarmLevel = qMax(m_reportedAlarmLevel, m_predictedAlarmLevel);
+    }
+
 private:
     Q_DISABLE_COPY_MOVE(TrafficFactor_Abstract)
 
@@ -577,6 +605,14 @@ private:
     QProperty<QString> m_typeString;
     QProperty<Units::Distance> m_vDist;
 
+    // Alarm levels reported by the traffic receiver and predicted by the app.
+    // The property alarmLevel holds the maximum of the two.
+    int m_reportedAlarmLevel {0};
+    int m_predictedAlarmLevel {0};
+
+    // True if m_reportedAlarmLevel was computed by a FLARM device
+    bool m_alarmLevelFromFLARM {false};
+
     // Timer for timeout. Traffic objects become invalid if their data has not
     // been refreshed for longer than "lifetime". The "valid" binding reads
     // lifetimeCounter.isActive(); QTimer notifies that (bindable) property when
@@ -23,6 +23,7 @@
 #include "positioning/PositionInfo.h"
 #include "traffic/TrafficFactor_Abstract.h"
 #include "traffic/TrafficFactorData.h"
+#include "units/Timespan.h"
 
 
 namespace Traffic {
@@ -123,6 +124,34 @@ public:
         // stale (true), gliding the icon across the map instead of snapping.
         TrafficFactor_Abstract::replaceBy(data.data);
         setPositionInfo(data.positionInfo);
+        m_timeToCPA = Units::Timespan();
+        m_hDistCPA = Units::Distance();
+        m_vDistCPA = Units::Distance();
+    }
+
+    /*! \brief Set data about the closest point of approach
+     *
+     *  This method is called by the owner of this class (=
+     *  TrafficDataProvider) at regular intervals, with data computed by
+     *  CollisionPredictor. It sets the properties timeToCPA, hDistCPA and
+     *  vDistCPA, and raises the alarm level to the predicted level if that
+     *  is higher than the level reported by the traffic receiver.
+     *
+     *  @param timeToCPA Time to the closest point of approach
+     *
+     *  @param hDistCPA Horizontal distance at the closest point of approach
+     *
+     *  @param vDistCPA Vertical distance at the closest point of approach
+     *
+     *  @param predictedAlarmLevel Predicted alarm level, in the range 0…3
+     */
+    void setCollisionPrediction(Units::Timespan timeToCPA, Units::Distance hDistCPA, Units::Distance vDistCPA, int predictedAlarmLevel)
+    {
+        const QScopedPropertyUpdateGroup updateGroup;
+        m_timeToCPA = timeToCPA;
+        m_hDistCPA = hDistCPA;
+        m_vDistCPA = vDistCPA;
+        setPredictedAlarmLevel(predictedAlarmLevel);
     }
 
 
@@ -221,6 +250,64 @@ public:
      */
     void setPositionInfo(const Positioning::PositionInfo& newPositionInfo) {m_positionInfo = newPositionInfo;}
 
+    /*! \brief Time to the closest point of approach
+     *
+     *  This property holds the time until the traffic comes closest to the
+     *  own aircraft, if both continue in a straight line. It is zero if the
+     *  traffic is moving away, and invalid if the own position is unknown.
+     *  The property is set by setCollisionPrediction().
+     */
+    Q_PROPERTY(Units::Timespan timeToCPA READ timeToCPA BINDABLE bindableTimeToCPA)
+
+    /*! \brief Getter method for property with the same name
+     *
+     *  @returns Property timeToCPA
+     */
+    [[nodiscard]] Units::Timespan timeToCPA() const {return m_timeToCPA.value();}
+
+    /*! \brief Getter method for property with the same name
+     *
+     *  @returns Property timeToCPA
+     */
+    [[nodiscard]] QBindable<Units::Timespan> bindableTimeToCPA() const {return &m_timeToCPA;}
+
+    /*! \brief Horizontal distance at the closest point of approach
+     *
+     *  The property is set by setCollisionPrediction().
+     */
+    Q_PROPERTY(Units::Distance hDistCPA READ hDistCPA BINDABLE bindableHDistCPA)
+
+    /*! \brief Getter method for property with the same name
+     *
+     *  @returns Property hDistCPA
+     */
+    [[nodiscard]] Units::Distance hDistCPA() const {return m_hDistCPA.value();}
+
+    /*! \brief Getter method for property with the same name
+     *
+     *  @returns Property hDistCPA
+     */
+    [[nodiscard]] QBindable<Units::Distance> bindableHDistCPA() const {return &m_hDistCPA;}
+
+    /*! \brief Vertical distance at the closest point of approach
+     *
+     *  This property is positive if the traffic will be above the own
+     *  aircraft. The property is set by setCollisionPrediction().
+     */
+    Q_PROPERTY(Units::Distance vDistCPA READ vDistCPA BINDABLE bindableVDistCPA)
+
+    /*! \brief Getter method for property with the same name
+     *
+     *  @returns Property vDistCPA
+     */
+    [[nodiscard]] Units::Distance vDistCPA() const {return m_vDistCPA.value();}
+
+    /*! \brief Getter method for property with the same name
+     *
+     *  @returns Property vDistCPA
+     */
+    [[nodiscard]] QBindable<Units::Distance> bindableVDistCPA() const {return &m_vDistCPA;}
+
     /*! \brief Uncertainty radius
      *
      *  If the last position update is less than 30s ago, this property holds
@@ -265,6 +352,9 @@ private:
     QProperty<QGeoCoordinate> m_extrapolatedCoordinate;
     QProperty<Units::Angle> m_extrapolatedTrueTrack;
     QProperty<Units::Distance> m_uncertaintyRadius;
+    QProperty<Units::Timespan> m_timeToCPA;
+    QProperty<Units::Distance> m_hDistCPA;
+    QProperty<Units::Distance> m_vDistCPA;
     QProperty<QString> m_icon;
     Q_OBJECT_BINDABLE_PROPERTY(Traffic::TrafficFactor_WithPosition, Positioning::PositionInfo, m_positionInfo, &Traffic::TrafficFactor_WithPosition::positionInfoChanged);
 };
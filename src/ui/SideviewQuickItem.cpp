@@ -1,5 +1,5 @@
 /***************************************************************************
- *   Copyright (C) 2025 by Simon Schneider, Stefan Kebekus                 *
+ *   Copyright (C) 2025-2026 by Simon Schneider, Stefan Kebekus            *
  *   stefan.kebekus@gmail.com                                              *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
@@ -18,9 +18,16 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <QSGFlatColorMaterial>
+#include <QSGGeometryNode>
+#include <QSGSimpleRectNode>
+#include <QtMath>
+#include <cmath>
+
 #include "GeoMapProvider.h"
 #include "PositionProvider.h"
 #include "SideviewQuickItem.h"
+#include "Trace.h"
 #include "weather/WeatherDataProvider.h"
 
 using namespace Qt::Literals::StringLiterals;
@@ -31,20 +38,232 @@ QStringList airspaceCategories = {"ATZ", "TMZ", "RMZ", "TIA", "TIZ", "NRA", "DNG
 Ui::SideviewQuickItem::SideviewQuickItem(QQuickItem *parent)
     : QQuickItem(parent), m_baroCache(new Navigation::BaroCache(this))
 {
+    setFlag(ItemHasContents, true);
+
     m_timer.setSingleShot(true);
     connect(&m_timer, &QTimer::timeout, this, &Ui::SideviewQuickItem::updateProperties);
     connect(GlobalObject::weatherDataProvider(), &Weather::WeatherDataProvider::QNHInfoChanged, this, &Ui::SideviewQuickItem::updateProperties);
 
+    // Samples are invalid once terrain maps or airspaces change
+    connect(GlobalObject::geoMapProvider(), &GeoMaps::GeoMapProvider::terrainMapTilesChanged, this, [this]() {
+        resetSamples();
+        updateProperties();
+    });
+    notifiers.push_back(GlobalObject::geoMapProvider()->bindableAirspaces().addNotifier([this]() {
+        resetSamples();
+        updateProperties();
+    }));
+
     notifiers.push_back(bindableHeight().addNotifier([this]() {updateProperties();}));
     notifiers.push_back(bindableWidth().addNotifier([this]() {updateProperties();}));
     notifiers.push_back(GlobalObject::positionProvider()->bindablePositionInfo().addNotifier([this]() {updateProperties();}));
     notifiers.push_back(GlobalObject::positionProvider()->bindablePressureAltitude().addNotifier([this]() {updateProperties();}));
     notifiers.push_back(m_pixelPer10km.addNotifier([this]() {updateProperties();}));
+    notifiers.push_back(m_skyColor.addNotifier([this]() {update();}));
+    notifiers.push_back(m_terrainFillColor.addNotifier([this]() {update();}));
     updateProperties();   
 }
 
+QSGNode* Ui::SideviewQuickItem::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* /*updatePaintNodeData*/)
+{
+    Trace::Span const span("SideviewQuickItem::updatePaintNode");
+
+    // The node tree consists of a rectangle for the sky, with a geometry node
+    // for the terrain as its child. Like the QML shape used before, the
+    // terrain has no outline.
+    auto* skyNode = static_cast<QSGSimpleRectNode*>(oldNode);
+    QSGGeometryNode* fillNode = nullptr;
+    if (skyNode == nullptr)
+    {
+        skyNode = new QSGSimpleRectNode();
+
+        fillNode = new QSGGeometryNode();
+        fillNode->setGeometry(new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0));
+        fillNode->geometry()->setDrawingMode(QSGGeometry::DrawTriangleStrip);
+        fillNode->setMaterial(new QSGFlatColorMaterial());
+        fillNode->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+        skyNode->appendChildNode(fillNode);
+    }
+    else
+    {
+        fillNode = static_cast<QSGGeometryNode*>(skyNode->firstChild());
+    }
+
+    // Sky
+    skyNode->setRect(boundingRect());
+    skyNode->setColor(m_skyColor.value());
+
+    // Terrain, as a triangle strip between the profile and the bottom edge
+    auto* fillGeometry = fillNode->geometry();
+    fillGeometry->allocate(2*static_cast<int>(m_terrain.size()));
+    auto* fillVertices = fillGeometry->vertexDataAsPoint2D();
+    for(qsizetype i = 0; i < m_terrain.size(); i++)
+    {
+        fillVertices[2*i].set(static_cast<float>(m_terrain[i].x()), static_cast<float>(m_terrain[i].y()));
+        fillVertices[2*i+1].set(static_cast<float>(m_terrain[i].x()), static_cast<float>(height()));
+    }
+    static_cast<QSGFlatColorMaterial*>(fillNode->material())->setColor(m_terrainFillColor.value());
+    fillNode->markDirty(QSGNode::DirtyGeometry | QSGNode::DirtyMaterial);
+
+    return skyNode;
+}
+
+Ui::SideviewQuickItem::Sample Ui::SideviewQuickItem::sample(qsizetype index) const
+{
+    Sample result;
+    result.coordinate = m_anchor.atDistanceAndAzimuth(static_cast<double>(index)*m_sampleSpacing, m_anchorTrack);
+    for(qsizetype i = 0; i < m_candidateAirspaces.size(); i++)
+    {
+        if (m_candidateAirspaces[i].polygon().contains(result.coordinate))
+        {
+            result.airspaces.append(i);
+        }
+    }
+    return result;
+}
+
+void Ui::SideviewQuickItem::updateSamples(qsizetype first, qsizetype last)
+{
+    // Drop samples that are no longer visible
+    while (!m_samples.isEmpty() && (m_firstSample < first))
+    {
+        m_samples.removeFirst();
+        m_firstSample++;
+    }
+    while (!m_samples.isEmpty() && (m_firstSample + m_samples.size() - 1 > last))
+    {
+        m_samples.removeLast();
+    }
+    if (m_samples.isEmpty())
+    {
+        m_firstSample = first;
+    }
+
+    // Compute samples for the newly exposed parts of the view, and look up
+    // their elevations in one batch
+    QList<Sample> newSamples;
+    for(auto index = first; index < m_firstSample; index++)
+    {
+        newSamples.append(sample(index));
+    }
+    auto const numPrepended = newSamples.size();
+    for(auto index = m_firstSample + m_samples.size(); index <= last; index++)
+    {
+        newSamples.append(sample(index));
+    }
+    if (newSamples.isEmpty())
+    {
+        return;
+    }
+
+    QList<QGeoCoordinate> coordinates;
+    coordinates.reserve(newSamples.size());
+    for(const auto& newSample : std::as_const(newSamples))
+    {
+        coordinates.append(newSample.coordinate);
+    }
+    auto const elevations = GlobalObject::geoMapProvider()->terrainElevationsAMSL(coordinates);
+    for(qsizetype i = 0; i < newSamples.size(); i++)
+    {
+        newSamples[i].elevation = elevations[i];
+    }
+
+    m_samples = newSamples.mid(0, numPrepended) + m_samples + newSamples.mid(numPrepended);
+    m_firstSample = first;
+}
+
+QVariantMap Ui::SideviewQuickItem::airspaceBands(const QList<GeoMaps::Airspace>& airspaces,
+                                                 const QList<Sample>& samples,
+                                                 const QList<double>& xCoordinates,
+                                                 const QList<Units::Distance>& elevations,
+                                                 Units::Pressure QNH,
+                                                 Units::Distance ownshipGeometricAltitude,
+                                                 Units::Distance ownshipPressureAltitude,
+                                                 const std::function<double(Units::Distance)>& altToYCoordinate)
+{
+    Trace::Span const span("SideviewQuickItem::airspaceBands");
+
+    QVector<QPolygonF> airspacePolygonsA;
+    QVector<QPolygonF> airspacePolygonsCTR;
+    QVector<QPolygonF> airspacePolygonsR;
+    QVector<QPolygonF> airspacePolygonsRMZ;
+    QVector<QPolygonF> airspacePolygonsNRA;
+    QVector<QPolygonF> airspacePolygonsPJE;
+    QVector<QPolygonF> airspacePolygonsTMZ;
+    QList<QPointF> upper;
+    QList<QPointF> lower;
+    for(qsizetype j = 0; j < airspaces.size(); j++)
+    {
+        const auto& airspace = airspaces[j];
+        for(int i=0; i < xCoordinates.size(); i++)
+        {
+            auto x = xCoordinates[i];
+            if ((i != xCoordinates.size()-1) && samples[i].airspaces.contains(j))
+            {
+                auto u = airspace.estimatedUpperBoundMSL(elevations[i], QNH, ownshipGeometricAltitude, ownshipPressureAltitude);
+                auto l = airspace.estimatedLowerBoundMSL(elevations[i], QNH, ownshipGeometricAltitude, ownshipPressureAltitude);
+                if (l < u)
+                {
+                    upper << QPointF(x, altToYCoordinate(u));
+                    lower << QPointF(x, altToYCoordinate(l));
+                    continue;
+                }
+            }
+
+            if (!upper.isEmpty())
+            {
+                std::reverse(lower.begin(), lower.end());
+                QPolygonF polygon(upper + lower);
+                polygon << upper[0];
+                if ((airspace.CAT() == u"A"_s) || (airspace.CAT() == u"B"_s) || (airspace.CAT() == u"C"_s) || (airspace.CAT() == u"D"_s))
+                {
+                    airspacePolygonsA << polygon;
+                }
+                if (airspace.CAT() == u"CTR"_s)
+                {
+                    airspacePolygonsCTR << polygon;
+                }
+                if ((airspace.CAT() == u"R"_s) || (airspace.CAT() == u"P"_s) || (airspace.CAT() == u"DNG"_s))
+                {
+                    airspacePolygonsR << polygon;
+                }
+                if ((airspace.CAT() == u"ATZ"_s) || (airspace.CAT() == u"RMZ"_s) || (airspace.CAT() == u"TIA"_s) || (airspace.CAT() == u"TIZ"_s))
+                {
+                    airspacePolygonsRMZ << polygon;
+                }
+                if (airspace.CAT() == u"NRA"_s)
+                {
+                    airspacePolygonsNRA << polygon;
+                }
+                if ((airspace.CAT() == u"PJE"_s) || (airspace.CAT() == u"SUA"_s))
+                {
+                    airspacePolygonsPJE << polygon;
+                }
+                if (airspace.CAT() == u"TMZ"_s)
+                {
+                    airspacePolygonsTMZ << polygon;
+                }
+                upper.clear();
+                lower.clear();
+            }
+        }
+    }
+
+    QVariantMap result;
+    result[u"A"_s] = QVariant::fromValue(airspacePolygonsA);
+    result[u"CTR"_s] = QVariant::fromValue(airspacePolygonsCTR);
+    result[u"R"_s] = QVariant::fromValue(airspacePolygonsR);
+    result[u"RMZ"_s] = QVariant::fromValue(airspacePolygonsRMZ);
+    result[u"NRA"_s] = QVariant::fromValue(airspacePolygonsNRA);
+    result[u"PJE"_s] = QVariant::fromValue(airspacePolygonsPJE);
+    result[u"TMZ"_s] = QVariant::fromValue(airspacePolygonsTMZ);
+    return result;
+}
+
 void Ui::SideviewQuickItem::updateProperties()
 {
+    Trace::Span const span("SideviewQuickItem::updateProperties");
+
     // Rate-limiting code. Ensure that this expensive method runs at most every minimumUpdateInterval_ms and not more often.
     if (m_timer.isActive())
     {
@@ -69,7 +288,8 @@ void Ui::SideviewQuickItem::updateProperties()
     m_ownshipPosition = {-100, -100};
     m_track = QString();
     m_error = QString();
-    m_terrain = QPolygonF();
+    m_terrain.clear();
+    update();
 
     QVariantMap newAirspaces;
     const QVector<QPolygonF> empty;
@@ -179,36 +399,65 @@ void Ui::SideviewQuickItem::updateProperties()
     }
 
     //
-    // Compute array of x-coordinates in pixels.
+    // Find the samples that are visible. Start over with a new anchor point if
+    // scale or track have changed, if the aircraft has left the line through
+    // the anchor point, or if it has moved further than the visible width.
     //
-    const int step = 4.0;
-    QList<int> xCoordinates;
-    xCoordinates.reserve( qRound((width()+20)/step) );
-    for(int x = -10; x <= width()+10; x += step)
+    const double step = 4.0;
+    auto const sampleSpacing = 10000.0*step/m_pixelPer10km.value();
+    auto const visibleDistance = 10000.0*width()/m_pixelPer10km.value();
+    double alongTrack = 0.0;
+    if (m_anchor.isValid())
     {
-        xCoordinates << x;
+        auto const distance = m_anchor.distanceTo(ownshipCoordinate);
+        auto const angle = qDegreesToRadians(m_anchor.azimuthTo(ownshipCoordinate) - m_anchorTrack);
+        alongTrack = distance*qCos(angle);
+        auto const crossTrack = distance*qSin(angle);
+        auto const trackDifference = qAbs(std::remainder(ownshipTrack.toDEG() - m_anchorTrack, 360.0));
+        if ((sampleSpacing != m_sampleSpacing) || (trackDifference > 1.0) || (qAbs(crossTrack) > 0.5*sampleSpacing) || (qAbs(alongTrack) > visibleDistance))
+        {
+            resetSamples();
+            alongTrack = 0.0;
+        }
     }
-
-    //
-    // For each x-coordinate, compute the associated QGeoCoordinate
-    //
-    QList<QGeoCoordinate> geoCoordinates;
-    geoCoordinates.reserve(xCoordinates.size());
-    for(auto x : std::as_const(xCoordinates))
+    auto pixelToDistance = [this](double x) {
+        return 10000.0*(x-0.2*width())/m_pixelPer10km.value();
+    };
+    if (!m_anchor.isValid())
     {
-        auto dist = 10000.0*(x-0.2*width())/(m_pixelPer10km.value());
-        auto geoCoordinate = ownshipCoordinate.atDistanceAndAzimuth(dist, ownshipTrack.toDEG());
-        geoCoordinates << geoCoordinate;
+        m_anchor = QGeoCoordinate(ownshipCoordinate.latitude(), ownshipCoordinate.longitude());
+        m_anchorTrack = ownshipTrack.toDEG();
+        m_sampleSpacing = sampleSpacing;
+
+        // Find airspaces along the line, for all positions of the aircraft
+        // until the next anchor point is chosen
+        auto const start = m_anchor.atDistanceAndAzimuth(pixelToDistance(-10)-visibleDistance-sampleSpacing, m_anchorTrack);
+        auto const end = m_anchor.atDistanceAndAzimuth(pixelToDistance(width()+10)+visibleDistance+sampleSpacing, m_anchorTrack);
+        QGeoRectangle const corridor(QList({start, m_anchor, end}));
+        m_candidateAirspaces.clear();
+        auto airspaces = GlobalObject::geoMapProvider()->airspaces();
+        for(const auto& airspace : std::as_const(airspaces))
+        {
+            if (airspaceCategories.contains(airspace.CAT()) && airspace.polygon().boundingGeoRectangle().intersects(corridor))
+            {
+                m_candidateAirspaces << airspace;
+            }
+        }
     }
+    updateSamples(qFloor((alongTrack+pixelToDistance(-10))/m_sampleSpacing), qCeil((alongTrack+pixelToDistance(width()+10))/m_sampleSpacing));
 
-    // For each geoCoordinate, compute the elevation
+    // For each sample, compute the x-coordinate in pixels and the elevation
+    QList<double> xCoordinates;
+    xCoordinates.reserve(m_samples.size());
     QList<Units::Distance> elevations;
-    elevations.reserve(geoCoordinates.size());
+    elevations.reserve(m_samples.size());
     Units::Distance minElevation = ownshipTerrainElevation;
     Units::Distance maxElevation = ownshipTerrainElevation;
-    for(const auto& geoCoordinate : std::as_const(geoCoordinates))
+    for(qsizetype i = 0; i < m_samples.size(); i++)
     {
-        auto elevation = GlobalObject::geoMapProvider()->terrainElevationAMSL(geoCoordinate);
+        xCoordinates << 0.2*width() + ((m_firstSample+i)*m_sampleSpacing - alongTrack)*m_pixelPer10km.value()/10000.0;
+
+        auto elevation = m_samples[i].elevation;
         if (!elevation.isFinite())
         {
             elevation = Units::Distance::fromM(0.0);
@@ -263,104 +512,14 @@ void Ui::SideviewQuickItem::updateProperties()
     }
 
     // Terrain
-    QPolygonF polygon;
-    polygon.reserve( elevations.size()+4 );
+    m_terrain.clear();
+    m_terrain.reserve(elevations.size());
     for(qsizetype i = 0; i < elevations.size(); i++)
     {
-        polygon << QPointF(xCoordinates[i], altToYCoordinate(elevations[i]));
+        m_terrain << QPointF(xCoordinates[i], altToYCoordinate(elevations[i]));
     }
-    polygon  << QPointF(width(), height()+2000) << QPointF(-20, height()+2000);
-    m_terrain = polygon;
-    //qWarning() << "SideviewQuickItem terrain" << m_elapsedTimer.elapsed();
+    update();
 
     // Airspaces
-    auto airspaces = GlobalObject::geoMapProvider()->airspaces();
-    QVector<QPolygonF> airspacePolygonsA;
-    QVector<QPolygonF> airspacePolygonsCTR;
-    QVector<QPolygonF> airspacePolygonsR;
-    QVector<QPolygonF> airspacePolygonsRMZ;
-    QVector<QPolygonF> airspacePolygonsNRA;
-    QVector<QPolygonF> airspacePolygonsPJE;
-    QVector<QPolygonF> airspacePolygonsTMZ;
-    QList<QPointF> upper;
-    QList<QPointF> lower;
-    QGeoRectangle const viewBBox(QList({geoCoordinates.constFirst(), geoCoordinates.constLast()}));
-    for(const auto& airspace : std::as_const(airspaces))
-    {
-        if (!airspaceCategories.contains(airspace.CAT()))
-        {
-            continue;
-        }
-        auto bbox = airspace.polygon().boundingGeoRectangle();
-        if (!bbox.intersects(viewBBox))
-        {
-            continue;
-        }
-
-        auto airspacePolygon = airspace.polygon();
-        for(int i=0; i < xCoordinates.size(); i++)
-        {
-            auto x = xCoordinates[i];
-            const auto& geoCoordinate = geoCoordinates[i];
-            if ((i != xCoordinates.size()-1) && airspacePolygon.contains(geoCoordinate))
-            {
-                auto u = airspace.estimatedUpperBoundMSL(elevations[i], QNH, ownshipGeometricAltitude, ownshipPressureAltitude);
-                auto l = airspace.estimatedLowerBoundMSL(elevations[i], QNH, ownshipGeometricAltitude, ownshipPressureAltitude);
-                if (l < u)
-                {
-                    upper << QPointF(x, altToYCoordinate(u));
-                    lower << QPointF(x, altToYCoordinate(l));
-                    continue;
-                }
-            }
-
-            if (!upper.isEmpty())
-            {
-                std::reverse(lower.begin(), lower.end());
-                QPolygonF polygon(upper + lower);
-                polygon << upper[0];
-                if ((airspace.CAT() == u"A"_s) || (airspace.CAT() == u"B"_s) || (airspace.CAT() == u"C"_s) || (airspace.CAT() == u"D"_s))
-                {
-                    airspacePolygonsA << polygon;
-                }
-                if (airspace.CAT() == u"CTR"_s)
-                {
-                    airspacePolygonsCTR << polygon;
-                }
-                if ((airspace.CAT() == u"R"_s) || (airspace.CAT() == u"P"_s) || (airspace.CAT() == u"DNG"_s))
-                {
-                    airspacePolygonsR << polygon;
-                }
-                if ((airspace.CAT() == u"ATZ"_s) || (airspace.CAT() == u"RMZ"_s) || (airspace.CAT() == u"TIA"_s) || (airspace.CAT() == u"TIZ"_s))
-                {
-                    airspacePolygonsRMZ << polygon;
-                }
-                if (airspace.CAT() == u"NRA"_s)
-                {
-                    airspacePolygonsNRA << polygon;
-                }
-                if ((airspace.CAT() == u"PJE"_s) || (airspace.CAT() == u"SUA"_s))
-                {
-                    airspacePolygonsPJE << polygon;
-                }
-                if (airspace.CAT() == u"TMZ"_s)
-                {
-                    airspacePolygonsTMZ << polygon;
-                }
-                upper.clear();
-                lower.clear();
-            }
-        }
-    }
-
-    newAirspaces[u"A"_s] = QVariant::fromValue(airspacePolygonsA);
-    newAirspaces[u"CTR"_s] = QVariant::fromValue(airspacePolygonsCTR);
-    newAirspaces[u"R"_s] = QVariant::fromValue(airspacePolygonsR);
-    newAirspaces[u"RMZ"_s] = QVariant::fromValue(airspacePolygonsRMZ);
-    newAirspaces[u"NRA"_s] = QVariant::fromValue(airspacePolygonsNRA);
-    newAirspaces[u"PJE"_s] = QVariant::fromValue(airspacePolygonsPJE);
-    newAirspaces[u"TMZ"_s] = QVariant::fromValue(airspacePolygonsTMZ);
-
-    m_airspaces = newAirspaces;
-    //qWarning() << "SideviewQuickItem full" << m_elapsedTimer.elapsed();
+    m_airspaces = airspaceBands(m_candidateAirspaces, m_samples, xCoordinates, elevations, QNH, ownshipGeometricAltitude, ownshipPressureAltitude, altToYCoordinate);
 }
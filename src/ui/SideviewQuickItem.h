@@ -1,5 +1,5 @@
 /***************************************************************************
- *   Copyright (C) 2025 by Simon Schneider, Stefan Kebekus                 *
+ *   Copyright (C) 2025-2026 by Simon Schneider, Stefan Kebekus            *
  *   stefan.kebekus@gmail.com                                              *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
@@ -20,27 +20,44 @@
 
 #pragma once
 
+#include <QColor>
 #include <QElapsedTimer>
+#include <QGeoCoordinate>
 #include <QQuickItem>
 #include <QTimer>
+#include <QVarLengthArray>
+#include <functional>
 
+#include "geomaps/Airspace.h"
 #include "navigation/BaroCache.h"
+#include "units/Distance.h"
+#include "units/Pressure.h"
+
+class Benchmark;
 
 
 namespace Ui {
 
 /*! \brief QML base class for lateral airspace view
  *
- * This class is the base class for the QML type "Sideview", which provides a lateral airspace view. It provides the polygons
- * used by Sideview to draw terrain, airspaces, the position of the own aircraft, and the 5-minute bar.
+ * This class is the base class for the QML type "Sideview", which provides a lateral airspace view. It draws sky and terrain
+ * directly into the scene graph, and provides the polygons used by Sideview to draw airspaces, the position of the own
+ * aircraft, and the 5-minute bar.
  *
- * Compiling the polygons is rather expensive. To keep the GUI responsive, the class limits the update frequency to one update every 700msec.
+ * Terrain elevations are sampled at fixed distances along a line through an anchor point, in the direction of the
+ * track. While the aircraft follows that line, the samples are reused and only the newly exposed part of the view is
+ * sampled. The airspaces that intersect the line are looked up once per anchor point; for every sample, the class
+ * remembers which of them contain the sample. To keep the GUI responsive, the class limits the update frequency to one
+ * update every 700msec.
  */
 class SideviewQuickItem : public QQuickItem
 {
     Q_OBJECT
     QML_NAMED_ELEMENT(SideviewQuickItem)
 
+    // The benchmarks call private static methods directly
+    friend class ::Benchmark;
+
 public:
     explicit SideviewQuickItem(QQuickItem *parent = nullptr);
 
@@ -97,12 +114,11 @@ public:
      */
     Q_PROPERTY(double pixelPer10km READ pixelPer10km WRITE setPixelPer10km BINDABLE bindablePixelPer10km REQUIRED)
 
-    /*! \brief Terrain polygons
-     *
-     * This property holds polygons that can be used with the QML class "Shape"
-     * in order to draw a the terrain in the lateral view of the airspace situation.
-     */
-    Q_PROPERTY(QPolygonF terrain READ terrain BINDABLE bindableTerrain)
+    /*! \brief Color of the sky */
+    Q_PROPERTY(QColor skyColor READ skyColor WRITE setSkyColor BINDABLE bindableSkyColor)
+
+    /*! \brief Fill color of the terrain */
+    Q_PROPERTY(QColor terrainFillColor READ terrainFillColor WRITE setTerrainFillColor BINDABLE bindableTerrainFillColor)
 
     /*! \brief Track string
      *
@@ -197,20 +213,78 @@ public:
 
     /*! \brief Getter method for property with the same name
      *
-     *  @returns Property terrain
+     *  @returns Property skyColor
+     */
+    QColor skyColor() const {return m_skyColor.value();}
+
+    /*! \brief Getter method for property with the same name
+     *
+     *  @returns Property skyColor
+     */
+    QBindable<QColor> bindableSkyColor() {return &m_skyColor;}
+
+    /*! \brief Setter method for property with the same name
+     *
+     *  @param newVal Property skyColor
+     */
+    void setSkyColor(const QColor& newVal) {m_skyColor = newVal;}
+
+    /*! \brief Getter method for property with the same name
+     *
+     *  @returns Property terrainFillColor
      */
-    QPolygonF terrain() const {return m_terrain.value();}
+    QColor terrainFillColor() const {return m_terrainFillColor.value();}
 
     /*! \brief Getter method for property with the same name
      *
-     *  @returns Property terrain
+     *  @returns Property terrainFillColor
+     */
+    QBindable<QColor> bindableTerrainFillColor() {return &m_terrainFillColor;}
+
+    /*! \brief Setter method for property with the same name
+     *
+     *  @param newVal Property terrainFillColor
      */
-    QBindable<QPolygonF> bindableTerrain() const {return &m_terrain;}
+    void setTerrainFillColor(const QColor& newVal) {m_terrainFillColor = newVal;}
 
+protected:
+    // Re-implemented from QQuickItem. Draws sky and terrain.
+    QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* updatePaintNodeData) override;
 
 private:
     Q_DISABLE_COPY_MOVE(SideviewQuickItem)
 
+    // Terrain sample along the track
+    struct Sample
+    {
+        QGeoCoordinate coordinate;
+        Units::Distance elevation;               // NaN if unknown
+        QVarLengthArray<qsizetype, 4> airspaces; // Indices of airspaces in m_candidateAirspaces that contain the coordinate
+    };
+
+    // Forget all samples, so that the next update starts with a new anchor point
+    void resetSamples() { m_samples.clear(); m_anchor = {}; }
+
+    // Ensure that m_samples holds exactly the samples with indices in the range [first, last]
+    void updateSamples(qsizetype first, qsizetype last);
+
+    // Computes a sample, except for its elevation
+    Sample sample(qsizetype index) const;
+
+    // Computes the value of the property airspaces: for every airspace
+    // category shown by Sideview.qml, a list of polygons in pixel
+    // coordinates. The samples refer to airspaces by their index in the list
+    // airspaces, the lists xCoordinates and elevations hold one entry per
+    // sample.
+    [[nodiscard]] static QVariantMap airspaceBands(const QList<GeoMaps::Airspace>& airspaces,
+                                                   const QList<Sample>& samples,
+                                                   const QList<double>& xCoordinates,
+                                                   const QList<Units::Distance>& elevations,
+                                                   Units::Pressure QNH,
+                                                   Units::Distance ownshipGeometricAltitude,
+                                                   Units::Distance ownshipPressureAltitude,
+                                                   const std::function<double(Units::Distance)>& altToYCoordinate);
+
     // Timers used for rate-limiting, used to ensure that the expensive method
     // updateProperties() runs at most every minimumUpdateInterval_ms.
     QElapsedTimer m_elapsedTimer;
@@ -231,7 +305,23 @@ private:
 
     QProperty<QPointF> m_fiveMinuteBar;
 
-    QProperty<QPolygonF> m_terrain;
+    QProperty<QColor> m_skyColor {QColor(Qt::white)};
+    QProperty<QColor> m_terrainFillColor {QColor(Qt::darkGray)};
+
+    // Terrain profile in pixel coordinates, used by updatePaintNode()
+    QList<QPointF> m_terrain;
+
+    // Samples are taken on the line through m_anchor in direction m_anchorTrack.
+    // The sample with index k has distance k*m_sampleSpacing from m_anchor.
+    // m_samples holds the samples with indices m_firstSample, m_firstSample+1, …
+    QGeoCoordinate m_anchor;
+    double m_anchorTrack {0.0}; // degrees
+    double m_sampleSpacing {0.0}; // meters
+    qsizetype m_firstSample {0};
+    QList<Sample> m_samples;
+
+    // Airspaces of relevant categories that intersect the line through the anchor point
+    QList<GeoMaps::Airspace> m_candidateAirspaces;
 
     QProperty<QVariantMap> m_airspaces;
 
@@ -0,0 +1,125 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <QtMath>
+
+#include "weather/QNHStationIndex.h"
+
+
+Weather::QNHStationIndex::QNHStationIndex(const QMap<QString, Weather::METAR>& METARs)
+{
+    m_stations.reserve(METARs.size());
+    m_vectors.reserve(METARs.size());
+    for (const auto& metar : METARs)
+    {
+        if (!metar.isValid())
+        {
+            continue;
+        }
+        if (!metar.QNH().isFinite())
+        {
+            continue;
+        }
+        if (!metar.coordinate().isValid())
+        {
+            continue;
+        }
+        m_stations.append(metar);
+        m_vectors.append(toVector(metar.coordinate()));
+    }
+}
+
+
+//
+// Methods
+//
+
+Weather::METAR Weather::QNHStationIndex::closest(const QGeoCoordinate& position) const
+{
+    if (m_stations.isEmpty())
+    {
+        return {};
+    }
+
+    // Without position, use the first station
+    if (!position.isValid())
+    {
+        return m_stations.constFirst();
+    }
+
+    // If we have not moved by more than the cached margin, the closest station
+    // cannot have changed: every other station is at least 2*margin further
+    // away from the cached position than the closest one.
+    if ((m_closestIndex >= 0) && m_closestPosition.isValid() &&
+        (position.distanceTo(m_closestPosition) < m_closestMargin_m))
+    {
+        return m_stations.at(m_closestIndex);
+    }
+
+    // Find the closest and second-closest station. For unit vectors, a larger
+    // dot product means a smaller great-circle distance.
+    auto const positionVector = toVector(position);
+    qsizetype closestIndex = -1;
+    qsizetype secondClosestIndex = -1;
+    double closestDot = -2.0;
+    double secondClosestDot = -2.0;
+    for(qsizetype i = 0; i < m_vectors.size(); i++)
+    {
+        const auto& vector = m_vectors.at(i);
+        auto const dot = (vector[0]*positionVector[0]) + (vector[1]*positionVector[1]) + (vector[2]*positionVector[2]);
+        if (dot > closestDot)
+        {
+            secondClosestIndex = closestIndex;
+            secondClosestDot = closestDot;
+            closestIndex = i;
+            closestDot = dot;
+            continue;
+        }
+        if (dot > secondClosestDot)
+        {
+            secondClosestIndex = i;
+            secondClosestDot = dot;
+        }
+    }
+
+    m_closestIndex = closestIndex;
+    m_closestPosition = position;
+    m_closestMargin_m = 0.0;
+    if (secondClosestIndex >= 0)
+    {
+        auto const closestDistance = position.distanceTo(m_stations.at(closestIndex).coordinate());
+        auto const secondClosestDistance = position.distanceTo(m_stations.at(secondClosestIndex).coordinate());
+        m_closestMargin_m = (secondClosestDistance - closestDistance)/2.0;
+    }
+    else
+    {
+        // There is only one station
+        m_closestMargin_m = qInf();
+    }
+    return m_stations.at(closestIndex);
+}
+
+
+std::array<double, 3> Weather::QNHStationIndex::toVector(const QGeoCoordinate& coordinate)
+{
+    auto const latitude = qDegreesToRadians(coordinate.latitude());
+    auto const longitude = qDegreesToRadians(coordinate.longitude());
+    return {qCos(latitude)*qCos(longitude), qCos(latitude)*qSin(longitude), qSin(latitude)};
+}
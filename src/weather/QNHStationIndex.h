@@ -0,0 +1,99 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Stefan Kebekus                                  *
+ *   stefan.kebekus@gmail.com                                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <array>
+
+#include <QGeoCoordinate>
+#include <QMap>
+
+#include "weather/METAR.h"
+
+
+namespace Weather {
+
+/*! \brief Index of weather stations that report a QNH
+ *
+ *  This class holds those METARs that are valid and have a coordinate and a
+ *  QNH, together with the unit vectors in 3-space describing the positions of
+ *  the stations. It finds the station closest to a given position with dot
+ *  products only.
+ *
+ *  The result of the last lookup is cached, together with half the distance
+ *  gap between the closest and the second-closest station. As long as the
+ *  query position stays within that margin of the cached position, the
+ *  closest station cannot change and no scan is needed. The cache is updated
+ *  by closest(), so instances must not be shared between threads.
+ */
+
+class QNHStationIndex
+{
+public:
+    /*! \brief Constructs an empty index */
+    QNHStationIndex() = default;
+
+    /*! \brief Constructs an index
+     *
+     *  @param METARs METARs, by ICAO code. METARs that are invalid or lack a
+     *  coordinate or a QNH are ignored.
+     */
+    explicit QNHStationIndex(const QMap<QString, Weather::METAR>& METARs);
+
+
+    //
+    // Methods
+    //
+
+    /*! \brief METAR of the closest station
+     *
+     *  @param position Position. If the position is invalid, the first
+     *  station in the order of the METARs passed to the constructor is
+     *  returned.
+     *
+     *  @returns METAR of the station closest to the position, or an invalid
+     *  METAR if the index is empty
+     */
+    [[nodiscard]] Weather::METAR closest(const QGeoCoordinate& position) const;
+
+    /*! \brief Number of stations in the index
+     *
+     *  @returns Number of stations
+     */
+    [[nodiscard]] qsizetype size() const { return m_stations.size(); }
+
+private:
+    // Unit vector in 3-space describing the coordinate
+    [[nodiscard]] static std::array<double, 3> toVector(const QGeoCoordinate& coordinate);
+
+    // METARs with QNH, in the order of the METARs passed to the constructor,
+    // and the unit vectors in 3-space describing their positions
+    QList<Weather::METAR> m_stations;
+    QList<std::array<double, 3>> m_vectors;
+
+    // Cache for closest(): index into m_stations, position for which it was
+    // computed, and distance that we may move from there before the result
+    // needs to be recomputed.
+    mutable qsizetype m_closestIndex {-1};
+    mutable QGeoCoordinate m_closestPosition;
+    mutable double m_closestMargin_m {0.0};
+};
+
+} // namespace Weather
@@ -1,5 +1,5 @@
 /***************************************************************************
- *   Copyright (C) 2020-2025 by Stefan Kebekus                             *
+ *   Copyright (C) 2020-2026 by Stefan Kebekus                             *
  *   stefan.kebekus@gmail.com                                              *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
@@ -18,11 +18,15 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <algorithm>
+
 #include <QGuiApplication>
 #include <QLockFile>
 #include <QSaveFile>
 #include <QNetworkReply>
+#include <QtConcurrent/QtConcurrentRun>
 
+#include "Trace.h"
 #include "sunset.h"
 
 #include "navigation/Clock.h"
@@ -34,12 +38,63 @@ using namespace std::chrono_literals;
 using namespace Qt::Literals::StringLiterals;
 
 
+namespace {
+
+// Returns the smallest rectangle that contains all 1°×1° cells of bBox that
+// are not contained in any of the rectangles in covered. The rectangle bBox
+// is expected to have integer coordinates. Returns an invalid rectangle if
+// all cells are covered.
+QGeoRectangle uncoveredPart(const QGeoRectangle& bBox, const QList<QGeoRectangle>& covered)
+{
+    auto normalizedLongitude = [](double longitude) {return (longitude > 180.0) ? longitude - 360.0 : longitude;};
+
+    auto const south = qRound(bBox.bottomLeft().latitude());
+    auto const west = qRound(bBox.bottomLeft().longitude());
+    auto const rows = qRound(bBox.height());
+    auto const columns = qRound(bBox.width());
+
+    QGeoRectangle result;
+    for(int row = 0; row < rows; row++)
+    {
+        for(int column = 0; column < columns; column++)
+        {
+            QGeoRectangle const cell({double(south + row + 1), normalizedLongitude(west + column)},
+                                     {double(south + row), normalizedLongitude(west + column + 1)});
+            if (std::any_of(covered.cbegin(), covered.cend(), [&cell](const QGeoRectangle& rect) {return rect.contains(cell);}))
+            {
+                continue;
+            }
+            result = result.isValid() ? result.united(cell) : cell;
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+
 Weather::WeatherDataProvider::WeatherDataProvider(QObject *parent) : QObject(parent)
 {
+    m_METARsNotifier = m_METARs.addNotifier([this]() {m_QNHStationIndex = QNHStationIndex(m_METARs.value());});
+
+    // Saving is debounced, because downloads often finish in quick succession
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(10s);
+    connect(&m_saveTimer, &QTimer::timeout, this, &Weather::WeatherDataProvider::save);
+
     QTimer::singleShot(0, this, &Weather::WeatherDataProvider::deferredInitialization);
 }
 
 
+Weather::WeatherDataProvider::~WeatherDataProvider()
+{
+    if (m_saveTimer.isActive())
+    {
+        save();
+    }
+}
+
+
 void Weather::WeatherDataProvider::deferredInitialization()
 {
     // Read METAR/TAF from "weather.dat".
@@ -100,12 +155,16 @@ void Weather::WeatherDataProvider::deleteExpiredMesages()
         }
     }
 
-    save();
+    m_saveTimer.start();
 }
 
 
 bool Weather::WeatherDataProvider::downloading() const
 {
+    if (m_parsing)
+    {
+        return true;
+    }
     for(const auto& networkReply : m_networkReplies)
     {
         if (networkReply.isNull())
@@ -124,8 +183,12 @@ bool Weather::WeatherDataProvider::downloading() const
 
 void Weather::WeatherDataProvider::downloadFinished()
 {
-    // Start to process the data only once ALL replies have been received. So, we check here if there are any running
-    // download processes and abort if indeed there are some.
+    Trace::Span const span("WeatherDataProvider::downloadFinished");
+
+    // Start to process the data only once ALL replies have been received, and
+    // once data from earlier replies has been parsed. So, we check here if
+    // there are any running download or parsing processes and abort if indeed
+    // there are some.
     if (downloading())
     {
         return;
@@ -134,8 +197,11 @@ void Weather::WeatherDataProvider::downloadFinished()
     // Update flag
     emit downloadingChanged();
 
-    // Read all replies and store the data in respective maps
+    // Read all replies. The data is parsed in a separate thread.
     bool hasError = false;
+    bool hasSuccess = false;
+    QList<QByteArray> data;
+    QList<QGeoRectangle> bBoxes;
     for(const auto& networkReply : std::as_const(m_networkReplies))
     {
         // Paranoid safety checks
@@ -149,17 +215,88 @@ void Weather::WeatherDataProvider::downloadFinished()
             emit error(networkReply->errorString());
             continue;
         }
+        hasSuccess = true;
+        data << networkReply->readAll();
+        auto const bBox = networkReply->property("bBox").value<QGeoRectangle>();
+        if (bBox.isValid())
+        {
+            bBoxes << bBox;
+        }
+    }
+
+    // Clear replies container
+    foreach(auto networkReply, m_networkReplies)
+    {
+        // Paranoid safety checks
+        if (!networkReply.isNull())
+        {
+            networkReply->deleteLater();
+        }
+    }
+    m_networkReplies.clear();
+
+    if (hasSuccess)
+    {
+        m_updateTimer.setInterval(updateIntervalNormal_ms);
+    }
+    if (hasError)
+    {
+        m_updateTimer.setInterval(updateIntervalOnError_ms);
+    }
+    if (data.isEmpty())
+    {
+        emit QNHInfoChanged();
+        return;
+    }
+
+    m_parsing = true;
+    emit downloadingChanged();
+    QtConcurrent::run(&Weather::WeatherDataProvider::parse, data).then(this, [this, bBoxes](const ParseResult& result) {
+        m_parsing = false;
+        merge(result);
+
+        // Log successful updates
+        if (!result.hasError)
+        {
+            auto const now = QDateTime::currentDateTimeUtc();
+            for(const auto& bBox : bBoxes)
+            {
+                updateLog << updateLogEntry{now, bBox};
+            }
+        }
+        else
+        {
+            m_updateTimer.setInterval(updateIntervalOnError_ms);
+        }
+
+        // Update flag and signals
+        emit downloadingChanged();
+        emit QNHInfoChanged();
+        m_saveTimer.start();
+
+        // Handle replies that have finished while parsing
+        if (!m_networkReplies.isEmpty())
+        {
+            downloadFinished();
+        }
+    });
+}
+
 
-        // Decode XML
-        QXmlStreamReader xml(networkReply);
-        QList<Weather::METAR> newMETARs;
-        QList<Weather::TAF> newTAFs;
+Weather::WeatherDataProvider::ParseResult Weather::WeatherDataProvider::parse(const QList<QByteArray>& data)
+{
+    Trace::Span const span("WeatherDataProvider::parse");
+
+    ParseResult result;
+    for(const auto& datum : data)
+    {
+        QXmlStreamReader xml(datum);
         while (!xml.atEnd() && !xml.hasError())
         {
             xml.readNext();
             if(xml.hasError())
             {
-                hasError = true;
+                result.hasError = true;
                 break;
             }
 
@@ -169,7 +306,7 @@ void Weather::WeatherDataProvider::downloadFinished()
                 Weather::METAR const metar(xml);
                 if (metar.isValid())
                 {
-                    newMETARs << metar;
+                    result.METARs << metar;
                 }
             }
 
@@ -179,54 +316,37 @@ void Weather::WeatherDataProvider::downloadFinished()
                 Weather::TAF const taf(xml);
                 if (taf.isValid())
                 {
-                    newTAFs << taf;
+                    result.TAFs << taf;
                 }
             }
         }
+    }
+    return result;
+}
+
 
+void Weather::WeatherDataProvider::merge(const ParseResult& result)
+{
+    // The maps are copied (and thereby detached) at most once, and the
+    // properties are set only if something was added.
+    if (!result.METARs.isEmpty())
+    {
         auto tmpMETARs = m_METARs.value();
-        for(const auto& newMETAR : std::as_const(newMETARs))
+        for(const auto& newMETAR : result.METARs)
         {
-            tmpMETARs[newMETAR.ICAOCode()] = newMETAR;
+            tmpMETARs.insert(newMETAR.ICAOCode(), newMETAR);
         }
         m_METARs = tmpMETARs;
-
-        auto tmpTAFs = m_TAFs.value();
-        for(const auto& newTAF : std::as_const(newTAFs))
-        {
-            tmpTAFs[newTAF.ICAOCode()] = newTAF;
-        }
-        m_TAFs = tmpTAFs;
-
-        const updateLogEntry le = {QDateTime::currentDateTimeUtc(), networkReply->property("bBox").value<QGeoRectangle>()};
-        if (le.m_bBox.isValid() && le.m_time.isValid())
-        {
-            updateLog << le;
-        }
-        m_updateTimer.setInterval(updateIntervalNormal_ms);
     }
 
-    // Clear replies container
-    foreach(auto networkReply, m_networkReplies)
+    if (!result.TAFs.isEmpty())
     {
-        // Paranoid safety checks
-        if (!networkReply.isNull())
+        auto tmpTAFs = m_TAFs.value();
+        for(const auto& newTAF : result.TAFs)
         {
-            networkReply->deleteLater();
+            tmpTAFs.insert(newTAF.ICAOCode(), newTAF);
         }
-    }
-    m_networkReplies.clear();
-
-    // Update flag and signals
-    emit QNHInfoChanged();
-
-    if (hasError)
-    {
-        m_updateTimer.setInterval(updateIntervalOnError_ms);
-    }
-    else
-    {
-        save();
+        m_TAFs = tmpTAFs;
     }
 }
 
@@ -410,32 +530,7 @@ Units::Pressure Weather::WeatherDataProvider::QNH() const
     }
 
     // Find QNH of nearest airfield
-    METAR closestMETARWithQNH;
-    for (auto i = m_METARs.value().cbegin(), end = m_METARs.value().cend(); i != end; ++i)
-    {
-        if (!i.value().isValid())
-        {
-            continue;
-        }
-        if (!i.value().QNH().isFinite())
-        {
-            continue;
-        }
-        if (!i.value().coordinate().isValid())
-        {
-            continue;
-        }
-        if (!closestMETARWithQNH.isValid()) {
-            closestMETARWithQNH = i.value();
-            continue;
-        }
-
-        QGeoCoordinate const here = Positioning::PositionProvider::lastValidCoordinate();
-        if (here.distanceTo(i.value().coordinate()) < here.distanceTo(closestMETARWithQNH.coordinate()))
-        {
-            closestMETARWithQNH = i.value();
-        }
-    }
+    auto const closestMETARWithQNH = m_QNHStationIndex.closest(Positioning::PositionProvider::lastValidCoordinate());
     if (closestMETARWithQNH.isValid())
     {
         return closestMETARWithQNH.QNH();
@@ -454,33 +549,7 @@ QString Weather::WeatherDataProvider::QNHInfo() const
     }
 
     // Find QNH of nearest airfield
-    METAR closestMETARWithQNH;
-    for (auto i = m_METARs.value().cbegin(), end = m_METARs.value().cend(); i != end; ++i)
-    {
-        if (!i.value().isValid())
-        {
-            continue;
-        }
-        if (!i.value().QNH().isFinite())
-        {
-            continue;
-        }
-        if (!i.value().coordinate().isValid())
-        {
-            continue;
-        }
-        if (!closestMETARWithQNH.isValid()) {
-            closestMETARWithQNH = i.value();
-            continue;
-        }
-
-        QGeoCoordinate const here = Positioning::PositionProvider::lastValidCoordinate();
-        if (here.distanceTo(i.value().coordinate()) < here.distanceTo(closestMETARWithQNH.coordinate()))
-        {
-            closestMETARWithQNH = i.value();
-        }
-    }
-
+    auto const closestMETARWithQNH = m_QNHStationIndex.closest(Positioning::PositionProvider::lastValidCoordinate());
     if (closestMETARWithQNH.isValid() && qIsFinite(closestMETARWithQNH.QNH().toHPa()))
     {
         return tr("%1 hPa in %2, %3").arg(qRound(closestMETARWithQNH.QNH().toHPa()))
@@ -543,28 +612,28 @@ void Weather::WeatherDataProvider::startDownload(const QGeoRectangle& _bBox)
     bBox.setBottomLeft({std::floor(_bBox.bottomLeft().latitude()), std::floor(_bBox.bottomLeft().longitude())});
     bBox.setTopRight({std::ceil(_bBox.topRight().latitude()), std::ceil(_bBox.topRight().longitude())});
 
-    // Check if bounding box is already covered
+    // Find the part of the bounding box that is not covered by recent updates
+    // or by downloads in progress, and download only that part
     updateLog.removeIf([](const updateLogEntry& ule) {return !ule.m_bBox.isValid() || !ule.m_time.isValid();});
     updateLog.removeIf([](const updateLogEntry& ule) {return ule.m_time.addSecs(qint64(5*60)) < QDateTime::currentDateTimeUtc();});
+    QList<QGeoRectangle> covered;
     for(const auto& ule : std::as_const(updateLog))
     {
-        if (ule.m_bBox.contains(bBox))
-        {
-            return;
-        }
+        covered << ule.m_bBox;
     }
     m_networkReplies.removeAll(nullptr);
     for(const auto& nwr : std::as_const(m_networkReplies))
     {
-        if (!nwr->isRunning())
-        {
-            continue;
-        }
-        if (nwr->property("area").value<QGeoRectangle>().contains(bBox))
+        if (nwr->isRunning())
         {
-            return;
+            covered << nwr->property("bBox").value<QGeoRectangle>();
         }
     }
+    bBox = uncoveredPart(bBox, covered);
+    if (!bBox.isValid())
+    {
+        return;
+    }
 
     {
         QString const urlString
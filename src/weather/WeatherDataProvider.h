@@ -28,8 +28,10 @@
 #include "geomaps/Waypoint.h"
 #include "navigation/Atmosphere.h"
 #include "weather/METAR.h"
+#include "weather/QNHStationIndex.h"
 #include "weather/TAF.h"
 
+class Benchmark;
 class QNetworkReply;
 
 
@@ -60,6 +62,9 @@ class WeatherDataProvider : public QObject {
     friend QDataStream& operator<<(QDataStream& stream, const updateLogEntry& ule);
     friend QDataStream& operator>>(QDataStream& stream, updateLogEntry& ule);
 
+    // The benchmarks call private static methods directly
+    friend class ::Benchmark;
+
 public:
     /*! \brief Standard constructor
      *
@@ -70,6 +75,12 @@ public:
     // No default constructor, important for QML singleton
     explicit WeatherDataProvider() = delete;
 
+    /*! \brief Destructor
+     *
+     * The destructor saves all weather data, if a save is pending.
+     */
+    ~WeatherDataProvider() override;
+
     // factory function for QML singleton
     static Weather::WeatherDataProvider* create(QQmlEngine* /*unused*/, QJSEngine* /*unused*/)
     {
@@ -194,8 +205,9 @@ public:
      *
      * This method initiates the asynchronous download of weather information
      * from the internet, for a region around the current position and around
-     * the current flight route.  This method quits immediately if data for that
-     * region has been downloaded successfully less than five minutes ago.
+     * the current flight route.  Only those parts of the region are downloaded
+     * for which no data has been downloaded successfully in the last five
+     * minutes. The method quits immediately if there are no such parts.
      *
      * If an error occurred while downloading, the signal "error" will be
      * emitted.
@@ -270,6 +282,27 @@ private:
     // silently on error.
     void save();
 
+    // Timer used to debounce save()
+    QTimer m_saveTimer;
+
+    // METARs and TAFs parsed from downloaded data
+    struct ParseResult
+    {
+        QList<Weather::METAR> METARs;
+        QList<Weather::TAF> TAFs;
+        bool hasError {false};
+    };
+
+    // Parses XML data from the server. This method is run in a separate
+    // thread.
+    static ParseResult parse(const QList<QByteArray>& data);
+
+    // Merges parsed data into m_METARs and m_TAFs
+    void merge(const ParseResult& result);
+
+    // Indicates that downloaded data is currently being parsed
+    bool m_parsing {false};
+
     // List of replies from aviationweather.com
     QList<QPointer<QNetworkReply>> m_networkReplies;
 
@@ -281,8 +314,12 @@ private:
 
     // METARs and TAFs by ICAO Code
     QProperty<QMap<QString, Weather::METAR>> m_METARs;
+    QPropertyNotifier m_METARsNotifier; // Used to rebuild the QNH station index
     QProperty<QMap<QString, Weather::TAF>> m_TAFs;
 
+    // Weather stations with QNH, rebuilt whenever m_METARs changes
+    Weather::QNHStationIndex m_QNHStationIndex;
+
     // Time and BBox of the last succesful METAR update for the current region and flight route
     struct updateLogEntry
     {